@@ -0,0 +1,138 @@
+// planescaling.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+// Measures how noise::model::Plane::GetValues() scales with the number of
+// threads in a noise::ThreadPool.  The program generates a terrain-like
+// module graph over a grid once for each thread count, from 1 up to the
+// number of processors (or the count given on the command line), and prints
+// the time, the speedup over one thread, and the parallel efficiency.
+//
+// Usage: planescaling [width [height [maxThreadCount [repeatCount]]]]
+//
+// The defaults are a 4096 x 4096 grid, one thread per processor, and the
+// best of 3 runs for each thread count.
+
+#include <stdio.h>
+#include <stdlib.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
+#include <noise.h>
+
+using namespace noise;
+
+// Returns the current time in seconds.
+static double GetTime ()
+{
+#ifdef _WIN32
+  LARGE_INTEGER frequency, counter;
+  QueryPerformanceFrequency (&frequency);
+  QueryPerformanceCounter (&counter);
+  return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+  struct timeval time;
+  gettimeofday (&time, NULL);
+  return time.tv_sec + time.tv_usec * 1.0e-6;
+#endif
+}
+
+// Generates the grid with the thread pool and returns the best time of
+// several runs.
+static double TimeGrid (const model::Plane& plane, int width, int height,
+  float* values, ThreadPool* pPool, int repeatCount)
+{
+  double bestTime = 0.0;
+  for (int i = 0; i < repeatCount; i++) {
+    double startTime = GetTime ();
+    plane.GetValues (width, height, 0.0, 16.0, 0.0, 16.0, values, pPool);
+    double time = GetTime () - startTime;
+    if (i == 0 || time < bestTime) {
+      bestTime = time;
+    }
+  }
+  return bestTime;
+}
+
+int main (int argc, char** argv)
+{
+  int width = argc > 1? atoi (argv[1]): 4096;
+  int height = argc > 2? atoi (argv[2]): width;
+  int maxThreadCount = argc > 3? atoi (argv[3]):
+    ThreadPool::GetProcessorCount ();
+  int repeatCount = argc > 4? atoi (argv[4]): 3;
+  if (width < 1 || height < 1 || maxThreadCount < 1 || repeatCount < 1) {
+    fprintf (stderr,
+      "usage: planescaling [width [height [maxThreadCount "
+      "[repeatCount]]]]\n");
+    return 1;
+  }
+
+  // A mountain-and-plains graph, similar to the ones that applications
+  // generate heightmaps from.
+  module::RidgedMulti mountains;
+  module::Billow plainsBase;
+  plainsBase.SetFrequency (2.0);
+  module::ScaleBias plains;
+  plains.SetSourceModule (0, plainsBase);
+  plains.SetScale (0.125);
+  plains.SetBias (-0.75);
+  module::Perlin terrainType;
+  terrainType.SetFrequency (0.5);
+  terrainType.SetPersistence (0.25);
+  module::Select terrain;
+  terrain.SetSourceModule (0, plains);
+  terrain.SetSourceModule (1, mountains);
+  terrain.SetControlModule (terrainType);
+  terrain.SetBounds (0.0, 1000.0);
+  terrain.SetEdgeFalloff (0.125);
+  model::Plane plane (terrain);
+
+  float* values = new float[(size_t)width * height];
+  printf ("%d x %d grid, %d processors\n", width, height,
+    ThreadPool::GetProcessorCount ());
+  printf ("threads      time   speedup  efficiency\n");
+  double baseTime = 0.0;
+  int threadCount = 1;
+  for (;;) {
+    ThreadPool pool (threadCount);
+    double time = TimeGrid (plane, width, height, values, &pool,
+      repeatCount);
+    if (threadCount == 1) {
+      baseTime = time;
+    }
+    double speedup = baseTime / time;
+    printf ("%7d  %8.3fs  %7.2fx  %9.1f%%\n", pool.GetThreadCount (), time,
+      speedup, 100.0 * speedup / pool.GetThreadCount ());
+    fflush (stdout);
+    if (threadCount == maxThreadCount) {
+      break;
+    }
+    threadCount = threadCount * 2 < maxThreadCount? threadCount * 2:
+      maxThreadCount;
+  }
+
+  delete[] values;
+  return 0;
+}
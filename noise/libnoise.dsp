@@ -189,6 +189,14 @@ SOURCE=.\src\module\exponent.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\src\module\hashcache.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\module\hashcache.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\src\module\invert.cpp
 # End Source File
 # Begin Source File
@@ -249,6 +257,14 @@ SOURCE=.\src\module\power.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\src\module\program.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\module\program.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\src\module\ridgedmulti.cpp
 # End Source File
 # Begin Source File
@@ -289,6 +305,14 @@ SOURCE=.\src\module\select.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\src\module\simplex.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\module\simplex.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\src\module\spheres.cpp
 # End Source File
 # Begin Source File
@@ -305,6 +329,22 @@ SOURCE=.\src\module\terrace.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\src\module\tilecache.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\module\tilecache.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\module\transformpoint.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\module\transformpoint.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\src\module\translatepoint.cpp
 # End Source File
 # Begin Source File
@@ -390,10 +430,18 @@ SOURCE=.\src\basictypes.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\src\boundsimpl.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\src\exception.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\src\fractalimpl.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\src\interp.h
 # End Source File
 # Begin Source File
@@ -426,6 +474,50 @@ SOURCE=.\src\noisegen.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\src\noisegen_avx2.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\noisegen_avx512.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\noisegen_sse2.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\noisegen_sse41.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\noisegenimpl.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\permutationtable.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\permutationtable.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\threadimpl.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\threadimpl.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\threadpool.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\threadpool.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\src\vectortable.h
 # End Source File
 # End Target
@@ -35,6 +35,13 @@ namespace noise
   /// Unsigned integer type.
   typedef unsigned int uint;
 
+  /// 64-bit unsigned integer type.
+#ifdef _MSC_VER
+  typedef unsigned __int64 uint64;
+#else
+  typedef unsigned long long uint64;
+#endif
+
   /// 32-bit unsigned integer type.
   typedef unsigned int uint32;
 
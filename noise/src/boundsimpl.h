@@ -0,0 +1,301 @@
+// boundsimpl.h
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+#ifndef NOISE_BOUNDSIMPL_H
+#define NOISE_BOUNDSIMPL_H
+
+#include <float.h>
+#include <math.h>
+#include "misc.h"
+
+// This header is internal to libnoise.  It implements the interval
+// arithmetic shared by the GetBounds() methods of the noise modules and by
+// noise::module::Program.  A range is a pair of lower and upper bounds; a
+// box is a pair of arrays holding the lower and upper x, y, and z
+// coordinates.  An infinite bound means that the values are unbounded in
+// that direction.
+//
+// Noise modules only output NaN where their output values are unbounded
+// (for example, noise::module::Power with a negative base), so a range
+// that may contain NaN has an infinite bound.  A calculation that can pass
+// NaN from a source range to its result must keep an infinite bound in the
+// result, even where the other values it outputs are bounded.
+//
+// The bounds are calculated with floating-point arithmetic, as are the
+// output values, but not always with the same operations in the same
+// order.  A calculation whose output values may be rounded differently from
+// its bounds rounds the bounds outward (see RoundOutward().)
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+namespace noise
+{
+
+  // Determines if a range may contain NaN.
+  inline bool MayBeNaN (double lower, double upper)
+  {
+    return !(lower > -HUGE_VAL && upper < HUGE_VAL);
+  }
+
+  // Makes the lower bound of a range infinite if the range was calculated
+  // from a range that may contain NaN but no longer shows it.  This widens
+  // the range, so the other values remain within it.
+  inline void KeepNaN (bool mayBeNaN, double& lower, double& upper)
+  {
+    if (mayBeNaN && !MayBeNaN (lower, upper)) {
+      lower = -HUGE_VAL;
+    }
+  }
+
+  // Calculates the range of a constant.  A constant that was folded from a
+  // calculation may be NaN.
+  inline void ConstBounds (double value, double& newLower, double& newUpper)
+  {
+    if (value == value) {
+      newLower = value;
+      newUpper = value;
+    } else {
+      newLower = -HUGE_VAL;
+      newUpper = HUGE_VAL;
+    }
+  }
+
+  // Returns the next representable value after x in the direction of y.
+  inline double NextAfter (double x, double y)
+  {
+#if defined (_MSC_VER) && _MSC_VER < 1800
+    return _nextafter (x, y);
+#else
+    return nextafter (x, y);
+#endif
+  }
+
+  // Rounds a range outward: widens it by the rounding error of a
+  // calculation whose terms have magnitudes that add up to the specified
+  // magnitude, then by one more unit in the last place.  Pass a magnitude of
+  // 0.0 if only the last rounding of the bounds may differ.
+  inline void RoundOutward (double magnitude, double& lower, double& upper)
+  {
+    double margin = 8.0 * DBL_EPSILON * magnitude;
+    if (margin < HUGE_VAL) {
+      lower -= margin;
+      upper += margin;
+    }
+    lower = NextAfter (lower, -HUGE_VAL);
+    upper = NextAfter (upper, HUGE_VAL);
+  }
+
+  // Multiplies two bounds.  A zero bound multiplied by an infinite bound is
+  // zero, since the values that the infinite bound stands for are finite.
+  inline double MultiplyBound (double a, double b)
+  {
+    if (a == 0.0 || b == 0.0) {
+      return 0.0;
+    }
+    return a * b;
+  }
+
+  // Calculates the range of |v| for v within [lower, upper].
+  inline void AbsBounds (double lower, double upper, double& newLower,
+    double& newUpper)
+  {
+    if (lower >= 0.0) {
+      newLower = lower;
+      newUpper = upper;
+    } else if (upper <= 0.0) {
+      newLower = -upper;
+      newUpper = -lower;
+    } else {
+      newLower = 0.0;
+      newUpper = GetMax (-lower, upper);
+    }
+  }
+
+  // Calculates the range of a clamped value.  Clamping never decreases a
+  // larger value below a smaller one, so the bounds are clamped directly.
+  // NaN is not clamped.
+  inline void ClampBounds (double lower, double upper, double clampLower,
+    double clampUpper, double& newLower, double& newUpper)
+  {
+    newLower = GetMin (GetMax (lower, clampLower), clampUpper);
+    newUpper = GetMin (GetMax (upper, clampLower), clampUpper);
+    KeepNaN (MayBeNaN (lower, upper), newLower, newUpper);
+  }
+
+  // Calculates the range of GetMax (v0, v1) for v0 within [lower0, upper0]
+  // and v1 within [lower1, upper1].  GetMax() returns v1 if v0 is NaN, so
+  // if either range may contain NaN, the result may be any value of v1 as
+  // well as NaN.
+  inline void MaxBounds (double lower0, double upper0, double lower1,
+    double upper1, double& newLower, double& newUpper)
+  {
+    if (MayBeNaN (lower0, upper0) || MayBeNaN (lower1, upper1)) {
+      newLower = GetMin (lower0, lower1);
+    } else {
+      newLower = GetMax (lower0, lower1);
+    }
+    newUpper = GetMax (upper0, upper1);
+  }
+
+  // Calculates the range of GetMin (v0, v1) for v0 within [lower0, upper0]
+  // and v1 within [lower1, upper1].  GetMin() returns v1 if v0 is NaN, so
+  // if either range may contain NaN, the result may be any value of v1 as
+  // well as NaN.
+  inline void MinBounds (double lower0, double upper0, double lower1,
+    double upper1, double& newLower, double& newUpper)
+  {
+    newLower = GetMin (lower0, lower1);
+    if (MayBeNaN (lower0, upper0) || MayBeNaN (lower1, upper1)) {
+      newUpper = GetMax (upper0, upper1);
+    } else {
+      newUpper = GetMin (upper0, upper1);
+    }
+  }
+
+  // Calculates the range of v0 * v1 for v0 within [lower0, upper0] and v1
+  // within [lower1, upper1].
+  inline void MultiplyBounds (double lower0, double upper0, double lower1,
+    double upper1, double& newLower, double& newUpper)
+  {
+    double p0 = MultiplyBound (lower0, lower1);
+    double p1 = MultiplyBound (lower0, upper1);
+    double p2 = MultiplyBound (upper0, lower1);
+    double p3 = MultiplyBound (upper0, upper1);
+    newLower = GetMin (GetMin (p0, p1), GetMin (p2, p3));
+    newUpper = GetMax (GetMax (p0, p1), GetMax (p2, p3));
+    RoundOutward (0.0, newLower, newUpper);
+    KeepNaN (MayBeNaN (lower0, upper0) || MayBeNaN (lower1, upper1),
+      newLower, newUpper);
+  }
+
+  // Calculates the range of pow (b, e) for b within [lowerBase, upperBase]
+  // and e within [lowerExponent, upperExponent].  If the base is not
+  // negative, pow() is monotonic in each argument, so the extremes lie at
+  // the corners.  A negative base may produce any value (or NaN), so the
+  // range is unbounded.
+  inline void PowBounds (double lowerBase, double upperBase,
+    double lowerExponent, double upperExponent, double& newLower,
+    double& newUpper)
+  {
+    if (!(lowerBase >= 0.0)) {
+      newLower = -HUGE_VAL;
+      newUpper = HUGE_VAL;
+      return;
+    }
+    double p0 = pow (lowerBase, lowerExponent);
+    double p1 = pow (lowerBase, upperExponent);
+    double p2 = pow (upperBase, lowerExponent);
+    double p3 = pow (upperBase, upperExponent);
+    newLower = GetMin (GetMin (p0, p1), GetMin (p2, p3));
+    newUpper = GetMax (GetMax (p0, p1), GetMax (p2, p3));
+    RoundOutward (0.0, newLower, newUpper);
+    KeepNaN (MayBeNaN (lowerBase, upperBase)
+      || MayBeNaN (lowerExponent, upperExponent), newLower, newUpper);
+  }
+
+  // Calculates the range of the exponential curve of noise::module::Exponent,
+  // pow (|(v + 1.0) / 2.0|, exponent) * 2.0 - 1.0, for v within [lower,
+  // upper].
+  inline void ExponentBounds (double lower, double upper, double exponent,
+    double& newLower, double& newUpper)
+  {
+    double lowerBase, upperBase;
+    AbsBounds ((lower + 1.0) / 2.0, (upper + 1.0) / 2.0, lowerBase,
+      upperBase);
+    PowBounds (lowerBase, upperBase, exponent, exponent, newLower, newUpper);
+    newLower = newLower * 2.0 - 1.0;
+    newUpper = newUpper * 2.0 - 1.0;
+  }
+
+  // Calculates the range of LinearInterp (v0, v1, a) for v0 within [lower0,
+  // upper0], v1 within [lower1, upper1], and a within [lowerAlpha,
+  // upperAlpha].  Within the 0.0 to 1.0 range, the interpolated value lies
+  // between v0 and v1, except for rounding, which may overshoot them even
+  // if they are equal; otherwise, it is extrapolated.
+  inline void LerpBounds (double lower0, double upper0, double lower1,
+    double upper1, double lowerAlpha, double upperAlpha, double& newLower,
+    double& newUpper)
+  {
+    if (lowerAlpha >= 0.0 && upperAlpha <= 1.0) {
+      newLower = GetMin (lower0, lower1);
+      newUpper = GetMax (upper0, upper1);
+      RoundOutward (GetMax (fabs (newLower), fabs (newUpper)), newLower,
+        newUpper);
+      return;
+    }
+    double lowerA, upperA, lowerB, upperB;
+    MultiplyBounds (lower0, upper0, 1.0 - upperAlpha, 1.0 - lowerAlpha,
+      lowerA, upperA);
+    MultiplyBounds (lower1, upper1, lowerAlpha, upperAlpha, lowerB, upperB);
+    newLower = lowerA + lowerB;
+    newUpper = upperA + upperB;
+    RoundOutward (0.0, newLower, newUpper);
+  }
+
+  // Calculates the box that contains an affine transformation of a box.
+  // The matrix holds three rows of four elements; the fourth element of
+  // each row is the translation.  The transformed coordinates add up the
+  // same terms in a different order, so they are rounded differently.
+  inline void TransformBox (const double* matrix, const double* lower,
+    const double* upper, double* newLower, double* newUpper)
+  {
+    for (int row = 0; row < 3; row++) {
+      const double* m = matrix + row * 4;
+      newLower[row] = m[3];
+      newUpper[row] = m[3];
+      double magnitude = fabs (m[3]);
+      for (int col = 0; col < 3; col++) {
+        double a = MultiplyBound (m[col], lower[col]);
+        double b = MultiplyBound (m[col], upper[col]);
+        newLower[row] += GetMin (a, b);
+        newUpper[row] += GetMax (a, b);
+        magnitude += GetMax (fabs (a), fabs (b));
+      }
+      RoundOutward (magnitude, newLower[row], newUpper[row]);
+    }
+  }
+
+  // Classifies the range of the control values of a selector module: 0 if
+  // only the first source module is needed, 1 if only the second source
+  // module is needed, or 2 if both are needed.  Which source module a NaN
+  // control value selects depends on the edge falloff, so both are needed
+  // if the range may contain NaN.
+  inline int ClassifyControlBounds (double lower, double upper,
+    double lowerBound, double upperBound, double edgeFalloff)
+  {
+    if (MayBeNaN (lower, upper)) {
+      return 2;
+    } else if (upper < (lowerBound - edgeFalloff)
+      || lower > (upperBound + edgeFalloff)) {
+      return 0;
+    } else if (lower >= (lowerBound + edgeFalloff)
+      && upper < (upperBound - edgeFalloff)) {
+      return 1;
+    }
+    return 2;
+  }
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,162 @@
+// fractalimpl.h
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+#ifndef NOISE_FRACTALIMPL_H
+#define NOISE_FRACTALIMPL_H
+
+#include <math.h>
+#include "interp.h"
+#include "misc.h"
+#include "noisegen.h"
+
+// This header is internal to libnoise.  It is shared by the fractal
+// generator modules, which add up octaves of coherent noise.
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+namespace noise
+{
+
+  // Calculates the weight of each octave of a fractal generator module for
+  // the spacing between the input values at which an application samples
+  // it, and returns the number of octaves to generate.
+  //
+  // The footprint of an octave is the spacing multiplied by its frequency.
+  // An octave whose footprint is at least 0.5 (less than two samples per
+  // wavelength) only produces aliasing, so its weight is 0.0.  An octave
+  // whose footprint is at most 0.25 has a weight of 1.0.  In between, the
+  // weight falls off along an S-curve in the logarithm of the footprint, so
+  // the last octaves fade out smoothly as the spacing grows.  A spacing of
+  // 0.0 gives every octave a weight of 1.0.
+  //
+  // The octaves past the returned count have a weight of 0.0.  The weights
+  // array must hold octaveCount elements.
+  inline int GetOctaveWeights (double frequency, double lacunarity,
+    int octaveCount, double sampleSpacing, double* pWeights)
+  {
+    int weightedOctaveCount = 0;
+    double footprint = fabs (frequency) * sampleSpacing;
+    for (int curOctave = 0; curOctave < octaveCount; curOctave++) {
+      double weight = 1.0;
+      if (footprint >= 0.5) {
+        weight = 0.0;
+      } else if (footprint > 0.25) {
+        weight = SCurve3 (log (0.5 / footprint) / log (2.0));
+      }
+      pWeights[curOctave] = weight;
+      if (weight > 0.0) {
+        weightedOctaveCount = curOctave + 1;
+      }
+      footprint *= fabs (lacunarity);
+    }
+    return weightedOctaveCount;
+  }
+
+  // Returns the largest magnitude of a span of input values, or infinity if
+  // any input value is NaN.  GetMax() returns its second argument if either
+  // argument is NaN, so a NaN input value would otherwise discard the
+  // magnitudes before it.
+  template <class T>
+  inline T GetMaxMagnitude (int count, const T* x, const T* y, const T* z)
+  {
+    T maxMagnitude = 0.0;
+    bool isNaN = false;
+    for (int i = 0; i < count; i++) {
+      maxMagnitude = GetMax (maxMagnitude, (T)fabs (x[i]));
+      maxMagnitude = GetMax (maxMagnitude, (T)fabs (y[i]));
+      maxMagnitude = GetMax (maxMagnitude, (T)fabs (z[i]));
+      isNaN = isNaN || x[i] != x[i] || y[i] != y[i] || z[i] != z[i];
+    }
+    return isNaN? (T)HUGE_VAL: maxMagnitude;
+  }
+
+  // Determines if MakeInt32Range() leaves the input values of an octave
+  // unchanged, given the largest magnitude of the unscaled input values and
+  // the frequency of that octave.  MakeInt32Range() only modifies a value
+  // whose magnitude is at least 2^30; the limit here is half of that, which
+  // covers the rounding of the scaled input values.  The GetValuesImpl()
+  // templates of the fractal generator modules skip MakeInt32Range() for
+  // the spans where this function returns true; it returns false if the
+  // magnitude is NaN or infinite.
+  inline bool IsInInt32Range (double maxMagnitude, double frequency)
+  {
+    return maxMagnitude * fabs (frequency) < 536870912.0;
+  }
+
+  // Divides the amplitudes of the octaves of a fractal generator module by
+  // the sum of their magnitudes, so that the range of the output values is
+  // the range of a single octave, whatever the number of octaves.
+  inline void NormalizeOctaveAmplitudes (int octaveCount, double* pAmplitudes)
+  {
+    double amplitudeSum = 0.0;
+    for (int curOctave = 0; curOctave < octaveCount; curOctave++) {
+      amplitudeSum += fabs (pAmplitudes[curOctave]);
+    }
+    if (amplitudeSum > 0.0) {
+      for (int curOctave = 0; curOctave < octaveCount; curOctave++) {
+        pAmplitudes[curOctave] /= amplitudeSum;
+      }
+    }
+  }
+
+  // Calls the specialized GradientCoherentNoise3DArray() function for the
+  // precision of the input values, so that the GetValuesImpl() templates of
+  // the fractal generator modules can select it by overloading.
+  inline void GradientCoherentNoise3DArray (
+    const GradientCoherentNoiseFunctions& functions, int count,
+    const double* x, const double* y, const double* z, double* values,
+    int seed)
+  {
+    functions.gradientCoherentNoise3DArray (count, x, y, z, values, seed);
+  }
+
+  inline void GradientCoherentNoise3DArray (
+    const GradientCoherentNoiseFunctions& functions, int count,
+    const float* x, const float* y, const float* z, float* values, int seed)
+  {
+    functions.gradientCoherentNoise3DArrayFloat (count, x, y, z, values,
+      seed);
+  }
+
+  inline void GradientCoherentNoise3DArray (
+    const GradientCoherentNoiseFunctions& functions, int count,
+    const double* x, const double* y, const double* z, double* values,
+    const PermutationTable& table, int seed)
+  {
+    functions.gradientCoherentNoise3DTableArray (count, x, y, z, values,
+      table, seed);
+  }
+
+  inline void GradientCoherentNoise3DArray (
+    const GradientCoherentNoiseFunctions& functions, int count,
+    const float* x, const float* y, const float* z, float* values,
+    const PermutationTable& table, int seed)
+  {
+    functions.gradientCoherentNoise3DTableArrayFloat (count, x, y, z, values,
+      table, seed);
+  }
+
+}
+
+#endif
+
+#endif
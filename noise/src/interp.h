@@ -53,6 +53,28 @@ namespace noise
 	  return p * a * a * a + q * a * a + r * a + s;
   }
 
+  /// Performs cubic interpolation between two single-precision values bound
+  /// between two other values.
+  ///
+  /// @param n0 The value before the first value.
+  /// @param n1 The first value.
+  /// @param n2 The second value.
+  /// @param n3 The value after the second value.
+  /// @param a The alpha value.
+  ///
+  /// @returns The interpolated value.
+  ///
+  /// This is the single-precision version of the double-precision
+  /// CubicInterp() function.
+  inline float CubicInterp (float n0, float n1, float n2, float n3, float a)
+  {
+    float p = (n3 - n2) - (n0 - n1);
+    float q = (n0 - n1) - p;
+    float r = n2 - n0;
+    float s = n1;
+    return p * a * a * a + q * a * a + r * a + s;
+  }
+
   /// Performs linear interpolation between two values.
   ///
   /// @param n0 The first value.
@@ -69,6 +91,21 @@ namespace noise
     return ((1.0 - a) * n0) + (a * n1);
   }
 
+  /// Performs linear interpolation between two single-precision values.
+  ///
+  /// @param n0 The first value.
+  /// @param n1 The second value.
+  /// @param a The alpha value.
+  ///
+  /// @returns The interpolated value.
+  ///
+  /// This is the single-precision version of the double-precision
+  /// LinearInterp() function.
+  inline float LinearInterp (float n0, float n1, float a)
+  {
+    return ((1.0f - a) * n0) + (a * n1);
+  }
+
   /// Maps a value onto a cubic S-curve.
   ///
   /// @param a The value to map onto a cubic S-curve.
@@ -84,6 +121,19 @@ namespace noise
     return (a * a * (3.0 - 2.0 * a));
   }
 
+  /// Maps a single-precision value onto a cubic S-curve.
+  ///
+  /// @param a The value to map onto a cubic S-curve.
+  ///
+  /// @returns The mapped value.
+  ///
+  /// This is the single-precision version of the double-precision SCurve3()
+  /// function.
+  inline float SCurve3 (float a)
+  {
+    return (a * a * (3.0f - 2.0f * a));
+  }
+
   /// Maps a value onto a quintic S-curve.
   ///
   /// @param a The value to map onto a quintic S-curve.
@@ -105,6 +155,22 @@ namespace noise
     return (6.0 * a5) - (15.0 * a4) + (10.0 * a3);
   }
 
+  /// Maps a single-precision value onto a quintic S-curve.
+  ///
+  /// @param a The value to map onto a quintic S-curve.
+  ///
+  /// @returns The mapped value.
+  ///
+  /// This is the single-precision version of the double-precision SCurve5()
+  /// function.
+  inline float SCurve5 (float a)
+  {
+    float a3 = a * a * a;
+    float a4 = a3 * a;
+    float a5 = a4 * a;
+    return (6.0f * a5) - (15.0f * a4) + (10.0f * a3);
+  }
+
   // @}
 
 }
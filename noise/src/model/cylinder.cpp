@@ -21,11 +21,49 @@
 //
 
 #include "../mathconsts.h"
+#include "../misc.h"
 #include "cylinder.h"
 
 using namespace noise;
 using namespace noise::model;
 
+// A grid of input values located on the surface of a cylinder.
+struct CylinderGrid
+{
+  const module::Module* pModule;
+  int width;
+  double lowerHeight;
+  double heightDelta;
+  const double* cosAngle;
+  const double* sinAngle;
+  float* values;
+};
+
+// Generates the output values for one row of a grid.
+static void GetCylinderRow (void* pContext, int row)
+{
+  const CylinderGrid& grid = *(const CylinderGrid*)pContext;
+  double x[module::MODULE_BATCH_SIZE];
+  double y[module::MODULE_BATCH_SIZE];
+  double z[module::MODULE_BATCH_SIZE];
+  double values[module::MODULE_BATCH_SIZE];
+  double curHeight = grid.lowerHeight + row * grid.heightDelta;
+  float* pDest = grid.values + (size_t)row * grid.width;
+  for (int offset = 0; offset < grid.width;
+    offset += module::MODULE_BATCH_SIZE) {
+    int n = GetMin (grid.width - offset, module::MODULE_BATCH_SIZE);
+    for (int i = 0; i < n; i++) {
+      x[i] = grid.cosAngle[offset + i];
+      y[i] = curHeight;
+      z[i] = grid.sinAngle[offset + i];
+    }
+    grid.pModule->GetValues (n, x, y, z, values);
+    for (int i = 0; i < n; i++) {
+      pDest[offset + i] = (float)values[i];
+    }
+  }
+}
+
 Cylinder::Cylinder (): m_pModule (NULL)
 {
 }
@@ -45,3 +83,42 @@ double Cylinder::GetValue (double angle, double height) const
   z = sin (angle * DEG_TO_RAD);
   return m_pModule->GetValue (x, y, z);
 }
+
+void Cylinder::GetValues (int width, int height, double lowerAngle,
+  double upperAngle, double lowerHeight, double upperHeight, float* values,
+  ThreadPool* pPool) const
+{
+  assert (m_pModule != NULL);
+
+  if (width < 1 || height < 1) {
+    throw noise::ExceptionInvalidParam ();
+  }
+
+  double* cosAngle = new double[width];
+  double* sinAngle = new double[width];
+  double angleDelta = (upperAngle - lowerAngle) / width;
+  for (int col = 0; col < width; col++) {
+    double curAngle = lowerAngle + col * angleDelta;
+    cosAngle[col] = cos (curAngle * DEG_TO_RAD);
+    sinAngle[col] = sin (curAngle * DEG_TO_RAD);
+  }
+
+  CylinderGrid grid;
+  grid.pModule = m_pModule;
+  grid.width = width;
+  grid.lowerHeight = lowerHeight;
+  grid.heightDelta = (upperHeight - lowerHeight) / height;
+  grid.cosAngle = cosAngle;
+  grid.sinAngle = sinAngle;
+  grid.values = values;
+  if (pPool != NULL) {
+    pPool->Run (height, GetCylinderRow, &grid);
+  } else {
+    for (int row = 0; row < height; row++) {
+      GetCylinderRow (&grid, row);
+    }
+  }
+
+  delete[] sinAngle;
+  delete[] cosAngle;
+}
@@ -27,6 +27,7 @@
 #include <math.h>
 #include <stdlib.h>
 #include "../module/modulebase.h"
+#include "../threadpool.h"
 
 namespace noise
 {
@@ -101,6 +102,35 @@ namespace noise
         /// origin.
         double GetValue (double angle, double height) const;
 
+        /// Generates the output values from the noise module for a grid of
+        /// input values located on the surface of the cylinder.
+        ///
+        /// @param width The number of columns (angles) in the grid.
+        /// @param height The number of rows (heights) in the grid.
+        /// @param lowerAngle The angle of the first column, in degrees.
+        /// @param upperAngle The angle one column past the last column, in
+        /// degrees.
+        /// @param lowerHeight The height of the first row.
+        /// @param upperHeight The height one row past the last row.
+        /// @param values The buffer that receives the output values; it
+        /// must have room for @a width * @a height values.
+        /// @param pPool The thread pool that generates the rows of the
+        /// grid, or NULL to generate them in the calling thread.
+        ///
+        /// @pre A noise module was passed to the SetModule() method.
+        /// @pre The width and height are at least 1.
+        ///
+        /// @throw noise::ExceptionInvalidParam
+        /// - An invalid parameter was specified; see the preconditions for
+        ///   more information.
+        ///
+        /// See noise::model::Plane::GetValues() for the layout of the
+        /// buffer and the requirements of the thread pool.  A grid that
+        /// spans 360 degrees wraps around the cylinder seamlessly.
+        void GetValues (int width, int height, double lowerAngle,
+          double upperAngle, double lowerHeight, double upperHeight,
+          float* values, ThreadPool* pPool = NULL) const;
+
         /// Sets the noise module that is used to generate the output values.
         ///
         /// @param module The noise module that is used to generate the output
@@ -19,11 +19,49 @@
 // The developer's email is ojacobson@lionsanctuary.net
 //
 
+#include "../misc.h"
 #include "plane.h"
 
 using namespace noise;
 using namespace noise::model;
 
+// A grid of input values located on the surface of a plane.
+struct PlaneGrid
+{
+  const module::Module* pModule;
+  int width;
+  double lowerX;
+  double xDelta;
+  double lowerZ;
+  double zDelta;
+  float* values;
+};
+
+// Generates the output values for one row of a grid.
+static void GetPlaneRow (void* pContext, int row)
+{
+  const PlaneGrid& grid = *(const PlaneGrid*)pContext;
+  double x[module::MODULE_BATCH_SIZE];
+  double y[module::MODULE_BATCH_SIZE];
+  double z[module::MODULE_BATCH_SIZE];
+  double values[module::MODULE_BATCH_SIZE];
+  double curZ = grid.lowerZ + row * grid.zDelta;
+  float* pDest = grid.values + (size_t)row * grid.width;
+  for (int offset = 0; offset < grid.width;
+    offset += module::MODULE_BATCH_SIZE) {
+    int n = GetMin (grid.width - offset, module::MODULE_BATCH_SIZE);
+    for (int i = 0; i < n; i++) {
+      x[i] = grid.lowerX + (offset + i) * grid.xDelta;
+      y[i] = 0.0;
+      z[i] = curZ;
+    }
+    grid.pModule->GetValues (n, x, y, z, values);
+    for (int i = 0; i < n; i++) {
+      pDest[offset + i] = (float)values[i];
+    }
+  }
+}
+
 Plane::Plane ():
   m_pModule (NULL)
 {
@@ -41,3 +79,29 @@ double Plane::GetValue (double x, double z) const
   
   return m_pModule->GetValue (x, 0, z);
 }
+
+void Plane::GetValues (int width, int height, double lowerX, double upperX,
+  double lowerZ, double upperZ, float* values, ThreadPool* pPool) const
+{
+  assert (m_pModule != NULL);
+
+  if (width < 1 || height < 1) {
+    throw noise::ExceptionInvalidParam ();
+  }
+
+  PlaneGrid grid;
+  grid.pModule = m_pModule;
+  grid.width = width;
+  grid.lowerX = lowerX;
+  grid.xDelta = (upperX - lowerX) / width;
+  grid.lowerZ = lowerZ;
+  grid.zDelta = (upperZ - lowerZ) / height;
+  grid.values = values;
+  if (pPool != NULL) {
+    pPool->Run (height, GetPlaneRow, &grid);
+  } else {
+    for (int row = 0; row < height; row++) {
+      GetPlaneRow (&grid, row);
+    }
+  }
+}
@@ -24,6 +24,7 @@
 
 #include <assert.h>
 #include "../module/modulebase.h"
+#include "../threadpool.h"
 
 namespace noise
 {
@@ -50,6 +51,14 @@ namespace noise
     /// - terrain height maps for local areas
     ///
     /// This plane extends infinitely in both directions.
+    ///
+    /// The input values lie at @a y = 0.0.  The noise modules that pass the
+    /// @a y coordinate through unchanged to the gradient-coherent-noise
+    /// functions (such as noise::module::Perlin, noise::module::Billow,
+    /// noise::module::RidgedMulti, and the combiner modules) generate their
+    /// output values there with the faster two-dimensional noise functions
+    /// (see noise::GradientCoherentNoise2D().)  The output values are the
+    /// same as the output values of the three-dimensional noise.
     class Plane
     {
 
@@ -91,6 +100,45 @@ namespace noise
         /// SetModule() method.
         double GetValue (double x, double z) const;
 
+        /// Generates the output values from the noise module for a grid of
+        /// input values located on the surface of the plane.
+        ///
+        /// @param width The number of columns in the grid.
+        /// @param height The number of rows in the grid.
+        /// @param lowerX The @a x coordinate of the first column.
+        /// @param upperX The @a x coordinate one column past the last
+        /// column.
+        /// @param lowerZ The @a z coordinate of the first row.
+        /// @param upperZ The @a z coordinate one row past the last row.
+        /// @param values The buffer that receives the output values; it
+        /// must have room for @a width * @a height values.
+        /// @param pPool The thread pool that generates the rows of the
+        /// grid, or NULL to generate them in the calling thread.
+        ///
+        /// @pre A noise module was passed to the SetModule() method.
+        /// @pre The width and height are at least 1.
+        ///
+        /// @throw noise::ExceptionInvalidParam
+        /// - An invalid parameter was specified; see the preconditions for
+        ///   more information.
+        ///
+        /// The grid is evenly spaced; the output value in column @a i of row
+        /// @a j is stored in <i>values[j * width + i]</i>.  The upper bounds
+        /// are excluded so that adjacent grids join seamlessly.  Each output
+        /// value is the output value that the GetValue() method returns for
+        /// the same coordinates, converted to @a float.
+        ///
+        /// This method passes whole rows to the
+        /// noise::module::Module::GetValues() method, so it is much faster
+        /// than calling the GetValue() method for each input value.  If a
+        /// thread pool is specified, its threads call the noise module at
+        /// the same time.  All noise modules in libnoise support this, but a
+        /// custom noise module that modifies its state from its GetValue()
+        /// or GetValues() method may not.
+        void GetValues (int width, int height, double lowerX, double upperX,
+          double lowerZ, double upperZ, float* values,
+          ThreadPool* pPool = NULL) const;
+
         /// Sets the noise module that is used to generate the output values.
         ///
         /// @param module The noise module that is used to generate the output
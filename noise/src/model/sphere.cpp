@@ -21,11 +21,53 @@
 //
 
 #include "../latlon.h"
+#include "../misc.h"
 #include "sphere.h"
 
 using namespace noise;
 using namespace noise::model;
 
+// A grid of input values located on the surface of a sphere.
+struct SphereGrid
+{
+  const module::Module* pModule;
+  int width;
+  double southLat;
+  double latDelta;
+  const double* cosLon;
+  const double* sinLon;
+  float* values;
+};
+
+// Generates the output values for one row of a grid.  The coordinates are
+// calculated the same way as the LatLonToXYZ() function calculates them,
+// with the sines and cosines of the longitudes taken from tables.
+static void GetSphereRow (void* pContext, int row)
+{
+  const SphereGrid& grid = *(const SphereGrid*)pContext;
+  double x[module::MODULE_BATCH_SIZE];
+  double y[module::MODULE_BATCH_SIZE];
+  double z[module::MODULE_BATCH_SIZE];
+  double values[module::MODULE_BATCH_SIZE];
+  double curLat = grid.southLat + row * grid.latDelta;
+  double r    = cos (DEG_TO_RAD * curLat);
+  double curY = sin (DEG_TO_RAD * curLat);
+  float* pDest = grid.values + (size_t)row * grid.width;
+  for (int offset = 0; offset < grid.width;
+    offset += module::MODULE_BATCH_SIZE) {
+    int n = GetMin (grid.width - offset, module::MODULE_BATCH_SIZE);
+    for (int i = 0; i < n; i++) {
+      x[i] = r * grid.cosLon[offset + i];
+      y[i] = curY;
+      z[i] = r * grid.sinLon[offset + i];
+    }
+    grid.pModule->GetValues (n, x, y, z, values);
+    for (int i = 0; i < n; i++) {
+      pDest[offset + i] = (float)values[i];
+    }
+  }
+}
+
 Sphere::Sphere ():
   m_pModule (NULL)
 {
@@ -44,3 +86,42 @@ double Sphere::GetValue (double lat, double lon) const
   LatLonToXYZ (lat, lon, x, y, z);
   return m_pModule->GetValue (x, y, z);
 }
+
+void Sphere::GetValues (int width, int height, double southLat,
+  double northLat, double westLon, double eastLon, float* values,
+  ThreadPool* pPool) const
+{
+  assert (m_pModule != NULL);
+
+  if (width < 1 || height < 1) {
+    throw noise::ExceptionInvalidParam ();
+  }
+
+  double* cosLon = new double[width];
+  double* sinLon = new double[width];
+  double lonDelta = (eastLon - westLon) / width;
+  for (int col = 0; col < width; col++) {
+    double curLon = westLon + col * lonDelta;
+    cosLon[col] = cos (DEG_TO_RAD * curLon);
+    sinLon[col] = sin (DEG_TO_RAD * curLon);
+  }
+
+  SphereGrid grid;
+  grid.pModule = m_pModule;
+  grid.width = width;
+  grid.southLat = southLat;
+  grid.latDelta = (northLat - southLat) / height;
+  grid.cosLon = cosLon;
+  grid.sinLon = sinLon;
+  grid.values = values;
+  if (pPool != NULL) {
+    pPool->Run (height, GetSphereRow, &grid);
+  } else {
+    for (int row = 0; row < height; row++) {
+      GetSphereRow (&grid, row);
+    }
+  }
+
+  delete[] sinLon;
+  delete[] cosLon;
+}
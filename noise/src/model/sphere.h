@@ -25,6 +25,7 @@
 
 #include <assert.h>
 #include "../module/modulebase.h"
+#include "../threadpool.h"
 
 namespace noise
 {
@@ -101,6 +102,37 @@ namespace noise
         /// western hemisphere.
         double GetValue (double lat, double lon) const;
 
+        /// Generates the output values from the noise module for a grid of
+        /// input values located on the surface of the sphere.
+        ///
+        /// @param width The number of columns (longitudes) in the grid.
+        /// @param height The number of rows (latitudes) in the grid.
+        /// @param southLat The latitude of the first row, in degrees.
+        /// @param northLat The latitude one row past the last row, in
+        /// degrees.
+        /// @param westLon The longitude of the first column, in degrees.
+        /// @param eastLon The longitude one column past the last column, in
+        /// degrees.
+        /// @param values The buffer that receives the output values; it
+        /// must have room for @a width * @a height values.
+        /// @param pPool The thread pool that generates the rows of the
+        /// grid, or NULL to generate them in the calling thread.
+        ///
+        /// @pre A noise module was passed to the SetModule() method.
+        /// @pre The width and height are at least 1.
+        ///
+        /// @throw noise::ExceptionInvalidParam
+        /// - An invalid parameter was specified; see the preconditions for
+        ///   more information.
+        ///
+        /// The rows run from south to north and the columns from west to
+        /// east.  See noise::model::Plane::GetValues() for the layout of the
+        /// buffer and the requirements of the thread pool.  A grid that
+        /// spans 360 degrees of longitude wraps around seamlessly.
+        void GetValues (int width, int height, double southLat,
+          double northLat, double westLon, double eastLon, float* values,
+          ThreadPool* pPool = NULL) const;
+
         /// Sets the noise module that is used to generate the output values.
         ///
         /// @param module The noise module that is used to generate the output
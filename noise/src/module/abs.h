@@ -54,6 +54,10 @@ namespace noise
         /// Constructor.
         Abs ();
 
+        virtual void GetBounds (double lowerX, double lowerY, double lowerZ,
+          double upperX, double upperY, double upperZ, double& lowerBound,
+          double& upperBound) const;
+
         virtual int GetSourceModuleCount () const
         {
           return 1;
@@ -61,6 +65,19 @@ namespace noise
 
         virtual double GetValue (double x, double y, double z) const;
 
+        virtual void GetValues (int count, const double* x, const double* y,
+          const double* z, double* values) const;
+
+        virtual void GetValues (int count, const float* x, const float* y,
+          const float* z, float* values) const;
+
+      private:
+
+        /// Implements both versions of the GetValues() method.
+        template <class T>
+        void GetValuesImpl (int count, const T* x, const T* y, const T* z,
+          T* values) const;
+
     };
 
     /// @}
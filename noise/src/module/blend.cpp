@@ -21,7 +21,9 @@
 //
 
 #include "blend.h"
+#include "../boundsimpl.h"
 #include "../interp.h"
+#include "../misc.h"
 
 using namespace noise::module;
 
@@ -30,6 +32,25 @@ Blend::Blend ():
 {
 }
 
+void Blend::GetBounds (double lowerX, double lowerY, double lowerZ,
+  double upperX, double upperY, double upperZ, double& lowerBound,
+  double& upperBound) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+  assert (m_pSourceModule[2] != NULL);
+
+  double lower0, upper0, lower1, upper1, lowerAlpha, upperAlpha;
+  m_pSourceModule[0]->GetBounds (lowerX, lowerY, lowerZ, upperX, upperY,
+    upperZ, lower0, upper0);
+  m_pSourceModule[1]->GetBounds (lowerX, lowerY, lowerZ, upperX, upperY,
+    upperZ, lower1, upper1);
+  m_pSourceModule[2]->GetBounds (lowerX, lowerY, lowerZ, upperX, upperY,
+    upperZ, lowerAlpha, upperAlpha);
+  LerpBounds (lower0, upper0, lower1, upper1, (lowerAlpha + 1.0) / 2.0,
+    (upperAlpha + 1.0) / 2.0, lowerBound, upperBound);
+}
+
 double Blend::GetValue (double x, double y, double z) const
 {
   assert (m_pSourceModule[0] != NULL);
@@ -41,3 +62,40 @@ double Blend::GetValue (double x, double y, double z) const
   double alpha = (m_pSourceModule[2]->GetValue (x, y, z) + 1.0) / 2.0;
   return LinearInterp (v0, v1, alpha);
 }
+
+void Blend::GetValues (int count, const double* x, const double* y,
+  const double* z, double* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+void Blend::GetValues (int count, const float* x, const float* y,
+  const float* z, float* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+template <class T>
+void Blend::GetValuesImpl (int count, const T* x, const T* y,
+  const T* z, T* values) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+  assert (m_pSourceModule[2] != NULL);
+
+  T v1[MODULE_BATCH_SIZE];
+  T alpha[MODULE_BATCH_SIZE];
+  for (int offset = 0; offset < count; offset += MODULE_BATCH_SIZE) {
+    int n = GetMin (count - offset, MODULE_BATCH_SIZE);
+    T* v0 = values + offset;
+    m_pSourceModule[0]->GetValues (n, x + offset, y + offset, z + offset,
+      v0);
+    m_pSourceModule[1]->GetValues (n, x + offset, y + offset, z + offset,
+      v1);
+    m_pSourceModule[2]->GetValues (n, x + offset, y + offset, z + offset,
+      alpha);
+    for (int i = 0; i < n; i++) {
+      v0[i] = LinearInterp (v0[i], v1[i], (alpha[i] + (T)1.0) / (T)2.0);
+    }
+  }
+}
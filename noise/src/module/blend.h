@@ -75,6 +75,10 @@ namespace noise
         /// Constructor.
         Blend ();
 
+        virtual void GetBounds (double lowerX, double lowerY, double lowerZ,
+          double upperX, double upperY, double upperZ, double& lowerBound,
+          double& upperBound) const;
+
         /// Returns the control module.
         ///
         /// @returns A reference to the control module.
@@ -105,6 +109,12 @@ namespace noise
 
 	      virtual double GetValue (double x, double y, double z) const;
 
+	      virtual void GetValues (int count, const double* x, const double* y,
+	        const double* z, double* values) const;
+
+        virtual void GetValues (int count, const float* x, const float* y,
+          const float* z, float* values) const;
+
         /// Sets the control module.
         ///
         /// @param controlModule The control module.
@@ -129,6 +139,13 @@ namespace noise
           m_pSourceModule[2] = &controlModule;
         }
 
+      private:
+
+        /// Implements both versions of the GetValues() method.
+        template <class T>
+        void GetValuesImpl (int count, const T* x, const T* y, const T* z,
+          T* values) const;
+
     };
 
     /// @}
@@ -20,26 +20,151 @@
 // off every 'zig'.)
 //
 
+#include <string.h>
+#include "../misc.h"
+#include "../threadimpl.h"
 #include "cache.h"
 
+using namespace noise;
 using namespace noise::module;
 
+template <class T>
+struct Cache::Span
+{
+  // Number of input values in the span, or zero if no span is cached.
+  int count;
+
+  // The cached output values for the span.
+  T values[MODULE_BATCH_SIZE];
+
+  // Coordinates of the span.
+  T x[MODULE_BATCH_SIZE];
+  T y[MODULE_BATCH_SIZE];
+  T z[MODULE_BATCH_SIZE];
+};
+
+struct Cache::ThreadState
+{
+  // The cached output value at the cached input value.
+  double cachedValue;
+
+  // Determines if a cached output value is stored.
+  bool isCached;
+
+  // Coordinates of the cached input value.
+  double xCache;
+  double yCache;
+  double zCache;
+
+  // The cached double-precision span.
+  Span<double> span;
+
+  // The cached single-precision span.
+  Span<float> spanFloat;
+
+  ThreadState ()
+  {
+    Invalidate ();
+  }
+
+  // Invalidates the cached values.
+  void Invalidate ()
+  {
+    isCached = false;
+    span.count = 0;
+    spanFloat.count = 0;
+  }
+};
+
+struct Cache::ThreadStorage: public PerThread<ThreadState>
+{
+};
+
 Cache::Cache ():
-  Module (GetSourceModuleCount ()),
-  m_isCached (false)
+  Module (GetSourceModuleCount ())
+{
+  m_pStorage = new ThreadStorage;
+}
+
+Cache::~Cache ()
+{
+  delete m_pStorage;
+}
+
+Cache::ThreadState& Cache::GetThreadState () const
 {
+  return m_pStorage->Get ();
+}
+
+void Cache::GetBounds (double lowerX, double lowerY, double lowerZ,
+  double upperX, double upperY, double upperZ, double& lowerBound,
+  double& upperBound) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  m_pSourceModule[0]->GetBounds (lowerX, lowerY, lowerZ, upperX, upperY,
+    upperZ, lowerBound, upperBound);
 }
 
 double Cache::GetValue (double x, double y, double z) const
 {
   assert (m_pSourceModule[0] != NULL);
 
-  if (!(m_isCached && x == m_xCache && y == m_yCache && z == m_zCache)) {
-    m_cachedValue = m_pSourceModule[0]->GetValue (x, y, z);
-    m_xCache = x;
-    m_yCache = y;
-    m_zCache = z;
+  ThreadState& state = GetThreadState ();
+  if (!(state.isCached && x == state.xCache && y == state.yCache
+    && z == state.zCache)) {
+    state.cachedValue = m_pSourceModule[0]->GetValue (x, y, z);
+    state.xCache = x;
+    state.yCache = y;
+    state.zCache = z;
+  }
+  state.isCached = true;
+  return state.cachedValue;
+}
+
+void Cache::GetValues (int count, const double* x, const double* y,
+  const double* z, double* values) const
+{
+  GetValuesImpl (count, x, y, z, values, GetThreadState ().span);
+}
+
+void Cache::GetValues (int count, const float* x, const float* y,
+  const float* z, float* values) const
+{
+  GetValuesImpl (count, x, y, z, values, GetThreadState ().spanFloat);
+}
+
+template <class T>
+void Cache::GetValuesImpl (int count, const T* x, const T* y, const T* z,
+  T* values, Span<T>& span) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  for (int offset = 0; offset < count; offset += MODULE_BATCH_SIZE) {
+    int n = GetMin (count - offset, MODULE_BATCH_SIZE);
+    size_t size = n * sizeof (T);
+    if (!(n == span.count
+      && memcmp (x + offset, span.x, size) == 0
+      && memcmp (y + offset, span.y, size) == 0
+      && memcmp (z + offset, span.z, size) == 0)) {
+      m_pSourceModule[0]->GetValues (n, x + offset, y + offset, z + offset,
+        span.values);
+      memcpy (span.x, x + offset, size);
+      memcpy (span.y, y + offset, size);
+      memcpy (span.z, z + offset, size);
+      span.count = n;
+    }
+    memcpy (values + offset, span.values, size);
+  }
+}
+
+void Cache::SetSourceModule (int index, const Module& sourceModule)
+{
+  Module::SetSourceModule (index, sourceModule);
+  m_pStorage->LockList ();
+  for (ThreadStorage::Node* pNode = m_pStorage->GetFirst (); pNode != NULL;
+    pNode = pNode->pNext) {
+    pNode->value.Invalidate ();
   }
-  m_isCached = true;
-  return m_cachedValue;
+  m_pStorage->UnlockList ();
 }
@@ -55,6 +55,22 @@ namespace noise
     /// module returns the cached output value without having the source
     /// module recalculate the output value.
     ///
+    /// The GetValues() method works the same way with spans of input values.
+    /// This noise module stores the last span of up to
+    /// noise::module::MODULE_BATCH_SIZE input values passed to it, along with
+    /// the output values for that span.  If the application passes an
+    /// identical span, this noise module copies the cached output values.
+    /// Double-precision and single-precision spans are cached separately.
+    ///
+    /// Each thread that calls this noise module has its own cached values,
+    /// so a noise module that contains this noise module can be called from
+    /// several threads at the same time (by a noise::ThreadPool, for
+    /// example.)  The first call from a thread briefly locks a mutex to
+    /// allocate the cached values for that thread; later calls from that
+    /// thread do not lock.  The cached values of a thread are freed when
+    /// that thread exits or when this noise module is destroyed, whichever
+    /// comes first.
+    ///
     /// If an application passes a new source module to the SetSourceModule()
     /// method, the cache is invalidated.
     ///
@@ -70,8 +86,19 @@ namespace noise
       public:
 
         /// Constructor.
+        ///
+        /// @throw noise::ExceptionOutOfMemory
+        /// - The operating system could not provide the thread-local
+        ///   storage that all noise modules with per-thread state share.
         Cache ();
 
+        /// Destructor.
+        ~Cache ();
+
+        virtual void GetBounds (double lowerX, double lowerY, double lowerZ,
+          double upperX, double upperY, double upperZ, double& lowerBound,
+          double& upperBound) const;
+
         virtual int GetSourceModuleCount () const
         {
           return 1;
@@ -79,29 +106,44 @@ namespace noise
 
         virtual double GetValue (double x, double y, double z) const;
 
-        virtual void SetSourceModule (int index, const Module& sourceModule)
-        {
-          Module::SetSourceModule (index, sourceModule);
-          m_isCached = false;
-        }
+        virtual void GetValues (int count, const double* x, const double* y,
+          const double* z, double* values) const;
+
+        virtual void GetValues (int count, const float* x, const float* y,
+          const float* z, float* values) const;
+
+        /// @note This method must not be called while another thread is
+        /// calling this noise module.
+        virtual void SetSourceModule (int index, const Module& sourceModule);
+
+      private:
 
-      protected:
+        /// A cached span of input values, along with the output values for
+        /// that span.
+        template <class T>
+        struct Span;
 
-        /// The cached output value at the cached input value.
-        mutable double m_cachedValue;
+        /// The cached values of one thread.
+        struct ThreadState;
 
-        /// Determines if a cached output value is stored in this noise
-        /// module.
-        mutable double m_isCached;
+        /// The storage for the cached values of each thread.
+        struct ThreadStorage;
 
-        /// @a x coordinate of the cached input value.
-        mutable double m_xCache;
+        /// Returns the cached values of the calling thread.
+        ///
+        /// @returns A reference to the cached values.
+        ///
+        /// If the calling thread has no cached values yet, this method
+        /// creates them.
+        ThreadState& GetThreadState () const;
 
-        /// @a y coordinate of the cached input value.
-        mutable double m_yCache;
+        /// Implements both versions of the GetValues() method.
+        template <class T>
+        void GetValuesImpl (int count, const T* x, const T* y, const T* z,
+          T* values, Span<T>& span) const;
 
-        /// @a z coordinate of the cached input value.
-        mutable double m_zCache;
+        /// The storage for the cached values of each thread.
+        ThreadStorage* m_pStorage;
 
     };
 
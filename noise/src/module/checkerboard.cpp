@@ -29,6 +29,14 @@ Checkerboard::Checkerboard ():
 {
 }
 
+void Checkerboard::GetBounds (double lowerX, double lowerY, double lowerZ,
+  double upperX, double upperY, double upperZ, double& lowerBound,
+  double& upperBound) const
+{
+  lowerBound = -1.0;
+  upperBound = 1.0;
+}
+
 double Checkerboard::GetValue (double x, double y, double z) const
 {
   int ix = (int)(floor (MakeInt32Range (x)));
@@ -36,3 +44,24 @@ double Checkerboard::GetValue (double x, double y, double z) const
   int iz = (int)(floor (MakeInt32Range (z)));
   return (ix & 1 ^ iy & 1 ^ iz & 1)? -1.0: 1.0;
 }
+
+void Checkerboard::GetValues (int count, const double* x, const double* y,
+  const double* z, double* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+void Checkerboard::GetValues (int count, const float* x, const float* y,
+  const float* z, float* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+template <class T>
+void Checkerboard::GetValuesImpl (int count, const T* x, const T* y,
+  const T* z, T* values) const
+{
+  for (int i = 0; i < count; i++) {
+    values[i] = (T)Checkerboard::GetValue (x[i], y[i], z[i]);
+  }
+}
@@ -20,6 +20,7 @@
 // off every 'zig'.)
 //
 
+#include "../boundsimpl.h"
 #include "clamp.h"
 
 using namespace noise::module;
@@ -31,6 +32,19 @@ Clamp::Clamp ():
 {
 }
 
+void Clamp::GetBounds (double lowerX, double lowerY, double lowerZ,
+  double upperX, double upperY, double upperZ, double& lowerBound,
+  double& upperBound) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  double lower, upper;
+  m_pSourceModule[0]->GetBounds (lowerX, lowerY, lowerZ, upperX, upperY,
+    upperZ, lower, upper);
+  ClampBounds (lower, upper, m_lowerBound, m_upperBound, lowerBound,
+    upperBound);
+}
+
 double Clamp::GetValue (double x, double y, double z) const
 {
   assert (m_pSourceModule[0] != NULL);
@@ -52,3 +66,33 @@ void Clamp::SetBounds (double lowerBound, double upperBound)
   m_lowerBound = lowerBound;
   m_upperBound = upperBound;
 }
+
+void Clamp::GetValues (int count, const double* x, const double* y,
+  const double* z, double* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+void Clamp::GetValues (int count, const float* x, const float* y,
+  const float* z, float* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+template <class T>
+void Clamp::GetValuesImpl (int count, const T* x, const T* y,
+  const T* z, T* values) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  T lowerBound = (T)m_lowerBound;
+  T upperBound = (T)m_upperBound;
+  m_pSourceModule[0]->GetValues (count, x, y, z, values);
+  for (int i = 0; i < count; i++) {
+    if (values[i] < lowerBound) {
+      values[i] = lowerBound;
+    } else if (values[i] > upperBound) {
+      values[i] = upperBound;
+    }
+  }
+}
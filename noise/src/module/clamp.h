@@ -80,6 +80,10 @@ namespace noise
         /// noise::module::DEFAULT_CLAMP_UPPER_BOUND.
         Clamp ();
 
+        virtual void GetBounds (double lowerX, double lowerY, double lowerZ,
+          double upperX, double upperY, double upperZ, double& lowerBound,
+          double& upperBound) const;
+
         /// Returns the lower bound of the clamping range.
         ///
         /// @returns The lower bound.
@@ -111,6 +115,12 @@ namespace noise
 
         virtual double GetValue (double x, double y, double z) const;
 
+        virtual void GetValues (int count, const double* x, const double* y,
+          const double* z, double* values) const;
+
+        virtual void GetValues (int count, const float* x, const float* y,
+          const float* z, float* values) const;
+
         /// Sets the lower and upper bounds of the clamping range.
         ///
         /// @param lowerBound The lower bound.
@@ -137,6 +147,13 @@ namespace noise
         /// Upper bound of the clamping range.
         double m_upperBound;
 
+      private:
+
+        /// Implements both versions of the GetValues() method.
+        template <class T>
+        void GetValuesImpl (int count, const T* x, const T* y, const T* z,
+          T* values) const;
+
     };
 
     /// @}
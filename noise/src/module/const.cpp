@@ -29,3 +29,32 @@ Const::Const ():
   m_constValue (DEFAULT_CONST_VALUE)
 {
 }
+
+void Const::GetBounds (double lowerX, double lowerY, double lowerZ,
+  double upperX, double upperY, double upperZ, double& lowerBound,
+  double& upperBound) const
+{
+  lowerBound = m_constValue;
+  upperBound = m_constValue;
+}
+
+void Const::GetValues (int count, const double* x, const double* y,
+  const double* z, double* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+void Const::GetValues (int count, const float* x, const float* y,
+  const float* z, float* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+template <class T>
+void Const::GetValuesImpl (int count, const T* x, const T* y,
+  const T* z, T* values) const
+{
+  for (int i = 0; i < count; i++) {
+    values[i] = (T)m_constValue;
+  }
+}
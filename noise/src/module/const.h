@@ -65,6 +65,10 @@ namespace noise
         /// noise::module::DEFAULT_CONST_VALUE.
         Const ();
 
+        virtual void GetBounds (double lowerX, double lowerY, double lowerZ,
+          double upperX, double upperY, double upperZ, double& lowerBound,
+          double& upperBound) const;
+
         /// Returns the constant output value for this noise module.
         ///
         /// @returns The constant output value for this noise module.
@@ -83,6 +87,12 @@ namespace noise
           return m_constValue;
         }
 
+        virtual void GetValues (int count, const double* x, const double* y,
+          const double* z, double* values) const;
+
+        virtual void GetValues (int count, const float* x, const float* y,
+          const float* z, float* values) const;
+
         /// Sets the constant output value for this noise module.
         ///
         /// @param constValue The constant output value for this noise module.
@@ -96,6 +106,13 @@ namespace noise
         /// Constant value.
         double m_constValue;
 
+      private:
+
+        /// Implements both versions of the GetValues() method.
+        template <class T>
+        void GetValuesImpl (int count, const T* x, const T* y, const T* z,
+          T* values) const;
+
     };
 
     /// @}
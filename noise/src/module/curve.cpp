@@ -20,6 +20,7 @@
 // off every 'zig'.)
 //
 
+#include "../boundsimpl.h"
 #include "../interp.h"
 #include "../misc.h"
 #include "curve.h"
@@ -71,13 +72,146 @@ int Curve::FindInsertionPos (double inputValue)
   return insertionPos;
 }
 
+void Curve::GetBounds (double lowerX, double lowerY, double lowerZ,
+  double upperX, double upperY, double upperZ, double& lowerBound,
+  double& upperBound) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  double lower, upper;
+  m_pSourceModule[0]->GetBounds (lowerX, lowerY, lowerZ, upperX, upperY,
+    upperZ, lower, upper);
+  MapBounds (lower, upper, lowerBound, upperBound);
+}
+
 double Curve::GetValue (double x, double y, double z) const
 {
   assert (m_pSourceModule[0] != NULL);
+
+  // Get the output value from the source module and map it onto the curve.
+  return MapValue (m_pSourceModule[0]->GetValue (x, y, z));
+}
+
+void Curve::GetValues (int count, const double* x, const double* y,
+  const double* z, double* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+void Curve::GetValues (int count, const float* x, const float* y,
+  const float* z, float* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+template <class T>
+void Curve::GetValuesImpl (int count, const T* x, const T* y,
+  const T* z, T* values) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  m_pSourceModule[0]->GetValues (count, x, y, z, values);
+  for (int i = 0; i < count; i++) {
+    values[i] = (T)MapValue (values[i]);
+  }
+}
+
+void Curve::InsertAtPos (int insertionPos, double inputValue,
+  double outputValue)
+{
+  // Make room for the new control point at the specified position within the
+  // control point array.  The position is determined by the input value of
+  // the control point; the control points must be sorted by input value
+  // within that array.
+  ControlPoint* newControlPoints = new ControlPoint[m_controlPointCount + 1];
+  for (int i = 0; i < m_controlPointCount; i++) {
+    if (i < insertionPos) {
+      newControlPoints[i] = m_pControlPoints[i];
+    } else {
+      newControlPoints[i + 1] = m_pControlPoints[i];
+    }
+  }
+  delete[] m_pControlPoints;
+  m_pControlPoints = newControlPoints;
+  ++m_controlPointCount;
+
+  // Now that we've made room for the new control point within the array, add
+  // the new control point.
+  m_pControlPoints[insertionPos].inputValue  = inputValue ;
+  m_pControlPoints[insertionPos].outputValue = outputValue;
+}
+
+void Curve::MapBounds (double lower, double upper, double& newLower,
+  double& newUpper) const
+{
   assert (m_controlPointCount >= 4);
 
-  // Get the output value from the source module.
-  double sourceModuleValue = m_pSourceModule[0]->GetValue (x, y, z);
+  const ControlPoint* pPoints = m_pControlPoints;
+  int lastIndex = m_controlPointCount - 1;
+  newLower = HUGE_VAL;
+  newUpper = -HUGE_VAL;
+
+  // Values outside of the control point array map onto the output value of
+  // the nearest control point.  NaN maps onto the last control point.
+  if (MayBeNaN (lower, upper)) {
+    upper = HUGE_VAL;
+  }
+  if (lower < pPoints[0].inputValue) {
+    newLower = GetMin (newLower, pPoints[0].outputValue);
+    newUpper = GetMax (newUpper, pPoints[0].outputValue);
+  }
+  if (upper >= pPoints[lastIndex].inputValue) {
+    newLower = GetMin (newLower, pPoints[lastIndex].outputValue);
+    newUpper = GetMax (newUpper, pPoints[lastIndex].outputValue);
+  }
+
+  // Within each segment of the curve that the range overlaps, the mapped
+  // value is a cubic polynomial of the alpha value, which ranges from 0.0 to
+  // 1.0.  Its extremes lie at the ends of the segment or where its
+  // derivative is zero, and are rounded outward by the magnitude of the
+  // terms of the polynomial.
+  for (int index2 = 1; index2 <= lastIndex; index2++) {
+    if (upper < pPoints[index2 - 1].inputValue
+      || lower >= pPoints[index2].inputValue) {
+      continue;
+    }
+    double n0 = pPoints[ClampValue (index2 - 2, 0, lastIndex)].outputValue;
+    double n1 = pPoints[index2 - 1].outputValue;
+    double n2 = pPoints[index2].outputValue;
+    double n3 = pPoints[ClampValue (index2 + 1, 0, lastIndex)].outputValue;
+    double p = (n3 - n2) - (n0 - n1);
+    double q = (n0 - n1) - p;
+    double r = n2 - n0;
+    double magnitude = fabs (p) + fabs (q) + fabs (r) + fabs (n1);
+
+    // The derivative is 3p * a^2 + 2q * a + r.
+    double alpha[4] = {0.0, 1.0, 0.0, 0.0};
+    int alphaCount = 2;
+    if (p != 0.0) {
+      double discriminant = q * q - 3.0 * p * r;
+      if (discriminant >= 0.0) {
+        double root = sqrt (discriminant);
+        alpha[alphaCount++] = (-q + root) / (3.0 * p);
+        alpha[alphaCount++] = (-q - root) / (3.0 * p);
+      }
+    } else if (q != 0.0) {
+      alpha[alphaCount++] = -r / (2.0 * q);
+    }
+    for (int i = 0; i < alphaCount; i++) {
+      if (alpha[i] >= 0.0 && alpha[i] <= 1.0) {
+        double lowerValue = CubicInterp (n0, n1, n2, n3, alpha[i]);
+        double upperValue = lowerValue;
+        RoundOutward (magnitude, lowerValue, upperValue);
+        newLower = GetMin (newLower, lowerValue);
+        newUpper = GetMax (newUpper, upperValue);
+      }
+    }
+  }
+}
+
+double Curve::MapValue (double sourceModuleValue) const
+{
+  assert (m_controlPointCount >= 4);
 
   // Find the first element in the control point array that has an input value
   // larger than the output value from the source module.
@@ -116,28 +250,3 @@ double Curve::GetValue (double x, double y, double z) const
     m_pControlPoints[index3].outputValue,
     alpha);
 }
-
-void Curve::InsertAtPos (int insertionPos, double inputValue,
-  double outputValue)
-{
-  // Make room for the new control point at the specified position within the
-  // control point array.  The position is determined by the input value of
-  // the control point; the control points must be sorted by input value
-  // within that array.
-  ControlPoint* newControlPoints = new ControlPoint[m_controlPointCount + 1];
-  for (int i = 0; i < m_controlPointCount; i++) {
-    if (i < insertionPos) {
-      newControlPoints[i] = m_pControlPoints[i];
-    } else {
-      newControlPoints[i + 1] = m_pControlPoints[i];
-    }
-  }
-  delete[] m_pControlPoints;
-  m_pControlPoints = newControlPoints;
-  ++m_controlPointCount;
-
-  // Now that we've made room for the new control point within the array, add
-  // the new control point.
-  m_pControlPoints[insertionPos].inputValue  = inputValue ;
-  m_pControlPoints[insertionPos].outputValue = outputValue;
-}
@@ -107,6 +107,10 @@ namespace noise
         /// @post All points on the curve are deleted.
         void ClearAllControlPoints ();
 
+        virtual void GetBounds (double lowerX, double lowerY, double lowerZ,
+          double upperX, double upperY, double upperZ, double& lowerBound,
+          double& upperBound) const;
+
         /// Returns a pointer to the array of control points on the curve.
         ///
         /// @returns A pointer to the array of control points.
@@ -137,6 +141,12 @@ namespace noise
 
         virtual double GetValue (double x, double y, double z) const;
 
+        virtual void GetValues (int count, const double* x, const double* y,
+          const double* z, double* values) const;
+
+        virtual void GetValues (int count, const float* x, const float* y,
+          const float* z, float* values) const;
+
       protected:
 
         /// Determines the array index in which to insert the control point
@@ -176,12 +186,46 @@ namespace noise
         void InsertAtPos (int insertionPos, double inputValue,
           double outputValue);
 
+        /// Maps a range of output values from the source module onto the
+        /// curve.
+        ///
+        /// @param lower The lower bound of the output values from the source
+        /// module.
+        /// @param upper The upper bound of the output values from the source
+        /// module.
+        /// @param newLower Receives the lower bound of the mapped values.
+        /// @param newUpper Receives the upper bound of the mapped values.
+        ///
+        /// @pre There are at least four control points on the curve.
+        void MapBounds (double lower, double upper, double& newLower,
+          double& newUpper) const;
+
+        /// Maps an output value from the source module onto the curve.
+        ///
+        /// @param sourceModuleValue The output value from the source module.
+        ///
+        /// @returns The mapped value.
+        ///
+        /// @pre There are at least four control points on the curve.
+        double MapValue (double sourceModuleValue) const;
+
         /// Number of control points on the curve.
         int m_controlPointCount;
 
         /// Array that stores the control points.
         ControlPoint* m_pControlPoints;
 
+      private:
+
+        /// The noise::module::Program noise module maps its values onto the
+        /// curve directly.
+        friend class Program;
+
+        /// Implements both versions of the GetValues() method.
+        template <class T>
+        void GetValuesImpl (int count, const T* x, const T* y, const T* z,
+          T* values) const;
+
     };
 
     /// @}
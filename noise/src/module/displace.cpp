@@ -20,6 +20,8 @@
 // off every 'zig'.)
 //
 
+#include "../boundsimpl.h"
+#include "../misc.h"
 #include "displace.h"
 
 using namespace noise::module;
@@ -29,6 +31,39 @@ Displace::Displace ():
 {
 }
 
+void Displace::GetBounds (double lowerX, double lowerY, double lowerZ,
+  double upperX, double upperY, double upperZ, double& lowerBound,
+  double& upperBound) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+  assert (m_pSourceModule[2] != NULL);
+  assert (m_pSourceModule[3] != NULL);
+
+  // Offset the box by the bounds of the three displacement modules.  A NaN
+  // or infinite displacement makes the input value of the source module NaN
+  // or infinite, for which a generator module outputs NaN, and the modules
+  // between it and the source module may map NaN onto any value.
+  double lower[3] = {lowerX, lowerY, lowerZ};
+  double upper[3] = {upperX, upperY, upperZ};
+  bool mayBeNaN = false;
+  for (int i = 0; i < 3; i++) {
+    double lowerDisplace, upperDisplace;
+    m_pSourceModule[i + 1]->GetBounds (lowerX, lowerY, lowerZ, upperX,
+      upperY, upperZ, lowerDisplace, upperDisplace);
+    lower[i] += lowerDisplace;
+    upper[i] += upperDisplace;
+    mayBeNaN = mayBeNaN || MayBeNaN (lowerDisplace, upperDisplace);
+  }
+  if (mayBeNaN) {
+    lowerBound = -HUGE_VAL;
+    upperBound = HUGE_VAL;
+    return;
+  }
+  m_pSourceModule[0]->GetBounds (lower[0], lower[1], lower[2], upper[0],
+    upper[1], upper[2], lowerBound, upperBound);
+}
+
 double Displace::GetValue (double x, double y, double z) const
 {
   assert (m_pSourceModule[0] != NULL);
@@ -46,3 +81,51 @@ double Displace::GetValue (double x, double y, double z) const
   // the original input value.
   return m_pSourceModule[0]->GetValue (xDisplace, yDisplace, zDisplace);
 }
+
+void Displace::GetValues (int count, const double* x, const double* y,
+  const double* z, double* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+void Displace::GetValues (int count, const float* x, const float* y,
+  const float* z, float* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+template <class T>
+void Displace::GetValuesImpl (int count, const T* x, const T* y,
+  const T* z, T* values) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+  assert (m_pSourceModule[2] != NULL);
+  assert (m_pSourceModule[3] != NULL);
+
+  T xDisplace[MODULE_BATCH_SIZE];
+  T yDisplace[MODULE_BATCH_SIZE];
+  T zDisplace[MODULE_BATCH_SIZE];
+  for (int offset = 0; offset < count; offset += MODULE_BATCH_SIZE) {
+    int n = GetMin (count - offset, MODULE_BATCH_SIZE);
+    const T* xi = x + offset;
+    const T* yi = y + offset;
+    const T* zi = z + offset;
+
+    // Get the output values from the three displacement modules.  Add each
+    // value to the corresponding coordinate in the input value.
+    m_pSourceModule[1]->GetValues (n, xi, yi, zi, xDisplace);
+    m_pSourceModule[2]->GetValues (n, xi, yi, zi, yDisplace);
+    m_pSourceModule[3]->GetValues (n, xi, yi, zi, zDisplace);
+    for (int i = 0; i < n; i++) {
+      xDisplace[i] = xi[i] + xDisplace[i];
+      yDisplace[i] = yi[i] + yDisplace[i];
+      zDisplace[i] = zi[i] + zDisplace[i];
+    }
+
+    // Retrieve the output values using the offsetted input values instead
+    // of the original input values.
+    m_pSourceModule[0]->GetValues (n, xDisplace, yDisplace, zDisplace,
+      values + offset);
+  }
+}
@@ -74,6 +74,10 @@ namespace noise
       /// Constructor.
       Displace ();
 
+      virtual void GetBounds (double lowerX, double lowerY, double lowerZ,
+        double upperX, double upperY, double upperZ, double& lowerBound,
+        double& upperBound) const;
+
       virtual int GetSourceModuleCount () const
       {
         return 4;
@@ -81,6 +85,12 @@ namespace noise
 
       virtual double GetValue (double x, double y, double z) const;
 
+      virtual void GetValues (int count, const double* x, const double* y,
+        const double* z, double* values) const;
+
+        virtual void GetValues (int count, const float* x, const float* y,
+          const float* z, float* values) const;
+
       /// Returns the @a x displacement module.
       ///
       /// @returns A reference to the @a x displacement module.
@@ -244,6 +254,13 @@ namespace noise
         m_pSourceModule[3] = &zDisplaceModule;
       }
 
+      private:
+
+        /// Implements both versions of the GetValues() method.
+        template <class T>
+        void GetValuesImpl (int count, const T* x, const T* y, const T* z,
+          T* values) const;
+
     };
 
     /// @}
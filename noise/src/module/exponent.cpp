@@ -20,6 +20,7 @@
 // off every 'zig'.)
 //
 
+#include "../boundsimpl.h"
 #include "exponent.h"
 
 using namespace noise::module;
@@ -30,6 +31,18 @@ Exponent::Exponent ():
 {
 }
 
+void Exponent::GetBounds (double lowerX, double lowerY, double lowerZ,
+  double upperX, double upperY, double upperZ, double& lowerBound,
+  double& upperBound) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  double lower, upper;
+  m_pSourceModule[0]->GetBounds (lowerX, lowerY, lowerZ, upperX, upperY,
+    upperZ, lower, upper);
+  ExponentBounds (lower, upper, m_exponent, lowerBound, upperBound);
+}
+
 double Exponent::GetValue (double x, double y, double z) const
 {
   assert (m_pSourceModule[0] != NULL);
@@ -37,3 +50,29 @@ double Exponent::GetValue (double x, double y, double z) const
   double value = m_pSourceModule[0]->GetValue (x, y, z);
   return (pow (fabs ((value + 1.0) / 2.0), m_exponent) * 2.0 - 1.0);
 }
+
+void Exponent::GetValues (int count, const double* x, const double* y,
+  const double* z, double* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+void Exponent::GetValues (int count, const float* x, const float* y,
+  const float* z, float* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+template <class T>
+void Exponent::GetValuesImpl (int count, const T* x, const T* y,
+  const T* z, T* values) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  T exponent = (T)m_exponent;
+  m_pSourceModule[0]->GetValues (count, x, y, z, values);
+  for (int i = 0; i < count; i++) {
+    values[i] = (pow (fabs ((values[i] + (T)1.0) / (T)2.0), exponent)
+      * (T)2.0 - (T)1.0);
+  }
+}
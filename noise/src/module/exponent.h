@@ -64,6 +64,10 @@ namespace noise
         /// The default exponent is set to noise::module::DEFAULT_EXPONENT.
         Exponent ();
 
+        virtual void GetBounds (double lowerX, double lowerY, double lowerZ,
+          double upperX, double upperY, double upperZ, double& lowerBound,
+          double& upperBound) const;
+
         /// Returns the exponent value to apply to the output value from the
         /// source module.
         ///
@@ -85,6 +89,12 @@ namespace noise
 
         virtual double GetValue (double x, double y, double z) const;
 
+        virtual void GetValues (int count, const double* x, const double* y,
+          const double* z, double* values) const;
+
+        virtual void GetValues (int count, const float* x, const float* y,
+          const float* z, float* values) const;
+
         /// Sets the exponent value to apply to the output value from the
         /// source module.
         ///
@@ -104,6 +114,13 @@ namespace noise
         /// Exponent to apply to the output value from the source module.
         double m_exponent;
 
+      private:
+
+        /// Implements both versions of the GetValues() method.
+        template <class T>
+        void GetValuesImpl (int count, const T* x, const T* y, const T* z,
+          T* values) const;
+
     };
 
     /// @}
@@ -0,0 +1,439 @@
+// hashcache.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+#include <string.h>
+#include "../misc.h"
+#include "../threadimpl.h"
+#include "hashcache.h"
+
+using namespace noise;
+using namespace noise::module;
+
+// The number of neighboring entries in which an input value may be stored.
+static const int HASHCACHE_WAY_COUNT = 4;
+
+// The largest number of entries in a table.
+static const int HASHCACHE_MAX_ENTRY_COUNT = 1 << 30;
+
+template <class T>
+struct HashCache::Entry
+{
+  // Coordinates of the input value.
+  T x;
+  T y;
+  T z;
+
+  // The output value at the input value.
+  T value;
+
+  // The time at which this entry was last used, or zero if this entry is
+  // not in use.
+  uint32 lastUse;
+
+  // Determines if this entry stores an input value.  The bit patterns of
+  // the coordinates are compared, so that 0.0 and -0.0, whose output values
+  // may differ, are stored in separate entries.
+  bool IsInputValue (T inX, T inY, T inZ) const
+  {
+    return lastUse != 0 && memcmp (&x, &inX, sizeof (T)) == 0
+      && memcmp (&y, &inY, sizeof (T)) == 0
+      && memcmp (&z, &inZ, sizeof (T)) == 0;
+  }
+};
+
+template <class T>
+struct HashCache::Table
+{
+  // The entries of this table, or NULL if this table has not been
+  // allocated.
+  Entry<T>* pEntries;
+
+  // One less than the number of entries, which is a power of two.
+  int mask;
+
+  // The time of the most recent use of an entry.
+  uint32 clock;
+
+  Table ():
+    pEntries (NULL),
+    mask (0),
+    clock (0)
+  {
+  }
+
+  ~Table ()
+  {
+    delete[] pEntries;
+  }
+
+  // Allocates an empty table with the specified number of entries.
+  void Allocate (int entryCount)
+  {
+    pEntries = new Entry<T>[entryCount];
+    mask = entryCount - 1;
+    Clear ();
+  }
+
+  // Marks all entries as not in use.
+  void Clear ()
+  {
+    if (pEntries != NULL) {
+      for (int i = 0; i <= mask; i++) {
+        pEntries[i].lastUse = 0;
+      }
+    }
+    clock = 0;
+  }
+
+  // Returns the entry that stores the specified input value, or NULL if
+  // the input value is not stored.
+  const Entry<T>* Find (uint32 hash, T x, T y, T z)
+  {
+    for (int i = 0; i < HASHCACHE_WAY_COUNT; i++) {
+      Entry<T>& entry = pEntries[(hash + i) & mask];
+      if (entry.IsInputValue (x, y, z)) {
+        entry.lastUse = Tick ();
+        return &entry;
+      }
+    }
+    return NULL;
+  }
+
+  // Frees the entries.
+  void Free ()
+  {
+    delete[] pEntries;
+    pEntries = NULL;
+    mask = 0;
+    clock = 0;
+  }
+
+  // Stores an input value and its output value, replacing the least
+  // recently used of the entries in which the input value may be stored.
+  void Insert (uint32 hash, T x, T y, T z, T value)
+  {
+    Entry<T>* pVictim = &pEntries[hash & mask];
+    for (int i = 0; i < HASHCACHE_WAY_COUNT; i++) {
+      Entry<T>& entry = pEntries[(hash + i) & mask];
+      if (entry.IsInputValue (x, y, z)) {
+        pVictim = &entry;
+        break;
+      }
+      if (entry.lastUse < pVictim->lastUse) {
+        pVictim = &entry;
+      }
+    }
+    pVictim->x = x;
+    pVictim->y = y;
+    pVictim->z = z;
+    pVictim->value = value;
+    pVictim->lastUse = Tick ();
+  }
+
+  // Returns the time of a new use of an entry.  When the clock wraps
+  // around, the table is cleared so that the times remain ordered.
+  uint32 Tick ()
+  {
+    if (++clock == 0) {
+      Clear ();
+      clock = 1;
+    }
+    return clock;
+  }
+};
+
+struct HashCache::ThreadState
+{
+  // The double-precision table.
+  Table<double> table;
+
+  // The single-precision table.
+  Table<float> tableFloat;
+
+  // The number of input values that were found in the tables.
+  uint64 hitCount;
+
+  // The number of input values that were not found in the tables.
+  uint64 missCount;
+
+  ThreadState ():
+    hitCount (0),
+    missCount (0)
+  {
+  }
+};
+
+struct HashCache::ThreadStorage: public PerThread<ThreadState>
+{
+  // The hit and miss counts of the threads that have exited.
+  uint64 exitedHitCount;
+  uint64 exitedMissCount;
+
+  ThreadStorage ():
+    exitedHitCount (0),
+    exitedMissCount (0)
+  {
+  }
+
+  // Keeps the counts of a thread that is exiting.
+  virtual void OnThreadExit (ThreadState& state)
+  {
+    exitedHitCount += state.hitCount;
+    exitedMissCount += state.missCount;
+  }
+};
+
+// Mixes a 32-bit word into a hash value.
+static inline uint32 MixHash (uint32 hash, uint32 word)
+{
+  word *= 0xcc9e2d51;
+  word = (word << 15) | (word >> 17);
+  word *= 0x1b873593;
+  hash ^= word;
+  hash = (hash << 13) | (hash >> 19);
+  return hash * 5 + 0xe6546b64;
+}
+
+// Finishes a hash value so that every bit of the input affects the low
+// bits used to index a table.
+static inline uint32 FinishHash (uint32 hash)
+{
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6b;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35;
+  hash ^= hash >> 16;
+  return hash;
+}
+
+// Returns a hash value of the bit patterns of the coordinates of an input
+// value.
+static uint32 HashCoords (double x, double y, double z)
+{
+  uint32 words[6];
+  memcpy (words    , &x, sizeof (double));
+  memcpy (words + 2, &y, sizeof (double));
+  memcpy (words + 4, &z, sizeof (double));
+  uint32 hash = 0;
+  for (int i = 0; i < 6; i++) {
+    hash = MixHash (hash, words[i]);
+  }
+  return FinishHash (hash);
+}
+
+static uint32 HashCoords (float x, float y, float z)
+{
+  uint32 words[3];
+  memcpy (words    , &x, sizeof (float));
+  memcpy (words + 1, &y, sizeof (float));
+  memcpy (words + 2, &z, sizeof (float));
+  uint32 hash = 0;
+  for (int i = 0; i < 3; i++) {
+    hash = MixHash (hash, words[i]);
+  }
+  return FinishHash (hash);
+}
+
+HashCache::HashCache ():
+  Module (GetSourceModuleCount ()),
+  m_entryCount (DEFAULT_HASHCACHE_ENTRY_COUNT)
+{
+  m_pStorage = new ThreadStorage;
+}
+
+HashCache::~HashCache ()
+{
+  delete m_pStorage;
+}
+
+uint64 HashCache::GetHitCount () const
+{
+  m_pStorage->LockList ();
+  uint64 hitCount = m_pStorage->exitedHitCount;
+  for (ThreadStorage::Node* pNode = m_pStorage->GetFirst (); pNode != NULL;
+    pNode = pNode->pNext) {
+    hitCount += pNode->value.hitCount;
+  }
+  m_pStorage->UnlockList ();
+  return hitCount;
+}
+
+uint64 HashCache::GetMissCount () const
+{
+  m_pStorage->LockList ();
+  uint64 missCount = m_pStorage->exitedMissCount;
+  for (ThreadStorage::Node* pNode = m_pStorage->GetFirst (); pNode != NULL;
+    pNode = pNode->pNext) {
+    missCount += pNode->value.missCount;
+  }
+  m_pStorage->UnlockList ();
+  return missCount;
+}
+
+HashCache::ThreadState& HashCache::GetThreadState () const
+{
+  return m_pStorage->Get ();
+}
+
+void HashCache::GetBounds (double lowerX, double lowerY, double lowerZ,
+  double upperX, double upperY, double upperZ, double& lowerBound,
+  double& upperBound) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  m_pSourceModule[0]->GetBounds (lowerX, lowerY, lowerZ, upperX, upperY,
+    upperZ, lowerBound, upperBound);
+}
+
+double HashCache::GetValue (double x, double y, double z) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  ThreadState& state = GetThreadState ();
+  Table<double>& table = state.table;
+  if (table.pEntries == NULL) {
+    table.Allocate (m_entryCount);
+  }
+
+  uint32 hash = HashCoords (x, y, z);
+  const Entry<double>* pEntry = table.Find (hash, x, y, z);
+  if (pEntry != NULL) {
+    state.hitCount++;
+    return pEntry->value;
+  }
+  state.missCount++;
+  double value = m_pSourceModule[0]->GetValue (x, y, z);
+  table.Insert (hash, x, y, z, value);
+  return value;
+}
+
+void HashCache::GetValues (int count, const double* x, const double* y,
+  const double* z, double* values) const
+{
+  ThreadState& state = GetThreadState ();
+  GetValuesImpl (count, x, y, z, values, state.table, state);
+}
+
+void HashCache::GetValues (int count, const float* x, const float* y,
+  const float* z, float* values) const
+{
+  ThreadState& state = GetThreadState ();
+  GetValuesImpl (count, x, y, z, values, state.tableFloat, state);
+}
+
+template <class T>
+void HashCache::GetValuesImpl (int count, const T* x, const T* y,
+  const T* z, T* values, Table<T>& table, ThreadState& state) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  if (table.pEntries == NULL) {
+    table.Allocate (m_entryCount);
+  }
+
+  // The input values that were not found in the table are gathered and
+  // passed to the source module in a single call.
+  int missIndex[MODULE_BATCH_SIZE];
+  uint32 missHash[MODULE_BATCH_SIZE];
+  T xMiss[MODULE_BATCH_SIZE];
+  T yMiss[MODULE_BATCH_SIZE];
+  T zMiss[MODULE_BATCH_SIZE];
+  T missValues[MODULE_BATCH_SIZE];
+  for (int offset = 0; offset < count; offset += MODULE_BATCH_SIZE) {
+    int n = GetMin (count - offset, MODULE_BATCH_SIZE);
+    int missCount = 0;
+    for (int i = offset; i < offset + n; i++) {
+      uint32 hash = HashCoords (x[i], y[i], z[i]);
+      const Entry<T>* pEntry = table.Find (hash, x[i], y[i], z[i]);
+      if (pEntry != NULL) {
+        values[i] = pEntry->value;
+      } else {
+        missIndex[missCount] = i;
+        missHash [missCount] = hash;
+        xMiss    [missCount] = x[i];
+        yMiss    [missCount] = y[i];
+        zMiss    [missCount] = z[i];
+        missCount++;
+      }
+    }
+    state.hitCount += n - missCount;
+    state.missCount += missCount;
+    if (missCount > 0) {
+      m_pSourceModule[0]->GetValues (missCount, xMiss, yMiss, zMiss,
+        missValues);
+      for (int i = 0; i < missCount; i++) {
+        values[missIndex[i]] = missValues[i];
+        table.Insert (missHash[i], xMiss[i], yMiss[i], zMiss[i],
+          missValues[i]);
+      }
+    }
+  }
+}
+
+void HashCache::ResetCounts ()
+{
+  m_pStorage->LockList ();
+  m_pStorage->exitedHitCount = 0;
+  m_pStorage->exitedMissCount = 0;
+  for (ThreadStorage::Node* pNode = m_pStorage->GetFirst (); pNode != NULL;
+    pNode = pNode->pNext) {
+    pNode->value.hitCount = 0;
+    pNode->value.missCount = 0;
+  }
+  m_pStorage->UnlockList ();
+}
+
+void HashCache::SetEntryCount (int entryCount)
+{
+  if (entryCount < HASHCACHE_WAY_COUNT
+    || entryCount > HASHCACHE_MAX_ENTRY_COUNT) {
+    throw noise::ExceptionInvalidParam ();
+  }
+
+  int powerOfTwo = HASHCACHE_WAY_COUNT;
+  while (powerOfTwo < entryCount) {
+    powerOfTwo <<= 1;
+  }
+  m_entryCount = powerOfTwo;
+
+  // The tables are allocated again, with the new size, when they are next
+  // used.
+  m_pStorage->LockList ();
+  for (ThreadStorage::Node* pNode = m_pStorage->GetFirst (); pNode != NULL;
+    pNode = pNode->pNext) {
+    pNode->value.table.Free ();
+    pNode->value.tableFloat.Free ();
+  }
+  m_pStorage->UnlockList ();
+}
+
+void HashCache::SetSourceModule (int index, const Module& sourceModule)
+{
+  Module::SetSourceModule (index, sourceModule);
+  m_pStorage->LockList ();
+  for (ThreadStorage::Node* pNode = m_pStorage->GetFirst (); pNode != NULL;
+    pNode = pNode->pNext) {
+    pNode->value.table.Clear ();
+    pNode->value.tableFloat.Clear ();
+  }
+  m_pStorage->UnlockList ();
+}
@@ -0,0 +1,222 @@
+// hashcache.h
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+#ifndef NOISE_MODULE_HASHCACHE_H
+#define NOISE_MODULE_HASHCACHE_H
+
+#include "modulebase.h"
+
+namespace noise
+{
+
+  namespace module
+  {
+
+    /// @addtogroup libnoise
+    /// @{
+
+    /// @addtogroup modules
+    /// @{
+
+    /// @addtogroup miscmodules
+    /// @{
+
+    /// Default number of entries in the table of a
+    /// noise::module::HashCache noise module.
+    const int DEFAULT_HASHCACHE_ENTRY_COUNT = 256;
+
+    /// Noise module that caches the output values generated by a source
+    /// module at many recent input values.
+    ///
+    /// This noise module works like a noise::module::Cache noise module,
+    /// except that it stores up to GetEntryCount() input values, along with
+    /// their output values, in a table instead of only the last input
+    /// value.  This is useful if the source module is reached through
+    /// several paths of a noise module (for example, through the control
+    /// module of a noise::module::Select noise module and one of its source
+    /// modules) and the other paths are evaluated in between; those calls
+    /// replace the single input value stored in a noise::module::Cache
+    /// noise module.
+    ///
+    /// Each input value is stored in one of four neighboring entries, found
+    /// by hashing its coordinates.  If all four entries are in use, the
+    /// entry that was least recently used is replaced.  The coordinates
+    /// are compared by their bit patterns, so 0.0 and -0.0 are stored in
+    /// separate entries.
+    ///
+    /// The GetValues() method looks up each input value in the table and
+    /// passes the input values that were not found to the source module in
+    /// a single call.  Double-precision and single-precision values are
+    /// stored in separate tables.
+    ///
+    /// To choose the size of the table, call the GetHitCount() and
+    /// GetMissCount() methods after generating a typical set of output
+    /// values.  If the table is too small, the number of misses exceeds the
+    /// number of distinct input values.
+    ///
+    /// Like a noise::module::Cache noise module, this noise module has a
+    /// separate table for each thread that calls it, so it can be called
+    /// from several threads at the same time.  The table of a thread is
+    /// freed when that thread exits.  The hit and miss counts are the sums
+    /// of the counts of each thread, including the threads that have exited.
+    ///
+    /// If an application passes a new source module to the SetSourceModule()
+    /// method, the tables are cleared.
+    ///
+    /// This noise module requires one source module.
+    class HashCache: public Module
+    {
+
+      public:
+
+        /// Constructor.
+        ///
+        /// The default number of entries is set to
+        /// noise::module::DEFAULT_HASHCACHE_ENTRY_COUNT.
+        ///
+        /// @throw noise::ExceptionOutOfMemory
+        /// - The operating system could not provide storage for the tables
+        ///   of each thread.
+        HashCache ();
+
+        /// Destructor.
+        ~HashCache ();
+
+        virtual void GetBounds (double lowerX, double lowerY, double lowerZ,
+          double upperX, double upperY, double upperZ, double& lowerBound,
+          double& upperBound) const;
+
+        /// Returns the number of entries in the table.
+        ///
+        /// @returns The number of entries in the table.
+        int GetEntryCount () const
+        {
+          return m_entryCount;
+        }
+
+        /// Returns the number of input values that were found in the table.
+        ///
+        /// @returns The number of hits since this noise module was created
+        /// or the ResetCounts() method was called.
+        ///
+        /// This method must not be called while another thread is calling
+        /// this noise module.
+        uint64 GetHitCount () const;
+
+        /// Returns the number of input values that were not found in the
+        /// table.
+        ///
+        /// @returns The number of misses since this noise module was
+        /// created or the ResetCounts() method was called.
+        ///
+        /// This method must not be called while another thread is calling
+        /// this noise module.
+        uint64 GetMissCount () const;
+
+        virtual int GetSourceModuleCount () const
+        {
+          return 1;
+        }
+
+        virtual double GetValue (double x, double y, double z) const;
+
+        virtual void GetValues (int count, const double* x, const double* y,
+          const double* z, double* values) const;
+
+        virtual void GetValues (int count, const float* x, const float* y,
+          const float* z, float* values) const;
+
+        /// Resets the hit and miss counts to zero.
+        ///
+        /// This method must not be called while another thread is calling
+        /// this noise module.
+        void ResetCounts ();
+
+        /// Sets the number of entries in the table.
+        ///
+        /// @param entryCount The number of entries in the table.
+        ///
+        /// @pre The number of entries ranges from 4 to 2^30.
+        ///
+        /// @throw noise::ExceptionInvalidParam
+        /// - An invalid parameter was specified; see the preconditions for
+        ///   more information.
+        ///
+        /// The number of entries is rounded up to a power of two.  The
+        /// tables are cleared.
+        ///
+        /// This method must not be called while another thread is calling
+        /// this noise module.
+        void SetEntryCount (int entryCount);
+
+        /// @note This method must not be called while another thread is
+        /// calling this noise module.
+        virtual void SetSourceModule (int index, const Module& sourceModule);
+
+      private:
+
+        /// An entry of a table.
+        template <class T>
+        struct Entry;
+
+        /// A table of cached input values and output values.
+        template <class T>
+        struct Table;
+
+        /// The tables and counts of one thread.
+        struct ThreadState;
+
+        /// The storage for the tables of each thread.
+        struct ThreadStorage;
+
+        /// Returns the tables and counts of the calling thread.
+        ///
+        /// @returns A reference to the tables and counts.
+        ///
+        /// If the calling thread has no tables yet, this method creates
+        /// them.
+        ThreadState& GetThreadState () const;
+
+        /// Implements both versions of the GetValues() method.
+        template <class T>
+        void GetValuesImpl (int count, const T* x, const T* y, const T* z,
+          T* values, Table<T>& table, ThreadState& state) const;
+
+        /// The number of entries in the table.
+        int m_entryCount;
+
+        /// The storage for the tables of each thread.
+        ThreadStorage* m_pStorage;
+
+    };
+
+    /// @}
+
+    /// @}
+
+    /// @}
+
+  }
+
+}
+
+#endif
@@ -29,9 +29,46 @@ Invert::Invert ():
 {
 }
 
+void Invert::GetBounds (double lowerX, double lowerY, double lowerZ,
+  double upperX, double upperY, double upperZ, double& lowerBound,
+  double& upperBound) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  double lower, upper;
+  m_pSourceModule[0]->GetBounds (lowerX, lowerY, lowerZ, upperX, upperY,
+    upperZ, lower, upper);
+  lowerBound = -upper;
+  upperBound = -lower;
+}
+
 double Invert::GetValue (double x, double y, double z) const
 {
   assert (m_pSourceModule[0] != NULL);
 
   return -(m_pSourceModule[0]->GetValue (x, y, z));
 }
+
+void Invert::GetValues (int count, const double* x, const double* y,
+  const double* z, double* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+void Invert::GetValues (int count, const float* x, const float* y,
+  const float* z, float* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+template <class T>
+void Invert::GetValuesImpl (int count, const T* x, const T* y,
+  const T* z, T* values) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  m_pSourceModule[0]->GetValues (count, x, y, z, values);
+  for (int i = 0; i < count; i++) {
+    values[i] = -values[i];
+  }
+}
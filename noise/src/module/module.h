@@ -35,19 +35,24 @@
 #include "cylinders.h"
 #include "displace.h"
 #include "exponent.h"
+#include "hashcache.h"
 #include "invert.h"
 #include "max.h"
 #include "min.h"
 #include "multiply.h"
 #include "perlin.h"
 #include "power.h"
+#include "program.h"
 #include "ridgedmulti.h"
 #include "rotatepoint.h"
 #include "scalebias.h"
 #include "scalepoint.h"
 #include "select.h"
+#include "simplex.h"
 #include "spheres.h"
 #include "terrace.h"
+#include "tilecache.h"
+#include "transformpoint.h"
 #include "translatepoint.h"
 #include "turbulence.h"
 #include "voronoi.h"
@@ -44,3 +44,27 @@ Module::~Module ()
 {
   delete[] m_pSourceModule;
 }
+
+void Module::GetBounds (double lowerX, double lowerY, double lowerZ,
+  double upperX, double upperY, double upperZ, double& lowerBound,
+  double& upperBound) const
+{
+  lowerBound = -HUGE_VAL;
+  upperBound = HUGE_VAL;
+}
+
+void Module::GetValues (int count, const double* x, const double* y,
+  const double* z, double* values) const
+{
+  for (int i = 0; i < count; i++) {
+    values[i] = GetValue (x[i], y[i], z[i]);
+  }
+}
+
+void Module::GetValues (int count, const float* x, const float* y,
+  const float* z, float* values) const
+{
+  for (int i = 0; i < count; i++) {
+    values[i] = (float)GetValue (x[i], y[i], z[i]);
+  }
+}
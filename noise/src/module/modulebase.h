@@ -43,6 +43,13 @@ namespace noise
     /// @addtogroup modules
     /// @{
 
+    /// Maximum number of input values that a noise module processes at once
+    /// when generating an array of output values.
+    ///
+    /// Noise modules that need temporary arrays to generate an array of
+    /// output values allocate them on the stack with this many elements.
+    const int MODULE_BATCH_SIZE = 128;
+
     /// Abstract base class for noise modules.
     ///
     /// A <i>noise module</i> is an object that calculates and outputs a value
@@ -184,6 +191,12 @@ namespace noise
     /// To generate an output value, pass the ( @a x, @a y, @a z ) coordinates
     /// of an input value to the GetValue() method.
     ///
+    /// To generate many output values at once, pass arrays of coordinates to
+    /// the GetValues() method.  If you store the output values as floats,
+    /// pass arrays of floats instead; the noise modules then compute the
+    /// output values in single precision, which is faster but less precise
+    /// at large coordinates.
+    ///
     /// <b>Using a noise module to generate terrain height maps or textures</b>
     ///
     /// One way to generate a terrain height map or a texture is to first
@@ -209,6 +222,22 @@ namespace noise
     /// referenced in the protected @a m_pSourceModule array, mathematically
     /// combine those values, and return the combined value.
     ///
+    /// Optionally override the GetValues() virtual method.  The default
+    /// implementation calls GetValue() once per input value, which is
+    /// correct but slow.  An overriding method should retrieve the arrays of
+    /// output values from its source modules with their GetValues() methods
+    /// and combine those arrays in a single loop.  Override both the
+    /// double-precision and the single-precision versions; a private member
+    /// template that implements both, such as the one in
+    /// noise::module::Add, avoids duplicating the code.
+    ///
+    /// Optionally override the GetBounds() virtual method.  The default
+    /// implementation returns an unbounded range; an overriding method
+    /// should retrieve the bounds of its source modules over the box (or
+    /// over the transformed box) and combine them.  The returned range may be
+    /// larger than the actual range of output values, but it must contain
+    /// all of them.
+    ///
     /// When developing a noise module, you must ensure that your noise module
     /// does not modify any source module or control module connected to it; a
     /// noise module can only modify the output value from those source
@@ -231,6 +260,46 @@ namespace noise
         /// Destructor.
         virtual ~Module ();
 
+        /// Returns a range that contains every output value within an
+        /// axis-aligned box.
+        ///
+        /// @param lowerX The lower @a x coordinate of the box.
+        /// @param lowerY The lower @a y coordinate of the box.
+        /// @param lowerZ The lower @a z coordinate of the box.
+        /// @param upperX The upper @a x coordinate of the box.
+        /// @param upperY The upper @a y coordinate of the box.
+        /// @param upperZ The upper @a z coordinate of the box.
+        /// @param lowerBound Receives the lower bound of the output values.
+        /// @param upperBound Receives the upper bound of the output values.
+        ///
+        /// @pre All source modules required by this noise module have been
+        /// passed to the SetSourceModule() method.
+        /// @pre Each lower coordinate is less than or equal to the
+        /// corresponding upper coordinate.
+        ///
+        /// The GetValue() method returns a value within these bounds for
+        /// every input value within the box, including the faces of the box.
+        /// The bounds are conservative: the actual output values usually
+        /// cover only part of the range, but never leave it.  The coordinates
+        /// may be infinite, and either bound may be infinite if the output
+        /// values are unbounded.
+        ///
+        /// Generator modules bound their output values by the amplitudes of
+        /// their octaves, and other noise modules transform the box and the
+        /// bounds of their source modules, so this method is typically much
+        /// faster than generating a single output value.  An application can
+        /// use it to skip regions whose output values cannot cross a
+        /// threshold (for example, an iso-surface) without generating them.
+        ///
+        /// The values returned by the single-precision version of
+        /// GetValues() may exceed these bounds by roughly the precision of a
+        /// float.
+        ///
+        /// The default implementation returns -HUGE_VAL and +HUGE_VAL.
+        virtual void GetBounds (double lowerX, double lowerY, double lowerZ,
+          double upperX, double upperY, double upperZ, double& lowerBound,
+          double& upperBound) const;
+
         /// Returns a reference to a source module connected to this noise
         /// module.
         ///
@@ -295,6 +364,82 @@ namespace noise
         /// module, call the GetSourceModuleCount() method.
         virtual double GetValue (double x, double y, double z) const = 0;
 
+        /// Generates the output values given the coordinates of an array of
+        /// input values.
+        ///
+        /// @param count The number of input values.
+        /// @param x An array containing the @a x coordinates of the input
+        /// values.
+        /// @param y An array containing the @a y coordinates of the input
+        /// values.
+        /// @param z An array containing the @a z coordinates of the input
+        /// values.
+        /// @param values An array that receives the output values.
+        ///
+        /// @pre All source modules required by this noise module have been
+        /// passed to the SetSourceModule() method.
+        /// @pre Each array contains at least @a count elements.
+        /// @pre The @a values array does not overlap any of the coordinate
+        /// arrays.
+        ///
+        /// After this method returns, the <i>i</i>th element of @a values
+        /// contains the value that GetValue() returns for the <i>i</i>th
+        /// input value.
+        ///
+        /// Calling this method once for a span of input values is much
+        /// faster than calling GetValue() once per input value.  Each noise
+        /// module processes the whole span in a tight loop before handing
+        /// the span to the noise module that requested it, so there is only
+        /// one virtual call per noise module per span.
+        ///
+        /// Noise modules that need temporary storage process the span in
+        /// pieces of at most noise::module::MODULE_BATCH_SIZE input values.
+        ///
+        /// The default implementation calls GetValue() for each input value.
+        virtual void GetValues (int count, const double* x, const double* y,
+          const double* z, double* values) const;
+
+        /// Generates single-precision output values given the coordinates
+        /// of an array of input values.
+        ///
+        /// @param count The number of input values.
+        /// @param x An array containing the @a x coordinates of the input
+        /// values.
+        /// @param y An array containing the @a y coordinates of the input
+        /// values.
+        /// @param z An array containing the @a z coordinates of the input
+        /// values.
+        /// @param values An array that receives the output values.
+        ///
+        /// @pre All source modules required by this noise module have been
+        /// passed to the SetSourceModule() method.
+        /// @pre Each array contains at least @a count elements.
+        /// @pre The @a values array does not overlap any of the coordinate
+        /// arrays.
+        ///
+        /// This method works like the double-precision version of
+        /// GetValues(), but the noise modules perform their calculations in
+        /// single precision.  The coherent-noise functions then process
+        /// twice as many input values per vector instruction, and the
+        /// temporary arrays take half the memory.
+        ///
+        /// The output values differ from the double-precision output values
+        /// by roughly the precision of a float, multiplied by the gain of
+        /// the noise modules in between.  A float also cannot represent
+        /// coordinates as precisely as a double.  Once the input
+        /// coordinates, multiplied by the frequency of the highest octave
+        /// of a generator module, grow past 32768, a float resolves fewer
+        /// than 256 positions within each unit cube of the integer lattice
+        /// and the output becomes visibly coarse; above 8388608, the
+        /// coherent noise is zero.  This happens long before
+        /// noise::MakeInt32Range() takes effect; see the single-precision
+        /// version of noise::GradientCoherentNoise3D() for details.
+        ///
+        /// The default implementation calls GetValue() for each input value
+        /// and converts the result to a float.
+        virtual void GetValues (int count, const float* x, const float* y,
+          const float* z, float* values) const;
+
         /// Connects a source module to this noise module.
         ///
         /// @param index An index value to assign to this source module.
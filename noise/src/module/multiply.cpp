@@ -20,6 +20,8 @@
 // off every 'zig'.)
 //
 
+#include "../boundsimpl.h"
+#include "../misc.h"
 #include "multiply.h"
 
 using namespace noise::module;
@@ -29,6 +31,21 @@ Multiply::Multiply ():
 {
 }
 
+void Multiply::GetBounds (double lowerX, double lowerY, double lowerZ,
+  double upperX, double upperY, double upperZ, double& lowerBound,
+  double& upperBound) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+
+  double lower0, upper0, lower1, upper1;
+  m_pSourceModule[0]->GetBounds (lowerX, lowerY, lowerZ, upperX, upperY,
+    upperZ, lower0, upper0);
+  m_pSourceModule[1]->GetBounds (lowerX, lowerY, lowerZ, upperX, upperY,
+    upperZ, lower1, upper1);
+  MultiplyBounds (lower0, upper0, lower1, upper1, lowerBound, upperBound);
+}
+
 double Multiply::GetValue (double x, double y, double z) const
 {
   assert (m_pSourceModule[0] != NULL);
@@ -37,3 +54,34 @@ double Multiply::GetValue (double x, double y, double z) const
   return m_pSourceModule[0]->GetValue (x, y, z)
        * m_pSourceModule[1]->GetValue (x, y, z);
 }
+
+void Multiply::GetValues (int count, const double* x, const double* y,
+  const double* z, double* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+void Multiply::GetValues (int count, const float* x, const float* y,
+  const float* z, float* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+template <class T>
+void Multiply::GetValuesImpl (int count, const T* x, const T* y,
+  const T* z, T* values) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+
+  T v1[MODULE_BATCH_SIZE];
+  for (int offset = 0; offset < count; offset += MODULE_BATCH_SIZE) {
+    int n = GetMin (count - offset, MODULE_BATCH_SIZE);
+    T* v0 = values + offset;
+    m_pSourceModule[0]->GetValues (n, x + offset, y + offset, z + offset, v0);
+    m_pSourceModule[1]->GetValues (n, x + offset, y + offset, z + offset, v1);
+    for (int i = 0; i < n; i++) {
+      v0[i] *= v1[i];
+    }
+  }
+}
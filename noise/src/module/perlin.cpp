@@ -20,34 +20,77 @@
 // off every 'zig'.)
 //
 
+#include "../fractalimpl.h"
+#include "../misc.h"
 #include "perlin.h"
 
 using namespace noise::module;
 
 Perlin::Perlin ():
   Module (GetSourceModuleCount ()),
+  m_enableNormalization (false),
   m_frequency    (DEFAULT_PERLIN_FREQUENCY   ),
   m_lacunarity   (DEFAULT_PERLIN_LACUNARITY  ),
   m_noiseQuality (DEFAULT_PERLIN_QUALITY     ),
+  m_pNoiseFunctions (
+    &GetGradientCoherentNoiseFunctions (DEFAULT_PERLIN_QUALITY)),
   m_octaveCount  (DEFAULT_PERLIN_OCTAVE_COUNT),
+  m_pPermutationTable (NULL),
   m_persistence  (DEFAULT_PERLIN_PERSISTENCE ),
+  m_sampleSpacing (DEFAULT_PERLIN_SAMPLE_SPACING),
   m_seed         (DEFAULT_PERLIN_SEED)
 {
+  CalcOctaveTable ();
+}
+
+void Perlin::CalcOctaveTable ()
+{
+  // Only generate the octaves that the sample spacing can represent.  The
+  // frequency and amplitude of each octave are calculated in the same order
+  // as they were when the octave loops calculated them, so the output values
+  // do not change.
+  double octaveWeights[PERLIN_MAX_OCTAVE];
+  m_weightedOctaveCount = GetOctaveWeights (m_frequency, m_lacunarity,
+    m_octaveCount, m_sampleSpacing, octaveWeights);
+  double curFrequency = m_frequency;
+  double curPersistence = 1.0;
+  for (int curOctave = 0; curOctave < m_weightedOctaveCount; curOctave++) {
+    m_octaveAmplitudes[curOctave] = curPersistence * octaveWeights[curOctave];
+    m_octaveFrequencies[curOctave] = curFrequency;
+    m_octaveSeeds[curOctave] = (m_seed + curOctave) & 0xffffffff;
+    curFrequency *= m_lacunarity;
+    curPersistence *= m_persistence;
+  }
+  if (m_enableNormalization) {
+    NormalizeOctaveAmplitudes (m_weightedOctaveCount, m_octaveAmplitudes);
+  }
+}
+
+void Perlin::GetBounds (double lowerX, double lowerY, double lowerZ,
+  double upperX, double upperY, double upperZ, double& lowerBound,
+  double& upperBound) const
+{
+  // Each octave adds a coherent-noise value scaled by the amplitude of that
+  // octave.
+  double amplitude = 0.0;
+  for (int curOctave = 0; curOctave < m_weightedOctaveCount; curOctave++) {
+    amplitude += fabs (m_octaveAmplitudes[curOctave]);
+  }
+  upperBound = amplitude * GRADIENT_COHERENT_NOISE_BOUND;
+  lowerBound = -upperBound;
 }
 
 double Perlin::GetValue (double x, double y, double z) const
 {
   double value = 0.0;
   double signal = 0.0;
-  double curPersistence = 1.0;
   double nx, ny, nz;
-  int seed;
 
   x *= m_frequency;
   y *= m_frequency;
   z *= m_frequency;
 
-  for (int curOctave = 0; curOctave < m_octaveCount; curOctave++) {
+  for (int curOctave = 0; curOctave < m_weightedOctaveCount; curOctave++) {
 
     // Make sure that these floating-point values have the same range as a 32-
     // bit integer so that we can pass them to the coherent-noise functions.
@@ -57,16 +100,185 @@ double Perlin::GetValue (double x, double y, double z) const
 
     // Get the coherent-noise value from the input value and add it to the
     // final result.
-    seed = (m_seed + curOctave) & 0xffffffff;
-    signal = GradientCoherentNoise3D (nx, ny, nz, seed, m_noiseQuality);
-    value += signal * curPersistence;
+    int seed = m_octaveSeeds[curOctave];
+    if (m_pPermutationTable != NULL) {
+      signal = m_pNoiseFunctions->gradientCoherentNoise3DTable (nx, ny, nz,
+        *m_pPermutationTable, seed);
+    } else {
+      signal = m_pNoiseFunctions->gradientCoherentNoise3D (nx, ny, nz, seed);
+    }
+    value += signal * m_octaveAmplitudes[curOctave];
 
     // Prepare the next octave.
     x *= m_lacunarity;
     y *= m_lacunarity;
     z *= m_lacunarity;
-    curPersistence *= m_persistence;
   }
 
   return value;
 }
+
+double Perlin::GetValue4D (double x, double y, double z, double w) const
+{
+  double value = 0.0;
+  double signal = 0.0;
+  double nx, ny, nz, nw;
+
+  x *= m_frequency;
+  y *= m_frequency;
+  z *= m_frequency;
+  w *= m_frequency;
+
+  for (int curOctave = 0; curOctave < m_weightedOctaveCount; curOctave++) {
+
+    // Make sure that these floating-point values have the same range as a 32-
+    // bit integer so that we can pass them to the coherent-noise functions.
+    nx = MakeInt32Range (x);
+    ny = MakeInt32Range (y);
+    nz = MakeInt32Range (z);
+    nw = MakeInt32Range (w);
+
+    // Get the coherent-noise value from the input value and add it to the
+    // final result.
+    signal = GradientCoherentNoise4D (nx, ny, nz, nw,
+      m_octaveSeeds[curOctave], m_noiseQuality);
+    value += signal * m_octaveAmplitudes[curOctave];
+
+    // Prepare the next octave.
+    x *= m_lacunarity;
+    y *= m_lacunarity;
+    z *= m_lacunarity;
+    w *= m_lacunarity;
+  }
+
+  return value;
+}
+
+double Perlin::GetValueAndGradient (double x, double y, double z, double& dx,
+  double& dy, double& dz) const
+{
+  double value = 0.0;
+  double signal = 0.0;
+  double nx, ny, nz;
+  double sx, sy, sz;
+
+  // The derivative of an octave with respect to the input value is the
+  // derivative of the coherent noise multiplied by the frequency of that
+  // octave.
+  dx = 0.0;
+  dy = 0.0;
+  dz = 0.0;
+
+  x *= m_frequency;
+  y *= m_frequency;
+  z *= m_frequency;
+
+  for (int curOctave = 0; curOctave < m_weightedOctaveCount; curOctave++) {
+
+    // Make sure that these floating-point values have the same range as a 32-
+    // bit integer so that we can pass them to the coherent-noise functions.
+    nx = MakeInt32Range (x);
+    ny = MakeInt32Range (y);
+    nz = MakeInt32Range (z);
+
+    // Get the coherent-noise value and its derivatives from the input value
+    // and add them to the final result.
+    int seed = m_octaveSeeds[curOctave];
+    if (m_pPermutationTable != NULL) {
+      signal = m_pNoiseFunctions->gradientCoherentNoiseDeriv3DTable (nx, ny,
+        nz, *m_pPermutationTable, seed, sx, sy, sz);
+    } else {
+      signal = m_pNoiseFunctions->gradientCoherentNoiseDeriv3D (nx, ny, nz,
+        seed, sx, sy, sz);
+    }
+    double amplitude = m_octaveAmplitudes[curOctave];
+    double curFrequency = m_octaveFrequencies[curOctave];
+    value += signal * amplitude;
+    dx += sx * amplitude * curFrequency;
+    dy += sy * amplitude * curFrequency;
+    dz += sz * amplitude * curFrequency;
+
+    // Prepare the next octave.
+    x *= m_lacunarity;
+    y *= m_lacunarity;
+    z *= m_lacunarity;
+  }
+
+  return value;
+}
+
+void Perlin::GetValues (int count, const double* x, const double* y,
+  const double* z, double* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+void Perlin::GetValues (int count, const float* x, const float* y,
+  const float* z, float* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+template <class T>
+void Perlin::GetValuesImpl (int count, const T* x, const T* y,
+  const T* z, T* values) const
+{
+  T xCur[MODULE_BATCH_SIZE];
+  T yCur[MODULE_BATCH_SIZE];
+  T zCur[MODULE_BATCH_SIZE];
+  T nx[MODULE_BATCH_SIZE];
+  T ny[MODULE_BATCH_SIZE];
+  T nz[MODULE_BATCH_SIZE];
+  T signal[MODULE_BATCH_SIZE];
+
+  // Convert the parameters to the precision of the input values.
+  T frequency = (T)m_frequency;
+  T lacunarity = (T)m_lacunarity;
+
+  for (int offset = 0; offset < count; offset += MODULE_BATCH_SIZE) {
+    int n = GetMin (count - offset, MODULE_BATCH_SIZE);
+    T* value = values + offset;
+    T maxMagnitude = GetMaxMagnitude (n, x + offset, y + offset,
+      z + offset);
+    for (int i = 0; i < n; i++) {
+      xCur[i] = x[offset + i] * frequency;
+      yCur[i] = y[offset + i] * frequency;
+      zCur[i] = z[offset + i] * frequency;
+      value[i] = 0.0;
+    }
+
+    // Generate each octave for the whole span before moving on to the next
+    // octave.  The per-point operations are the same as the ones in
+    // GetValue(), so the double-precision output values are identical.
+    for (int curOctave = 0; curOctave < m_weightedOctaveCount; curOctave++) {
+      const T* px = xCur;
+      const T* py = yCur;
+      const T* pz = zCur;
+      if (!IsInInt32Range (maxMagnitude, m_octaveFrequencies[curOctave])) {
+        for (int i = 0; i < n; i++) {
+          nx[i] = MakeInt32Range (xCur[i]);
+          ny[i] = MakeInt32Range (yCur[i]);
+          nz[i] = MakeInt32Range (zCur[i]);
+        }
+        px = nx;
+        py = ny;
+        pz = nz;
+      }
+      int seed = m_octaveSeeds[curOctave];
+      if (m_pPermutationTable != NULL) {
+        GradientCoherentNoise3DArray (*m_pNoiseFunctions, n, px, py, pz,
+          signal, *m_pPermutationTable, seed);
+      } else {
+        GradientCoherentNoise3DArray (*m_pNoiseFunctions, n, px, py, pz,
+          signal, seed);
+      }
+      T amplitude = (T)m_octaveAmplitudes[curOctave];
+      for (int i = 0; i < n; i++) {
+        value[i] += signal[i] * amplitude;
+        xCur[i] *= lacunarity;
+        yCur[i] *= lacunarity;
+        zCur[i] *= lacunarity;
+      }
+    }
+  }
+}
@@ -55,6 +55,9 @@ namespace noise
     /// Default noise quality for the noise::module::Perlin noise module.
     const noise::NoiseQuality DEFAULT_PERLIN_QUALITY = QUALITY_STD;
 
+    /// Default sample spacing for the noise::module::Perlin noise module.
+    const double DEFAULT_PERLIN_SAMPLE_SPACING = 0.0;
+
     /// Default noise seed for the noise::module::Perlin noise module.
     const int DEFAULT_PERLIN_SEED = 0;
 
@@ -132,6 +135,16 @@ namespace noise
     /// with the lacunarity value to determine the effects.  For best results,
     /// set the lacunarity to a number between 1.5 and 3.5.
     ///
+    /// <b>Sample spacing</b>
+    ///
+    /// If an application samples the Perlin noise at regular intervals, such
+    /// as the vertices of a distant terrain chunk, the octaves whose
+    /// wavelength is shorter than two intervals cannot be represented by
+    /// the samples; they only add aliasing and calculation time.  An
+    /// application may pass the interval to the SetSampleSpacing() method
+    /// so that these octaves are skipped, and the last octave that is
+    /// generated fades out smoothly as the interval grows.
+    ///
     /// <b>References &amp; acknowledgments</b>
     ///
     /// <a href=http://www.noisemachine.com/talk1/>The Noise Machine</a> -
@@ -176,10 +189,35 @@ namespace noise
         /// The default persistence value is set to
         /// noise::module::DEFAULT_PERLIN_PERSISTENCE.
         ///
+        /// The default sample spacing is set to
+        /// noise::module::DEFAULT_PERLIN_SAMPLE_SPACING.
+        ///
         /// The default seed value is set to
         /// noise::module::DEFAULT_PERLIN_SEED.
         Perlin ();
 
+        /// Enables or disables normalizing the amplitudes of the octaves.
+        ///
+        /// @param enable Specifies whether to normalize the amplitudes of
+        /// the octaves or not.
+        ///
+        /// Without normalization, each octave adds its amplitude to the
+        /// range of the output values, so the range grows with the number
+        /// of octaves and the persistence.  Normalization divides the
+        /// amplitude of each octave by the sum of the amplitudes of all
+        /// generated octaves, so the output values have the range of a
+        /// single octave, whatever the number of octaves.  GetBounds()
+        /// returns the normalized bounds.
+        void EnableNormalization (bool enable = true)
+        {
+          m_enableNormalization = enable;
+          CalcOctaveTable ();
+        }
+
+        virtual void GetBounds (double lowerX, double lowerY, double lowerZ,
+          double upperX, double upperY, double upperZ, double& lowerBound,
+          double& upperBound) const;
+
         /// Returns the frequency of the first octave.
         ///
         /// @returns The frequency of the first octave.
@@ -221,6 +259,16 @@ namespace noise
           return m_octaveCount;
         }
 
+        /// Returns the permutation table that hashes the lattice points of
+        /// the Perlin noise.
+        ///
+        /// @returns A pointer to the permutation table, or NULL if the
+        /// Perlin noise uses the default lattice hash.
+        const noise::PermutationTable* GetPermutationTable () const
+        {
+          return m_pPermutationTable;
+        }
+
         /// Returns the persistence value of the Perlin noise.
         ///
         /// @returns The persistence value of the Perlin noise.
@@ -231,6 +279,15 @@ namespace noise
           return m_persistence;
         }
 
+        /// Returns the spacing between the input values at which the
+        /// application samples this noise module.
+        ///
+        /// @returns The sample spacing.
+        double GetSampleSpacing () const
+        {
+          return m_sampleSpacing;
+        }
+
         /// Returns the seed value used by the Perlin-noise function.
         ///
         /// @returns The seed value.
@@ -246,12 +303,72 @@ namespace noise
 
         virtual double GetValue (double x, double y, double z) const;
 
+        /// Generates an output value from a four-dimensional input value.
+        ///
+        /// @param x The @a x coordinate of the input value.
+        /// @param y The @a y coordinate of the input value.
+        /// @param z The @a z coordinate of the input value.
+        /// @param w The @a w coordinate of the input value.
+        ///
+        /// @returns The output value.
+        ///
+        /// This method generates each octave with the
+        /// GradientCoherentNoise4D() function instead of the
+        /// three-dimensional function, with the same parameters.  Use the
+        /// @a w coordinate as time to animate the noise, or map two
+        /// coordinates onto two circles to generate seamlessly tiling
+        /// two-dimensional noise (see GradientCoherentNoise4D().)
+        ///
+        /// The four-dimensional noise may be larger than the
+        /// three-dimensional noise (see
+        /// noise::GRADIENT_COHERENT_NOISE_4D_BOUND), so the output values
+        /// may exceed the bounds returned by GetBounds().
+        double GetValue4D (double x, double y, double z, double w) const;
+
+        /// Generates an output value and its partial derivatives.
+        ///
+        /// @param x The @a x coordinate of the input value.
+        /// @param y The @a y coordinate of the input value.
+        /// @param z The @a z coordinate of the input value.
+        /// @param dx Receives the partial derivative with respect to @a x.
+        /// @param dy Receives the partial derivative with respect to @a y.
+        /// @param dz Receives the partial derivative with respect to @a z.
+        ///
+        /// @returns The output value, which is identical to the value
+        /// returned by the GetValue() method.
+        ///
+        /// The derivatives are calculated analytically in each octave and
+        /// are carried through the octave loop, so they cost far less than
+        /// estimating them from six additional output values.  They can be
+        /// used to generate surface normals or slopes directly.
+        double GetValueAndGradient (double x, double y, double z, double& dx,
+          double& dy, double& dz) const;
+
+        virtual void GetValues (int count, const double* x, const double* y,
+          const double* z, double* values) const;
+
+        virtual void GetValues (int count, const float* x, const float* y,
+          const float* z, float* values) const;
+
+        /// Determines if the amplitudes of the octaves are normalized.
+        ///
+        /// @returns
+        /// - @a true if the amplitudes of the octaves are normalized.
+        /// - @a false if not.
+        ///
+        /// See EnableNormalization() for details.
+        bool IsNormalizationEnabled () const
+        {
+          return m_enableNormalization;
+        }
+
         /// Sets the frequency of the first octave.
         ///
         /// @param frequency The frequency of the first octave.
         void SetFrequency (double frequency)
         {
           m_frequency = frequency;
+          CalcOctaveTable ();
         }
 
         /// Sets the lacunarity of the Perlin noise.
@@ -266,6 +383,7 @@ namespace noise
         void SetLacunarity (double lacunarity)
         {
           m_lacunarity = lacunarity;
+          CalcOctaveTable ();
         }
 
         /// Sets the quality of the Perlin noise.
@@ -277,6 +395,8 @@ namespace noise
         void SetNoiseQuality (noise::NoiseQuality noiseQuality)
         {
           m_noiseQuality = noiseQuality;
+          m_pNoiseFunctions = &noise::GetGradientCoherentNoiseFunctions (
+            noiseQuality);
         }
 
         /// Sets the number of octaves that generate the Perlin noise.
@@ -301,6 +421,26 @@ namespace noise
             throw noise::ExceptionInvalidParam ();
           }
           m_octaveCount = octaveCount;
+          CalcOctaveTable ();
+        }
+
+        /// Sets the permutation table that hashes the lattice points of the
+        /// Perlin noise.
+        ///
+        /// @param pTable A pointer to the permutation table, or NULL to use
+        /// the default lattice hash.
+        ///
+        /// The permutation table replaces the arithmetic lattice hash of
+        /// the gradient-coherent-noise functions; see
+        /// noise::PermutationTable.  Each octave still uses its own seed.
+        ///
+        /// This noise module does not copy the permutation table, so the
+        /// table must exist as long as this noise module uses it.
+        ///
+        /// The GetValue4D() method always uses the default lattice hash.
+        void SetPermutationTable (const noise::PermutationTable* pTable)
+        {
+          m_pPermutationTable = pTable;
         }
 
         /// Sets the persistence value of the Perlin noise.
@@ -314,6 +454,36 @@ namespace noise
         void SetPersistence (double persistence)
         {
           m_persistence = persistence;
+          CalcOctaveTable ();
+        }
+
+        /// Sets the spacing between the input values at which the
+        /// application samples this noise module.
+        ///
+        /// @param sampleSpacing The sample spacing.
+        ///
+        /// @pre The sample spacing is not negative.
+        ///
+        /// @throw noise::ExceptionInvalidParam An invalid parameter was
+        /// specified; see the preconditions for more information.
+        ///
+        /// The octaves whose wavelength is shorter than twice the sample
+        /// spacing are not generated, and the octaves whose wavelength is
+        /// between two and four times the sample spacing fade out.  The
+        /// output values then differ from the output values for a sample
+        /// spacing of 0.0, which generates every octave.
+        ///
+        /// The sample spacing is measured in the units of the input
+        /// values; if a transformer module scales the input values before
+        /// they reach this noise module, scale the sample spacing in the
+        /// same way.
+        void SetSampleSpacing (double sampleSpacing)
+        {
+          if (sampleSpacing < 0.0) {
+            throw noise::ExceptionInvalidParam ();
+          }
+          m_sampleSpacing = sampleSpacing;
+          CalcOctaveTable ();
         }
 
         /// Sets the seed value used by the Perlin-noise function.
@@ -322,10 +492,21 @@ namespace noise
         void SetSeed (int seed)
         {
           m_seed = seed;
+          CalcOctaveTable ();
         }
 
       protected:
 
+        /// Calculates the frequency, amplitude, and seed value of each
+        /// octave that this noise module generates.
+        ///
+        /// This method is called when a parameter that affects the octaves
+        /// changes.
+        void CalcOctaveTable ();
+
+        /// Determines if the amplitudes of the octaves are normalized.
+        bool m_enableNormalization;
+
         /// Frequency of the first octave.
         double m_frequency;
 
@@ -335,15 +516,47 @@ namespace noise
         /// Quality of the Perlin noise.
         noise::NoiseQuality m_noiseQuality;
 
+        /// Gradient-coherent-noise functions specialized for the noise
+        /// quality.
+        const noise::GradientCoherentNoiseFunctions* m_pNoiseFunctions;
+
+        /// Amplitude of each generated octave.
+        double m_octaveAmplitudes[PERLIN_MAX_OCTAVE];
+
         /// Total number of octaves that generate the Perlin noise.
         int m_octaveCount;
 
+        /// Frequency of each generated octave.
+        double m_octaveFrequencies[PERLIN_MAX_OCTAVE];
+
+        /// Seed value of each generated octave.
+        int m_octaveSeeds[PERLIN_MAX_OCTAVE];
+
+        /// Permutation table that hashes the lattice points, or NULL to use
+        /// the default lattice hash.
+        const noise::PermutationTable* m_pPermutationTable;
+
         /// Persistence of the Perlin noise.
         double m_persistence;
 
+        /// Spacing between the input values at which the application
+        /// samples the Perlin noise.
+        double m_sampleSpacing;
+
         /// Seed value used by the Perlin-noise function.
         int m_seed;
 
+        /// Number of octaves that the sample spacing lets this noise module
+        /// generate.
+        int m_weightedOctaveCount;
+
+      private:
+
+        /// Implements both versions of the GetValues() method.
+        template <class T>
+        void GetValuesImpl (int count, const T* x, const T* y, const T* z,
+          T* values) const;
+
     };
 
     /// @}
@@ -0,0 +1,1678 @@
+// program.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+#include <string.h>
+#include <typeinfo>
+#include "../boundsimpl.h"
+#include "../interp.h"
+#include "../misc.h"
+#include "../threadimpl.h"
+#include "module.h"
+#include "program.h"
+
+using namespace noise;
+using namespace noise::module;
+
+// Operations performed by the instructions of a program.  Unless noted
+// otherwise, an operation reads the value registers in src[] and writes the
+// value register dest.
+enum Opcode
+{
+  OP_ABS,
+  OP_ADD,
+  OP_ADD_CONST,       // Adds the constant in params to src[0].
+  OP_AFFINE,          // Writes the coordinate register dest.
+  OP_BLEND,
+  OP_BRANCH,          // Starts the instructions of source module src[0] of
+                      // a selector: copies the input values that need it
+                      // from the coordinate register coords into the
+                      // coordinate register dest, or jumps to target if
+                      // there are none.
+  OP_CALL,            // Calls pModule at the coordinate register coords.
+  OP_CLAMP,
+  OP_CONST,
+  OP_CURVE,
+  OP_DISPLACE,        // Writes the coordinate register dest.
+  OP_END_BRANCH,      // Ends the instructions of a source module of a
+                      // selector.
+  OP_EXPONENT,
+  OP_GATHER,          // Copies the values that source module src[1] of a
+                      // selector needs from the value register src[0].
+  OP_INVERT,
+  OP_MAX,
+  OP_MIN,
+  OP_MULTIPLY,
+  OP_MULTIPLY_CONST,  // Multiplies src[0] by the constant in params.
+  OP_POWER,
+  OP_ROTATE_POINT,    // Writes the coordinate register dest.
+  OP_SCALE_BIAS,
+  OP_SCALE_POINT,     // Writes the coordinate register dest.
+  OP_SELECT,
+  OP_SELECT_TEST,     // Writes the condition register.
+  OP_TERRACE,
+  OP_TRANSLATE_POINT, // Writes the coordinate register dest.
+  OP_TURBULENCE       // Writes the coordinate register dest.
+};
+
+struct Program::Instruction
+{
+  // The operation (one of the Opcode values.)
+  int opcode;
+
+  // The register that receives the result.
+  int dest;
+
+  // The value registers that are read.
+  int src[4];
+
+  // The coordinate register that holds the input values.
+  int coords;
+
+  // The condition register of a selector.
+  int condition;
+
+  // The index of the instruction to jump to.
+  int target;
+
+  // The noise module that is called or whose tables are used.
+  const Module* pModule;
+
+  // Parameters copied from the compiled noise module.  A constant is
+  // stored as its value in double precision followed by its value in
+  // single precision.
+  double params[12];
+};
+
+// Grows an array, if necessary, so that it can hold one more element.
+template <class T>
+static void GrowArray (T*& pArray, int count, int& capacity)
+{
+  if (count < capacity) {
+    return;
+  }
+  int newCapacity = GetMax (16, capacity * 2);
+  T* pNewArray = new T[newCapacity];
+  for (int i = 0; i < count; i++) {
+    pNewArray[i] = pArray[i];
+  }
+  delete[] pArray;
+  pArray = pNewArray;
+  capacity = newCapacity;
+}
+
+// Determines if two generator modules have the same type and parameters,
+// and therefore output the same values.
+static bool IsSameGenerator (const Module& a, const Module& b)
+{
+  if (typeid (a) != typeid (b)) {
+    return false;
+  }
+  if (typeid (a) == typeid (Billow)) {
+    const Billow& billowA = (const Billow&)a;
+    const Billow& billowB = (const Billow&)b;
+    return billowA.GetFrequency     () == billowB.GetFrequency     ()
+        && billowA.GetLacunarity    () == billowB.GetLacunarity    ()
+        && billowA.GetNoiseQuality  () == billowB.GetNoiseQuality  ()
+        && billowA.GetOctaveCount   () == billowB.GetOctaveCount   ()
+        && billowA.GetPermutationTable () == billowB.GetPermutationTable ()
+        && billowA.GetPersistence   () == billowB.GetPersistence   ()
+        && billowA.GetSampleSpacing () == billowB.GetSampleSpacing ()
+        && billowA.GetSeed          () == billowB.GetSeed          ()
+        && billowA.IsNormalizationEnabled ()
+          == billowB.IsNormalizationEnabled ();
+  }
+  if (typeid (a) == typeid (Checkerboard)) {
+    return true;
+  }
+  if (typeid (a) == typeid (Cylinders)) {
+    return ((const Cylinders&)a).GetFrequency ()
+        == ((const Cylinders&)b).GetFrequency ();
+  }
+  if (typeid (a) == typeid (Perlin)) {
+    const Perlin& perlinA = (const Perlin&)a;
+    const Perlin& perlinB = (const Perlin&)b;
+    return perlinA.GetFrequency     () == perlinB.GetFrequency     ()
+        && perlinA.GetLacunarity    () == perlinB.GetLacunarity    ()
+        && perlinA.GetNoiseQuality  () == perlinB.GetNoiseQuality  ()
+        && perlinA.GetOctaveCount   () == perlinB.GetOctaveCount   ()
+        && perlinA.GetPermutationTable () == perlinB.GetPermutationTable ()
+        && perlinA.GetPersistence   () == perlinB.GetPersistence   ()
+        && perlinA.GetSampleSpacing () == perlinB.GetSampleSpacing ()
+        && perlinA.GetSeed          () == perlinB.GetSeed          ()
+        && perlinA.IsNormalizationEnabled ()
+          == perlinB.IsNormalizationEnabled ();
+  }
+  if (typeid (a) == typeid (RidgedMulti)) {
+    const RidgedMulti& ridgedA = (const RidgedMulti&)a;
+    const RidgedMulti& ridgedB = (const RidgedMulti&)b;
+    return ridgedA.GetFrequency     () == ridgedB.GetFrequency     ()
+        && ridgedA.GetLacunarity    () == ridgedB.GetLacunarity    ()
+        && ridgedA.GetNoiseQuality  () == ridgedB.GetNoiseQuality  ()
+        && ridgedA.GetOctaveCount   () == ridgedB.GetOctaveCount   ()
+        && ridgedA.GetPermutationTable () == ridgedB.GetPermutationTable ()
+        && ridgedA.GetSampleSpacing () == ridgedB.GetSampleSpacing ()
+        && ridgedA.GetSeed          () == ridgedB.GetSeed          ()
+        && ridgedA.IsNormalizationEnabled ()
+          == ridgedB.IsNormalizationEnabled ();
+  }
+  if (typeid (a) == typeid (Simplex)) {
+    const Simplex& simplexA = (const Simplex&)a;
+    const Simplex& simplexB = (const Simplex&)b;
+    return simplexA.GetFrequency     () == simplexB.GetFrequency     ()
+        && simplexA.GetLacunarity    () == simplexB.GetLacunarity    ()
+        && simplexA.GetOctaveCount   () == simplexB.GetOctaveCount   ()
+        && simplexA.GetPersistence   () == simplexB.GetPersistence   ()
+        && simplexA.GetSampleSpacing () == simplexB.GetSampleSpacing ()
+        && simplexA.GetSeed          () == simplexB.GetSeed          ();
+  }
+  if (typeid (a) == typeid (Spheres)) {
+    return ((const Spheres&)a).GetFrequency ()
+        == ((const Spheres&)b).GetFrequency ();
+  }
+  if (typeid (a) == typeid (Voronoi)) {
+    const Voronoi& voronoiA = (const Voronoi&)a;
+    const Voronoi& voronoiB = (const Voronoi&)b;
+    return voronoiA.GetDisplacement   () == voronoiB.GetDisplacement   ()
+        && voronoiA.GetDistanceType   () == voronoiB.GetDistanceType   ()
+        && voronoiA.GetFrequency      () == voronoiB.GetFrequency      ()
+        && voronoiA.GetSeed           () == voronoiB.GetSeed           ()
+        && voronoiA.IsDistanceEnabled () == voronoiB.IsDistanceEnabled ();
+  }
+  return false;
+}
+
+// Determines if the output value of a noise module only depends on its
+// input value through its source modules, so that the noise module is
+// compiled into an instruction.
+static bool IsCompiledType (const Module& module)
+{
+  const std::type_info& type = typeid (module);
+  return type == typeid (Abs)
+      || type == typeid (Add)
+      || type == typeid (Blend)
+      || type == typeid (Clamp)
+      || type == typeid (Curve)
+      || type == typeid (Displace)
+      || type == typeid (Exponent)
+      || type == typeid (Invert)
+      || type == typeid (Max)
+      || type == typeid (Min)
+      || type == typeid (Multiply)
+      || type == typeid (Power)
+      || type == typeid (RotatePoint)
+      || type == typeid (ScaleBias)
+      || type == typeid (ScalePoint)
+      || type == typeid (Select)
+      || type == typeid (Terrace)
+      || type == typeid (TransformPoint)
+      || type == typeid (TranslatePoint)
+      || type == typeid (Turbulence);
+}
+
+// Determines if a noise module transforms the coordinates of the input
+// value by an affine transformation.
+static bool IsAffineType (const Module& module)
+{
+  const std::type_info& type = typeid (module);
+  return type == typeid (RotatePoint)
+      || type == typeid (ScalePoint)
+      || type == typeid (TransformPoint)
+      || type == typeid (TranslatePoint);
+}
+
+// Classifies a control value of a noise::module::Select noise module: 0 if
+// only the first source module is needed, 1 if only the second source
+// module is needed, or 2 if both are needed.
+template <class T>
+static int ClassifyControlValue (const Select& select, T controlValue)
+{
+  double lowerBound = select.GetLowerBound ();
+  double upperBound = select.GetUpperBound ();
+  double edgeFalloff = select.GetEdgeFalloff ();
+  if (controlValue < (lowerBound - edgeFalloff)
+    || controlValue > (upperBound + edgeFalloff)) {
+    return 0;
+  } else if (controlValue >= (lowerBound + edgeFalloff)
+    && controlValue < (upperBound - edgeFalloff)) {
+    return 1;
+  }
+  return 2;
+}
+
+// Returns the value of a constant in the precision of the output values.
+static inline double GetConstValue (const double* params, double)
+{
+  return params[0];
+}
+
+static inline float GetConstValue (const double* params, float)
+{
+  return (float)params[1];
+}
+
+struct Program::Compiler
+{
+  // A distinct noise module in the graph.  Generator modules with the same
+  // type and parameters are represented by the first one found.
+  struct Node
+  {
+    // The noise module that is compiled.
+    const Module* pModule;
+
+    // The number of times the noise module is reached from the root noise
+    // module.
+    int useCount;
+
+    // Determines if the output value of the noise module does not depend
+    // on the input value.
+    bool isConstant;
+  };
+
+  // The value register that holds the output values of a shared noise
+  // module at a coordinate register.
+  struct Result
+  {
+    const Module* pModule;
+    int coords;
+    int reg;
+  };
+
+  // The instructions emitted so far.
+  Instruction* pInstructions;
+  int instructionCount;
+  int instructionCapacity;
+
+  // The distinct noise modules in the graph.
+  Node* pNodes;
+  int nodeCount;
+  int nodeCapacity;
+
+  // The output values of the shared noise modules that can be reused by
+  // the instructions emitted next.  Each result holds a reference to its
+  // value register.
+  Result* pResults;
+  int resultCount;
+  int resultCapacity;
+
+  // The number of references to each value register; a register with no
+  // references is unused.  An instruction only writes a register that it
+  // holds the only reference to.
+  int* pValueRefs;
+  int valueCount;
+
+  // Describes the coordinate registers.  Coordinate register 0 holds the
+  // input values of the program and is always in use.
+  struct Coords
+  {
+    // Determines if the register is in use.
+    bool isInUse;
+
+    // The coordinate register that this register holds a subset of, or -1
+    // if it does not hold a subset of another register.  A subset is
+    // copied by an OP_BRANCH instruction.
+    int parent;
+
+    // The condition register and the source module index of the
+    // OP_BRANCH instruction that copies the subset.
+    int condition;
+    int sourceIndex;
+  };
+  Coords* pCoords;
+  int coordCount;
+
+  // The number of condition registers.
+  int conditionCount;
+
+  // Determines if chains of noise modules are fused into one instruction.
+  bool isFusionEnabled;
+
+  Compiler (bool enableFusion):
+    pInstructions (NULL),
+    instructionCount (0),
+    instructionCapacity (0),
+    pNodes (NULL),
+    nodeCount (0),
+    nodeCapacity (0),
+    pResults (NULL),
+    resultCount (0),
+    resultCapacity (0),
+    pValueRefs (NULL),
+    valueCount (0),
+    pCoords (NULL),
+    coordCount (0),
+    conditionCount (0),
+    isFusionEnabled (enableFusion)
+  {
+    NewCoords ();
+  }
+
+  ~Compiler ()
+  {
+    delete[] pInstructions;
+    delete[] pNodes;
+    delete[] pResults;
+    delete[] pValueRefs;
+    delete[] pCoords;
+  }
+
+  // Counts the number of times each noise module is reached from a root
+  // noise module, and determines which noise modules are constant.
+  void CountUses (const Module& module)
+  {
+    int nodeIndex = GetNodeIndex (module);
+    if (pNodes[nodeIndex].useCount++ > 0) {
+      return;
+    }
+    if (typeid (module) == typeid (Const)) {
+      pNodes[nodeIndex].isConstant = true;
+      return;
+    }
+
+    // Only the source modules of compiled noise modules are compiled.  A
+    // compiled noise module is constant if its source modules are; the
+    // output value of a transformer module only depends on its first
+    // source module.
+    if (!IsCompiledType (module)) {
+      return;
+    }
+    bool isConstant = true;
+    for (int i = 0; i < module.GetSourceModuleCount (); i++) {
+      const Module& sourceModule = module.GetSourceModule (i);
+      CountUses (sourceModule);
+      if (i == 0 || !IsTransformerType (module)) {
+        isConstant = isConstant && IsConstant (sourceModule);
+      }
+    }
+    pNodes[nodeIndex].isConstant = isConstant;
+  }
+
+  // Returns the index of the node that represents a noise module, adding
+  // the node if necessary.
+  int GetNodeIndex (const Module& module)
+  {
+    for (int i = 0; i < nodeCount; i++) {
+      if (pNodes[i].pModule == &module
+        || IsSameGenerator (*pNodes[i].pModule, module)) {
+        return i;
+      }
+    }
+    GrowArray (pNodes, nodeCount, nodeCapacity);
+    pNodes[nodeCount].pModule = &module;
+    pNodes[nodeCount].useCount = 0;
+    pNodes[nodeCount].isConstant = false;
+    return nodeCount++;
+  }
+
+  const Node& GetNode (const Module& module)
+  {
+    return pNodes[GetNodeIndex (module)];
+  }
+
+  // Determines if the output value of a noise module does not depend on
+  // the input value.
+  bool IsConstant (const Module& module)
+  {
+    return GetNode (module).isConstant;
+  }
+
+  // Determines if a noise module is a transformer module.
+  static bool IsTransformerType (const Module& module)
+  {
+    return IsAffineType (module)
+      || typeid (module) == typeid (Displace)
+      || typeid (module) == typeid (Turbulence);
+  }
+
+  // Compiles a noise module whose input values are in the coordinate
+  // register coords, and returns a reference to the value register that
+  // receives its output values.  A shared noise module is only compiled
+  // once per coordinate register.
+  int CompileModule (const Module& module, int coords)
+  {
+    const Node& node = GetNode (module);
+    const Module& nodeModule = *node.pModule;
+    if (node.isConstant) {
+      return CompileConstant (nodeModule);
+    }
+    if (node.useCount < 2) {
+      return CompileNode (nodeModule, coords);
+    }
+    int reg = FindResult (nodeModule, coords);
+    if (reg < 0) {
+      reg = CompileNode (nodeModule, coords);
+      AddResult (nodeModule, coords, reg);
+    }
+    pValueRefs[reg]++;
+    return reg;
+  }
+
+  // Records the value register that holds the output values of a shared
+  // noise module.  The result takes over a reference to the register.
+  void AddResult (const Module& module, int coords, int reg)
+  {
+    GrowArray (pResults, resultCount, resultCapacity);
+    pResults[resultCount].pModule = &module;
+    pResults[resultCount].coords = coords;
+    pResults[resultCount].reg = reg;
+    resultCount++;
+  }
+
+  // Returns the value register that holds the output values of a shared
+  // noise module at a coordinate register, or -1 if they have not been
+  // computed.  If the coordinate register holds a subset of another
+  // register at which the output values were computed, this method emits
+  // an instruction that copies the subset of the output values.
+  int FindResult (const Module& module, int coords)
+  {
+    for (int i = 0; i < resultCount; i++) {
+      if (pResults[i].pModule == &module && pResults[i].coords == coords) {
+        return pResults[i].reg;
+      }
+    }
+    const Coords& subset = pCoords[coords];
+    if (subset.parent < 0) {
+      return -1;
+    }
+    int parentReg = FindResult (module, subset.parent);
+    if (parentReg < 0) {
+      return -1;
+    }
+    int reg = NewValue ();
+    int i = Emit (OP_GATHER);
+    pInstructions[i].dest = reg;
+    pInstructions[i].src[0] = parentReg;
+    pInstructions[i].src[1] = subset.sourceIndex;
+    pInstructions[i].condition = subset.condition;
+    AddResult (module, coords, reg);
+    return reg;
+  }
+
+  // Compiles a noise module without looking for its output values.
+  int CompileNode (const Module& module, int coords);
+
+  // Compiles a noise module whose output value does not depend on the
+  // input value.
+  int CompileConstant (const Module& module)
+  {
+    int reg = NewValue ();
+    int i = Emit (OP_CONST);
+    pInstructions[i].dest = reg;
+    GetConstant (module, pInstructions[i].params);
+    return reg;
+  }
+
+  // Stores the output value of a noise module whose output value does not
+  // depend on the input value in the parameters of an instruction.  The
+  // noise module computes its output value in each precision, so that the
+  // program outputs the same values.
+  static void GetConstant (const Module& module, double* params)
+  {
+    double origin = 0.0;
+    float originFloat = 0.0f;
+    double value;
+    float valueFloat;
+    module.GetValues (1, &origin, &origin, &origin, &value);
+    module.GetValues (1, &originFloat, &originFloat, &originFloat,
+      &valueFloat);
+    params[0] = value;
+    params[1] = valueFloat;
+  }
+
+  // Compiles a chain of transformer modules that apply an affine
+  // transformation into one instruction that writes the coordinate register
+  // newCoords, and returns the last noise module in the chain.  The chain
+  // ends before a noise module whose output values are shared.
+  const Module& CompileAffineChain (const Module& module, int coords,
+    int newCoords);
+
+  // Forgets the results that were added after the specified number of
+  // results.  This is done when leaving a block of instructions that may
+  // be skipped, or when a coordinate register is about to be reused.
+  void DropResults (int count)
+  {
+    while (resultCount > count) {
+      ReleaseValue (pResults[--resultCount].reg);
+    }
+  }
+
+  // Appends an instruction and returns its index.
+  int Emit (int opcode)
+  {
+    GrowArray (pInstructions, instructionCount, instructionCapacity);
+    Instruction& instruction = pInstructions[instructionCount];
+    memset (&instruction, 0, sizeof (Instruction));
+    instruction.opcode = opcode;
+    return instructionCount++;
+  }
+
+  // Reserves an unused coordinate register.
+  int NewCoords ()
+  {
+    int reg = 0;
+    while (reg < coordCount && pCoords[reg].isInUse) {
+      reg++;
+    }
+    if (reg == coordCount) {
+      Coords* pNewCoords = new Coords[coordCount + 1];
+      for (int i = 0; i < coordCount; i++) {
+        pNewCoords[i] = pCoords[i];
+      }
+      delete[] pCoords;
+      pCoords = pNewCoords;
+      coordCount++;
+    }
+    pCoords[reg].isInUse = true;
+    pCoords[reg].parent = -1;
+    pCoords[reg].condition = 0;
+    pCoords[reg].sourceIndex = 0;
+    return reg;
+  }
+
+  // Reserves an unused value register and returns a reference to it.
+  int NewValue ()
+  {
+    for (int i = 0; i < valueCount; i++) {
+      if (pValueRefs[i] == 0) {
+        pValueRefs[i] = 1;
+        return i;
+      }
+    }
+    int* pNewRefs = new int[valueCount + 1];
+    for (int i = 0; i < valueCount; i++) {
+      pNewRefs[i] = pValueRefs[i];
+    }
+    pNewRefs[valueCount] = 1;
+    delete[] pValueRefs;
+    pValueRefs = pNewRefs;
+    return valueCount++;
+  }
+
+  void FreeCoords (int reg)
+  {
+    pCoords[reg].isInUse = false;
+  }
+
+  void ReleaseValue (int reg)
+  {
+    pValueRefs[reg]--;
+  }
+
+  // Exchanges a reference to a value register for a register that an
+  // instruction may write to: the same register if the reference is the
+  // only one, otherwise a new register.
+  int MakeWritable (int reg)
+  {
+    if (pValueRefs[reg] == 1) {
+      return reg;
+    }
+    ReleaseValue (reg);
+    return NewValue ();
+  }
+
+  // Compiles a noise module whose output value is a function of the output
+  // value of its only source module.
+  int CompileUnary (const Module& module, int coords, int opcode)
+  {
+    int reg = CompileModule (module.GetSourceModule (0), coords);
+    int dest = MakeWritable (reg);
+    int i = Emit (opcode);
+    pInstructions[i].dest = dest;
+    pInstructions[i].src[0] = reg;
+    pInstructions[i].pModule = &module;
+    return dest;
+  }
+
+  // Compiles a noise module whose output value is a function of the output
+  // values of its first two source modules.
+  int CompileBinary (const Module& module, int coords, int opcode)
+  {
+    // A constant operand of an addition or multiplication is stored in
+    // the instruction.  Both operations are commutative, so the output
+    // values do not change if the constant is the first operand.
+    if (opcode == OP_ADD || opcode == OP_MULTIPLY) {
+      for (int j = 0; j < 2; j++) {
+        const Module& constModule = module.GetSourceModule (j);
+        if (IsConstant (constModule)) {
+          int reg = CompileModule (module.GetSourceModule (1 - j), coords);
+          int dest = MakeWritable (reg);
+          int i = Emit (opcode == OP_ADD? OP_ADD_CONST: OP_MULTIPLY_CONST);
+          pInstructions[i].dest = dest;
+          pInstructions[i].src[0] = reg;
+          GetConstant (constModule, pInstructions[i].params);
+          return dest;
+        }
+      }
+    }
+    int reg0 = CompileModule (module.GetSourceModule (0), coords);
+    int reg1 = CompileModule (module.GetSourceModule (1), coords);
+    int dest = MakeWritable (reg0);
+    int i = Emit (opcode);
+    pInstructions[i].dest = dest;
+    pInstructions[i].src[0] = reg0;
+    pInstructions[i].src[1] = reg1;
+    ReleaseValue (reg1);
+    return dest;
+  }
+
+  // Compiles the source module of a transformer module at the coordinate
+  // register written by the most recently emitted instruction.
+  int CompileTransformed (const Module& module, int newCoords)
+  {
+    int resultMark = resultCount;
+    int reg = CompileModule (module.GetSourceModule (0), newCoords);
+    DropResults (resultMark);
+    FreeCoords (newCoords);
+    return reg;
+  }
+
+  // Sets the parameters of the most recently emitted instruction.
+  void SetParams (double p0, double p1 = 0.0, double p2 = 0.0)
+  {
+    Instruction& instruction = pInstructions[instructionCount - 1];
+    instruction.params[0] = p0;
+    instruction.params[1] = p1;
+    instruction.params[2] = p2;
+  }
+};
+
+const Module& Program::Compiler::CompileAffineChain (const Module& module,
+  int coords, int newCoords)
+{
+  TransformPoint chain;
+  chain.AppendTransform (module);
+  const Module* pModule = &module;
+  for (;;) {
+    const Module& sourceModule = pModule->GetSourceModule (0);
+    if (!IsAffineType (sourceModule) || GetNode (sourceModule).useCount > 1) {
+      break;
+    }
+    chain.AppendTransform (sourceModule);
+    pModule = &sourceModule;
+  }
+
+  int i = Emit (OP_AFFINE);
+  pInstructions[i].dest = newCoords;
+  pInstructions[i].coords = coords;
+  const double* pMatrix = chain.GetMatrix ();
+  for (int j = 0; j < 12; j++) {
+    pInstructions[i].params[j] = pMatrix[j];
+  }
+  return *pModule;
+}
+
+int Program::Compiler::CompileNode (const Module& module, int coords)
+{
+  const std::type_info& type = typeid (module);
+
+  // Modifier modules.
+  if (type == typeid (Abs)) {
+    return CompileUnary (module, coords, OP_ABS);
+  }
+  if (type == typeid (Clamp)) {
+    const Clamp& clamp = (const Clamp&)module;
+    int reg = CompileUnary (module, coords, OP_CLAMP);
+    SetParams (clamp.GetLowerBound (), clamp.GetUpperBound ());
+    return reg;
+  }
+  if (type == typeid (Curve)) {
+    return CompileUnary (module, coords, OP_CURVE);
+  }
+  if (type == typeid (Exponent)) {
+    int reg = CompileUnary (module, coords, OP_EXPONENT);
+    SetParams (((const Exponent&)module).GetExponent ());
+    return reg;
+  }
+  if (type == typeid (Invert)) {
+    // Negation is exact, so a pair of noise::module::Invert noise modules
+    // is skipped.
+    const Module& sourceModule = module.GetSourceModule (0);
+    if (typeid (sourceModule) == typeid (Invert)) {
+      return CompileModule (sourceModule.GetSourceModule (0), coords);
+    }
+    return CompileUnary (module, coords, OP_INVERT);
+  }
+  if (type == typeid (ScaleBias)) {
+    const ScaleBias& scaleBias = (const ScaleBias&)module;
+    double scale = scaleBias.GetScale ();
+    double bias = scaleBias.GetBias ();
+    const Module* pSourceModule = &module.GetSourceModule (0);
+    if (isFusionEnabled) {
+      // Fold the chain of noise::module::ScaleBias noise modules into
+      // this one.  The inner noise module is applied first.
+      while (typeid (*pSourceModule) == typeid (ScaleBias)
+        && GetNode (*pSourceModule).useCount == 1) {
+        const ScaleBias& innerScaleBias = (const ScaleBias&)*pSourceModule;
+        bias = innerScaleBias.GetBias () * scale + bias;
+        scale = innerScaleBias.GetScale () * scale;
+        pSourceModule = &innerScaleBias.GetSourceModule (0);
+      }
+    }
+    int reg = CompileModule (*pSourceModule, coords);
+    int dest = MakeWritable (reg);
+    int i = Emit (OP_SCALE_BIAS);
+    pInstructions[i].dest = dest;
+    pInstructions[i].src[0] = reg;
+    SetParams (scale, bias);
+    return dest;
+  }
+  if (type == typeid (Terrace)) {
+    return CompileUnary (module, coords, OP_TERRACE);
+  }
+
+  // Combiner modules.
+  if (type == typeid (Add)) {
+    return CompileBinary (module, coords, OP_ADD);
+  }
+  if (type == typeid (Max)) {
+    return CompileBinary (module, coords, OP_MAX);
+  }
+  if (type == typeid (Min)) {
+    return CompileBinary (module, coords, OP_MIN);
+  }
+  if (type == typeid (Multiply)) {
+    return CompileBinary (module, coords, OP_MULTIPLY);
+  }
+  if (type == typeid (Power)) {
+    return CompileBinary (module, coords, OP_POWER);
+  }
+
+  // Selector modules.
+  if (type == typeid (Blend)) {
+    int reg0 = CompileModule (module.GetSourceModule (0), coords);
+    int reg1 = CompileModule (module.GetSourceModule (1), coords);
+    int alpha = CompileModule (module.GetSourceModule (2), coords);
+    int dest = MakeWritable (reg0);
+    int i = Emit (OP_BLEND);
+    pInstructions[i].dest = dest;
+    pInstructions[i].src[0] = reg0;
+    pInstructions[i].src[1] = reg1;
+    pInstructions[i].src[2] = alpha;
+    ReleaseValue (reg1);
+    ReleaseValue (alpha);
+    return dest;
+  }
+  if (type == typeid (Select)) {
+    const Select& select = (const Select&)module;
+
+    // If the control value is constant and selects one source module in
+    // both precisions, the selector module outputs the values of that
+    // source module.
+    const Module& controlModule = select.GetControlModule ();
+    if (IsConstant (controlModule)) {
+      double controlValue[12];
+      GetConstant (controlModule, controlValue);
+      int sourceIndex = ClassifyControlValue (select, controlValue[0]);
+      if (sourceIndex != 2 && sourceIndex
+        == ClassifyControlValue (select, (float)controlValue[1])) {
+        return CompileModule (module.GetSourceModule (sourceIndex), coords);
+      }
+    }
+
+    // The control values are tested first, so that each source module is
+    // only evaluated at the input values that need it.  The instructions
+    // of a source module run on a copy of those input values, and are
+    // skipped if there are none; their output values must not be reused
+    // outside of them.
+    int control = CompileModule (controlModule, coords);
+    int condition = conditionCount++;
+    int test = Emit (OP_SELECT_TEST);
+    pInstructions[test].src[0] = control;
+    pInstructions[test].condition = condition;
+    SetParams (select.GetLowerBound (), select.GetUpperBound (),
+      select.GetEdgeFalloff ());
+
+    int reg[2];
+    for (int sourceIndex = 0; sourceIndex < 2; sourceIndex++) {
+      int subsetCoords = NewCoords ();
+      pCoords[subsetCoords].parent = coords;
+      pCoords[subsetCoords].condition = condition;
+      pCoords[subsetCoords].sourceIndex = sourceIndex;
+      int branch = Emit (OP_BRANCH);
+      pInstructions[branch].dest = subsetCoords;
+      pInstructions[branch].coords = coords;
+      pInstructions[branch].src[0] = sourceIndex;
+      pInstructions[branch].condition = condition;
+      int resultMark = resultCount;
+      reg[sourceIndex] = CompileModule (
+        module.GetSourceModule (sourceIndex), subsetCoords);
+      DropResults (resultMark);
+      FreeCoords (subsetCoords);
+      int end = Emit (OP_END_BRANCH);
+      pInstructions[end].condition = condition;
+      pInstructions[branch].target = instructionCount;
+    }
+
+    int dest = MakeWritable (control);
+    int i = Emit (OP_SELECT);
+    pInstructions[i].dest = dest;
+    pInstructions[i].src[0] = reg[0];
+    pInstructions[i].src[1] = reg[1];
+    pInstructions[i].src[2] = control;
+    pInstructions[i].condition = condition;
+    SetParams (select.GetLowerBound (), select.GetUpperBound (),
+      select.GetEdgeFalloff ());
+    ReleaseValue (reg[0]);
+    ReleaseValue (reg[1]);
+    return dest;
+  }
+
+  // Transformer modules.  The parameters are set before the source module
+  // is compiled, since compiling it emits more instructions.
+  if (isFusionEnabled && IsAffineType (module)) {
+    const Module& sourceModule = module.GetSourceModule (0);
+    if (IsAffineType (sourceModule) && GetNode (sourceModule).useCount == 1) {
+      int newCoords = NewCoords ();
+      const Module& lastModule = CompileAffineChain (module, coords,
+        newCoords);
+      return CompileTransformed (lastModule, newCoords);
+    }
+  }
+  if (type == typeid (Displace)) {
+    int src[3];
+    for (int j = 0; j < 3; j++) {
+      src[j] = CompileModule (module.GetSourceModule (j + 1), coords);
+    }
+    int newCoords = NewCoords ();
+    int i = Emit (OP_DISPLACE);
+    pInstructions[i].dest = newCoords;
+    pInstructions[i].coords = coords;
+    for (int j = 0; j < 3; j++) {
+      pInstructions[i].src[j] = src[j];
+      ReleaseValue (src[j]);
+    }
+    return CompileTransformed (module, newCoords);
+  }
+  if (type == typeid (RotatePoint)) {
+    const RotatePoint& rotatePoint = (const RotatePoint&)module;
+    int newCoords = NewCoords ();
+    int i = Emit (OP_ROTATE_POINT);
+    pInstructions[i].dest = newCoords;
+    pInstructions[i].coords = coords;
+    double* params = pInstructions[i].params;
+    params[0] = rotatePoint.m_x1Matrix;
+    params[1] = rotatePoint.m_y1Matrix;
+    params[2] = rotatePoint.m_z1Matrix;
+    params[3] = rotatePoint.m_x2Matrix;
+    params[4] = rotatePoint.m_y2Matrix;
+    params[5] = rotatePoint.m_z2Matrix;
+    params[6] = rotatePoint.m_x3Matrix;
+    params[7] = rotatePoint.m_y3Matrix;
+    params[8] = rotatePoint.m_z3Matrix;
+    return CompileTransformed (module, newCoords);
+  }
+  if (type == typeid (ScalePoint)) {
+    const ScalePoint& scalePoint = (const ScalePoint&)module;
+    int newCoords = NewCoords ();
+    int i = Emit (OP_SCALE_POINT);
+    pInstructions[i].dest = newCoords;
+    pInstructions[i].coords = coords;
+    SetParams (scalePoint.GetXScale (), scalePoint.GetYScale (),
+      scalePoint.GetZScale ());
+    return CompileTransformed (module, newCoords);
+  }
+  if (type == typeid (TransformPoint)) {
+    const double* pMatrix = ((const TransformPoint&)module).GetMatrix ();
+    int newCoords = NewCoords ();
+    int i = Emit (OP_AFFINE);
+    pInstructions[i].dest = newCoords;
+    pInstructions[i].coords = coords;
+    for (int j = 0; j < 12; j++) {
+      pInstructions[i].params[j] = pMatrix[j];
+    }
+    return CompileTransformed (module, newCoords);
+  }
+  if (type == typeid (TranslatePoint)) {
+    const TranslatePoint& translatePoint = (const TranslatePoint&)module;
+    int newCoords = NewCoords ();
+    int i = Emit (OP_TRANSLATE_POINT);
+    pInstructions[i].dest = newCoords;
+    pInstructions[i].coords = coords;
+    SetParams (translatePoint.GetXTranslation (),
+      translatePoint.GetYTranslation (),
+      translatePoint.GetZTranslation ());
+    return CompileTransformed (module, newCoords);
+  }
+  if (type == typeid (Turbulence)) {
+    int newCoords = NewCoords ();
+    int i = Emit (OP_TURBULENCE);
+    pInstructions[i].dest = newCoords;
+    pInstructions[i].coords = coords;
+    pInstructions[i].pModule = &module;
+    return CompileTransformed (module, newCoords);
+  }
+
+  // Generator modules and noise modules that are not compiled.
+  int reg = NewValue ();
+  int i = Emit (OP_CALL);
+  pInstructions[i].dest = reg;
+  pInstructions[i].coords = coords;
+  pInstructions[i].pModule = &module;
+  return reg;
+}
+
+// An array of registers of one precision.
+template <class T>
+struct RegisterArray
+{
+  T* pData;
+  int size;
+
+  RegisterArray ():
+    pData (NULL),
+    size (0)
+  {
+  }
+
+  ~RegisterArray ()
+  {
+    delete[] pData;
+  }
+
+  // Returns an array of at least the specified size.
+  T* Reserve (int minSize)
+  {
+    if (size < minSize) {
+      delete[] pData;
+      pData = NULL;
+      pData = new T[minSize];
+      size = minSize;
+    }
+    return pData;
+  }
+};
+
+// A condition register, which describes the input values in a span that
+// need each source module of a selector.
+struct ConditionRegister
+{
+  // The number of input values that need each source module.
+  int count[2];
+
+  // The indices of the input values that need each source module, in
+  // increasing order.
+  int index[2][MODULE_BATCH_SIZE];
+
+  // The number of input values in the span that contains the selector.
+  int spanCount;
+};
+
+struct Program::ThreadState
+{
+  // The value registers followed by the coordinate registers.
+  RegisterArray<double> doubleRegisters;
+  RegisterArray<float> floatRegisters;
+
+  // The condition registers.
+  RegisterArray<ConditionRegister> conditions;
+
+  RegisterArray<double>& GetRegisters (const double*)
+  {
+    return doubleRegisters;
+  }
+
+  RegisterArray<float>& GetRegisters (const float*)
+  {
+    return floatRegisters;
+  }
+};
+
+struct Program::ThreadStorage: public PerThread<ThreadState>
+{
+};
+
+Program::Program ():
+  Module (GetSourceModuleCount ()),
+  m_conditionCount (0),
+  m_coordCount (0),
+  m_instructionCount (0),
+  m_isFusionEnabled (false),
+  m_pInstructions (NULL),
+  m_resultRegister (-1),
+  m_valueCount (0)
+{
+  m_pStorage = new ThreadStorage;
+}
+
+Program::~Program ()
+{
+  delete[] m_pInstructions;
+  delete m_pStorage;
+}
+
+void Program::Compile (const Module& root)
+{
+  Compiler compiler (m_isFusionEnabled);
+  compiler.CountUses (root);
+  int resultRegister = compiler.CompileModule (root, 0);
+
+  delete[] m_pInstructions;
+  m_pInstructions = compiler.pInstructions;
+  compiler.pInstructions = NULL;
+  m_instructionCount = compiler.instructionCount;
+  m_conditionCount = compiler.conditionCount;
+  m_coordCount = compiler.coordCount;
+  m_valueCount = compiler.valueCount;
+  m_resultRegister = resultRegister;
+}
+
+void Program::GetBounds (double lowerX, double lowerY, double lowerZ,
+  double upperX, double upperY, double upperZ, double& lowerBound,
+  double& upperBound) const
+{
+  if (m_resultRegister < 0) {
+    lowerBound = 0.0;
+    upperBound = 0.0;
+    return;
+  }
+
+  // The instructions run over ranges instead of values: a value register
+  // holds the bounds of its output values, and a coordinate register holds
+  // a box.  Each calculation matches the GetBounds() method of the
+  // corresponding noise module.  As in the Run() method, the instructions
+  // of a source module of a selector are skipped if the range of control
+  // values does not need that source module.  A coordinate register also
+  // records whether its coordinates may be NaN or infinite, as with a
+  // noise::module::Displace noise module whose displacements are unbounded.
+  double* pLower = new double[2 * (m_valueCount + 3 * m_coordCount)];
+  double* pUpper = pLower + m_valueCount;
+  double* pCoordLower = pUpper + m_valueCount;
+  double* pCoordUpper = pCoordLower + 3 * m_coordCount;
+  int* pSourceIndices = new int[m_conditionCount];
+  bool* pCoordNaN = new bool[m_coordCount];
+  pCoordNaN[0] = false;
+  pCoordLower[0] = lowerX;
+  pCoordLower[1] = lowerY;
+  pCoordLower[2] = lowerZ;
+  pCoordUpper[0] = upperX;
+  pCoordUpper[1] = upperY;
+  pCoordUpper[2] = upperZ;
+
+  for (int pc = 0; pc < m_instructionCount; pc++) {
+    const Instruction& instruction = m_pInstructions[pc];
+    const double* params = instruction.params;
+    int d = instruction.dest;
+    int s0 = instruction.src[0];
+    int s1 = instruction.src[1];
+    int s2 = instruction.src[2];
+    const double* cl = pCoordLower + 3 * instruction.coords;
+    const double* cu = pCoordUpper + 3 * instruction.coords;
+    double* dl = pCoordLower + 3 * instruction.dest;
+    double* du = pCoordUpper + 3 * instruction.dest;
+    bool isCoordNaN = pCoordNaN[instruction.coords];
+
+    switch (instruction.opcode) {
+      case OP_ABS:
+        AbsBounds (pLower[s0], pUpper[s0], pLower[d], pUpper[d]);
+        break;
+      case OP_ADD:
+        pLower[d] = pLower[s0] + pLower[s1];
+        pUpper[d] = pUpper[s0] + pUpper[s1];
+        break;
+      case OP_ADD_CONST: {
+        double lower, upper;
+        ConstBounds (params[0], lower, upper);
+        pLower[d] = pLower[s0] + lower;
+        pUpper[d] = pUpper[s0] + upper;
+        break;
+      }
+      case OP_AFFINE:
+        TransformBox (params, cl, cu, dl, du);
+        pCoordNaN[instruction.dest] = isCoordNaN;
+        break;
+      case OP_BLEND:
+        LerpBounds (pLower[s0], pUpper[s0], pLower[s1], pUpper[s1],
+          (pLower[s2] + 1.0) / 2.0, (pUpper[s2] + 1.0) / 2.0, pLower[d],
+          pUpper[d]);
+        break;
+      case OP_BRANCH: {
+        int sourceIndex = pSourceIndices[instruction.condition];
+        if (sourceIndex != 2 && sourceIndex != s0) {
+          pc = instruction.target - 1;
+          break;
+        }
+        for (int i = 0; i < 3; i++) {
+          dl[i] = cl[i];
+          du[i] = cu[i];
+        }
+        pCoordNaN[instruction.dest] = isCoordNaN;
+        break;
+      }
+      case OP_CALL:
+        // A generator module outputs NaN for NaN or infinite coordinates,
+        // which the modules within a called module may map onto any value.
+        if (isCoordNaN) {
+          pLower[d] = -HUGE_VAL;
+          pUpper[d] = HUGE_VAL;
+          break;
+        }
+        instruction.pModule->GetBounds (cl[0], cl[1], cl[2], cu[0], cu[1],
+          cu[2], pLower[d], pUpper[d]);
+        break;
+      case OP_CLAMP:
+        ClampBounds (pLower[s0], pUpper[s0], params[0], params[1], pLower[d],
+          pUpper[d]);
+        break;
+      case OP_CONST:
+        ConstBounds (params[0], pLower[d], pUpper[d]);
+        break;
+      case OP_CURVE:
+        ((const Curve*)instruction.pModule)->MapBounds (pLower[s0],
+          pUpper[s0], pLower[d], pUpper[d]);
+        break;
+      case OP_DISPLACE:
+        for (int i = 0; i < 3; i++) {
+          double lower = pLower[instruction.src[i]];
+          double upper = pUpper[instruction.src[i]];
+          dl[i] = cl[i] + lower;
+          du[i] = cu[i] + upper;
+          isCoordNaN = isCoordNaN || MayBeNaN (lower, upper);
+        }
+        pCoordNaN[instruction.dest] = isCoordNaN;
+        break;
+      case OP_END_BRANCH:
+        break;
+      case OP_EXPONENT:
+        ExponentBounds (pLower[s0], pUpper[s0], params[0], pLower[d],
+          pUpper[d]);
+        break;
+      case OP_GATHER:
+        pLower[d] = pLower[s0];
+        pUpper[d] = pUpper[s0];
+        break;
+      case OP_INVERT: {
+        double lower = pLower[s0];
+        pLower[d] = -pUpper[s0];
+        pUpper[d] = -lower;
+        break;
+      }
+      case OP_MAX:
+        MaxBounds (pLower[s0], pUpper[s0], pLower[s1], pUpper[s1], pLower[d],
+          pUpper[d]);
+        break;
+      case OP_MIN:
+        MinBounds (pLower[s0], pUpper[s0], pLower[s1], pUpper[s1], pLower[d],
+          pUpper[d]);
+        break;
+      case OP_MULTIPLY:
+        MultiplyBounds (pLower[s0], pUpper[s0], pLower[s1], pUpper[s1],
+          pLower[d], pUpper[d]);
+        break;
+      case OP_MULTIPLY_CONST: {
+        double lower, upper;
+        ConstBounds (params[0], lower, upper);
+        MultiplyBounds (pLower[s0], pUpper[s0], lower, upper, pLower[d],
+          pUpper[d]);
+        break;
+      }
+      case OP_POWER:
+        PowBounds (pLower[s0], pUpper[s0], pLower[s1], pUpper[s1],
+          pLower[d], pUpper[d]);
+        break;
+      case OP_ROTATE_POINT: {
+        double matrix[12] = {
+          params[0], params[1], params[2], 0.0,
+          params[3], params[4], params[5], 0.0,
+          params[6], params[7], params[8], 0.0};
+        TransformBox (matrix, cl, cu, dl, du);
+        pCoordNaN[instruction.dest] = isCoordNaN;
+        break;
+      }
+      case OP_SCALE_BIAS:
+        MultiplyBounds (pLower[s0], pUpper[s0], params[0], params[0],
+          pLower[d], pUpper[d]);
+        pLower[d] += params[1];
+        pUpper[d] += params[1];
+        break;
+      case OP_SCALE_POINT:
+        for (int i = 0; i < 3; i++) {
+          MultiplyBounds (cl[i], cu[i], params[i], params[i], dl[i], du[i]);
+        }
+        pCoordNaN[instruction.dest] = isCoordNaN;
+        break;
+      case OP_SELECT: {
+        // The bounds of a source module that is not needed were not
+        // calculated.
+        int sourceIndex = pSourceIndices[instruction.condition];
+        if (sourceIndex == 0) {
+          pLower[d] = pLower[s0];
+          pUpper[d] = pUpper[s0];
+        } else if (sourceIndex == 1) {
+          pLower[d] = pLower[s1];
+          pUpper[d] = pUpper[s1];
+        } else {
+          LerpBounds (pLower[s0], pUpper[s0], pLower[s1], pUpper[s1], 0.0,
+            1.0, pLower[d], pUpper[d]);
+        }
+        break;
+      }
+      case OP_SELECT_TEST:
+        pSourceIndices[instruction.condition] = ClassifyControlBounds (
+          pLower[s0], pUpper[s0], params[0], params[1], params[2]);
+        break;
+      case OP_TERRACE:
+        ((const Terrace*)instruction.pModule)->MapBounds (pLower[s0],
+          pUpper[s0], pLower[d], pUpper[d]);
+        break;
+      case OP_TRANSLATE_POINT:
+        for (int i = 0; i < 3; i++) {
+          dl[i] = cl[i] + params[i];
+          du[i] = cu[i] + params[i];
+        }
+        pCoordNaN[instruction.dest] = isCoordNaN;
+        break;
+      case OP_TURBULENCE:
+        ((const Turbulence*)instruction.pModule)->GetDistortedBox (cl, cu, dl,
+          du);
+        pCoordNaN[instruction.dest] = isCoordNaN;
+        break;
+    }
+  }
+
+  lowerBound = pLower[m_resultRegister];
+  upperBound = pUpper[m_resultRegister];
+  delete[] pLower;
+  delete[] pSourceIndices;
+  delete[] pCoordNaN;
+}
+
+double Program::GetValue (double x, double y, double z) const
+{
+  double value;
+  Run (1, &x, &y, &z, &value, m_pStorage->Get ());
+  return value;
+}
+
+void Program::GetValues (int count, const double* x, const double* y,
+  const double* z, double* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+void Program::GetValues (int count, const float* x, const float* y,
+  const float* z, float* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+template <class T>
+void Program::GetValuesImpl (int count, const T* x, const T* y,
+  const T* z, T* values) const
+{
+  ThreadState& state = m_pStorage->Get ();
+  for (int offset = 0; offset < count; offset += MODULE_BATCH_SIZE) {
+    int n = GetMin (count - offset, MODULE_BATCH_SIZE);
+    Run (n, x + offset, y + offset, z + offset, values + offset, state);
+  }
+}
+
+template <class T>
+void Program::Run (int count, const T* x, const T* y, const T* z,
+  T* values, ThreadState& state) const
+{
+  if (m_resultRegister < 0) {
+    for (int i = 0; i < count; i++) {
+      values[i] = (T)0.0;
+    }
+    return;
+  }
+
+  // Value register r starts at element r * MODULE_BATCH_SIZE.  Coordinate
+  // register c starts after the value registers, with its x, y, and z
+  // arrays in that order; coordinate register 0 refers to the input
+  // values instead.
+  T* pRegisters = state.GetRegisters (x).Reserve (
+    (m_valueCount + 3 * m_coordCount) * MODULE_BATCH_SIZE);
+  T* pCoordRegisters = pRegisters + m_valueCount * MODULE_BATCH_SIZE;
+  ConditionRegister* pConditions = state.conditions.Reserve (
+    m_conditionCount);
+
+  for (int pc = 0; pc < m_instructionCount; pc++) {
+    const Instruction& instruction = m_pInstructions[pc];
+    const double* params = instruction.params;
+
+    // The registers used by most operations.
+    T* d  = pRegisters + instruction.dest   * MODULE_BATCH_SIZE;
+    T* s0 = pRegisters + instruction.src[0] * MODULE_BATCH_SIZE;
+    T* s1 = pRegisters + instruction.src[1] * MODULE_BATCH_SIZE;
+    T* s2 = pRegisters + instruction.src[2] * MODULE_BATCH_SIZE;
+    const T* cx = x;
+    const T* cy = y;
+    const T* cz = z;
+    if (instruction.coords != 0) {
+      cx = pCoordRegisters + 3 * instruction.coords * MODULE_BATCH_SIZE;
+      cy = cx + MODULE_BATCH_SIZE;
+      cz = cy + MODULE_BATCH_SIZE;
+    }
+    T* dx = pCoordRegisters + 3 * instruction.dest * MODULE_BATCH_SIZE;
+    T* dy = dx + MODULE_BATCH_SIZE;
+    T* dz = dy + MODULE_BATCH_SIZE;
+
+    // Each operation performs the same calculation, with the same types,
+    // as the GetValues() method of the corresponding noise module, so that
+    // the output values are identical.
+    switch (instruction.opcode) {
+      case OP_ABS:
+        for (int i = 0; i < count; i++) {
+          d[i] = fabs (s0[i]);
+        }
+        break;
+      case OP_ADD:
+        for (int i = 0; i < count; i++) {
+          d[i] = s0[i] + s1[i];
+        }
+        break;
+      case OP_ADD_CONST: {
+        T value = GetConstValue (params, (T)0.0);
+        for (int i = 0; i < count; i++) {
+          d[i] = s0[i] + value;
+        }
+        break;
+      }
+      case OP_AFFINE:
+        for (int i = 0; i < count; i++) {
+          T xi = cx[i];
+          T yi = cy[i];
+          T zi = cz[i];
+          dx[i] = (params[0] * xi) + (params[ 1] * yi) + (params[ 2] * zi)
+            + params[ 3];
+          dy[i] = (params[4] * xi) + (params[ 5] * yi) + (params[ 6] * zi)
+            + params[ 7];
+          dz[i] = (params[8] * xi) + (params[ 9] * yi) + (params[10] * zi)
+            + params[11];
+        }
+        break;
+      case OP_BLEND:
+        for (int i = 0; i < count; i++) {
+          d[i] = LinearInterp (s0[i], s1[i], (s2[i] + (T)1.0) / (T)2.0);
+        }
+        break;
+      case OP_BRANCH: {
+        // The instructions of the source module run on the input values
+        // that need it, so the span becomes shorter until the matching
+        // OP_END_BRANCH instruction.
+        ConditionRegister& condition = pConditions[instruction.condition];
+        int sourceIndex = instruction.src[0];
+        int subsetCount = condition.count[sourceIndex];
+        if (subsetCount == 0) {
+          pc = instruction.target - 1;
+          break;
+        }
+        const int* index = condition.index[sourceIndex];
+        for (int i = 0; i < subsetCount; i++) {
+          dx[i] = cx[index[i]];
+          dy[i] = cy[index[i]];
+          dz[i] = cz[index[i]];
+        }
+        condition.spanCount = count;
+        count = subsetCount;
+        break;
+      }
+      case OP_CALL:
+        instruction.pModule->GetValues (count, cx, cy, cz, d);
+        break;
+      case OP_CLAMP: {
+        T lowerBound = (T)params[0];
+        T upperBound = (T)params[1];
+        for (int i = 0; i < count; i++) {
+          if (s0[i] < lowerBound) {
+            d[i] = lowerBound;
+          } else if (s0[i] > upperBound) {
+            d[i] = upperBound;
+          } else {
+            d[i] = s0[i];
+          }
+        }
+        break;
+      }
+      case OP_CONST: {
+        T value = GetConstValue (params, (T)0.0);
+        for (int i = 0; i < count; i++) {
+          d[i] = value;
+        }
+        break;
+      }
+      case OP_CURVE: {
+        const Curve* pCurve = (const Curve*)instruction.pModule;
+        for (int i = 0; i < count; i++) {
+          d[i] = (T)pCurve->MapValue (s0[i]);
+        }
+        break;
+      }
+      case OP_DISPLACE:
+        for (int i = 0; i < count; i++) {
+          dx[i] = cx[i] + s0[i];
+          dy[i] = cy[i] + s1[i];
+          dz[i] = cz[i] + s2[i];
+        }
+        break;
+      case OP_END_BRANCH:
+        count = pConditions[instruction.condition].spanCount;
+        break;
+      case OP_EXPONENT: {
+        T exponent = (T)params[0];
+        for (int i = 0; i < count; i++) {
+          d[i] = (pow (fabs ((s0[i] + (T)1.0) / (T)2.0), exponent)
+            * (T)2.0 - (T)1.0);
+        }
+        break;
+      }
+      case OP_GATHER: {
+        const ConditionRegister& condition
+          = pConditions[instruction.condition];
+        int sourceIndex = instruction.src[1];
+        const int* index = condition.index[sourceIndex];
+        for (int i = 0; i < condition.count[sourceIndex]; i++) {
+          d[i] = s0[index[i]];
+        }
+        break;
+      }
+      case OP_INVERT:
+        for (int i = 0; i < count; i++) {
+          d[i] = -s0[i];
+        }
+        break;
+      case OP_MAX:
+        for (int i = 0; i < count; i++) {
+          d[i] = GetMax (s0[i], s1[i]);
+        }
+        break;
+      case OP_MIN:
+        for (int i = 0; i < count; i++) {
+          d[i] = GetMin (s0[i], s1[i]);
+        }
+        break;
+      case OP_MULTIPLY:
+        for (int i = 0; i < count; i++) {
+          d[i] = s0[i] * s1[i];
+        }
+        break;
+      case OP_MULTIPLY_CONST: {
+        T value = GetConstValue (params, (T)0.0);
+        for (int i = 0; i < count; i++) {
+          d[i] = s0[i] * value;
+        }
+        break;
+      }
+      case OP_POWER:
+        for (int i = 0; i < count; i++) {
+          d[i] = pow (s0[i], s1[i]);
+        }
+        break;
+      case OP_ROTATE_POINT:
+        for (int i = 0; i < count; i++) {
+          T xi = cx[i];
+          T yi = cy[i];
+          T zi = cz[i];
+          dx[i] = (params[0] * xi) + (params[1] * yi) + (params[2] * zi);
+          dy[i] = (params[3] * xi) + (params[4] * yi) + (params[5] * zi);
+          dz[i] = (params[6] * xi) + (params[7] * yi) + (params[8] * zi);
+        }
+        break;
+      case OP_SCALE_BIAS: {
+        T scale = (T)params[0];
+        T bias = (T)params[1];
+        for (int i = 0; i < count; i++) {
+          d[i] = s0[i] * scale + bias;
+        }
+        break;
+      }
+      case OP_SCALE_POINT:
+        for (int i = 0; i < count; i++) {
+          dx[i] = cx[i] * params[0];
+          dy[i] = cy[i] * params[1];
+          dz[i] = cz[i] * params[2];
+        }
+        break;
+      case OP_SELECT: {
+        // The output values of each source module are stored in the order
+        // of the input values that need it.
+        const ConditionRegister& condition
+          = pConditions[instruction.condition];
+        const int* index0 = condition.index[0];
+        const int* index1 = condition.index[1];
+        int count0 = condition.count[0];
+        int count1 = condition.count[1];
+        int i0 = 0;
+        int i1 = 0;
+        double lowerBound = params[0];
+        double upperBound = params[1];
+        double edgeFalloff = params[2];
+        for (int i = 0; i < count; i++) {
+          T v0 = (T)0.0;
+          T v1 = (T)0.0;
+          if (i0 < count0 && index0[i0] == i) {
+            v0 = s0[i0++];
+          }
+          if (i1 < count1 && index1[i1] == i) {
+            v1 = s1[i1++];
+          }
+          T c = s2[i];
+          if (edgeFalloff > 0.0) {
+            if (c < (lowerBound - edgeFalloff)) {
+              d[i] = v0;
+            } else if (c < (lowerBound + edgeFalloff)) {
+              T lowerCurve = (lowerBound - edgeFalloff);
+              T upperCurve = (lowerBound + edgeFalloff);
+              T alpha = SCurve3 (
+                (c - lowerCurve) / (upperCurve - lowerCurve));
+              d[i] = LinearInterp (v0, v1, alpha);
+            } else if (c < (upperBound - edgeFalloff)) {
+              d[i] = v1;
+            } else if (c < (upperBound + edgeFalloff)) {
+              T lowerCurve = (upperBound - edgeFalloff);
+              T upperCurve = (upperBound + edgeFalloff);
+              T alpha = SCurve3 (
+                (c - lowerCurve) / (upperCurve - lowerCurve));
+              d[i] = LinearInterp (v1, v0, alpha);
+            } else {
+              d[i] = v0;
+            }
+          } else {
+            if (c < lowerBound || c > upperBound) {
+              d[i] = v0;
+            } else {
+              d[i] = v1;
+            }
+          }
+        }
+        break;
+      }
+      case OP_SELECT_TEST: {
+        // Same classification as noise::module::Select.
+        ConditionRegister& condition = pConditions[instruction.condition];
+        int* index0 = condition.index[0];
+        int* index1 = condition.index[1];
+        int count0 = 0;
+        int count1 = 0;
+        double lowerBound = params[0];
+        double upperBound = params[1];
+        double edgeFalloff = params[2];
+        for (int i = 0; i < count; i++) {
+          if (s0[i] < (lowerBound - edgeFalloff)
+            || s0[i] > (upperBound + edgeFalloff)) {
+            index0[count0++] = i;
+          } else if (s0[i] >= (lowerBound + edgeFalloff)
+            && s0[i] < (upperBound - edgeFalloff)) {
+            index1[count1++] = i;
+          } else {
+            index0[count0++] = i;
+            index1[count1++] = i;
+          }
+        }
+        condition.count[0] = count0;
+        condition.count[1] = count1;
+        break;
+      }
+      case OP_TERRACE: {
+        const Terrace* pTerrace = (const Terrace*)instruction.pModule;
+        for (int i = 0; i < count; i++) {
+          d[i] = (T)pTerrace->MapValue (s0[i]);
+        }
+        break;
+      }
+      case OP_TRANSLATE_POINT:
+        for (int i = 0; i < count; i++) {
+          dx[i] = cx[i] + params[0];
+          dy[i] = cy[i] + params[1];
+          dz[i] = cz[i] + params[2];
+        }
+        break;
+      case OP_TURBULENCE: {
+        const Turbulence* pTurbulence
+          = (const Turbulence*)instruction.pModule;
+        T x0[MODULE_BATCH_SIZE];
+        T y0[MODULE_BATCH_SIZE];
+        T z0[MODULE_BATCH_SIZE];
+        T power = (T)pTurbulence->GetPower ();
+        for (int i = 0; i < count; i++) {
+          x0[i] = cx[i] + (T)(12414.0 / 65536.0);
+          y0[i] = cy[i] + (T)(65124.0 / 65536.0);
+          z0[i] = cz[i] + (T)(31337.0 / 65536.0);
+        }
+        pTurbulence->m_xDistortModule.GetValues (count, x0, y0, z0, dx);
+        for (int i = 0; i < count; i++) {
+          x0[i] = cx[i] + (T)(26519.0 / 65536.0);
+          y0[i] = cy[i] + (T)(18128.0 / 65536.0);
+          z0[i] = cz[i] + (T)(60493.0 / 65536.0);
+        }
+        pTurbulence->m_yDistortModule.GetValues (count, x0, y0, z0, dy);
+        for (int i = 0; i < count; i++) {
+          x0[i] = cx[i] + (T)(53820.0 / 65536.0);
+          y0[i] = cy[i] + (T)(11213.0 / 65536.0);
+          z0[i] = cz[i] + (T)(44845.0 / 65536.0);
+        }
+        pTurbulence->m_zDistortModule.GetValues (count, x0, y0, z0, dz);
+        for (int i = 0; i < count; i++) {
+          dx[i] = cx[i] + (dx[i] * power);
+          dy[i] = cy[i] + (dy[i] * power);
+          dz[i] = cz[i] + (dz[i] * power);
+        }
+        break;
+      }
+    }
+  }
+
+  const T* result = pRegisters + m_resultRegister * MODULE_BATCH_SIZE;
+  for (int i = 0; i < count; i++) {
+    values[i] = result[i];
+  }
+}
@@ -0,0 +1,271 @@
+// program.h
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+#ifndef NOISE_MODULE_PROGRAM_H
+#define NOISE_MODULE_PROGRAM_H
+
+#include "modulebase.h"
+
+namespace noise
+{
+
+  namespace module
+  {
+
+    /// @addtogroup libnoise
+    /// @{
+
+    /// @addtogroup modules
+    /// @{
+
+    /// @addtogroup miscmodules
+    /// @{
+
+    /// Noise module that evaluates a compiled copy of another noise
+    /// module.
+    ///
+    /// The Compile() method walks the noise modules reachable from a root
+    /// noise module through their source modules and translates them into
+    /// a flat list of instructions.  The GetValue() and GetValues() methods
+    /// run these instructions over spans of up to
+    /// noise::module::MODULE_BATCH_SIZE input values, keeping the
+    /// intermediate output values and transformed coordinates in arrays
+    /// (registers) that are reused as the program proceeds.  Compared to
+    /// calling the root noise module, a program makes one pass over the
+    /// instruction list per span instead of a chain of virtual calls per
+    /// noise module, and does not copy coordinates between the temporary
+    /// arrays of each noise module.
+    ///
+    /// The combiner, modifier, selector, and transformer modules in
+    /// libnoise are translated into instructions that perform their
+    /// calculations directly.  Generator modules, noise modules that are
+    /// not part of libnoise, other programs, and the caching noise modules
+    /// (noise::module::Cache, noise::module::HashCache, and
+    /// noise::module::TileCache) are called through their GetValues()
+    /// method; their source modules are not compiled.  A caching noise
+    /// module that is reached several times therefore still computes its
+    /// output values once per span.
+    ///
+    /// A noise module that is reached several times from the root noise
+    /// module (through the source modules of different noise modules) is
+    /// only evaluated once per input value.  Generator modules of the same
+    /// type with the same parameters and seed are treated as the same
+    /// noise module.
+    ///
+    /// Parts of the graph are simplified without changing the output
+    /// values:
+    /// - A noise module whose output value does not depend on the input
+    ///   value, such as a noise::module::Add noise module with two
+    ///   noise::module::Const source modules, is replaced by its output
+    ///   value.
+    /// - A constant operand of a noise::module::Add or
+    ///   noise::module::Multiply noise module is stored in the instruction.
+    /// - A noise::module::Invert noise module whose source module is also
+    ///   a noise::module::Invert noise module is skipped.
+    /// - A noise::module::Select noise module whose control value is
+    ///   constant and outside of the transitions is replaced by the source
+    ///   module it selects.
+    ///
+    /// Chains of noise modules that can only be merged by changing the
+    /// rounding of the output values are fused if fusion is enabled; see
+    /// the EnableFusion() method.
+    ///
+    /// As with a noise::module::Select noise module, each source module of
+    /// a compiled selector module is only evaluated at the input values
+    /// that need it.  Output values computed for a selector module's source
+    /// module are not shared with noise modules outside of that source
+    /// module, since they are not computed for every input value.
+    ///
+    /// Unless fusion is enabled, the output values of a program are
+    /// identical to the output values of the root noise module.
+    ///
+    /// A program copies the parameters of the compiled noise modules, such
+    /// as the bounds of a noise::module::Clamp noise module, and calls only
+    /// one of several equal generator modules.  If an application changes
+    /// a parameter or a source module of any noise module reached from the
+    /// root noise module, including the noise modules called through their
+    /// GetValues() method, it must call the Compile() method again; until
+    /// then, the program may keep using the old parameters.  The noise
+    /// modules called through their GetValues() method must exist for the
+    /// lifetime of the program.
+    ///
+    /// A program can be called from several threads at the same time.
+    ///
+    /// This noise module does not require any source modules.
+    class Program: public Module
+    {
+
+      public:
+
+        /// Constructor.
+        ///
+        /// An empty program outputs 0.0.
+        ///
+        /// @throw noise::ExceptionOutOfMemory
+        /// - The operating system could not provide storage for the
+        ///   registers of each thread.
+        Program ();
+
+        /// Destructor.
+        ~Program ();
+
+        /// Enables or disables the fusion of chains of noise modules.
+        ///
+        /// @param enable Specifies whether to fuse chains of noise modules.
+        ///
+        /// If fusion is enabled, the Compile() method merges a chain of
+        /// noise::module::ScaleBias noise modules into one instruction, and
+        /// a chain of noise::module::ScalePoint,
+        /// noise::module::TranslatePoint, noise::module::RotatePoint, and
+        /// noise::module::TransformPoint noise modules into one affine
+        /// transformation (see noise::module::TransformPoint.)  The output values
+        /// may then differ from the output values of the root noise module
+        /// by rounding errors.  A noise module whose output values are
+        /// shared with other noise modules is not merged.
+        ///
+        /// Fusion is disabled by default.  This setting takes effect the
+        /// next time the Compile() method is called.
+        void EnableFusion (bool enable = true)
+        {
+          m_isFusionEnabled = enable;
+        }
+
+        /// Compiles a noise module and its source modules into this
+        /// program.
+        ///
+        /// @param root The noise module to compile.
+        ///
+        /// @throw noise::ExceptionNoModule
+        /// - A noise module reachable from the root noise module is missing
+        ///   a source module.
+        ///
+        /// This method replaces the previous contents of this program.  It
+        /// must be called again after any noise module reached from the
+        /// root noise module is changed.  It must not be called while
+        /// another thread is calling this program.
+        void Compile (const Module& root);
+
+        virtual void GetBounds (double lowerX, double lowerY, double lowerZ,
+          double upperX, double upperY, double upperZ, double& lowerBound,
+          double& upperBound) const;
+
+        /// Returns the number of instructions in this program.
+        ///
+        /// @returns The number of instructions.
+        int GetInstructionCount () const
+        {
+          return m_instructionCount;
+        }
+
+        /// Determines if chains of noise modules are fused.
+        ///
+        /// @returns
+        /// - @a true if chains of noise modules are fused.
+        /// - @a false if chains of noise modules are not fused.
+        bool IsFusionEnabled () const
+        {
+          return m_isFusionEnabled;
+        }
+
+        virtual int GetSourceModuleCount () const
+        {
+          return 0;
+        }
+
+        virtual double GetValue (double x, double y, double z) const;
+
+        virtual void GetValues (int count, const double* x, const double* y,
+          const double* z, double* values) const;
+
+        virtual void GetValues (int count, const float* x, const float* y,
+          const float* z, float* values) const;
+
+      private:
+
+        /// Translates noise modules into instructions.
+        struct Compiler;
+
+        /// An instruction of a program.
+        struct Instruction;
+
+        /// The registers of one thread.
+        struct ThreadState;
+
+        /// The storage for the registers of each thread.
+        struct ThreadStorage;
+
+        /// Implements both versions of the GetValues() method.
+        template <class T>
+        void GetValuesImpl (int count, const T* x, const T* y, const T* z,
+          T* values) const;
+
+        /// Runs the instructions over a span of input values.
+        ///
+        /// @param count The number of input values, which does not exceed
+        /// noise::module::MODULE_BATCH_SIZE.
+        /// @param x The @a x coordinates of the input values.
+        /// @param y The @a y coordinates of the input values.
+        /// @param z The @a z coordinates of the input values.
+        /// @param values The array that receives the output values.
+        /// @param state The registers of the calling thread.
+        template <class T>
+        void Run (int count, const T* x, const T* y, const T* z, T* values,
+          ThreadState& state) const;
+
+        /// The number of condition registers.
+        int m_conditionCount;
+
+        /// The number of coordinate registers.
+        int m_coordCount;
+
+        /// The number of instructions in this program.
+        int m_instructionCount;
+
+        /// Determines if chains of noise modules are fused.
+        bool m_isFusionEnabled;
+
+        /// The instructions of this program.
+        Instruction* m_pInstructions;
+
+        /// The storage for the registers of each thread.
+        ThreadStorage* m_pStorage;
+
+        /// The value register that holds the output values of the
+        /// program, or -1 if the program is empty.
+        int m_resultRegister;
+
+        /// The number of value registers.
+        int m_valueCount;
+
+    };
+
+    /// @}
+
+    /// @}
+
+    /// @}
+
+  }
+
+}
+
+#endif
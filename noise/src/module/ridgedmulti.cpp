@@ -20,19 +20,47 @@
 // off every 'zig'.)
 //
 
+#include "../fractalimpl.h"
+#include "../misc.h"
 #include "ridgedmulti.h"
 
 using namespace noise::module;
 
 RidgedMulti::RidgedMulti ():
   Module (GetSourceModuleCount ()),
+  m_enableNormalization (false),
   m_frequency    (DEFAULT_RIDGED_FREQUENCY   ),
   m_lacunarity   (DEFAULT_RIDGED_LACUNARITY  ),
   m_noiseQuality (DEFAULT_RIDGED_QUALITY     ),
+  m_pNoiseFunctions (
+    &GetGradientCoherentNoiseFunctions (DEFAULT_RIDGED_QUALITY)),
   m_octaveCount  (DEFAULT_RIDGED_OCTAVE_COUNT),
+  m_pPermutationTable (NULL),
+  m_sampleSpacing (DEFAULT_RIDGED_SAMPLE_SPACING),
   m_seed         (DEFAULT_RIDGED_SEED)
 {
   CalcSpectralWeights ();
+  CalcOctaveTable ();
+}
+
+void RidgedMulti::CalcOctaveTable ()
+{
+  // Only generate the octaves that the sample spacing can represent.  See
+  // Perlin::CalcOctaveTable().
+  double octaveWeights[RIDGED_MAX_OCTAVE];
+  m_weightedOctaveCount = GetOctaveWeights (m_frequency, m_lacunarity,
+    m_octaveCount, m_sampleSpacing, octaveWeights);
+  double curFrequency = m_frequency;
+  for (int curOctave = 0; curOctave < m_weightedOctaveCount; curOctave++) {
+    m_octaveAmplitudes[curOctave] = m_pSpectralWeights[curOctave]
+      * octaveWeights[curOctave];
+    m_octaveFrequencies[curOctave] = curFrequency;
+    m_octaveSeeds[curOctave] = (m_seed + curOctave) & 0x7fffffff;
+    curFrequency *= m_lacunarity;
+  }
+  if (m_enableNormalization) {
+    NormalizeOctaveAmplitudes (m_weightedOctaveCount, m_octaveAmplitudes);
+  }
 }
 
 // Calculates the spectral weights for each octave.
@@ -52,6 +80,26 @@ void RidgedMulti::CalcSpectralWeights ()
 
 // Multifractal code originally written by F. Kenton "Doc Mojo" Musgrave,
 // 1998.  Modified by jas for use with libnoise.
+void RidgedMulti::GetBounds (double lowerX, double lowerY, double lowerZ,
+  double upperX, double upperY, double upperZ, double& lowerBound,
+  double& upperBound) const
+{
+  // The squared ridge signal, (1.0 - |n|) ^ 2, does not exceed 1.0 since
+  // GRADIENT_COHERENT_NOISE_BOUND is less than 2.0, and the weight from the
+  // previous octave is clamped to the 0.0 to 1.0 range.  The signal of each
+  // octave therefore ranges from 0.0 to 1.0 before it is scaled by the
+  // amplitude of that octave.
+  double lower = 0.0;
+  double upper = 0.0;
+  for (int curOctave = 0; curOctave < m_weightedOctaveCount; curOctave++) {
+    double spectralWeight = m_octaveAmplitudes[curOctave];
+    lower += GetMin (0.0, spectralWeight);
+    upper += GetMax (0.0, spectralWeight);
+  }
+  lowerBound = (lower * 1.25) - 1.0;
+  upperBound = (upper * 1.25) - 1.0;
+}
+
 double RidgedMulti::GetValue (double x, double y, double z) const
 {
   x *= m_frequency;
@@ -67,7 +115,7 @@ double RidgedMulti::GetValue (double x, double y, double z) const
   double offset = 1.0;
   double gain = 2.0;
 
-  for (int curOctave = 0; curOctave < m_octaveCount; curOctave++) {
+  for (int curOctave = 0; curOctave < m_weightedOctaveCount; curOctave++) {
 
     // Make sure that these floating-point values have the same range as a 32-
     // bit integer so that we can pass them to the coherent-noise functions.
@@ -77,8 +125,13 @@ double RidgedMulti::GetValue (double x, double y, double z) const
     nz = MakeInt32Range (z);
 
     // Get the coherent-noise value.
-    int seed = (m_seed + curOctave) & 0x7fffffff;
-    signal = GradientCoherentNoise3D (nx, ny, nz, seed, m_noiseQuality);
+    int seed = m_octaveSeeds[curOctave];
+    if (m_pPermutationTable != NULL) {
+      signal = m_pNoiseFunctions->gradientCoherentNoise3DTable (nx, ny, nz,
+        *m_pPermutationTable, seed);
+    } else {
+      signal = m_pNoiseFunctions->gradientCoherentNoise3D (nx, ny, nz, seed);
+    }
 
     // Make the ridges.
     signal = fabs (signal);
@@ -102,7 +155,7 @@ double RidgedMulti::GetValue (double x, double y, double z) const
     }
 
     // Add the signal to the output value.
-    value += (signal * m_pSpectralWeights[curOctave]);
+    value += (signal * m_octaveAmplitudes[curOctave]);
 
     // Go to the next octave.
     x *= m_lacunarity;
@@ -112,3 +165,258 @@ double RidgedMulti::GetValue (double x, double y, double z) const
 
   return (value * 1.25) - 1.0;
 }
+
+double RidgedMulti::GetValue4D (double x, double y, double z, double w)
+  const
+{
+  x *= m_frequency;
+  y *= m_frequency;
+  z *= m_frequency;
+  w *= m_frequency;
+
+  double signal = 0.0;
+  double value  = 0.0;
+  double weight = 1.0;
+
+  // These parameters are the same as the ones in GetValue().
+  double offset = 1.0;
+  double gain = 2.0;
+
+  for (int curOctave = 0; curOctave < m_weightedOctaveCount; curOctave++) {
+
+    // Make sure that these floating-point values have the same range as a 32-
+    // bit integer so that we can pass them to the coherent-noise functions.
+    double nx, ny, nz, nw;
+    nx = MakeInt32Range (x);
+    ny = MakeInt32Range (y);
+    nz = MakeInt32Range (z);
+    nw = MakeInt32Range (w);
+
+    // Get the coherent-noise value, and make the ridges in the same way as
+    // GetValue().
+    int seed = m_octaveSeeds[curOctave];
+    signal = GradientCoherentNoise4D (nx, ny, nz, nw, seed, m_noiseQuality);
+    signal = fabs (signal);
+    signal = offset - signal;
+    signal *= signal;
+    signal *= weight;
+
+    // Weight successive contributions by the previous signal.
+    weight = signal * gain;
+    if (weight > 1.0) {
+      weight = 1.0;
+    }
+    if (weight < 0.0) {
+      weight = 0.0;
+    }
+
+    // Add the signal to the output value.
+    value += (signal * m_octaveAmplitudes[curOctave]);
+
+    // Go to the next octave.
+    x *= m_lacunarity;
+    y *= m_lacunarity;
+    z *= m_lacunarity;
+    w *= m_lacunarity;
+  }
+
+  return (value * 1.25) - 1.0;
+}
+
+double RidgedMulti::GetValueAndGradient (double x, double y, double z,
+  double& dx, double& dy, double& dz) const
+{
+  x *= m_frequency;
+  y *= m_frequency;
+  z *= m_frequency;
+
+  double signal = 0.0;
+  double value  = 0.0;
+  double weight = 1.0;
+
+  // The derivatives of the output value and of the weight.  The weight
+  // depends on the signals of all previous octaves, so its derivatives are
+  // carried from one octave to the next.
+  double valueDx = 0.0, valueDy = 0.0, valueDz = 0.0;
+  double weightDx = 0.0, weightDy = 0.0, weightDz = 0.0;
+
+  // These parameters should be user-defined; they may be exposed in a
+  // future version of libnoise.
+  double offset = 1.0;
+  double gain = 2.0;
+
+  for (int curOctave = 0; curOctave < m_weightedOctaveCount; curOctave++) {
+
+    // Make sure that these floating-point values have the same range as a 32-
+    // bit integer so that we can pass them to the coherent-noise functions.
+    double nx, ny, nz;
+    nx = MakeInt32Range (x);
+    ny = MakeInt32Range (y);
+    nz = MakeInt32Range (z);
+
+    // Get the coherent-noise value and its derivatives with respect to the
+    // input value.
+    int seed = m_octaveSeeds[curOctave];
+    double sx, sy, sz;
+    if (m_pPermutationTable != NULL) {
+      signal = m_pNoiseFunctions->gradientCoherentNoiseDeriv3DTable (nx, ny,
+        nz, *m_pPermutationTable, seed, sx, sy, sz);
+    } else {
+      signal = m_pNoiseFunctions->gradientCoherentNoiseDeriv3D (nx, ny, nz,
+        seed, sx, sy, sz);
+    }
+    double curFrequency = m_octaveFrequencies[curOctave];
+    double slope = (signal < 0.0? -curFrequency: curFrequency);
+    sx *= slope;
+    sy *= slope;
+    sz *= slope;
+
+    // Make the ridges.  The derivatives of (offset - |signal|) are the
+    // negated derivatives of |signal|.
+    signal = fabs (signal);
+    signal = offset - signal;
+
+    // Square the signal to increase the sharpness of the ridges, and apply
+    // the weighting from the previous octave (product rule.)
+    double ridge = signal;
+    signal *= signal;
+    sx = (-2.0 * ridge * sx * weight) + (signal * weightDx);
+    sy = (-2.0 * ridge * sy * weight) + (signal * weightDy);
+    sz = (-2.0 * ridge * sz * weight) + (signal * weightDz);
+    signal *= weight;
+
+    // Weight successive contributions by the previous signal.  The weight
+    // is constant where it is clamped.
+    weight = signal * gain;
+    weightDx = sx * gain;
+    weightDy = sy * gain;
+    weightDz = sz * gain;
+    if (weight > 1.0) {
+      weight = 1.0;
+      weightDx = weightDy = weightDz = 0.0;
+    }
+    if (weight < 0.0) {
+      weight = 0.0;
+      weightDx = weightDy = weightDz = 0.0;
+    }
+
+    // Add the signal to the output value.
+    double spectralWeight = m_octaveAmplitudes[curOctave];
+    value += (signal * spectralWeight);
+    valueDx += (sx * spectralWeight);
+    valueDy += (sy * spectralWeight);
+    valueDz += (sz * spectralWeight);
+
+    // Go to the next octave.
+    x *= m_lacunarity;
+    y *= m_lacunarity;
+    z *= m_lacunarity;
+  }
+
+  dx = valueDx * 1.25;
+  dy = valueDy * 1.25;
+  dz = valueDz * 1.25;
+  return (value * 1.25) - 1.0;
+}
+
+void RidgedMulti::GetValues (int count, const double* x, const double* y,
+  const double* z, double* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+void RidgedMulti::GetValues (int count, const float* x, const float* y,
+  const float* z, float* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+template <class T>
+void RidgedMulti::GetValuesImpl (int count, const T* x, const T* y,
+  const T* z, T* values) const
+{
+  T xCur[MODULE_BATCH_SIZE];
+  T yCur[MODULE_BATCH_SIZE];
+  T zCur[MODULE_BATCH_SIZE];
+  T nx[MODULE_BATCH_SIZE];
+  T ny[MODULE_BATCH_SIZE];
+  T nz[MODULE_BATCH_SIZE];
+  T weight[MODULE_BATCH_SIZE];
+  T noise[MODULE_BATCH_SIZE];
+  T signal;
+
+  // These parameters should be user-defined; they may be exposed in a
+  // future version of libnoise.
+  T offset = 1.0;
+  T gain = 2.0;
+
+  // Convert the parameters to the precision of the input values.
+  T frequency = (T)m_frequency;
+  T lacunarity = (T)m_lacunarity;
+
+  for (int first = 0; first < count; first += MODULE_BATCH_SIZE) {
+    int n = GetMin (count - first, MODULE_BATCH_SIZE);
+    T* value = values + first;
+    T maxMagnitude = GetMaxMagnitude (n, x + first, y + first, z + first);
+    for (int i = 0; i < n; i++) {
+      xCur[i] = x[first + i] * frequency;
+      yCur[i] = y[first + i] * frequency;
+      zCur[i] = z[first + i] * frequency;
+      weight[i] = 1.0;
+      value[i] = 0.0;
+    }
+
+    // Generate each octave for the whole span before moving on to the next
+    // octave.  The per-point operations are the same as the ones in
+    // GetValue(), so the double-precision output values are identical.
+    for (int curOctave = 0; curOctave < m_weightedOctaveCount; curOctave++) {
+      const T* px = xCur;
+      const T* py = yCur;
+      const T* pz = zCur;
+      if (!IsInInt32Range (maxMagnitude, m_octaveFrequencies[curOctave])) {
+        for (int i = 0; i < n; i++) {
+          nx[i] = MakeInt32Range (xCur[i]);
+          ny[i] = MakeInt32Range (yCur[i]);
+          nz[i] = MakeInt32Range (zCur[i]);
+        }
+        px = nx;
+        py = ny;
+        pz = nz;
+      }
+      int seed = m_octaveSeeds[curOctave];
+      if (m_pPermutationTable != NULL) {
+        GradientCoherentNoise3DArray (*m_pNoiseFunctions, n, px, py, pz,
+          noise, *m_pPermutationTable, seed);
+      } else {
+        GradientCoherentNoise3DArray (*m_pNoiseFunctions, n, px, py, pz,
+          noise, seed);
+      }
+      T spectralWeight = (T)m_octaveAmplitudes[curOctave];
+      for (int i = 0; i < n; i++) {
+        // Make the ridges, sharpen them, and apply the weighting from the
+        // previous octave.
+        signal = fabs (noise[i]);
+        signal = offset - signal;
+        signal *= signal;
+        signal *= weight[i];
+
+        // Weight successive contributions by the previous signal.
+        weight[i] = signal * gain;
+        if (weight[i] > (T)1.0) {
+          weight[i] = 1.0;
+        }
+        if (weight[i] < (T)0.0) {
+          weight[i] = 0.0;
+        }
+
+        value[i] += (signal * spectralWeight);
+        xCur[i] *= lacunarity;
+        yCur[i] *= lacunarity;
+        zCur[i] *= lacunarity;
+      }
+    }
+    for (int i = 0; i < n; i++) {
+      value[i] = (value[i] * (T)1.25) - (T)1.0;
+    }
+  }
+}
@@ -54,6 +54,10 @@ namespace noise
     /// module.
     const noise::NoiseQuality DEFAULT_RIDGED_QUALITY = QUALITY_STD;
 
+    /// Default sample spacing for the noise::module::RidgedMulti noise
+    /// module.
+    const double DEFAULT_RIDGED_SAMPLE_SPACING = 0.0;
+
     /// Default noise seed for the noise::module::RidgedMulti noise module.
     const int DEFAULT_RIDGED_SEED = 0;
 
@@ -141,10 +145,35 @@ namespace noise
         /// The default lacunarity is set to
         /// noise::module::DEFAULT_RIDGED_LACUNARITY.
         ///
+        /// The default sample spacing is set to
+        /// noise::module::DEFAULT_RIDGED_SAMPLE_SPACING.
+        ///
         /// The default seed value is set to
         /// noise::module::DEFAULT_RIDGED_SEED.
         RidgedMulti ();
 
+        /// Enables or disables normalizing the amplitudes of the octaves.
+        ///
+        /// @param enable Specifies whether to normalize the amplitudes of
+        /// the octaves or not.
+        ///
+        /// Without normalization, each octave adds its spectral weight to
+        /// the range of the output values, so the range grows with the
+        /// number of octaves.  Normalization divides the spectral weight
+        /// of each octave by the sum of the spectral weights of all
+        /// generated octaves, so the output values have the range of a
+        /// single octave, whatever the number of octaves.  GetBounds()
+        /// returns the normalized bounds.
+        void EnableNormalization (bool enable = true)
+        {
+          m_enableNormalization = enable;
+          CalcOctaveTable ();
+        }
+
+        virtual void GetBounds (double lowerX, double lowerY, double lowerZ,
+          double upperX, double upperY, double upperZ, double& lowerBound,
+          double& upperBound) const;
+
         /// Returns the frequency of the first octave.
         ///
         /// @returns The frequency of the first octave.
@@ -188,6 +217,25 @@ namespace noise
           return m_octaveCount;
         }
 
+        /// Returns the permutation table that hashes the lattice points of
+        /// the ridged-multifractal noise.
+        ///
+        /// @returns A pointer to the permutation table, or NULL if the
+        /// ridged-multifractal noise uses the default lattice hash.
+        const noise::PermutationTable* GetPermutationTable () const
+        {
+          return m_pPermutationTable;
+        }
+
+        /// Returns the spacing between the input values at which the
+        /// application samples this noise module.
+        ///
+        /// @returns The sample spacing.
+        double GetSampleSpacing () const
+        {
+          return m_sampleSpacing;
+        }
+
         /// Returns the seed value used by the ridged-multifractal-noise
         /// function.
         ///
@@ -204,12 +252,65 @@ namespace noise
 
         virtual double GetValue (double x, double y, double z) const;
 
+        /// Generates an output value from a four-dimensional input value.
+        ///
+        /// @param x The @a x coordinate of the input value.
+        /// @param y The @a y coordinate of the input value.
+        /// @param z The @a z coordinate of the input value.
+        /// @param w The @a w coordinate of the input value.
+        ///
+        /// @returns The output value.
+        ///
+        /// See noise::module::Perlin::GetValue4D() for details.  The
+        /// output values may exceed the bounds returned by GetBounds().
+        double GetValue4D (double x, double y, double z, double w) const;
+
+        /// Generates an output value and its partial derivatives.
+        ///
+        /// @param x The @a x coordinate of the input value.
+        /// @param y The @a y coordinate of the input value.
+        /// @param z The @a z coordinate of the input value.
+        /// @param dx Receives the partial derivative with respect to @a x.
+        /// @param dy Receives the partial derivative with respect to @a y.
+        /// @param dz Receives the partial derivative with respect to @a z.
+        ///
+        /// @returns The output value, which is identical to the value
+        /// returned by the GetValue() method.
+        ///
+        /// The derivatives are calculated analytically in each octave, and
+        /// the derivatives of the weight that an octave applies to the
+        /// next octave are carried through the octave loop, so they cost far
+        /// less than estimating them from six additional output values.
+        /// Along the ridges, where the derivatives are discontinuous, this
+        /// method returns the derivatives on one side of the ridge.
+        double GetValueAndGradient (double x, double y, double z, double& dx,
+          double& dy, double& dz) const;
+
+        virtual void GetValues (int count, const double* x, const double* y,
+          const double* z, double* values) const;
+
+        virtual void GetValues (int count, const float* x, const float* y,
+          const float* z, float* values) const;
+
+        /// Determines if the amplitudes of the octaves are normalized.
+        ///
+        /// @returns
+        /// - @a true if the amplitudes of the octaves are normalized.
+        /// - @a false if not.
+        ///
+        /// See EnableNormalization() for details.
+        bool IsNormalizationEnabled () const
+        {
+          return m_enableNormalization;
+        }
+
         /// Sets the frequency of the first octave.
         ///
         /// @param frequency The frequency of the first octave.
         void SetFrequency (double frequency)
         {
           m_frequency = frequency;
+          CalcOctaveTable ();
         }
 
         /// Sets the lacunarity of the ridged-multifractal noise.
@@ -225,6 +326,7 @@ namespace noise
         {
           m_lacunarity = lacunarity;
           CalcSpectralWeights ();
+          CalcOctaveTable ();
         }
 
         /// Sets the quality of the ridged-multifractal noise.
@@ -236,6 +338,8 @@ namespace noise
         void SetNoiseQuality (noise::NoiseQuality noiseQuality)
         {
           m_noiseQuality = noiseQuality;
+          m_pNoiseFunctions = &noise::GetGradientCoherentNoiseFunctions (
+            noiseQuality);
         }
 
         /// Sets the number of octaves that generate the ridged-multifractal
@@ -261,6 +365,49 @@ namespace noise
             throw noise::ExceptionInvalidParam ();
           }
           m_octaveCount = octaveCount;
+          CalcOctaveTable ();
+        }
+
+        /// Sets the permutation table that hashes the lattice points of the
+        /// ridged-multifractal noise.
+        ///
+        /// @param pTable A pointer to the permutation table, or NULL to use
+        /// the default lattice hash.
+        ///
+        /// The permutation table replaces the arithmetic lattice hash of
+        /// the gradient-coherent-noise functions; see
+        /// noise::PermutationTable.  Each octave still uses its own seed.
+        ///
+        /// This noise module does not copy the permutation table, so the
+        /// table must exist as long as this noise module uses it.
+        ///
+        /// The GetValue4D() method always uses the default lattice hash.
+        void SetPermutationTable (const noise::PermutationTable* pTable)
+        {
+          m_pPermutationTable = pTable;
+        }
+
+        /// Sets the spacing between the input values at which the
+        /// application samples this noise module.
+        ///
+        /// @param sampleSpacing The sample spacing.
+        ///
+        /// @pre The sample spacing is not negative.
+        ///
+        /// @throw noise::ExceptionInvalidParam An invalid parameter was
+        /// specified; see the preconditions for more information.
+        ///
+        /// Octaves that are too fine for this spacing are skipped or faded
+        /// out, which changes the ridged-multifractal noise.  A spacing of
+        /// 0.0 generates every octave.  See
+        /// noise::module::Perlin::SetSampleSpacing() for details.
+        void SetSampleSpacing (double sampleSpacing)
+        {
+          if (sampleSpacing < 0.0) {
+            throw noise::ExceptionInvalidParam ();
+          }
+          m_sampleSpacing = sampleSpacing;
+          CalcOctaveTable ();
         }
 
         /// Sets the seed value used by the ridged-multifractal-noise
@@ -270,15 +417,26 @@ namespace noise
         void SetSeed (int seed)
         {
           m_seed = seed;
+          CalcOctaveTable ();
         }
 
       protected:
 
+        /// Calculates the frequency, amplitude, and seed value of each
+        /// octave that this noise module generates.
+        ///
+        /// This method is called when a parameter that affects the octaves
+        /// changes.
+        void CalcOctaveTable ();
+
         /// Calculates the spectral weights for each octave.
         ///
         /// This method is called when the lacunarity changes.
         void CalcSpectralWeights ();
 
+        /// Determines if the amplitudes of the octaves are normalized.
+        bool m_enableNormalization;
+
         /// Frequency of the first octave.
         double m_frequency;
 
@@ -288,16 +446,48 @@ namespace noise
         /// Quality of the ridged-multifractal noise.
         noise::NoiseQuality m_noiseQuality;
 
+        /// Gradient-coherent-noise functions specialized for the noise
+        /// quality.
+        const noise::GradientCoherentNoiseFunctions* m_pNoiseFunctions;
+
+        /// Amplitude of each generated octave.
+        double m_octaveAmplitudes[RIDGED_MAX_OCTAVE];
+
         /// Total number of octaves that generate the ridged-multifractal
         /// noise.
         int m_octaveCount;
 
+        /// Frequency of each generated octave.
+        double m_octaveFrequencies[RIDGED_MAX_OCTAVE];
+
+        /// Seed value of each generated octave.
+        int m_octaveSeeds[RIDGED_MAX_OCTAVE];
+
+        /// Permutation table that hashes the lattice points, or NULL to use
+        /// the default lattice hash.
+        const noise::PermutationTable* m_pPermutationTable;
+
         /// Contains the spectral weights for each octave.
         double m_pSpectralWeights[RIDGED_MAX_OCTAVE];
 
+        /// Spacing between the input values at which the application
+        /// samples the ridged-multifractal noise.
+        double m_sampleSpacing;
+
         /// Seed value used by the ridged-multfractal-noise function.
         int m_seed;
 
+        /// Number of octaves that the sample spacing lets this noise module
+        /// generate.
+        int m_weightedOctaveCount;
+
+      private:
+
+        /// Implements both versions of the GetValues() method.
+        template <class T>
+        void GetValuesImpl (int count, const T* x, const T* y, const T* z,
+          T* values) const;
+
     };
 
     /// @}
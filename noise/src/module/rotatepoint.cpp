@@ -20,7 +20,9 @@
 // off every 'zig'.)
 //
 
+#include "../boundsimpl.h"
 #include "../mathconsts.h"
+#include "../misc.h"
 #include "rotatepoint.h"
 
 using namespace noise::module;
@@ -31,6 +33,24 @@ RotatePoint::RotatePoint ():
   SetAngles (DEFAULT_ROTATE_X, DEFAULT_ROTATE_Y, DEFAULT_ROTATE_Z);
 }
 
+void RotatePoint::GetBounds (double lowerX, double lowerY, double lowerZ,
+  double upperX, double upperY, double upperZ, double& lowerBound,
+  double& upperBound) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  double matrix[12] = {
+    m_x1Matrix, m_y1Matrix, m_z1Matrix, 0.0,
+    m_x2Matrix, m_y2Matrix, m_z2Matrix, 0.0,
+    m_x3Matrix, m_y3Matrix, m_z3Matrix, 0.0};
+  double lower[3] = {lowerX, lowerY, lowerZ};
+  double upper[3] = {upperX, upperY, upperZ};
+  double newLower[3], newUpper[3];
+  TransformBox (matrix, lower, upper, newLower, newUpper);
+  m_pSourceModule[0]->GetBounds (newLower[0], newLower[1], newLower[2],
+    newUpper[0], newUpper[1], newUpper[2], lowerBound, upperBound);
+}
+
 double RotatePoint::GetValue (double x, double y, double z) const
 {
   assert (m_pSourceModule[0] != NULL);
@@ -66,3 +86,38 @@ void RotatePoint::SetAngles (double xAngle, double yAngle,
   m_yAngle = yAngle;
   m_zAngle = zAngle;
 }
+
+void RotatePoint::GetValues (int count, const double* x, const double* y,
+  const double* z, double* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+void RotatePoint::GetValues (int count, const float* x, const float* y,
+  const float* z, float* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+template <class T>
+void RotatePoint::GetValuesImpl (int count, const T* x, const T* y,
+  const T* z, T* values) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  T nx[MODULE_BATCH_SIZE];
+  T ny[MODULE_BATCH_SIZE];
+  T nz[MODULE_BATCH_SIZE];
+  for (int offset = 0; offset < count; offset += MODULE_BATCH_SIZE) {
+    int n = GetMin (count - offset, MODULE_BATCH_SIZE);
+    for (int i = 0; i < n; i++) {
+      T xi = x[offset + i];
+      T yi = y[offset + i];
+      T zi = z[offset + i];
+      nx[i] = (m_x1Matrix * xi) + (m_y1Matrix * yi) + (m_z1Matrix * zi);
+      ny[i] = (m_x2Matrix * xi) + (m_y2Matrix * yi) + (m_z2Matrix * zi);
+      nz[i] = (m_x3Matrix * xi) + (m_y3Matrix * yi) + (m_z3Matrix * zi);
+    }
+    m_pSourceModule[0]->GetValues (n, nx, ny, nz, values + offset);
+  }
+}
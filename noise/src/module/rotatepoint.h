@@ -86,6 +86,10 @@ namespace noise
         /// set to noise::module::DEFAULT_ROTATE_Z.
         RotatePoint ();
 
+        virtual void GetBounds (double lowerX, double lowerY, double lowerZ,
+          double upperX, double upperY, double upperZ, double& lowerBound,
+          double& upperBound) const;
+
         virtual int GetSourceModuleCount () const
         {
           return 1;
@@ -93,6 +97,12 @@ namespace noise
 
         virtual double GetValue (double x, double y, double z) const;
 
+        virtual void GetValues (int count, const double* x, const double* y,
+          const double* z, double* values) const;
+
+        virtual void GetValues (int count, const float* x, const float* y,
+          const float* z, float* values) const;
+
         /// Returns the rotation angle around the @a x axis to apply to the
         /// input value.
         ///
@@ -218,6 +228,18 @@ namespace noise
         /// @a z rotation angle applied to the input value, in degrees.
         double m_zAngle;
 
+      private:
+
+        /// The noise::module::Program and noise::module::TransformPoint
+        /// noise modules copy the rotation matrix.
+        friend class Program;
+        friend class TransformPoint;
+
+        /// Implements both versions of the GetValues() method.
+        template <class T>
+        void GetValuesImpl (int count, const T* x, const T* y, const T* z,
+          T* values) const;
+
     };
 
     /// @}
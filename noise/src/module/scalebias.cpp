@@ -20,6 +20,7 @@
 // off every 'zig'.)
 //
 
+#include "../boundsimpl.h"
 #include "scalebias.h"
 
 using namespace noise::module;
@@ -31,9 +32,49 @@ ScaleBias::ScaleBias ():
 {
 }
 
+void ScaleBias::GetBounds (double lowerX, double lowerY, double lowerZ,
+  double upperX, double upperY, double upperZ, double& lowerBound,
+  double& upperBound) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  double lower, upper;
+  m_pSourceModule[0]->GetBounds (lowerX, lowerY, lowerZ, upperX, upperY,
+    upperZ, lower, upper);
+  MultiplyBounds (lower, upper, m_scale, m_scale, lowerBound, upperBound);
+  lowerBound += m_bias;
+  upperBound += m_bias;
+}
+
 double ScaleBias::GetValue (double x, double y, double z) const
 {
   assert (m_pSourceModule[0] != NULL);
 
   return m_pSourceModule[0]->GetValue (x, y, z) * m_scale + m_bias;
 }
+
+void ScaleBias::GetValues (int count, const double* x, const double* y,
+  const double* z, double* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+void ScaleBias::GetValues (int count, const float* x, const float* y,
+  const float* z, float* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+template <class T>
+void ScaleBias::GetValuesImpl (int count, const T* x, const T* y,
+  const T* z, T* values) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  T scale = (T)m_scale;
+  T bias = (T)m_bias;
+  m_pSourceModule[0]->GetValues (count, x, y, z, values);
+  for (int i = 0; i < count; i++) {
+    values[i] = values[i] * scale + bias;
+  }
+}
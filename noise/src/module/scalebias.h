@@ -81,6 +81,10 @@ namespace noise
           return m_bias;
         }
 
+        virtual void GetBounds (double lowerX, double lowerY, double lowerZ,
+          double upperX, double upperY, double upperZ, double& lowerBound,
+          double& upperBound) const;
+
         /// Returns the scaling factor to apply to the output value from the
         /// source module.
         ///
@@ -101,6 +105,12 @@ namespace noise
 
         virtual double GetValue (double x, double y, double z) const;
 
+        virtual void GetValues (int count, const double* x, const double* y,
+          const double* z, double* values) const;
+
+        virtual void GetValues (int count, const float* x, const float* y,
+          const float* z, float* values) const;
+
         /// Sets the bias to apply to the scaled output value from the source
         /// module.
         ///
@@ -136,6 +146,13 @@ namespace noise
         /// module.
         double m_scale;
 
+      private:
+
+        /// Implements both versions of the GetValues() method.
+        template <class T>
+        void GetValuesImpl (int count, const T* x, const T* y, const T* z,
+          T* values) const;
+
     };
 
     /// @}
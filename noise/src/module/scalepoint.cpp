@@ -20,6 +20,8 @@
 // off every 'zig'.)
 //
 
+#include "../boundsimpl.h"
+#include "../misc.h"
 #include "scalepoint.h"
 
 using namespace noise::module;
@@ -32,6 +34,20 @@ ScalePoint::ScalePoint ():
 {
 }
 
+void ScalePoint::GetBounds (double lowerX, double lowerY, double lowerZ,
+  double upperX, double upperY, double upperZ, double& lowerBound,
+  double& upperBound) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  double lowerX1, upperX1, lowerY1, upperY1, lowerZ1, upperZ1;
+  MultiplyBounds (lowerX, upperX, m_xScale, m_xScale, lowerX1, upperX1);
+  MultiplyBounds (lowerY, upperY, m_yScale, m_yScale, lowerY1, upperY1);
+  MultiplyBounds (lowerZ, upperZ, m_zScale, m_zScale, lowerZ1, upperZ1);
+  m_pSourceModule[0]->GetBounds (lowerX1, lowerY1, lowerZ1, upperX1, upperY1,
+    upperZ1, lowerBound, upperBound);
+}
+
 double ScalePoint::GetValue (double x, double y, double z) const
 {
   assert (m_pSourceModule[0] != NULL);
@@ -39,3 +55,35 @@ double ScalePoint::GetValue (double x, double y, double z) const
   return m_pSourceModule[0]->GetValue (x * m_xScale, y * m_yScale,
     z * m_zScale);
 }
+
+void ScalePoint::GetValues (int count, const double* x, const double* y,
+  const double* z, double* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+void ScalePoint::GetValues (int count, const float* x, const float* y,
+  const float* z, float* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+template <class T>
+void ScalePoint::GetValuesImpl (int count, const T* x, const T* y,
+  const T* z, T* values) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  T nx[MODULE_BATCH_SIZE];
+  T ny[MODULE_BATCH_SIZE];
+  T nz[MODULE_BATCH_SIZE];
+  for (int offset = 0; offset < count; offset += MODULE_BATCH_SIZE) {
+    int n = GetMin (count - offset, MODULE_BATCH_SIZE);
+    for (int i = 0; i < n; i++) {
+      nx[i] = x[offset + i] * m_xScale;
+      ny[i] = y[offset + i] * m_yScale;
+      nz[i] = z[offset + i] * m_zScale;
+    }
+    m_pSourceModule[0]->GetValues (n, nx, ny, nz, values + offset);
+  }
+}
@@ -82,6 +82,10 @@ namespace noise
         /// to noise::module::DEFAULT_SCALE_POINT_Z.
         ScalePoint ();
 
+        virtual void GetBounds (double lowerX, double lowerY, double lowerZ,
+          double upperX, double upperY, double upperZ, double& lowerBound,
+          double& upperBound) const;
+
         virtual int GetSourceModuleCount () const
         {
           return 1;
@@ -89,6 +93,12 @@ namespace noise
 
         virtual double GetValue (double x, double y, double z) const;
 
+        virtual void GetValues (int count, const double* x, const double* y,
+          const double* z, double* values) const;
+
+        virtual void GetValues (int count, const float* x, const float* y,
+          const float* z, float* values) const;
+
         /// Returns the scaling factor applied to the @a x coordinate of the
         /// input value.
         ///
@@ -197,6 +207,13 @@ namespace noise
         /// Scaling factor applied to the @a z coordinate of the input value.
         double m_zScale;
 
+      private:
+
+        /// Implements both versions of the GetValues() method.
+        template <class T>
+        void GetValuesImpl (int count, const T* x, const T* y, const T* z,
+          T* values) const;
+
     };
 
     /// @}
@@ -20,7 +20,9 @@
 // off every 'zig'.)
 //
 
+#include "../boundsimpl.h"
 #include "../interp.h"
+#include "../misc.h"
 #include "select.h"
 
 using namespace noise::module;
@@ -33,6 +35,36 @@ Select::Select ():
 {
 }
 
+void Select::GetBounds (double lowerX, double lowerY, double lowerZ,
+  double upperX, double upperY, double upperZ, double& lowerBound,
+  double& upperBound) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+  assert (m_pSourceModule[2] != NULL);
+
+  // Only retrieve the bounds of the source modules that the control values
+  // within the box may select.  Within the edge transitions, the output
+  // value is a blend of both source modules that lies between them.
+  double lowerControl, upperControl;
+  m_pSourceModule[2]->GetBounds (lowerX, lowerY, lowerZ, upperX, upperY,
+    upperZ, lowerControl, upperControl);
+  int sourceIndex = ClassifyControlBounds (lowerControl, upperControl,
+    m_lowerBound, m_upperBound, m_edgeFalloff);
+  if (sourceIndex != 2) {
+    m_pSourceModule[sourceIndex]->GetBounds (lowerX, lowerY, lowerZ, upperX,
+      upperY, upperZ, lowerBound, upperBound);
+    return;
+  }
+  double lower0, upper0, lower1, upper1;
+  m_pSourceModule[0]->GetBounds (lowerX, lowerY, lowerZ, upperX, upperY,
+    upperZ, lower0, upper0);
+  m_pSourceModule[1]->GetBounds (lowerX, lowerY, lowerZ, upperX, upperY,
+    upperZ, lower1, upper1);
+  LerpBounds (lower0, upper0, lower1, upper1, 0.0, 1.0, lowerBound,
+    upperBound);
+}
+
 double Select::GetValue (double x, double y, double z) const
 {
   assert (m_pSourceModule[0] != NULL);
@@ -90,6 +122,134 @@ double Select::GetValue (double x, double y, double z) const
   }
 }
 
+void Select::GetValues (int count, const double* x, const double* y,
+  const double* z, double* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+void Select::GetValues (int count, const float* x, const float* y,
+  const float* z, float* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+// Retrieves the output values from a noise module at the input values in
+// a span that have the specified indices.  Each output value is stored at
+// the index of its input value.  At least one index must be specified.
+template <class T>
+static void GetValuesAt (const Module& sourceModule, int count,
+  int indexCount, const int* index, const T* x, const T* y, const T* z,
+  T* values)
+{
+  if (indexCount == count) {
+    sourceModule.GetValues (count, x, y, z, values);
+    return;
+  }
+  T xs[MODULE_BATCH_SIZE];
+  T ys[MODULE_BATCH_SIZE];
+  T zs[MODULE_BATCH_SIZE];
+  T vs[MODULE_BATCH_SIZE];
+  int i = 0;
+  do {
+    xs[i] = x[index[i]];
+    ys[i] = y[index[i]];
+    zs[i] = z[index[i]];
+  } while (++i < indexCount);
+  sourceModule.GetValues (indexCount, xs, ys, zs, vs);
+  for (i = 0; i < indexCount; i++) {
+    values[index[i]] = vs[i];
+  }
+}
+
+template <class T>
+void Select::GetValuesImpl (int count, const T* x, const T* y,
+  const T* z, T* values) const
+{
+  assert (m_pSourceModule[0] != NULL);
+  assert (m_pSourceModule[1] != NULL);
+  assert (m_pSourceModule[2] != NULL);
+
+  T controlValue[MODULE_BATCH_SIZE];
+  T v0[MODULE_BATCH_SIZE];
+  T v1[MODULE_BATCH_SIZE];
+  int index0[MODULE_BATCH_SIZE];
+  int index1[MODULE_BATCH_SIZE];
+  for (int offset = 0; offset < count; offset += MODULE_BATCH_SIZE) {
+    int n = GetMin (count - offset, MODULE_BATCH_SIZE);
+    const T* xi = x + offset;
+    const T* yi = y + offset;
+    const T* zi = z + offset;
+    T* value = values + offset;
+    m_pSourceModule[2]->GetValues (n, xi, yi, zi, controlValue);
+
+    // Split the span by control value into the input values that need the
+    // first source module, and those that need the second source module.
+    // The input values within a falloff region are in both lists.
+    int count0 = 0;
+    int count1 = 0;
+    for (int i = 0; i < n; i++) {
+      if (controlValue[i] < (m_lowerBound - m_edgeFalloff)
+        || controlValue[i] > (m_upperBound + m_edgeFalloff)) {
+        index0[count0++] = i;
+      } else if (controlValue[i] >= (m_lowerBound + m_edgeFalloff)
+        && controlValue[i] < (m_upperBound - m_edgeFalloff)) {
+        index1[count1++] = i;
+      } else {
+        index0[count0++] = i;
+        index1[count1++] = i;
+      }
+    }
+
+    // If every control value selects the same source module, only that
+    // source module is evaluated.  Otherwise, each source module is only
+    // evaluated at the input values that need it; the other elements of
+    // v0 and v1 are not used.
+    if (count1 == 0) {
+      m_pSourceModule[0]->GetValues (n, xi, yi, zi, value);
+      continue;
+    } else if (count0 == 0) {
+      m_pSourceModule[1]->GetValues (n, xi, yi, zi, value);
+      continue;
+    }
+    GetValuesAt (*m_pSourceModule[0], n, count0, index0, xi, yi, zi, v0);
+    GetValuesAt (*m_pSourceModule[1], n, count1, index1, xi, yi, zi, v1);
+
+    for (int i = 0; i < n; i++) {
+      // Same selection as GetValue(), applied to the precomputed output
+      // values from the source modules.
+      T c = controlValue[i];
+      if (m_edgeFalloff > 0.0) {
+        if (c < (m_lowerBound - m_edgeFalloff)) {
+          value[i] = v0[i];
+        } else if (c < (m_lowerBound + m_edgeFalloff)) {
+          T lowerCurve = (m_lowerBound - m_edgeFalloff);
+          T upperCurve = (m_lowerBound + m_edgeFalloff);
+          T alpha = SCurve3 (
+            (c - lowerCurve) / (upperCurve - lowerCurve));
+          value[i] = LinearInterp (v0[i], v1[i], alpha);
+        } else if (c < (m_upperBound - m_edgeFalloff)) {
+          value[i] = v1[i];
+        } else if (c < (m_upperBound + m_edgeFalloff)) {
+          T lowerCurve = (m_upperBound - m_edgeFalloff);
+          T upperCurve = (m_upperBound + m_edgeFalloff);
+          T alpha = SCurve3 (
+            (c - lowerCurve) / (upperCurve - lowerCurve));
+          value[i] = LinearInterp (v1[i], v0[i], alpha);
+        } else {
+          value[i] = v0[i];
+        }
+      } else {
+        if (c < m_lowerBound || c > m_upperBound) {
+          value[i] = v0[i];
+        } else {
+          value[i] = v1[i];
+        }
+      }
+    }
+  }
+}
+
 void Select::SetBounds (double lowerBound, double upperBound)
 {
   assert (lowerBound < upperBound);
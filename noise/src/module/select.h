@@ -80,6 +80,12 @@ namespace noise
     /// smooth the transition, pass a non-zero value to the SetEdgeFalloff()
     /// method.  Higher values result in a smoother transition.
     ///
+    /// A source module is only evaluated at the input values that need its
+    /// output value.  When this noise module generates output values in
+    /// batches, it passes each source module only the input values that
+    /// select that source module or fall within a transition, so a source
+    /// module that is rarely selected costs little.
+    ///
     /// This noise module requires three source modules.
     class Select: public Module
     {
@@ -98,6 +104,10 @@ namespace noise
         /// noise::module::DEFAULT_SELECT_UPPER_BOUND.
         Select ();
 
+        virtual void GetBounds (double lowerX, double lowerY, double lowerZ,
+          double upperX, double upperY, double upperZ, double& lowerBound,
+          double& upperBound) const;
+
         /// Returns the control module.
         ///
         /// @returns A reference to the control module.
@@ -170,6 +180,12 @@ namespace noise
 
         virtual double GetValue (double x, double y, double z) const;
 
+        virtual void GetValues (int count, const double* x, const double* y,
+          const double* z, double* values) const;
+
+        virtual void GetValues (int count, const float* x, const float* y,
+          const float* z, float* values) const;
+
         /// Sets the lower and upper bounds of the selection range.
         ///
         /// @param lowerBound The lower bound.
@@ -252,6 +268,13 @@ namespace noise
         /// Upper bound of the selection range.
         double m_upperBound;
 
+      private:
+
+        /// Implements both versions of the GetValues() method.
+        template <class T>
+        void GetValuesImpl (int count, const T* x, const T* y, const T* z,
+          T* values) const;
+
     };
 
     /// @}
@@ -0,0 +1,160 @@
+// simplex.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+#include "../fractalimpl.h"
+#include "../misc.h"
+#include "simplex.h"
+
+using namespace noise::module;
+
+Simplex::Simplex ():
+  Module (GetSourceModuleCount ()),
+  m_frequency     (DEFAULT_SIMPLEX_FREQUENCY     ),
+  m_lacunarity    (DEFAULT_SIMPLEX_LACUNARITY    ),
+  m_octaveCount   (DEFAULT_SIMPLEX_OCTAVE_COUNT  ),
+  m_persistence   (DEFAULT_SIMPLEX_PERSISTENCE   ),
+  m_sampleSpacing (DEFAULT_SIMPLEX_SAMPLE_SPACING),
+  m_seed          (DEFAULT_SIMPLEX_SEED)
+{
+}
+
+void Simplex::GetBounds (double lowerX, double lowerY, double lowerZ,
+  double upperX, double upperY, double upperZ, double& lowerBound,
+  double& upperBound) const
+{
+  // Each octave adds a coherent-noise value scaled by the persistence and
+  // the weight of that octave.
+  double octaveWeights[SIMPLEX_MAX_OCTAVE];
+  int octaveCount = GetOctaveWeights (m_frequency, m_lacunarity,
+    m_octaveCount, m_sampleSpacing, octaveWeights);
+  double amplitude = 0.0;
+  double curPersistence = 1.0;
+  for (int curOctave = 0; curOctave < octaveCount; curOctave++) {
+    amplitude += fabs (curPersistence * octaveWeights[curOctave]);
+    curPersistence *= m_persistence;
+  }
+  upperBound = amplitude * SIMPLEX_COHERENT_NOISE_BOUND;
+  lowerBound = -upperBound;
+}
+
+double Simplex::GetValue (double x, double y, double z) const
+{
+  double value = 0.0;
+  double signal = 0.0;
+  double curPersistence = 1.0;
+  double nx, ny, nz;
+  int seed;
+
+  // Only generate the octaves that the sample spacing can represent.
+  double octaveWeights[SIMPLEX_MAX_OCTAVE];
+  int octaveCount = GetOctaveWeights (m_frequency, m_lacunarity,
+    m_octaveCount, m_sampleSpacing, octaveWeights);
+
+  x *= m_frequency;
+  y *= m_frequency;
+  z *= m_frequency;
+
+  for (int curOctave = 0; curOctave < octaveCount; curOctave++) {
+
+    // Make sure that these floating-point values have the same range as a 32-
+    // bit integer so that we can pass them to the coherent-noise functions.
+    nx = MakeInt32Range (x);
+    ny = MakeInt32Range (y);
+    nz = MakeInt32Range (z);
+
+    // Get the coherent-noise value from the input value and add it to the
+    // final result.
+    seed = (m_seed + curOctave) & 0xffffffff;
+    signal = SimplexCoherentNoise3D (nx, ny, nz, seed);
+    value += signal * (curPersistence * octaveWeights[curOctave]);
+
+    // Prepare the next octave.
+    x *= m_lacunarity;
+    y *= m_lacunarity;
+    z *= m_lacunarity;
+    curPersistence *= m_persistence;
+  }
+
+  return value;
+}
+
+void Simplex::GetValues (int count, const double* x, const double* y,
+  const double* z, double* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+void Simplex::GetValues (int count, const float* x, const float* y,
+  const float* z, float* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+template <class T>
+void Simplex::GetValuesImpl (int count, const T* x, const T* y,
+  const T* z, T* values) const
+{
+  T xCur[MODULE_BATCH_SIZE];
+  T yCur[MODULE_BATCH_SIZE];
+  T zCur[MODULE_BATCH_SIZE];
+  T curPersistence;
+  int seed;
+
+  // Convert the parameters to the precision of the input values.
+  T frequency = (T)m_frequency;
+  T lacunarity = (T)m_lacunarity;
+  T persistence = (T)m_persistence;
+
+  // Only generate the octaves that the sample spacing can represent.
+  double octaveWeights[SIMPLEX_MAX_OCTAVE];
+  int octaveCount = GetOctaveWeights (m_frequency, m_lacunarity,
+    m_octaveCount, m_sampleSpacing, octaveWeights);
+
+  for (int offset = 0; offset < count; offset += MODULE_BATCH_SIZE) {
+    int n = GetMin (count - offset, MODULE_BATCH_SIZE);
+    T* value = values + offset;
+    for (int i = 0; i < n; i++) {
+      xCur[i] = x[offset + i] * frequency;
+      yCur[i] = y[offset + i] * frequency;
+      zCur[i] = z[offset + i] * frequency;
+      value[i] = 0.0;
+    }
+
+    // Generate each octave for the whole span before moving on to the next
+    // octave.  The per-point operations are the same as the ones in
+    // GetValue(), so the double-precision output values are identical.
+    curPersistence = 1.0;
+    for (int curOctave = 0; curOctave < octaveCount; curOctave++) {
+      seed = (m_seed + curOctave) & 0xffffffff;
+      T amplitude = curPersistence * (T)octaveWeights[curOctave];
+      for (int i = 0; i < n; i++) {
+        value[i] += SimplexCoherentNoise3D (MakeInt32Range (xCur[i]),
+          MakeInt32Range (yCur[i]), MakeInt32Range (zCur[i]), seed)
+          * amplitude;
+        xCur[i] *= lacunarity;
+        yCur[i] *= lacunarity;
+        zCur[i] *= lacunarity;
+      }
+      curPersistence *= persistence;
+    }
+  }
+}
@@ -0,0 +1,328 @@
+// simplex.h
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+#ifndef NOISE_MODULE_SIMPLEX_H
+#define NOISE_MODULE_SIMPLEX_H
+
+#include "modulebase.h"
+
+namespace noise
+{
+
+  namespace module
+  {
+
+    /// @addtogroup libnoise
+    /// @{
+
+    /// @addtogroup modules
+    /// @{
+
+    /// @addtogroup generatormodules
+    /// @{
+
+    /// Default frequency for the noise::module::Simplex noise module.
+    const double DEFAULT_SIMPLEX_FREQUENCY = 1.0;
+
+    /// Default lacunarity for the noise::module::Simplex noise module.
+    const double DEFAULT_SIMPLEX_LACUNARITY = 2.0;
+
+    /// Default number of octaves for the noise::module::Simplex noise
+    /// module.
+    const int DEFAULT_SIMPLEX_OCTAVE_COUNT = 6;
+
+    /// Default persistence value for the noise::module::Simplex noise
+    /// module.
+    const double DEFAULT_SIMPLEX_PERSISTENCE = 0.5;
+
+    /// Default sample spacing for the noise::module::Simplex noise module.
+    const double DEFAULT_SIMPLEX_SAMPLE_SPACING = 0.0;
+
+    /// Default noise seed for the noise::module::Simplex noise module.
+    const int DEFAULT_SIMPLEX_SEED = 0;
+
+    /// Maximum number of octaves for the noise::module::Simplex noise
+    /// module.
+    const int SIMPLEX_MAX_OCTAVE = 30;
+
+    /// Noise module that outputs 3-dimensional fractal simplex noise.
+    ///
+    /// This noise module adds up octaves of coherent noise in the same way
+    /// as the noise::module::Perlin noise module, and has the same
+    /// frequency, lacunarity, octave, persistence, sample spacing, and seed
+    /// parameters.  Instead of gradient coherent noise on a lattice of
+    /// cubes, each octave is generated by the SimplexCoherentNoise3D()
+    /// function, which uses a lattice of tetrahedra (simplices.)
+    ///
+    /// A simplex-noise value only depends on the four vertices of one
+    /// tetrahedron instead of the eight vertices of one cube, so this noise
+    /// module is faster than the noise::module::Perlin noise module with
+    /// the same number of octaves.  Because each vertex contributes to the
+    /// noise along a radial falloff, the noise does not show the
+    /// axis-aligned features of cubic-lattice noise.
+    ///
+    /// This noise module outputs simplex-noise values that usually range
+    /// from -1.0 to +1.0, but there are no guarantees that all output
+    /// values will exist within that range.  The features of simplex noise
+    /// are about as large as the features of Perlin noise with the same
+    /// frequency, but the two noise modules do not output the same values.
+    ///
+    /// There is no noise quality setting; the derivatives of simplex noise
+    /// are always continuous.
+    ///
+    /// This noise module does not require any source modules.
+    ///
+    /// <b>References &amp; acknowledgments</b>
+    ///
+    /// <a href=http://www.noisemachine.com/talk1/>The Noise Machine</a> -
+    /// Ken Perlin's presentation also describes simplex noise, which he
+    /// developed as a faster replacement for his original noise function.
+    class Simplex: public Module
+    {
+
+      public:
+
+        /// Constructor.
+        ///
+        /// The default frequency is set to
+        /// noise::module::DEFAULT_SIMPLEX_FREQUENCY.
+        ///
+        /// The default lacunarity is set to
+        /// noise::module::DEFAULT_SIMPLEX_LACUNARITY.
+        ///
+        /// The default number of octaves is set to
+        /// noise::module::DEFAULT_SIMPLEX_OCTAVE_COUNT.
+        ///
+        /// The default persistence value is set to
+        /// noise::module::DEFAULT_SIMPLEX_PERSISTENCE.
+        ///
+        /// The default sample spacing is set to
+        /// noise::module::DEFAULT_SIMPLEX_SAMPLE_SPACING.
+        ///
+        /// The default seed value is set to
+        /// noise::module::DEFAULT_SIMPLEX_SEED.
+        Simplex ();
+
+        virtual void GetBounds (double lowerX, double lowerY, double lowerZ,
+          double upperX, double upperY, double upperZ, double& lowerBound,
+          double& upperBound) const;
+
+        /// Returns the frequency of the first octave.
+        ///
+        /// @returns The frequency of the first octave.
+        double GetFrequency () const
+        {
+          return m_frequency;
+        }
+
+        /// Returns the lacunarity of the simplex noise.
+        ///
+        /// @returns The lacunarity of the simplex noise.
+        ///
+        /// The lacunarity is the frequency multiplier between successive
+        /// octaves.
+        double GetLacunarity () const
+        {
+          return m_lacunarity;
+        }
+
+        /// Returns the number of octaves that generate the simplex noise.
+        ///
+        /// @returns The number of octaves that generate the simplex noise.
+        ///
+        /// The number of octaves controls the amount of detail in the
+        /// simplex noise.
+        int GetOctaveCount () const
+        {
+          return m_octaveCount;
+        }
+
+        /// Returns the persistence value of the simplex noise.
+        ///
+        /// @returns The persistence value of the simplex noise.
+        ///
+        /// The persistence value controls the roughness of the simplex
+        /// noise.
+        double GetPersistence () const
+        {
+          return m_persistence;
+        }
+
+        /// Returns the spacing between the input values at which the
+        /// application samples this noise module.
+        ///
+        /// @returns The sample spacing.
+        double GetSampleSpacing () const
+        {
+          return m_sampleSpacing;
+        }
+
+        /// Returns the seed value used by the simplex-noise function.
+        ///
+        /// @returns The seed value.
+        int GetSeed () const
+        {
+          return m_seed;
+        }
+
+        virtual int GetSourceModuleCount () const
+        {
+          return 0;
+        }
+
+        virtual double GetValue (double x, double y, double z) const;
+
+        virtual void GetValues (int count, const double* x, const double* y,
+          const double* z, double* values) const;
+
+        virtual void GetValues (int count, const float* x, const float* y,
+          const float* z, float* values) const;
+
+        /// Sets the frequency of the first octave.
+        ///
+        /// @param frequency The frequency of the first octave.
+        void SetFrequency (double frequency)
+        {
+          m_frequency = frequency;
+        }
+
+        /// Sets the lacunarity of the simplex noise.
+        ///
+        /// @param lacunarity The lacunarity of the simplex noise.
+        ///
+        /// The lacunarity is the frequency multiplier between successive
+        /// octaves.
+        ///
+        /// For best results, set the lacunarity to a number between 1.5 and
+        /// 3.5.
+        void SetLacunarity (double lacunarity)
+        {
+          m_lacunarity = lacunarity;
+        }
+
+        /// Sets the number of octaves that generate the simplex noise.
+        ///
+        /// @param octaveCount The number of octaves that generate the
+        /// simplex noise.
+        ///
+        /// @pre The number of octaves ranges from 1 to
+        /// noise::module::SIMPLEX_MAX_OCTAVE.
+        ///
+        /// @throw noise::ExceptionInvalidParam An invalid parameter was
+        /// specified; see the preconditions for more information.
+        ///
+        /// The number of octaves controls the amount of detail in the
+        /// simplex noise.
+        ///
+        /// The larger the number of octaves, the more time required to
+        /// calculate the simplex-noise value.
+        void SetOctaveCount (int octaveCount)
+        {
+          if (octaveCount < 1 || octaveCount > SIMPLEX_MAX_OCTAVE) {
+            throw noise::ExceptionInvalidParam ();
+          }
+          m_octaveCount = octaveCount;
+        }
+
+        /// Sets the persistence value of the simplex noise.
+        ///
+        /// @param persistence The persistence value of the simplex noise.
+        ///
+        /// The persistence value controls the roughness of the simplex
+        /// noise.
+        ///
+        /// For best results, set the persistence to a number between 0.0 and
+        /// 1.0.
+        void SetPersistence (double persistence)
+        {
+          m_persistence = persistence;
+        }
+
+        /// Sets the spacing between the input values at which the
+        /// application samples this noise module.
+        ///
+        /// @param sampleSpacing The sample spacing.
+        ///
+        /// @pre The sample spacing is not negative.
+        ///
+        /// @throw noise::ExceptionInvalidParam An invalid parameter was
+        /// specified; see the preconditions for more information.
+        ///
+        /// See noise::module::Perlin::SetSampleSpacing() for the effect of
+        /// the sample spacing on the octaves.
+        void SetSampleSpacing (double sampleSpacing)
+        {
+          if (sampleSpacing < 0.0) {
+            throw noise::ExceptionInvalidParam ();
+          }
+          m_sampleSpacing = sampleSpacing;
+        }
+
+        /// Sets the seed value used by the simplex-noise function.
+        ///
+        /// @param seed The seed value.
+        void SetSeed (int seed)
+        {
+          m_seed = seed;
+        }
+
+      protected:
+
+        /// Frequency of the first octave.
+        double m_frequency;
+
+        /// Frequency multiplier between successive octaves.
+        double m_lacunarity;
+
+        /// Total number of octaves that generate the simplex noise.
+        int m_octaveCount;
+
+        /// Persistence of the simplex noise.
+        double m_persistence;
+
+        /// Spacing between the input values at which the application
+        /// samples the simplex noise.
+        double m_sampleSpacing;
+
+        /// Seed value used by the simplex-noise function.
+        int m_seed;
+
+      private:
+
+        /// Implements both versions of the GetValues() method.
+        template <class T>
+        void GetValuesImpl (int count, const T* x, const T* y, const T* z,
+          T* values) const;
+
+    };
+
+    /// @}
+
+    /// @}
+
+    /// @}
+
+  }
+
+}
+
+#endif
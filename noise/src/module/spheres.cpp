@@ -20,6 +20,7 @@
 // off every 'zig'.)
 //
 
+#include "../boundsimpl.h"
 #include "../misc.h"
 #include "spheres.h"
 
@@ -31,6 +32,50 @@ Spheres::Spheres ():
 {
 }
 
+void Spheres::GetBounds (double lowerX, double lowerY, double lowerZ,
+  double upperX, double upperY, double upperZ, double& lowerBound,
+  double& upperBound) const
+{
+  // Find the range of distances from the origin to the points within
+  // the box.
+  double minDist = 0.0;
+  double maxDist = 0.0;
+  const double lower[3] = {lowerX, lowerY, lowerZ};
+  const double upper[3] = {upperX, upperY, upperZ};
+  for (int i = 0; i < 3; i++) {
+    double lowerCoord, upperCoord;
+    MultiplyBounds (lower[i], upper[i], m_frequency, m_frequency, lowerCoord,
+      upperCoord);
+    double nearest = 0.0;
+    if (lowerCoord > 0.0) {
+      nearest = lowerCoord;
+    } else if (upperCoord < 0.0) {
+      nearest = -upperCoord;
+    }
+    double farthest = GetMax (fabs (lowerCoord), fabs (upperCoord));
+    minDist += nearest * nearest;
+    maxDist += farthest * farthest;
+  }
+  minDist = sqrt (minDist);
+  maxDist = sqrt (maxDist);
+
+  // If the box lies between two adjacent spheres, the output value follows
+  // the distance to the nearest one: it decreases from 1.0 to -1.0 halfway
+  // between them and then increases back to 1.0.
+  double base = floor (minDist);
+  if (maxDist < base + 1.0) {
+    double dist0 = minDist - base;
+    double dist1 = maxDist - base;
+    double value0 = 1.0 - (GetMin (dist0, 1.0 - dist0) * 4.0);
+    double value1 = 1.0 - (GetMin (dist1, 1.0 - dist1) * 4.0);
+    lowerBound = (dist0 <= 0.5 && dist1 >= 0.5)? -1.0: GetMin (value0, value1);
+    upperBound = GetMax (value0, value1);
+  } else {
+    lowerBound = -1.0;
+    upperBound = 1.0;
+  }
+}
+
 double Spheres::GetValue (double x, double y, double z) const
 {
   x *= m_frequency;
@@ -43,3 +88,24 @@ double Spheres::GetValue (double x, double y, double z) const
   double nearestDist = GetMin (distFromSmallerSphere, distFromLargerSphere);
   return 1.0 - (nearestDist * 4.0); // Puts it in the -1.0 to +1.0 range.
 }
+
+void Spheres::GetValues (int count, const double* x, const double* y,
+  const double* z, double* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+void Spheres::GetValues (int count, const float* x, const float* y,
+  const float* z, float* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+template <class T>
+void Spheres::GetValuesImpl (int count, const T* x, const T* y,
+  const T* z, T* values) const
+{
+  for (int i = 0; i < count; i++) {
+    values[i] = (T)Spheres::GetValue (x[i], y[i], z[i]);
+  }
+}
@@ -78,6 +78,10 @@ namespace noise
         /// noise::module::DEFAULT_SPHERES_FREQUENCY.
         Spheres ();
 
+        virtual void GetBounds (double lowerX, double lowerY, double lowerZ,
+          double upperX, double upperY, double upperZ, double& lowerBound,
+          double& upperBound) const;
+
         /// Returns the frequency of the concentric spheres.
         ///
         /// @returns The frequency of the concentric spheres.
@@ -96,6 +100,12 @@ namespace noise
 
         virtual double GetValue (double x, double y, double z) const;
 
+        virtual void GetValues (int count, const double* x, const double* y,
+          const double* z, double* values) const;
+
+        virtual void GetValues (int count, const float* x, const float* y,
+          const float* z, float* values) const;
+
         /// Sets the frequenct of the concentric spheres.
         ///
         /// @param frequency The frequency of the concentric spheres.
@@ -112,6 +122,13 @@ namespace noise
         /// Frequency of the concentric spheres.
         double m_frequency;
 
+      private:
+
+        /// Implements both versions of the GetValues() method.
+        template <class T>
+        void GetValuesImpl (int count, const T* x, const T* y, const T* z,
+          T* values) const;
+
     };
 
     /// @}
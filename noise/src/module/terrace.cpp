@@ -20,6 +20,7 @@
 // off every 'zig'.)
 //
 
+#include "../boundsimpl.h"
 #include "../interp.h"
 #include "../misc.h"
 #include "terrace.h"
@@ -74,13 +75,117 @@ int Terrace::FindInsertionPos (double value)
   return insertionPos;
 }
 
+void Terrace::GetBounds (double lowerX, double lowerY, double lowerZ,
+  double upperX, double upperY, double upperZ, double& lowerBound,
+  double& upperBound) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  double lower, upper;
+  m_pSourceModule[0]->GetBounds (lowerX, lowerY, lowerZ, upperX, upperY,
+    upperZ, lower, upper);
+  MapBounds (lower, upper, lowerBound, upperBound);
+}
+
 double Terrace::GetValue (double x, double y, double z) const
 {
   assert (m_pSourceModule[0] != NULL);
+
+  // Get the output value from the source module and map it onto the
+  // terrace-forming curve.
+  return MapValue (m_pSourceModule[0]->GetValue (x, y, z));
+}
+
+void Terrace::GetValues (int count, const double* x, const double* y,
+  const double* z, double* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+void Terrace::GetValues (int count, const float* x, const float* y,
+  const float* z, float* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+template <class T>
+void Terrace::GetValuesImpl (int count, const T* x, const T* y,
+  const T* z, T* values) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  m_pSourceModule[0]->GetValues (count, x, y, z, values);
+  for (int i = 0; i < count; i++) {
+    values[i] = (T)MapValue (values[i]);
+  }
+}
+
+void Terrace::InsertAtPos (int insertionPos, double value)
+{
+  // Make room for the new control point at the specified position within
+  // the control point array.  The position is determined by the value of
+  // the control point; the control points must be sorted by value within
+  // that array.
+  double* newControlPoints = new double[m_controlPointCount + 1];
+  for (int i = 0; i < m_controlPointCount; i++) {
+    if (i < insertionPos) {
+      newControlPoints[i] = m_pControlPoints[i];
+    } else {
+      newControlPoints[i + 1] = m_pControlPoints[i];
+    }
+  }
+  delete[] m_pControlPoints;
+  m_pControlPoints = newControlPoints;
+  ++m_controlPointCount;
+
+  // Now that we've made room for the new control point within the array,
+  // add the new control point.
+  m_pControlPoints[insertionPos] = value;
+}
+
+void Terrace::MapBounds (double lower, double upper, double& newLower,
+  double& newUpper) const
+{
   assert (m_controlPointCount >= 2);
 
-  // Get the output value from the source module.
-  double sourceModuleValue = m_pSourceModule[0]->GetValue (x, y, z);
+  int lastIndex = m_controlPointCount - 1;
+  newLower = HUGE_VAL;
+  newUpper = -HUGE_VAL;
+
+  // Values outside of the control point array map onto the value of the
+  // nearest control point.  NaN maps onto the last control point.
+  if (MayBeNaN (lower, upper)) {
+    upper = HUGE_VAL;
+  }
+  if (lower < m_pControlPoints[0]) {
+    newLower = GetMin (newLower, m_pControlPoints[0]);
+    newUpper = GetMax (newUpper, m_pControlPoints[0]);
+  }
+  if (upper >= m_pControlPoints[lastIndex]) {
+    newLower = GetMin (newLower, m_pControlPoints[lastIndex]);
+    newUpper = GetMax (newUpper, m_pControlPoints[lastIndex]);
+  }
+
+  // Within each terrace that the range overlaps, the squared alpha value
+  // ranges from 0.0 to 1.0, so the mapped value lies between the values of
+  // the two control points, whether or not the terraces are inverted.
+  for (int index1 = 1; index1 <= lastIndex; index1++) {
+    double value0 = m_pControlPoints[index1 - 1];
+    double value1 = m_pControlPoints[index1];
+    if (upper < value0 || lower >= value1) {
+      continue;
+    }
+    double lowerValue, upperValue;
+    LerpBounds (value0, value0, value1, value1, 0.0, 1.0, lowerValue,
+      upperValue);
+    newLower = GetMin (newLower, lowerValue);
+    newUpper = GetMax (newUpper, upperValue);
+  }
+}
+
+double Terrace::MapValue (double sourceModuleValue) const
+{
+  assert (m_controlPointCount >= 2);
 
   // Find the first element in the control point array that has a value
   // larger than the output value from the source module.
@@ -120,29 +225,6 @@ double Terrace::GetValue (double x, double y, double z) const
   return LinearInterp (value0, value1, alpha);
 }
 
-void Terrace::InsertAtPos (int insertionPos, double value)
-{
-  // Make room for the new control point at the specified position within
-  // the control point array.  The position is determined by the value of
-  // the control point; the control points must be sorted by value within
-  // that array.
-  double* newControlPoints = new double[m_controlPointCount + 1];
-  for (int i = 0; i < m_controlPointCount; i++) {
-    if (i < insertionPos) {
-      newControlPoints[i] = m_pControlPoints[i];
-    } else {
-      newControlPoints[i + 1] = m_pControlPoints[i];
-    }
-  }
-  delete[] m_pControlPoints;
-  m_pControlPoints = newControlPoints;
-  ++m_controlPointCount;
-
-  // Now that we've made room for the new control point within the array,
-  // add the new control point.
-  m_pControlPoints[insertionPos] = value;
-}
-
 void Terrace::MakeControlPoints (int controlPointCount)
 {
   if (controlPointCount < 2) {
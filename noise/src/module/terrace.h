@@ -102,6 +102,10 @@ namespace noise
 	      /// @post All control points on the terrace-forming curve are deleted.
 	      void ClearAllControlPoints ();
 
+	      virtual void GetBounds (double lowerX, double lowerY, double lowerZ,
+	        double upperX, double upperY, double upperZ, double& lowerBound,
+	        double& upperBound) const;
+
 	      /// Returns a pointer to the array of control points on the
 	      /// terrace-forming curve.
 	      ///
@@ -161,6 +165,12 @@ namespace noise
 
     	  virtual double GetValue (double x, double y, double z) const;
 
+    	  virtual void GetValues (int count, const double* x, const double* y,
+    	    const double* z, double* values) const;
+
+        virtual void GetValues (int count, const float* x, const float* y,
+          const float* z, float* values) const;
+
 	      /// Creates a number of equally-spaced control points that range from
         /// -1 to +1.
 	      ///
@@ -217,6 +227,30 @@ namespace noise
         /// order is still preserved.
 	      void InsertAtPos (int insertionPos, double value);
 
+        /// Maps a range of output values from the source module onto the
+        /// terrace-forming curve.
+        ///
+        /// @param lower The lower bound of the output values from the source
+        /// module.
+        /// @param upper The upper bound of the output values from the source
+        /// module.
+        /// @param newLower Receives the lower bound of the mapped values.
+        /// @param newUpper Receives the upper bound of the mapped values.
+        ///
+        /// @pre There are at least two control points on the curve.
+        void MapBounds (double lower, double upper, double& newLower,
+          double& newUpper) const;
+
+        /// Maps an output value from the source module onto the
+        /// terrace-forming curve.
+        ///
+        /// @param sourceModuleValue The output value from the source module.
+        ///
+        /// @returns The mapped value.
+        ///
+        /// @pre There are at least two control points on the curve.
+        double MapValue (double sourceModuleValue) const;
+
 	      /// Number of control points stored in this noise module.
 	      int m_controlPointCount;
 
@@ -227,6 +261,17 @@ namespace noise
 	      /// Array that stores the control points.
 	      double* m_pControlPoints;
 
+      private:
+
+        /// The noise::module::Program noise module maps its values onto the
+        /// terrace-forming curve directly.
+        friend class Program;
+
+        /// Implements both versions of the GetValues() method.
+        template <class T>
+        void GetValuesImpl (int count, const T* x, const T* y, const T* z,
+          T* values) const;
+
     };
 
     /// @}
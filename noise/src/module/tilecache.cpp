@@ -0,0 +1,548 @@
+// tilecache.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+#include "../misc.h"
+#include "../threadimpl.h"
+#include "tilecache.h"
+
+using namespace noise;
+using namespace noise::module;
+
+struct TileCache::Tile
+{
+  // Indices of the tile; the tile with the indices (0, 0, 0) contains the
+  // grid origin.
+  int i;
+  int j;
+  int k;
+
+  // The output values at the grid points of the tile, with the @a x index
+  // varying fastest and the @a z index varying slowest.
+  double* values;
+
+  // The next tile in the same hash bucket.
+  Tile* pNextInBucket;
+
+  // The next more recently used and next less recently used tiles.
+  Tile* pNewer;
+  Tile* pOlder;
+};
+
+struct TileCache::ThreadState
+{
+  // The hash buckets, or NULL if they have not been allocated.
+  Tile** pBuckets;
+
+  // One less than the number of hash buckets, which is a power of two.
+  int bucketMask;
+
+  // The most recently used and least recently used tiles.
+  Tile* pNewest;
+  Tile* pOldest;
+
+  // The number of stored tiles.
+  int tileCount;
+
+  // The number of bytes used by the stored tiles and the hash buckets,
+  // which are counted against the memory budget of the noise module.
+  size_t residentBytes;
+
+  ThreadState ():
+    pBuckets (NULL),
+    bucketMask (0),
+    pNewest (NULL),
+    pOldest (NULL),
+    tileCount (0),
+    residentBytes (0)
+  {
+  }
+
+  ~ThreadState ()
+  {
+    Clear ();
+  }
+
+  // Discards all tiles and frees the hash buckets.  Returns the number of
+  // bytes that were freed.
+  size_t Clear ()
+  {
+    Tile* pTile = pNewest;
+    while (pTile != NULL) {
+      Tile* pOlderTile = pTile->pOlder;
+      delete[] pTile->values;
+      delete pTile;
+      pTile = pOlderTile;
+    }
+    delete[] pBuckets;
+    pBuckets = NULL;
+    bucketMask = 0;
+    pNewest = NULL;
+    pOldest = NULL;
+    tileCount = 0;
+    size_t freedBytes = residentBytes;
+    residentBytes = 0;
+    return freedBytes;
+  }
+
+  // Returns the hash bucket of the tile with the specified indices.
+  Tile*& GetBucket (int i, int j, int k)
+  {
+    uint32 hash = (uint32)i * 73856093 ^ (uint32)j * 19349663
+      ^ (uint32)k * 83492791;
+    return pBuckets[hash & bucketMask];
+  }
+
+  // Makes a tile the most recently used tile.
+  void MakeNewest (Tile* pTile)
+  {
+    pTile->pNewer = NULL;
+    pTile->pOlder = pNewest;
+    if (pNewest != NULL) {
+      pNewest->pNewer = pTile;
+    } else {
+      pOldest = pTile;
+    }
+    pNewest = pTile;
+  }
+
+  // Replaces the hash buckets with the specified number of buckets, which
+  // must be a power of two, and moves the stored tiles into them.
+  void Rehash (int bucketCount)
+  {
+    Tile** pNewBuckets = new Tile*[bucketCount];
+    for (int i = 0; i < bucketCount; i++) {
+      pNewBuckets[i] = NULL;
+    }
+    delete[] pBuckets;
+    pBuckets = pNewBuckets;
+    bucketMask = bucketCount - 1;
+    for (Tile* pTile = pNewest; pTile != NULL; pTile = pTile->pOlder) {
+      Tile*& bucket = GetBucket (pTile->i, pTile->j, pTile->k);
+      pTile->pNextInBucket = bucket;
+      bucket = pTile;
+    }
+  }
+
+  // Removes a tile from the list of tiles ordered by use.
+  void RemoveFromList (Tile* pTile)
+  {
+    if (pTile->pNewer != NULL) {
+      pTile->pNewer->pOlder = pTile->pOlder;
+    } else {
+      pNewest = pTile->pOlder;
+    }
+    if (pTile->pOlder != NULL) {
+      pTile->pOlder->pNewer = pTile->pNewer;
+    } else {
+      pOldest = pTile->pNewer;
+    }
+  }
+
+  // Removes a tile from its hash bucket.
+  void RemoveFromBucket (Tile* pTile)
+  {
+    Tile** ppTile = &GetBucket (pTile->i, pTile->j, pTile->k);
+    while (*ppTile != pTile) {
+      ppTile = &(*ppTile)->pNextInBucket;
+    }
+    *ppTile = pTile->pNextInBucket;
+  }
+};
+
+struct TileCache::ThreadStorage: public PerThread<ThreadState>
+{
+  // The number of bytes used by the tiles of all threads.  Each thread
+  // adds to it before it allocates memory, so the memory budget is shared
+  // by all threads without a lock.
+  volatile size_t residentBytes;
+
+  // The number of threads that store at least one tile.  Each of them is
+  // entitled to an equal share of the memory budget.
+  volatile int activeThreadCount;
+
+  ThreadStorage ():
+    residentBytes (0),
+    activeThreadCount (0)
+  {
+  }
+
+  // Discards the tiles of a thread and returns their memory to the
+  // budget.
+  void Discard (ThreadState& state)
+  {
+    if (state.tileCount > 0) {
+      AtomicAdd (activeThreadCount, -1);
+    }
+    Release (state.Clear ());
+  }
+
+  // Stops counting memory against the memory budget.
+  void Release (size_t bytes)
+  {
+    AtomicAdd (residentBytes, (size_t)0 - bytes);
+  }
+
+  // Counts memory against the memory budget if it fits within the budget.
+  // Returns false, without counting it, if it does not fit.
+  bool Reserve (size_t bytes, size_t memoryBudget)
+  {
+    size_t previousBytes = AtomicAdd (residentBytes, bytes);
+    if (bytes > memoryBudget || previousBytes > memoryBudget - bytes) {
+      Release (bytes);
+      return false;
+    }
+    return true;
+  }
+
+protected:
+
+  virtual void OnThreadExit (ThreadState& state)
+  {
+    Discard (state);
+  }
+};
+
+// Returns the index of the tile that contains the grid point with the
+// specified index along one axis.
+static inline int GetTileIndex (int index, int tileSize)
+{
+  return index >= 0? index / tileSize: -((-index - 1) / tileSize) - 1;
+}
+
+// Returns the index of the grid point at a coordinate along one axis, and
+// determines if the coordinate lies exactly on that grid point.
+static inline bool GetGridIndex (double value, double origin, double spacing,
+  int& index)
+{
+  // Grid points far from the origin are not cached, so that the indices of
+  // a tile and its grid points cannot overflow.
+  double nearest = floor ((value - origin) / spacing + 0.5);
+  if (!(nearest >= -1073741824.0 && nearest <= 1073741824.0)) {
+    return false;
+  }
+  index = (int)nearest;
+  return origin + index * spacing == value;
+}
+
+TileCache::TileCache ():
+  Module (GetSourceModuleCount ()),
+  m_memoryBudget (DEFAULT_TILECACHE_MEMORY_BUDGET),
+  m_originX (0.0),
+  m_originY (0.0),
+  m_originZ (0.0),
+  m_spacingX (1.0),
+  m_spacingY (1.0),
+  m_spacingZ (1.0),
+  m_tileSizeX (DEFAULT_TILECACHE_TILE_SIZE_X),
+  m_tileSizeY (DEFAULT_TILECACHE_TILE_SIZE_Y),
+  m_tileSizeZ (DEFAULT_TILECACHE_TILE_SIZE_Z)
+{
+  m_pStorage = new ThreadStorage;
+}
+
+TileCache::~TileCache ()
+{
+  delete m_pStorage;
+}
+
+void TileCache::ClearTiles ()
+{
+  m_pStorage->LockList ();
+  for (ThreadStorage::Node* pNode = m_pStorage->GetFirst (); pNode != NULL;
+    pNode = pNode->pNext) {
+    m_pStorage->Discard (pNode->value);
+  }
+  m_pStorage->UnlockList ();
+}
+
+void TileCache::ComputeTile (Tile& tile) const
+{
+  double x[MODULE_BATCH_SIZE];
+  double y[MODULE_BATCH_SIZE];
+  double z[MODULE_BATCH_SIZE];
+  int pointCount = m_tileSizeX * m_tileSizeY * m_tileSizeZ;
+  int i0 = tile.i * m_tileSizeX;
+  int j0 = tile.j * m_tileSizeY;
+  int k0 = tile.k * m_tileSizeZ;
+  int i = 0;
+  int j = 0;
+  int k = 0;
+  for (int offset = 0; offset < pointCount; offset += MODULE_BATCH_SIZE) {
+    int n = GetMin (pointCount - offset, MODULE_BATCH_SIZE);
+    for (int p = 0; p < n; p++) {
+      x[p] = m_originX + (i0 + i) * m_spacingX;
+      y[p] = m_originY + (j0 + j) * m_spacingY;
+      z[p] = m_originZ + (k0 + k) * m_spacingZ;
+      if (++i == m_tileSizeX) {
+        i = 0;
+        if (++j == m_tileSizeY) {
+          j = 0;
+          k++;
+        }
+      }
+    }
+    m_pSourceModule[0]->GetValues (n, x, y, z, tile.values + offset);
+  }
+}
+
+bool TileCache::GetGridPoint (double x, double y, double z, int& i, int& j,
+  int& k) const
+{
+  return GetGridIndex (x, m_originX, m_spacingX, i)
+      && GetGridIndex (y, m_originY, m_spacingY, j)
+      && GetGridIndex (z, m_originZ, m_spacingZ, k);
+}
+
+bool TileCache::GetGridValue (ThreadState& state, int i, int j, int k,
+  Tile*& pTile, double& value) const
+{
+  int ti = GetTileIndex (i, m_tileSizeX);
+  int tj = GetTileIndex (j, m_tileSizeY);
+  int tk = GetTileIndex (k, m_tileSizeZ);
+  if (pTile == NULL || pTile->i != ti || pTile->j != tj || pTile->k != tk) {
+    pTile = NULL;
+    if (state.pBuckets != NULL) {
+      pTile = state.GetBucket (ti, tj, tk);
+      while (pTile != NULL
+        && !(pTile->i == ti && pTile->j == tj && pTile->k == tk)) {
+        pTile = pTile->pNextInBucket;
+      }
+    }
+
+    if (pTile != NULL) {
+      state.RemoveFromList (pTile);
+    } else if ((pTile = NewTile (state)) != NULL) {
+      pTile->i = ti;
+      pTile->j = tj;
+      pTile->k = tk;
+      ComputeTile (*pTile);
+      Tile*& newBucket = state.GetBucket (ti, tj, tk);
+      pTile->pNextInBucket = newBucket;
+      newBucket = pTile;
+    } else {
+      return false;
+    }
+    state.MakeNewest (pTile);
+  }
+
+  int localI = i - ti * m_tileSizeX;
+  int localJ = j - tj * m_tileSizeY;
+  int localK = k - tk * m_tileSizeZ;
+  value = pTile->values[(localK * m_tileSizeY + localJ) * m_tileSizeX
+    + localI];
+  return true;
+}
+
+size_t TileCache::GetMemoryUsage () const
+{
+  return m_pStorage->residentBytes;
+}
+
+TileCache::Tile* TileCache::NewTile (ThreadState& state) const
+{
+  int pointCount = m_tileSizeX * m_tileSizeY * m_tileSizeZ;
+  size_t tileBytes = sizeof (Tile) + sizeof (double) * pointCount;
+  int activeThreadCount = m_pStorage->activeThreadCount;
+  if (state.tileCount == 0) {
+    activeThreadCount++;
+  }
+  size_t share = m_memoryBudget / GetMax (activeThreadCount, 1);
+
+  // Free the least recently used tiles of this thread while it uses more
+  // than its share of the memory budget, so that threads that started
+  // later can store tiles too.
+  while (state.tileCount > 1 && state.residentBytes > share) {
+    Tile* pOldTile = state.pOldest;
+    state.RemoveFromList (pOldTile);
+    state.RemoveFromBucket (pOldTile);
+    delete[] pOldTile->values;
+    delete pOldTile;
+    state.tileCount--;
+    state.residentBytes -= tileBytes;
+    m_pStorage->Release (tileBytes);
+  }
+
+  // Allocate a new tile if it fits in this thread's share and in the
+  // memory budget; the first tile of a thread also needs a hash bucket.
+  size_t bytes = tileBytes;
+  if (state.pBuckets == NULL) {
+    bytes += sizeof (Tile*);
+  }
+  if (state.residentBytes + bytes > share
+    || !m_pStorage->Reserve (bytes, m_memoryBudget)) {
+    if (state.tileCount == 0) {
+      return NULL;
+    }
+    Tile* pTile = state.pOldest;
+    state.RemoveFromList (pTile);
+    state.RemoveFromBucket (pTile);
+    return pTile;
+  }
+  Tile* pTile = NULL;
+  try {
+    if (state.pBuckets == NULL) {
+      state.Rehash (1);
+    }
+    pTile = new Tile;
+    pTile->values = NULL;
+    pTile->values = new double[pointCount];
+  } catch (...) {
+    delete pTile;
+    m_pStorage->Release (bytes);
+    throw;
+  }
+  state.residentBytes += bytes;
+  if (state.tileCount++ == 0) {
+    AtomicAdd (m_pStorage->activeThreadCount, 1);
+  }
+
+  // Keep about one tile per hash bucket.  If the larger buckets do not fit
+  // in the memory budget, the existing buckets are kept.
+  int bucketCount = state.bucketMask + 1;
+  size_t bucketBytes = sizeof (Tile*) * bucketCount;
+  if (state.tileCount > bucketCount && bucketCount < (1 << 20)
+    && m_pStorage->Reserve (bucketBytes, m_memoryBudget)) {
+    try {
+      state.Rehash (bucketCount * 2);
+      state.residentBytes += bucketBytes;
+    } catch (...) {
+      m_pStorage->Release (bucketBytes);
+    }
+  }
+  return pTile;
+}
+
+TileCache::ThreadState& TileCache::GetThreadState () const
+{
+  return m_pStorage->Get ();
+}
+
+void TileCache::GetBounds (double lowerX, double lowerY, double lowerZ,
+  double upperX, double upperY, double upperZ, double& lowerBound,
+  double& upperBound) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  m_pSourceModule[0]->GetBounds (lowerX, lowerY, lowerZ, upperX, upperY,
+    upperZ, lowerBound, upperBound);
+}
+
+double TileCache::GetValue (double x, double y, double z) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  int i, j, k;
+  if (!GetGridPoint (x, y, z, i, j, k)) {
+    return m_pSourceModule[0]->GetValue (x, y, z);
+  }
+  Tile* pTile = NULL;
+  double value;
+  if (!GetGridValue (GetThreadState (), i, j, k, pTile, value)) {
+    return m_pSourceModule[0]->GetValue (x, y, z);
+  }
+  return value;
+}
+
+void TileCache::GetValues (int count, const double* x, const double* y,
+  const double* z, double* values) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  // Input values that do not lie on grid points, or whose tiles cannot be
+  // stored, are gathered and passed to the source module in a single call.
+  int missIndex[MODULE_BATCH_SIZE];
+  double xMiss[MODULE_BATCH_SIZE];
+  double yMiss[MODULE_BATCH_SIZE];
+  double zMiss[MODULE_BATCH_SIZE];
+  double missValues[MODULE_BATCH_SIZE];
+  ThreadState& state = GetThreadState ();
+  Tile* pTile = NULL;
+  for (int offset = 0; offset < count; offset += MODULE_BATCH_SIZE) {
+    int n = GetMin (count - offset, MODULE_BATCH_SIZE);
+    int missCount = 0;
+    for (int p = offset; p < offset + n; p++) {
+      int i, j, k;
+      if (!GetGridPoint (x[p], y[p], z[p], i, j, k)
+        || !GetGridValue (state, i, j, k, pTile, values[p])) {
+        missIndex[missCount] = p;
+        xMiss    [missCount] = x[p];
+        yMiss    [missCount] = y[p];
+        zMiss    [missCount] = z[p];
+        missCount++;
+      }
+    }
+    if (missCount > 0) {
+      m_pSourceModule[0]->GetValues (missCount, xMiss, yMiss, zMiss,
+        missValues);
+      for (int p = 0; p < missCount; p++) {
+        values[missIndex[p]] = missValues[p];
+      }
+    }
+  }
+}
+
+void TileCache::GetValues (int count, const float* x, const float* y,
+  const float* z, float* values) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  m_pSourceModule[0]->GetValues (count, x, y, z, values);
+}
+
+void TileCache::SetGrid (double originX, double originY, double originZ,
+  double spacingX, double spacingY, double spacingZ)
+{
+  if (!(spacingX > 0.0 && spacingY > 0.0 && spacingZ > 0.0)) {
+    throw noise::ExceptionInvalidParam ();
+  }
+  m_originX = originX;
+  m_originY = originY;
+  m_originZ = originZ;
+  m_spacingX = spacingX;
+  m_spacingY = spacingY;
+  m_spacingZ = spacingZ;
+  ClearTiles ();
+}
+
+void TileCache::SetMemoryBudget (size_t memoryBudget)
+{
+  m_memoryBudget = memoryBudget;
+  ClearTiles ();
+}
+
+void TileCache::SetSourceModule (int index, const Module& sourceModule)
+{
+  Module::SetSourceModule (index, sourceModule);
+  ClearTiles ();
+}
+
+void TileCache::SetTileSize (int tileSizeX, int tileSizeY, int tileSizeZ)
+{
+  if (tileSizeX < 1 || tileSizeY < 1 || tileSizeZ < 1
+    || tileSizeX > TILECACHE_MAX_TILE_POINT_COUNT / tileSizeY / tileSizeZ) {
+    throw noise::ExceptionInvalidParam ();
+  }
+  m_tileSizeX = tileSizeX;
+  m_tileSizeY = tileSizeY;
+  m_tileSizeZ = tileSizeZ;
+  ClearTiles ();
+}
@@ -0,0 +1,361 @@
+// tilecache.h
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+#ifndef NOISE_MODULE_TILECACHE_H
+#define NOISE_MODULE_TILECACHE_H
+
+#include <stddef.h>
+#include "modulebase.h"
+
+namespace noise
+{
+
+  namespace module
+  {
+
+    /// @addtogroup libnoise
+    /// @{
+
+    /// @addtogroup modules
+    /// @{
+
+    /// @addtogroup miscmodules
+    /// @{
+
+    /// Default memory budget, in bytes, of a noise::module::TileCache noise
+    /// module.
+    const size_t DEFAULT_TILECACHE_MEMORY_BUDGET = 64 * 1024 * 1024;
+
+    /// Default size of a tile along the @a x axis, in grid points, of a
+    /// noise::module::TileCache noise module.
+    const int DEFAULT_TILECACHE_TILE_SIZE_X = 32;
+
+    /// Default size of a tile along the @a y axis, in grid points, of a
+    /// noise::module::TileCache noise module.
+    const int DEFAULT_TILECACHE_TILE_SIZE_Y = 1;
+
+    /// Default size of a tile along the @a z axis, in grid points, of a
+    /// noise::module::TileCache noise module.
+    const int DEFAULT_TILECACHE_TILE_SIZE_Z = 32;
+
+    /// Maximum number of grid points in a tile of a
+    /// noise::module::TileCache noise module.
+    const int TILECACHE_MAX_TILE_POINT_COUNT = 1024 * 1024;
+
+    /// Noise module that caches the output values generated by a source
+    /// module over whole tiles of a grid.
+    ///
+    /// This noise module defines a grid of input values by an origin and a
+    /// spacing along each axis; the grid point with the indices
+    /// ( @a i, @a j, @a k ) has the coordinates ( <i>originX + i *
+    /// spacingX</i>, <i>originY + j * spacingY</i>, <i>originZ + k *
+    /// spacingZ</i> ).  The grid is divided into tiles, which by default
+    /// are 32 grid points along the @a x and @a z axes and one grid point
+    /// along the @a y axis.
+    ///
+    /// When an application passes an input value that lies exactly on a
+    /// grid point, this noise module generates the output values of the
+    /// source module for every grid point in the tile that contains it,
+    /// in a single call to the source module's GetValues() method, and
+    /// stores them.  Later input values within that tile are answered from
+    /// memory.  Input values that do not lie on a grid point are passed to
+    /// the source module.
+    ///
+    /// This is useful if an expensive source module is evaluated
+    /// repeatedly over the same region; for example, by several
+    /// noise::module::Terrace, noise::module::Curve, or
+    /// noise::module::Select chains that share it, or by several passes
+    /// over the same noise map.  To generate a noise map with a
+    /// noise::model::Plane model, set the grid origin to the lower bounds
+    /// of the map and the spacing to the distance between adjacent
+    /// output values; the model then generates input values that lie
+    /// exactly on grid points.
+    ///
+    /// Each thread that calls this noise module has its own tiles, so it
+    /// can be called from several threads at the same time.  The memory
+    /// budget is shared by the tiles of all threads; each thread that
+    /// stores tiles may use an equal share of it.  When a thread needs a
+    /// new tile and its share is used up, it reuses its own tile that was
+    /// least recently used, and a thread that cannot store any tile passes
+    /// its input values to the source module.  The tiles of a thread are
+    /// discarded when the thread exits.  Only double-precision output
+    /// values are cached; single-precision input values are passed to the
+    /// source module.
+    ///
+    /// If an application changes the grid, the tile size, the memory
+    /// budget, or the source module, the stored tiles are discarded.
+    /// These methods must not be called while another thread is calling
+    /// this noise module.
+    ///
+    /// This noise module requires one source module.
+    class TileCache: public Module
+    {
+
+      public:
+
+        /// Constructor.
+        ///
+        /// The grid origin is set to (0.0, 0.0, 0.0) and the grid spacing
+        /// to 1.0 along each axis.
+        ///
+        /// The default memory budget is set to
+        /// noise::module::DEFAULT_TILECACHE_MEMORY_BUDGET.
+        ///
+        /// The default tile size is set to
+        /// noise::module::DEFAULT_TILECACHE_TILE_SIZE_X,
+        /// noise::module::DEFAULT_TILECACHE_TILE_SIZE_Y, and
+        /// noise::module::DEFAULT_TILECACHE_TILE_SIZE_Z.
+        ///
+        /// @throw noise::ExceptionOutOfMemory
+        /// - The operating system could not provide storage for the tiles
+        ///   of each thread.
+        TileCache ();
+
+        /// Destructor.
+        ~TileCache ();
+
+        virtual void GetBounds (double lowerX, double lowerY, double lowerZ,
+          double upperX, double upperY, double upperZ, double& lowerBound,
+          double& upperBound) const;
+
+        /// Returns the memory budget, in bytes.
+        ///
+        /// @returns The memory budget.
+        size_t GetMemoryBudget () const
+        {
+          return m_memoryBudget;
+        }
+
+        /// Returns the memory used by the stored tiles of all threads, in
+        /// bytes.
+        ///
+        /// @returns The memory used by the stored tiles.
+        ///
+        /// The memory usage includes the bookkeeping for the tiles.  It
+        /// does not exceed the memory budget.
+        size_t GetMemoryUsage () const;
+
+        virtual int GetSourceModuleCount () const
+        {
+          return 1;
+        }
+
+        /// Returns the number of grid points in a tile along the @a x axis.
+        ///
+        /// @returns The tile size along the @a x axis.
+        int GetTileSizeX () const
+        {
+          return m_tileSizeX;
+        }
+
+        /// Returns the number of grid points in a tile along the @a y axis.
+        ///
+        /// @returns The tile size along the @a y axis.
+        int GetTileSizeY () const
+        {
+          return m_tileSizeY;
+        }
+
+        /// Returns the number of grid points in a tile along the @a z axis.
+        ///
+        /// @returns The tile size along the @a z axis.
+        int GetTileSizeZ () const
+        {
+          return m_tileSizeZ;
+        }
+
+        virtual double GetValue (double x, double y, double z) const;
+
+        virtual void GetValues (int count, const double* x, const double* y,
+          const double* z, double* values) const;
+
+        virtual void GetValues (int count, const float* x, const float* y,
+          const float* z, float* values) const;
+
+        /// Sets the grid on which the output values are cached.
+        ///
+        /// @param originX The @a x coordinate of the grid point with the
+        /// indices (0, 0, 0).
+        /// @param originY The @a y coordinate of that grid point.
+        /// @param originZ The @a z coordinate of that grid point.
+        /// @param spacingX The distance between grid points along the @a x
+        /// axis.
+        /// @param spacingY The distance between grid points along the @a y
+        /// axis.
+        /// @param spacingZ The distance between grid points along the @a z
+        /// axis.
+        ///
+        /// @pre The spacing along each axis is greater than 0.0.
+        ///
+        /// @throw noise::ExceptionInvalidParam
+        /// - An invalid parameter was specified; see the preconditions for
+        ///   more information.
+        void SetGrid (double originX, double originY, double originZ,
+          double spacingX, double spacingY, double spacingZ);
+
+        /// Sets the memory budget.
+        ///
+        /// @param memoryBudget The memory budget, in bytes.
+        ///
+        /// The tiles of all threads, along with their bookkeeping, do not
+        /// use more memory than this budget.  If the budget is smaller than
+        /// a tile, no tiles are stored.
+        void SetMemoryBudget (size_t memoryBudget);
+
+        virtual void SetSourceModule (int index, const Module& sourceModule);
+
+        /// Sets the number of grid points in a tile along each axis.
+        ///
+        /// @param tileSizeX The tile size along the @a x axis.
+        /// @param tileSizeY The tile size along the @a y axis.
+        /// @param tileSizeZ The tile size along the @a z axis.
+        ///
+        /// @pre Each tile size is at least 1.
+        /// @pre The number of grid points in a tile does not exceed
+        /// noise::module::TILECACHE_MAX_TILE_POINT_COUNT.
+        ///
+        /// @throw noise::ExceptionInvalidParam
+        /// - An invalid parameter was specified; see the preconditions for
+        ///   more information.
+        void SetTileSize (int tileSizeX, int tileSizeY, int tileSizeZ);
+
+      private:
+
+        /// A tile of stored output values.
+        struct Tile;
+
+        /// The tiles of one thread.
+        struct ThreadState;
+
+        /// The storage for the tiles of each thread.
+        struct ThreadStorage;
+
+        /// Discards the tiles of every thread.
+        void ClearTiles ();
+
+        /// Generates the output values of the source module for every grid
+        /// point in a tile.
+        ///
+        /// @param tile The tile; its indices must be set.
+        void ComputeTile (Tile& tile) const;
+
+        /// Returns the indices of the grid point at an input value.
+        ///
+        /// @param x The @a x coordinate of the input value.
+        /// @param y The @a y coordinate of the input value.
+        /// @param z The @a z coordinate of the input value.
+        /// @param i On exit, the index of the grid point along the @a x
+        /// axis.
+        /// @param j On exit, the index of the grid point along the @a y
+        /// axis.
+        /// @param k On exit, the index of the grid point along the @a z
+        /// axis.
+        ///
+        /// @returns
+        /// - @a true if the input value lies exactly on a grid point.
+        /// - @a false if not.
+        bool GetGridPoint (double x, double y, double z, int& i, int& j,
+          int& k) const;
+
+        /// Returns the stored output value at a grid point, generating the
+        /// tile that contains it if necessary.
+        ///
+        /// @param state The tiles of the calling thread.
+        /// @param i The index of the grid point along the @a x axis.
+        /// @param j The index of the grid point along the @a y axis.
+        /// @param k The index of the grid point along the @a z axis.
+        /// @param pTile A pointer to the tile that was last used by the
+        /// caller, or NULL; on exit, a pointer to the tile that contains
+        /// the grid point.
+        /// @param value On exit, the output value at the grid point.
+        ///
+        /// @returns
+        /// - @a true if the output value was found or generated.
+        /// - @a false if the tile that contains the grid point could not be
+        ///   stored within the memory budget.
+        bool GetGridValue (ThreadState& state, int i, int j, int k,
+          Tile*& pTile, double& value) const;
+
+        /// Returns the tiles of the calling thread.
+        ///
+        /// @returns A reference to the tiles.
+        ThreadState& GetThreadState () const;
+
+        /// Returns a tile in which a new tile can be generated.
+        ///
+        /// @param state The tiles of the calling thread.
+        ///
+        /// @returns A pointer to a newly allocated tile, or to the least
+        /// recently used tile of the calling thread, which has been removed
+        /// from the stored tiles; NULL if the calling thread has no tiles
+        /// and no new tile fits within the memory budget.
+        ///
+        /// Tiles of the calling thread that exceed its share of the memory
+        /// budget are freed first.
+        Tile* NewTile (ThreadState& state) const;
+
+        /// The memory budget shared by all threads, in bytes.
+        size_t m_memoryBudget;
+
+        /// The @a x coordinate of the grid origin.
+        double m_originX;
+
+        /// The @a y coordinate of the grid origin.
+        double m_originY;
+
+        /// The @a z coordinate of the grid origin.
+        double m_originZ;
+
+        /// The storage for the tiles of each thread.
+        ThreadStorage* m_pStorage;
+
+        /// The distance between grid points along the @a x axis.
+        double m_spacingX;
+
+        /// The distance between grid points along the @a y axis.
+        double m_spacingY;
+
+        /// The distance between grid points along the @a z axis.
+        double m_spacingZ;
+
+        /// The number of grid points in a tile along the @a x axis.
+        int m_tileSizeX;
+
+        /// The number of grid points in a tile along the @a y axis.
+        int m_tileSizeY;
+
+        /// The number of grid points in a tile along the @a z axis.
+        int m_tileSizeZ;
+
+    };
+
+    /// @}
+
+    /// @}
+
+    /// @}
+
+  }
+
+}
+
+#endif
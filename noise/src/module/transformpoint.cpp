@@ -0,0 +1,191 @@
+// transformpoint.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+
+#include <typeinfo>
+#include "../boundsimpl.h"
+#include "../misc.h"
+#include "rotatepoint.h"
+#include "scalepoint.h"
+#include "transformpoint.h"
+#include "translatepoint.h"
+
+using namespace noise::module;
+
+// The identity matrix.
+static const double IDENTITY_MATRIX[12] = {
+  1.0, 0.0, 0.0, 0.0,
+  0.0, 1.0, 0.0, 0.0,
+  0.0, 0.0, 1.0, 0.0
+};
+
+TransformPoint::TransformPoint ():
+  Module (GetSourceModuleCount ())
+{
+  SetMatrix (IDENTITY_MATRIX);
+}
+
+bool TransformPoint::AppendTransform (const Module& transformer)
+{
+  // Retrieve the matrix of the transformer module.
+  double step[12];
+  const std::type_info& type = typeid (transformer);
+  if (type == typeid (RotatePoint)) {
+    const RotatePoint& rotatePoint = (const RotatePoint&)transformer;
+    step[ 0] = rotatePoint.m_x1Matrix;
+    step[ 1] = rotatePoint.m_y1Matrix;
+    step[ 2] = rotatePoint.m_z1Matrix;
+    step[ 3] = 0.0;
+    step[ 4] = rotatePoint.m_x2Matrix;
+    step[ 5] = rotatePoint.m_y2Matrix;
+    step[ 6] = rotatePoint.m_z2Matrix;
+    step[ 7] = 0.0;
+    step[ 8] = rotatePoint.m_x3Matrix;
+    step[ 9] = rotatePoint.m_y3Matrix;
+    step[10] = rotatePoint.m_z3Matrix;
+    step[11] = 0.0;
+  } else if (type == typeid (ScalePoint)) {
+    const ScalePoint& scalePoint = (const ScalePoint&)transformer;
+    for (int i = 0; i < 12; i++) {
+      step[i] = 0.0;
+    }
+    step[ 0] = scalePoint.GetXScale ();
+    step[ 5] = scalePoint.GetYScale ();
+    step[10] = scalePoint.GetZScale ();
+  } else if (type == typeid (TranslatePoint)) {
+    const TranslatePoint& translatePoint
+      = (const TranslatePoint&)transformer;
+    for (int i = 0; i < 12; i++) {
+      step[i] = IDENTITY_MATRIX[i];
+    }
+    step[ 3] = translatePoint.GetXTranslation ();
+    step[ 7] = translatePoint.GetYTranslation ();
+    step[11] = translatePoint.GetZTranslation ();
+  } else if (type == typeid (TransformPoint)) {
+    const double* pMatrix = ((const TransformPoint&)transformer).m_matrix;
+    for (int i = 0; i < 12; i++) {
+      step[i] = pMatrix[i];
+    }
+  } else {
+    return false;
+  }
+
+  // The new transformation is applied after the current transformation,
+  // so the new matrix is the product of the two matrices, with the
+  // translation of the current transformation transformed as a point.
+  double product[12];
+  for (int row = 0; row < 3; row++) {
+    for (int col = 0; col < 4; col++) {
+      double sum = (col == 3)? step[row * 4 + 3]: 0.0;
+      for (int k = 0; k < 3; k++) {
+        sum += step[row * 4 + k] * m_matrix[k * 4 + col];
+      }
+      product[row * 4 + col] = sum;
+    }
+  }
+  SetMatrix (product);
+  return true;
+}
+
+int TransformPoint::CollapseChain (const Module& transformer)
+{
+  // Combine the transformations of the chain before changing this noise
+  // module, since the chain may contain this noise module.
+  TransformPoint chain;
+  const Module* pModule = &transformer;
+  int chainLength = 0;
+  while (chain.AppendTransform (*pModule)) {
+    pModule = &pModule->GetSourceModule (0);
+    chainLength++;
+  }
+  SetMatrix (chain.m_matrix);
+  SetSourceModule (0, *pModule);
+  return chainLength;
+}
+
+void TransformPoint::GetBounds (double lowerX, double lowerY, double lowerZ,
+  double upperX, double upperY, double upperZ, double& lowerBound,
+  double& upperBound) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  double lower[3] = {lowerX, lowerY, lowerZ};
+  double upper[3] = {upperX, upperY, upperZ};
+  double newLower[3], newUpper[3];
+  TransformBox (m_matrix, lower, upper, newLower, newUpper);
+  m_pSourceModule[0]->GetBounds (newLower[0], newLower[1], newLower[2],
+    newUpper[0], newUpper[1], newUpper[2], lowerBound, upperBound);
+}
+
+double TransformPoint::GetValue (double x, double y, double z) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  const double* m = m_matrix;
+  double nx = (m[0] * x) + (m[1] * y) + (m[ 2] * z) + m[ 3];
+  double ny = (m[4] * x) + (m[5] * y) + (m[ 6] * z) + m[ 7];
+  double nz = (m[8] * x) + (m[9] * y) + (m[10] * z) + m[11];
+  return m_pSourceModule[0]->GetValue (nx, ny, nz);
+}
+
+void TransformPoint::GetValues (int count, const double* x,
+  const double* y, const double* z, double* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+void TransformPoint::GetValues (int count, const float* x, const float* y,
+  const float* z, float* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+template <class T>
+void TransformPoint::GetValuesImpl (int count, const T* x, const T* y,
+  const T* z, T* values) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  const double* m = m_matrix;
+  T nx[MODULE_BATCH_SIZE];
+  T ny[MODULE_BATCH_SIZE];
+  T nz[MODULE_BATCH_SIZE];
+  for (int offset = 0; offset < count; offset += MODULE_BATCH_SIZE) {
+    int n = GetMin (count - offset, MODULE_BATCH_SIZE);
+    for (int i = 0; i < n; i++) {
+      T xi = x[offset + i];
+      T yi = y[offset + i];
+      T zi = z[offset + i];
+      nx[i] = (m[0] * xi) + (m[1] * yi) + (m[ 2] * zi) + m[ 3];
+      ny[i] = (m[4] * xi) + (m[5] * yi) + (m[ 6] * zi) + m[ 7];
+      nz[i] = (m[8] * xi) + (m[9] * yi) + (m[10] * zi) + m[11];
+    }
+    m_pSourceModule[0]->GetValues (n, nx, ny, nz, values + offset);
+  }
+}
+
+void TransformPoint::SetMatrix (const double* pMatrix)
+{
+  for (int i = 0; i < 12; i++) {
+    m_matrix[i] = pMatrix[i];
+  }
+}
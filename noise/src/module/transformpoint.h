@@ -0,0 +1,179 @@
+// transformpoint.h
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+
+#ifndef NOISE_MODULE_TRANSFORMPOINT_H
+#define NOISE_MODULE_TRANSFORMPOINT_H
+
+#include "modulebase.h"
+
+namespace noise
+{
+
+  namespace module
+  {
+
+    /// @addtogroup libnoise
+    /// @{
+
+    /// @addtogroup modules
+    /// @{
+
+    /// @addtogroup transformermodules
+    /// @{
+
+    /// Noise module that applies an affine transformation to the input
+    /// value before returning the output value from a source module.
+    ///
+    /// The GetValue() method transforms the ( @a x, @a y, @a z )
+    /// coordinates of the input value by a 3x4 matrix before returning the
+    /// output value from the source module:
+    /// - @a x' = m[0] * @a x + m[1] * @a y + m[2]  * @a z + m[3]
+    /// - @a y' = m[4] * @a x + m[5] * @a y + m[6]  * @a z + m[7]
+    /// - @a z' = m[8] * @a x + m[9] * @a y + m[10] * @a z + m[11]
+    ///
+    /// To set the matrix, call the SetMatrix() method.  The default matrix
+    /// is the identity matrix.
+    ///
+    /// This noise module can replace a chain of noise::module::ScalePoint,
+    /// noise::module::TranslatePoint, and noise::module::RotatePoint noise
+    /// modules, which costs one call per transformer module for each
+    /// output value.  To collapse such a chain into this noise module, call
+    /// the CollapseChain() method.
+    ///
+    /// This noise module requires one source module.
+    class TransformPoint: public Module
+    {
+
+      public:
+
+        /// Constructor.
+        ///
+        /// The default matrix is the identity matrix.
+        TransformPoint ();
+
+        /// Appends the transformation applied by a transformer module to
+        /// the transformation applied by this noise module.
+        ///
+        /// @param transformer The transformer module.
+        ///
+        /// @returns
+        /// - @a true if the transformer module is a
+        ///   noise::module::ScalePoint, noise::module::TranslatePoint,
+        ///   noise::module::RotatePoint, or noise::module::TransformPoint
+        ///   noise module.
+        /// - @a false otherwise; the matrix is not changed.
+        ///
+        /// The appended transformation is applied after the current
+        /// transformation, as if the transformer module were placed between
+        /// this noise module and its source module.
+        bool AppendTransform (const Module& transformer);
+
+        /// Replaces a chain of transformer modules with this noise module.
+        ///
+        /// @param transformer The first transformer module in the chain.
+        ///
+        /// @returns The number of transformer modules in the chain.
+        ///
+        /// @throw noise::ExceptionNoModule
+        /// - A transformer module in the chain does not have a source
+        ///   module.
+        ///
+        /// The chain starts with the specified transformer module and
+        /// continues through the source modules for as long as they are
+        /// noise::module::ScalePoint, noise::module::TranslatePoint,
+        /// noise::module::RotatePoint, or noise::module::TransformPoint
+        /// noise modules.  This method sets the matrix to the combined
+        /// transformation of the chain, and sets the source module to the
+        /// source module of the last transformer module in the chain.
+        /// This noise module then outputs the same values as the first
+        /// transformer module, except for rounding errors.
+        ///
+        /// If the specified noise module is not one of these transformer
+        /// modules, the chain is empty; this method sets the matrix to the
+        /// identity matrix and sets the source module to the specified noise
+        /// module.
+        ///
+        /// The transformer modules in the chain are not modified, and do
+        /// not need to exist after this method returns.
+        int CollapseChain (const Module& transformer);
+
+        /// Returns the matrix of the affine transformation applied to the
+        /// input value.
+        ///
+        /// @returns A pointer to the 12 elements of the 3x4 matrix, in
+        /// row-major order.
+        const double* GetMatrix () const
+        {
+          return m_matrix;
+        }
+
+        virtual void GetBounds (double lowerX, double lowerY, double lowerZ,
+          double upperX, double upperY, double upperZ, double& lowerBound,
+          double& upperBound) const;
+
+        virtual int GetSourceModuleCount () const
+        {
+          return 1;
+        }
+
+        virtual double GetValue (double x, double y, double z) const;
+
+        virtual void GetValues (int count, const double* x, const double* y,
+          const double* z, double* values) const;
+
+        virtual void GetValues (int count, const float* x, const float* y,
+          const float* z, float* values) const;
+
+        /// Sets the matrix of the affine transformation applied to the
+        /// input value.
+        ///
+        /// @param pMatrix A pointer to the 12 elements of a 3x4 matrix, in
+        /// row-major order.
+        void SetMatrix (const double* pMatrix);
+
+      protected:
+
+        /// The 3x4 matrix of the affine transformation, in row-major
+        /// order.
+        double m_matrix[12];
+
+      private:
+
+        /// Implements both versions of the GetValues() method.
+        template <class T>
+        void GetValuesImpl (int count, const T* x, const T* y, const T* z,
+          T* values) const;
+
+    };
+
+    /// @}
+
+    /// @}
+
+    /// @}
+
+  }
+
+}
+
+#endif
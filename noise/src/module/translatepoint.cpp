@@ -20,6 +20,7 @@
 // off every 'zig'.)
 //
 
+#include "../misc.h"
 #include "translatepoint.h"
 
 using namespace noise::module;
@@ -32,6 +33,18 @@ TranslatePoint::TranslatePoint ():
 {
 }
 
+void TranslatePoint::GetBounds (double lowerX, double lowerY, double lowerZ,
+  double upperX, double upperY, double upperZ, double& lowerBound,
+  double& upperBound) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  m_pSourceModule[0]->GetBounds (lowerX + m_xTranslation,
+    lowerY + m_yTranslation, lowerZ + m_zTranslation,
+    upperX + m_xTranslation, upperY + m_yTranslation,
+    upperZ + m_zTranslation, lowerBound, upperBound);
+}
+
 double TranslatePoint::GetValue (double x, double y, double z) const
 {
   assert (m_pSourceModule[0] != NULL);
@@ -39,3 +52,35 @@ double TranslatePoint::GetValue (double x, double y, double z) const
   return m_pSourceModule[0]->GetValue (x + m_xTranslation, y + m_yTranslation,
     z + m_zTranslation);
 }
+
+void TranslatePoint::GetValues (int count, const double* x, const double* y,
+  const double* z, double* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+void TranslatePoint::GetValues (int count, const float* x, const float* y,
+  const float* z, float* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+template <class T>
+void TranslatePoint::GetValuesImpl (int count, const T* x, const T* y,
+  const T* z, T* values) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  T nx[MODULE_BATCH_SIZE];
+  T ny[MODULE_BATCH_SIZE];
+  T nz[MODULE_BATCH_SIZE];
+  for (int offset = 0; offset < count; offset += MODULE_BATCH_SIZE) {
+    int n = GetMin (count - offset, MODULE_BATCH_SIZE);
+    for (int i = 0; i < n; i++) {
+      nx[i] = x[offset + i] + m_xTranslation;
+      ny[i] = y[offset + i] + m_yTranslation;
+      nz[i] = z[offset + i] + m_zTranslation;
+    }
+    m_pSourceModule[0]->GetValues (n, nx, ny, nz, values + offset);
+  }
+}
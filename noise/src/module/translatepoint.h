@@ -83,6 +83,10 @@ namespace noise
         /// set to noise::module::DEFAULT_TRANSLATE_POINT_Z.
         TranslatePoint ();
 
+        virtual void GetBounds (double lowerX, double lowerY, double lowerZ,
+          double upperX, double upperY, double upperZ, double& lowerBound,
+          double& upperBound) const;
+
         virtual int GetSourceModuleCount () const
         {
           return 1;
@@ -90,6 +94,12 @@ namespace noise
 
         virtual double GetValue (double x, double y, double z) const;
 
+        virtual void GetValues (int count, const double* x, const double* y,
+          const double* z, double* values) const;
+
+        virtual void GetValues (int count, const float* x, const float* y,
+          const float* z, float* values) const;
+
         /// Returns the translation amount to apply to the @a x coordinate of
         /// the input value.
         ///
@@ -208,6 +218,13 @@ namespace noise
         /// value.
         double m_zTranslation;
 
+      private:
+
+        /// Implements both versions of the GetValues() method.
+        template <class T>
+        void GetValuesImpl (int count, const T* x, const T* y, const T* z,
+          T* values) const;
+
     };
 
     /// @}
@@ -20,6 +20,8 @@
 // off every 'zig'.)
 //
 
+#include "../boundsimpl.h"
+#include "../misc.h"
 #include "turbulence.h"
 
 using namespace noise::module;
@@ -33,6 +35,25 @@ Turbulence::Turbulence ():
   SetRoughness (DEFAULT_TURBULENCE_ROUGHNESS);
 }
 
+void Turbulence::GetDistortedBox (const double* lower, const double* upper,
+  double* newLower, double* newUpper) const
+{
+  // The bounds of the noise::module::Perlin noise modules do not depend on
+  // the input values, so the offsets added to the coordinates in GetValue()
+  // are not needed here.
+  const Perlin* pDistortModules[3] = {
+    &m_xDistortModule, &m_yDistortModule, &m_zDistortModule};
+  for (int i = 0; i < 3; i++) {
+    double lowerDistort, upperDistort;
+    pDistortModules[i]->GetBounds (lower[0], lower[1], lower[2], upper[0],
+      upper[1], upper[2], lowerDistort, upperDistort);
+    MultiplyBounds (lowerDistort, upperDistort, m_power, m_power,
+      lowerDistort, upperDistort);
+    newLower[i] = lower[i] + lowerDistort;
+    newUpper[i] = upper[i] + upperDistort;
+  }
+}
+
 double Turbulence::GetFrequency () const
 {
   // Since each noise::module::Perlin noise module has the same frequency, it
@@ -45,6 +66,20 @@ int Turbulence::GetSeed () const
   return m_xDistortModule.GetSeed ();
 }
 
+void Turbulence::GetBounds (double lowerX, double lowerY, double lowerZ,
+  double upperX, double upperY, double upperZ, double& lowerBound,
+  double& upperBound) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  double lower[3] = {lowerX, lowerY, lowerZ};
+  double upper[3] = {upperX, upperY, upperZ};
+  double newLower[3], newUpper[3];
+  GetDistortedBox (lower, upper, newLower, newUpper);
+  m_pSourceModule[0]->GetBounds (newLower[0], newLower[1], newLower[2],
+    newUpper[0], newUpper[1], newUpper[2], lowerBound, upperBound);
+}
+
 double Turbulence::GetValue (double x, double y, double z) const
 {
   assert (m_pSourceModule[0] != NULL);
@@ -89,3 +124,68 @@ void Turbulence::SetSeed (int seed)
   m_yDistortModule.SetSeed (seed + 1);
   m_zDistortModule.SetSeed (seed + 2);
 }
+
+void Turbulence::GetValues (int count, const double* x, const double* y,
+  const double* z, double* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+void Turbulence::GetValues (int count, const float* x, const float* y,
+  const float* z, float* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+template <class T>
+void Turbulence::GetValuesImpl (int count, const T* x, const T* y,
+  const T* z, T* values) const
+{
+  assert (m_pSourceModule[0] != NULL);
+
+  T x0[MODULE_BATCH_SIZE];
+  T y0[MODULE_BATCH_SIZE];
+  T z0[MODULE_BATCH_SIZE];
+  T xDistort[MODULE_BATCH_SIZE];
+  T yDistort[MODULE_BATCH_SIZE];
+  T zDistort[MODULE_BATCH_SIZE];
+  T power = (T)m_power;
+  for (int offset = 0; offset < count; offset += MODULE_BATCH_SIZE) {
+    int n = GetMin (count - offset, MODULE_BATCH_SIZE);
+    const T* xi = x + offset;
+    const T* yi = y + offset;
+    const T* zi = z + offset;
+
+    // Apply the same offsets as GetValue() to the input values of each
+    // noise::module::Perlin noise module.  The coordinate arrays are reused
+    // for each distortion module.
+    for (int i = 0; i < n; i++) {
+      x0[i] = xi[i] + (T)(12414.0 / 65536.0);
+      y0[i] = yi[i] + (T)(65124.0 / 65536.0);
+      z0[i] = zi[i] + (T)(31337.0 / 65536.0);
+    }
+    m_xDistortModule.GetValues (n, x0, y0, z0, xDistort);
+    for (int i = 0; i < n; i++) {
+      x0[i] = xi[i] + (T)(26519.0 / 65536.0);
+      y0[i] = yi[i] + (T)(18128.0 / 65536.0);
+      z0[i] = zi[i] + (T)(60493.0 / 65536.0);
+    }
+    m_yDistortModule.GetValues (n, x0, y0, z0, yDistort);
+    for (int i = 0; i < n; i++) {
+      x0[i] = xi[i] + (T)(53820.0 / 65536.0);
+      y0[i] = yi[i] + (T)(11213.0 / 65536.0);
+      z0[i] = zi[i] + (T)(44845.0 / 65536.0);
+    }
+    m_zDistortModule.GetValues (n, x0, y0, z0, zDistort);
+    for (int i = 0; i < n; i++) {
+      xDistort[i] = xi[i] + (xDistort[i] * power);
+      yDistort[i] = yi[i] + (yDistort[i] * power);
+      zDistort[i] = zi[i] + (zDistort[i] * power);
+    }
+
+    // Retrieve the output values at the offsetted input values instead of
+    // the original input values.
+    m_pSourceModule[0]->GetValues (n, xDistort, yDistort, zDistort,
+      values + offset);
+  }
+}
@@ -130,6 +130,10 @@ namespace noise
         /// noise::module::DEFAULT_TURBULENCE_SEED.
         Turbulence ();
 
+        virtual void GetBounds (double lowerX, double lowerY, double lowerZ,
+          double upperX, double upperY, double upperZ, double& lowerBound,
+          double& upperBound) const;
+
         /// Returns the frequency of the turbulence.
         ///
         /// @returns The frequency of the turbulence.
@@ -162,6 +166,15 @@ namespace noise
           return m_xDistortModule.GetOctaveCount ();
         }
 
+        /// Returns the spacing between the input values at which the
+        /// application samples this noise module.
+        ///
+        /// @returns The sample spacing.
+        double GetSampleSpacing () const
+        {
+          return m_xDistortModule.GetSampleSpacing ();
+        }
+
         /// Returns the seed value of the internal Perlin-noise modules that
         /// are used to displace the input values.
         ///
@@ -179,6 +192,12 @@ namespace noise
 
         virtual double GetValue (double x, double y, double z) const;
 
+        virtual void GetValues (int count, const double* x, const double* y,
+          const double* z, double* values) const;
+
+        virtual void GetValues (int count, const float* x, const float* y,
+          const float* z, float* values) const;
+
         /// Sets the frequency of the turbulence.
         ///
         /// @param frequency The frequency of the turbulence.
@@ -226,6 +245,28 @@ namespace noise
           m_zDistortModule.SetOctaveCount (roughness);
         }
 
+        /// Sets the spacing between the input values at which the
+        /// application samples this noise module.
+        ///
+        /// @param sampleSpacing The sample spacing.
+        ///
+        /// @pre The sample spacing is not negative.
+        ///
+        /// @throw noise::ExceptionInvalidParam An invalid parameter was
+        /// specified; see the preconditions for more information.
+        ///
+        /// The internal noise::module::Perlin noise modules are sampled at
+        /// the same spacing as the input values, so the octaves of the
+        /// displacement that are too fine for this spacing are skipped.
+        /// The input values passed to the source module are not affected.
+        void SetSampleSpacing (double sampleSpacing)
+        {
+          // Set the sample spacing of each Perlin-noise module.
+          m_xDistortModule.SetSampleSpacing (sampleSpacing);
+          m_yDistortModule.SetSampleSpacing (sampleSpacing);
+          m_zDistortModule.SetSampleSpacing (sampleSpacing);
+        }
+
         /// Sets the seed value of the internal noise modules that are used to
         /// displace the input values.
         ///
@@ -254,6 +295,31 @@ namespace noise
         /// Noise module that displaces the @a z coordinate.
         Perlin m_zDistortModule;
 
+      private:
+
+        /// The noise::module::Program noise module calls the
+        /// noise::module::Perlin noise modules directly.
+        friend class Program;
+
+        /// Calculates the box that contains the distorted input values for
+        /// the input values within a box.
+        ///
+        /// @param lower The lower @a x, @a y, and @a z coordinates of the
+        /// box.
+        /// @param upper The upper @a x, @a y, and @a z coordinates of the
+        /// box.
+        /// @param newLower Receives the lower coordinates of the distorted
+        /// box.
+        /// @param newUpper Receives the upper coordinates of the distorted
+        /// box.
+        void GetDistortedBox (const double* lower, const double* upper,
+          double* newLower, double* newUpper) const;
+
+        /// Implements both versions of the GetValues() method.
+        template <class T>
+        void GetValuesImpl (int count, const T* x, const T* y, const T* z,
+          T* values) const;
+
     };
 
     /// @}
@@ -21,24 +21,228 @@
 //
 
 #include "../mathconsts.h"
+#include "../misc.h"
+#include "../threadimpl.h"
 #include "voronoi.h"
 
 using namespace noise::module;
 
+using namespace noise;
+
+// Generates the position of the seed point inside the specified unit cube.
+static inline void GenerateSeedPoint (int xCell, int yCell, int zCell,
+  int seed, double& xPos, double& yPos, double& zPos)
+{
+  xPos = xCell + ValueNoise3D (xCell, yCell, zCell, seed    );
+  yPos = yCell + ValueNoise3D (xCell, yCell, zCell, seed + 1);
+  zPos = zCell + ValueNoise3D (xCell, yCell, zCell, seed + 2);
+}
+
+// Calculates, along one axis, the squared distance from the input value to
+// the region that contains the seed points of each of the five unit cubes
+// from pInt - 2 to pInt + 2.  A value-noise value ranges from -1.0 to +3.0,
+// so the seed point of a unit cube lies from one unit below to three units
+// above its lower corner.
+static inline void GetSeedPointGaps (double p, int pInt, double* pGaps)
+{
+  for (int i = 0; i < 5; i++) {
+    double cell = (double)(pInt - 2 + i);
+    double gap = GetMax (0.0, GetMax ((cell - 1.0) - p, p - (cell + 3.0)));
+    pGaps[i] = gap * gap;
+  }
+}
+
+// A cache of the seed points of the unit cubes that the batched methods
+// search.  Nearby input values search mostly the same unit cubes, so the
+// seed points of all unit cubes near each piece of at most
+// MODULE_BATCH_SIZE input values are generated in advance by the
+// vectorized value-noise function, if there are not too many of them.
+// Otherwise, the seed points are generated when they are first needed and
+// kept in a direct-mapped cache.  At about 56 KB, the cache is too large for
+// the stack, so each thread keeps one per noise module.
+struct Voronoi::SeedPointCache
+{
+  // Maximum number of unit cubes in the block of unit cubes whose seed
+  // points are generated in advance.
+  static const int BLOCK_SIZE = 1024;
+
+  // Number of entries in the direct-mapped cache; must be a power of two.
+  static const int SIZE = 512;
+
+  struct Entry
+  {
+    int xCell, yCell, zCell;
+    bool isValid;
+    double xPos, yPos, zPos;
+  };
+
+  // Lower corner and size of the block of unit cubes whose seed points
+  // were generated in advance.  The size is zero if there is no block.
+  int xBlock, yBlock, zBlock;
+  int xBlockSize, yBlockSize, zBlockSize;
+  int xBlockCells[BLOCK_SIZE], yBlockCells[BLOCK_SIZE],
+    zBlockCells[BLOCK_SIZE];
+  double xBlockPos[BLOCK_SIZE], yBlockPos[BLOCK_SIZE],
+    zBlockPos[BLOCK_SIZE];
+
+  Entry entries[SIZE];
+
+  SeedPointCache ()
+  {
+    Clear ();
+  }
+
+  // Discards all seed points, which depend on the seed value.
+  void Clear ()
+  {
+    xBlock = yBlock = zBlock = 0;
+    xBlockSize = yBlockSize = zBlockSize = 0;
+    for (int i = 0; i < SIZE; i++) {
+      entries[i].isValid = false;
+    }
+  }
+
+  // Generates the seed points of all unit cubes that the searches for the
+  // specified input values visit, if these unit cubes fit in the block.
+  template <class T>
+  void GenerateBlock (int count, const T* x, const T* y, const T* z,
+    double frequency, int seed)
+  {
+    xBlockSize = yBlockSize = zBlockSize = 0;
+    if (count <= 0) {
+      return;
+    }
+
+    // Find the range of the unit cubes that contain the input values, in
+    // the same way as FindFeatures().
+    int xMin = 0, yMin = 0, zMin = 0, xMax = 0, yMax = 0, zMax = 0;
+    for (int i = 0; i < count; i++) {
+      double xScaled = x[i] * frequency;
+      double yScaled = y[i] * frequency;
+      double zScaled = z[i] * frequency;
+      int xInt = (xScaled > 0.0? (int)xScaled: (int)xScaled - 1);
+      int yInt = (yScaled > 0.0? (int)yScaled: (int)yScaled - 1);
+      int zInt = (zScaled > 0.0? (int)zScaled: (int)zScaled - 1);
+      if (i == 0) {
+        xMin = xMax = xInt;
+        yMin = yMax = yInt;
+        zMin = zMax = zInt;
+      } else {
+        xMin = GetMin (xMin, xInt);
+        xMax = GetMax (xMax, xInt);
+        yMin = GetMin (yMin, yInt);
+        yMax = GetMax (yMax, yInt);
+        zMin = GetMin (zMin, zInt);
+        zMax = GetMax (zMax, zInt);
+      }
+    }
+
+    // Each search visits the unit cubes up to two units away.
+    double xSize = (double)xMax - (double)xMin + 5.0;
+    double ySize = (double)yMax - (double)yMin + 5.0;
+    double zSize = (double)zMax - (double)zMin + 5.0;
+    if (xSize * ySize * zSize > BLOCK_SIZE) {
+      return;
+    }
+
+    xBlock = xMin - 2;
+    yBlock = yMin - 2;
+    zBlock = zMin - 2;
+    int cellCount = 0;
+    for (int zCur = 0; zCur < (int)zSize; zCur++) {
+      for (int yCur = 0; yCur < (int)ySize; yCur++) {
+        for (int xCur = 0; xCur < (int)xSize; xCur++) {
+          xBlockCells[cellCount] = xBlock + xCur;
+          yBlockCells[cellCount] = yBlock + yCur;
+          zBlockCells[cellCount] = zBlock + zCur;
+          cellCount++;
+        }
+      }
+    }
+    ValueNoise3DArray (cellCount, xBlockCells, yBlockCells, zBlockCells,
+      xBlockPos, seed    );
+    ValueNoise3DArray (cellCount, xBlockCells, yBlockCells, zBlockCells,
+      yBlockPos, seed + 1);
+    ValueNoise3DArray (cellCount, xBlockCells, yBlockCells, zBlockCells,
+      zBlockPos, seed + 2);
+    for (int i = 0; i < cellCount; i++) {
+      xBlockPos[i] += xBlockCells[i];
+      yBlockPos[i] += yBlockCells[i];
+      zBlockPos[i] += zBlockCells[i];
+    }
+    xBlockSize = (int)xSize;
+    yBlockSize = (int)ySize;
+    zBlockSize = (int)zSize;
+  }
+
+  // Returns the position of the seed point inside the specified unit cube,
+  // from the cache if one is specified.
+  static inline void GetSeedPoint (SeedPointCache* pCache, int xCell,
+    int yCell, int zCell, int seed, double& xPos, double& yPos,
+    double& zPos)
+  {
+    if (pCache == NULL) {
+      GenerateSeedPoint (xCell, yCell, zCell, seed, xPos, yPos, zPos);
+      return;
+    }
+
+    unsigned int xOffset = (unsigned int)xCell - (unsigned int)pCache->xBlock;
+    unsigned int yOffset = (unsigned int)yCell - (unsigned int)pCache->yBlock;
+    unsigned int zOffset = (unsigned int)zCell - (unsigned int)pCache->zBlock;
+    if (xOffset < (unsigned int)pCache->xBlockSize
+      && yOffset < (unsigned int)pCache->yBlockSize
+      && zOffset < (unsigned int)pCache->zBlockSize) {
+      int i = (int)((zOffset * pCache->yBlockSize + yOffset)
+        * pCache->xBlockSize + xOffset);
+      xPos = pCache->xBlockPos[i];
+      yPos = pCache->yBlockPos[i];
+      zPos = pCache->zBlockPos[i];
+      return;
+    }
+
+    unsigned int hash = (unsigned int)xCell * 73856093u
+      ^ (unsigned int)yCell * 19349663u
+      ^ (unsigned int)zCell * 83492791u;
+    hash ^= (hash >> 16);
+    Entry& entry = pCache->entries[hash & (SIZE - 1)];
+    if (!entry.isValid || entry.xCell != xCell || entry.yCell != yCell
+      || entry.zCell != zCell) {
+      entry.xCell = xCell;
+      entry.yCell = yCell;
+      entry.zCell = zCell;
+      entry.isValid = true;
+      GenerateSeedPoint (xCell, yCell, zCell, seed, entry.xPos, entry.yPos,
+        entry.zPos);
+    }
+    xPos = entry.xPos;
+    yPos = entry.yPos;
+    zPos = entry.zPos;
+  }
+};
+
+struct Voronoi::ThreadStorage: public PerThread<SeedPointCache>
+{
+};
+
 Voronoi::Voronoi ():
   Module (GetSourceModuleCount ()),
-  m_displacement   (DEFAULT_VORONOI_DISPLACEMENT),
-  m_enableDistance (false                       ),
-  m_frequency      (DEFAULT_VORONOI_FREQUENCY   ),
-  m_seed           (DEFAULT_VORONOI_SEED        )
+  m_displacement   (DEFAULT_VORONOI_DISPLACEMENT ),
+  m_distanceType   (DEFAULT_VORONOI_DISTANCE_TYPE),
+  m_enableDistance (false                        ),
+  m_frequency      (DEFAULT_VORONOI_FREQUENCY    ),
+  m_seed           (DEFAULT_VORONOI_SEED         )
 {
+  m_pStorage = new ThreadStorage;
 }
 
-double Voronoi::GetValue (double x, double y, double z) const
+Voronoi::~Voronoi ()
 {
-  // This method could be more efficient by caching the seed values.  Fix
-  // later.
+  delete m_pStorage;
+}
 
+void Voronoi::FindFeatures (double x, double y, double z, bool findSecond,
+  SeedPointCache* pCache, VoronoiFeatures& features) const
+{
   x *= m_frequency;
   y *= m_frequency;
   z *= m_frequency;
@@ -47,23 +251,61 @@ double Voronoi::GetValue (double x, double y, double z) const
   int yInt = (y > 0.0? (int)y: (int)y - 1);
   int zInt = (z > 0.0? (int)z: (int)z - 1);
 
+  // The seed point of a unit cube is never closer to the input value than
+  // the nearest point of the region that contains it, so a unit cube can be
+  // skipped if the squared distance to that region exceeds the squared
+  // distance to a seed point that was already found (or, if the
+  // second-nearest seed point is needed, the larger of the squared
+  // distances to two such seed points.)  The seed points of the unit cube
+  // that contains the input value and of its nearest neighbour along the x
+  // axis provide the first such distances.
+  double xGaps[5], yGaps[5], zGaps[5];
+  GetSeedPointGaps (x, xInt, xGaps);
+  GetSeedPointGaps (y, yInt, yGaps);
+  GetSeedPointGaps (z, zInt, zGaps);
+  double xPos, yPos, zPos;
+  SeedPointCache::GetSeedPoint (pCache, xInt, yInt, zInt, m_seed, xPos, yPos,
+    zPos);
+  double pruneDist = (xPos - x) * (xPos - x) + (yPos - y) * (yPos - y)
+    + (zPos - z) * (zPos - z);
+  if (findSecond) {
+    int xNeighbor = (x - xInt < 0.5? xInt - 1: xInt + 1);
+    SeedPointCache::GetSeedPoint (pCache, xNeighbor, yInt, zInt, m_seed, xPos,
+      yPos, zPos);
+    pruneDist = GetMax (pruneDist, (xPos - x) * (xPos - x)
+      + (yPos - y) * (yPos - y) + (zPos - z) * (zPos - z));
+  }
+
   double minDist = 2147483647.0;
+  double secondDist = 2147483647.0;
   double xCandidate = 0;
   double yCandidate = 0;
   double zCandidate = 0;
 
   // Inside each unit cube, there is a seed point at a random position.  Go
   // through each of the nearby cubes until we find a cube with a seed point
-  // that is closest to the specified position.
+  // that is closest to the specified position.  The cubes are visited in
+  // the same order whether or not they are skipped, so the nearest seed
+  // point is the same as the one that a search of all 125 cubes finds.
   for (int zCur = zInt - 2; zCur <= zInt + 2; zCur++) {
+    double zGap = zGaps[zCur - zInt + 2];
+    if (zGap > pruneDist) {
+      continue;
+    }
     for (int yCur = yInt - 2; yCur <= yInt + 2; yCur++) {
+      double yzGap = yGaps[yCur - yInt + 2] + zGap;
+      if (yzGap > pruneDist) {
+        continue;
+      }
       for (int xCur = xInt - 2; xCur <= xInt + 2; xCur++) {
+        if (xGaps[xCur - xInt + 2] + yzGap > pruneDist) {
+          continue;
+        }
 
         // Calculate the position and distance to the seed point inside of
         // this unit cube.
-        double xPos = xCur + ValueNoise3D (xCur, yCur, zCur, m_seed    );
-        double yPos = yCur + ValueNoise3D (xCur, yCur, zCur, m_seed + 1);
-        double zPos = zCur + ValueNoise3D (xCur, yCur, zCur, m_seed + 2);
+        SeedPointCache::GetSeedPoint (pCache, xCur, yCur, zCur, m_seed, xPos,
+          yPos, zPos);
         double xDist = xPos - x;
         double yDist = yPos - y;
         double zDist = zPos - z;
@@ -72,30 +314,166 @@ double Voronoi::GetValue (double x, double y, double z) const
         if (dist < minDist) {
           // This seed point is closer to any others found so far, so record
           // this seed point.
+          secondDist = minDist;
           minDist = dist;
           xCandidate = xPos;
           yCandidate = yPos;
           zCandidate = zPos;
+        } else if (dist < secondDist) {
+          secondDist = dist;
         }
+        pruneDist = GetMin (pruneDist, findSecond? secondDist: minDist);
+      }
+    }
+  }
+
+  // The random value of the cell is taken from the unit cube that contains
+  // its seed point.
+  features.distance1 = sqrt (minDist);
+  features.distance2 = sqrt (secondDist);
+  features.cellId = IntValueNoise3D (
+    (int)(floor (xCandidate)),
+    (int)(floor (yCandidate)),
+    (int)(floor (zCandidate)), 0);
+  features.cellValue = 1.0 - ((double)features.cellId / 1073741824.0);
+  features.x = xCandidate / m_frequency;
+  features.y = yCandidate / m_frequency;
+  features.z = zCandidate / m_frequency;
+}
+
+void Voronoi::GetBounds (double lowerX, double lowerY, double lowerZ,
+  double upperX, double upperY, double upperZ, double& lowerBound,
+  double& upperBound) const
+{
+  // The seed point of the unit cube that contains the input value is at most
+  // 3.0 units away along each axis.  The seed point of its nearer neighbour
+  // along the x axis is at most 3.5 units away along that axis and 3.0 units
+  // along the others.  So the distances to the nearest and second-nearest
+  // seed points, and their difference, range from 0.0 to 5.5, and the output
+  // value from -1.0 to 5.5 * SQRT_3 - 1.0, which is less than 9.0.  The
+  // displacement value is scaled by a value-noise value from -1.0 to +3.0.
+  //
+  // Far from the origin, the indices of the unit cubes overflow, and the
+  // distances are not bounded.
+  double lowerDisplacement = GetMin (-m_displacement, 3.0 * m_displacement);
+  double upperDisplacement = GetMax (-m_displacement, 3.0 * m_displacement);
+  if (m_enableDistance) {
+    lowerBound = -1.0 + lowerDisplacement;
+    upperBound = 9.0 + upperDisplacement;
+    double lower[3] = {lowerX, lowerY, lowerZ};
+    double upper[3] = {upperX, upperY, upperZ};
+    for (int i = 0; i < 3; i++) {
+      double farthest = GetMax (fabs (lower[i]), fabs (upper[i]))
+        * fabs (m_frequency);
+      if (!(farthest < 1073741824.0)) {
+        upperBound = HUGE_VAL;
       }
     }
+  } else {
+    lowerBound = lowerDisplacement;
+    upperBound = upperDisplacement;
   }
+}
 
+double Voronoi::GetFeatureValue (const VoronoiFeatures& features) const
+{
   double value;
   if (m_enableDistance) {
-    // Determine the distance to the nearest seed point.
-    double xDist = xCandidate - x;
-    double yDist = yCandidate - y;
-    double zDist = zCandidate - z;
-    value = (sqrt (xDist * xDist + yDist * yDist + zDist * zDist)
-      ) * SQRT_3 - 1.0;
+    // Determine the distance to apply to the output value.
+    double dist;
+    switch (m_distanceType) {
+      case VORONOI_DISTANCE_F2:
+        dist = features.distance2;
+        break;
+      case VORONOI_DISTANCE_F2_MINUS_F1:
+        dist = features.distance2 - features.distance1;
+        break;
+      default:
+        dist = features.distance1;
+        break;
+    }
+    value = dist * SQRT_3 - 1.0;
   } else {
     value = 0.0;
   }
 
   // Return the calculated distance with the displacement value applied.
-  return value + (m_displacement * (double)ValueNoise3D (
-    (int)(floor (xCandidate)),
-    (int)(floor (yCandidate)),
-    (int)(floor (zCandidate))));
+  return value + (m_displacement * features.cellValue);
+}
+
+void Voronoi::GetFeatures (double x, double y, double z,
+  VoronoiFeatures& features) const
+{
+  FindFeatures (x, y, z, true, NULL, features);
+}
+
+void Voronoi::GetFeatures (int count, const double* x, const double* y,
+  const double* z, VoronoiFeatures* pFeatures) const
+{
+  SeedPointCache& cache = GetSeedPointCache ();
+  for (int offset = 0; offset < count; offset += MODULE_BATCH_SIZE) {
+    int n = GetMin (count - offset, MODULE_BATCH_SIZE);
+    cache.GenerateBlock (n, x + offset, y + offset, z + offset, m_frequency,
+      m_seed);
+    for (int i = offset; i < offset + n; i++) {
+      FindFeatures (x[i], y[i], z[i], true, &cache, pFeatures[i]);
+    }
+  }
+}
+
+Voronoi::SeedPointCache& Voronoi::GetSeedPointCache () const
+{
+  SeedPointCache& cache = m_pStorage->Get ();
+  cache.Clear ();
+  return cache;
+}
+
+double Voronoi::GetValue (double x, double y, double z) const
+{
+  VoronoiFeatures features;
+  FindFeatures (x, y, z, m_enableDistance
+    && m_distanceType != VORONOI_DISTANCE_F1, NULL, features);
+  return GetFeatureValue (features);
+}
+
+void Voronoi::GetValues (int count, const double* x, const double* y,
+  const double* z, double* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+void Voronoi::GetValues (int count, const float* x, const float* y,
+  const float* z, float* values) const
+{
+  GetValuesImpl (count, x, y, z, values);
+}
+
+template <class T>
+void Voronoi::GetValuesImpl (int count, const T* x, const T* y,
+  const T* z, T* values) const
+{
+  // Nearby input values search mostly the same unit cubes, so their seed
+  // points are only generated once.
+  bool findSecond = m_enableDistance
+    && m_distanceType != VORONOI_DISTANCE_F1;
+  SeedPointCache& cache = GetSeedPointCache ();
+  VoronoiFeatures features;
+  for (int offset = 0; offset < count; offset += MODULE_BATCH_SIZE) {
+    int n = GetMin (count - offset, MODULE_BATCH_SIZE);
+    cache.GenerateBlock (n, x + offset, y + offset, z + offset, m_frequency,
+      m_seed);
+    for (int i = offset; i < offset + n; i++) {
+      FindFeatures (x[i], y[i], z[i], findSecond, &cache, features);
+      values[i] = (T)GetFeatureValue (features);
+    }
+  }
+}
+
+void Voronoi::SetDistanceType (VoronoiDistance distanceType)
+{
+  if (distanceType < VORONOI_DISTANCE_F1
+    || distanceType > VORONOI_DISTANCE_F2_MINUS_F1) {
+    throw noise::ExceptionInvalidParam ();
+  }
+  m_distanceType = distanceType;
 }
@@ -34,6 +34,62 @@ namespace noise
     /// @addtogroup libnoise
     /// @{
 
+    /// Enumerates the distances that noise::module::Voronoi can apply to
+    /// its output value.
+    enum VoronoiDistance
+    {
+
+      /// Applies the distance from the nearest seed point (F1).  The output
+      /// value is zero at each seed point and increases towards the cell
+      /// boundaries.
+      VORONOI_DISTANCE_F1 = 0,
+
+      /// Applies the distance from the second-nearest seed point (F2).
+      VORONOI_DISTANCE_F2 = 1,
+
+      /// Applies the difference between the distances from the
+      /// second-nearest and the nearest seed points (F2 - F1).  The output
+      /// value is zero along the cell boundaries, which produces networks
+      /// of cracks.
+      VORONOI_DISTANCE_F2_MINUS_F1 = 2
+
+    };
+
+    /// This structure holds the results of a single search for the seed
+    /// points nearest to an input value.
+    ///
+    /// Distances are measured after the input value is scaled by the
+    /// frequency of the seed points, so that neighbouring seed points are
+    /// about one unit apart.
+    struct VoronoiFeatures
+    {
+
+      /// Distance from the nearest seed point (F1).
+      double distance1;
+
+      /// Distance from the second-nearest seed point (F2).
+      double distance2;
+
+      /// Random integer that identifies the Voronoi cell that contains the
+      /// input value; see noise::IntValueNoise3D().
+      int cellId;
+
+      /// Random value from -1.0 to +3.0 assigned to the Voronoi cell that
+      /// contains the input value.  This is the value that the displacement
+      /// value is multiplied by.
+      double cellValue;
+
+      /// @a x coordinate of the nearest seed point, in input coordinates.
+      double x;
+
+      /// @a y coordinate of the nearest seed point, in input coordinates.
+      double y;
+
+      /// @a z coordinate of the nearest seed point, in input coordinates.
+      double z;
+
+    };
+
     /// @addtogroup modules
     /// @{
 
@@ -44,6 +100,10 @@ namespace noise
     /// noise::module::Voronoi noise module.
     const double DEFAULT_VORONOI_DISPLACEMENT = 1.0;
 
+    /// Default distance to apply to the output value for the
+    /// noise::module::Voronoi noise module.
+    const VoronoiDistance DEFAULT_VORONOI_DISTANCE_TYPE = VORONOI_DISTANCE_F1;
+
     /// Default frequency of the seed points for the noise::module::Voronoi
     /// noise module.
     const double DEFAULT_VORONOI_FREQUENCY = 1.0;
@@ -71,8 +131,8 @@ namespace noise
     /// This noise module assigns each Voronoi cell with a random constant
     /// value from a coherent-noise function.  The <i>displacement value</i>
     /// controls the range of random values to assign to each cell.  The
-    /// range of random values is +/- the displacement value.  Call the
-    /// SetDisplacement() method to specify the displacement value.
+    /// random values range from -1.0 to +3.0 times the displacement value.
+    /// Call the SetDisplacement() method to specify the displacement value.
     ///
     /// To modify the random positions of the seed points, call the SetSeed()
     /// method.
@@ -83,9 +143,20 @@ namespace noise
     /// to increase in value the further away that point is from the nearest
     /// seed point.
     ///
+    /// By default, the applied distance is the distance from the nearest
+    /// seed point.  Call the SetDistanceType() method to apply the distance
+    /// from the second-nearest seed point, or the difference between the
+    /// two, instead.
+    ///
     /// Voronoi cells are often used to generate cracked-mud terrain
     /// formations or crystal-like textures
     ///
+    /// An application that needs several of these quantities at the same
+    /// input value, such as the cell value for a biome and the F2 - F1
+    /// distance for cracks, can call the GetFeatures() method.  It returns
+    /// all of them from a single search, instead of one search per noise
+    /// module.
+    ///
     /// This noise module requires no source modules.
     class Voronoi: public Module
     {
@@ -97,13 +168,23 @@ namespace noise
         /// The default displacement value is set to
         /// noise::module::DEFAULT_VORONOI_DISPLACEMENT.
         ///
+        /// The default distance type is set to
+        /// noise::module::DEFAULT_VORONOI_DISTANCE_TYPE.
+        ///
         /// The default frequency is set to
         /// noise::module::DEFAULT_VORONOI_FREQUENCY.
         ///
         /// The default seed value is set to
         /// noise::module::DEFAULT_VORONOI_SEED.
+        ///
+        /// @throw noise::ExceptionOutOfMemory
+        /// - The operating system could not provide the thread-local
+        ///   storage that all noise modules with per-thread state share.
         Voronoi ();
 
+        /// Destructor.
+        ~Voronoi ();
+
         /// Enables or disables applying the distance from the nearest seed
         /// point to the output value.
         ///
@@ -121,6 +202,10 @@ namespace noise
           m_enableDistance = enable;
         }
 
+        virtual void GetBounds (double lowerX, double lowerY, double lowerZ,
+          double upperX, double upperY, double upperZ, double& lowerBound,
+          double& upperBound) const;
+
         /// Returns the displacement value of the Voronoi cells.
         ///
         /// @returns The displacement value of the Voronoi cells.
@@ -128,12 +213,53 @@ namespace noise
         /// This noise module assigns each Voronoi cell with a random constant
         /// value from a coherent-noise function.  The <i>displacement
         /// value</i> controls the range of random values to assign to each
-        /// cell.  The range of random values is +/- the displacement value.
+        /// cell.  The random values range from -1.0 to +3.0 times the
+        /// displacement value.
         double GetDisplacement () const
         {
           return m_displacement;
         }
 
+        /// Returns the distance that is applied to the output value.
+        ///
+        /// @returns The distance that is applied to the output value.
+        ///
+        /// The distance is only applied if it is enabled; see
+        /// EnableDistance().
+        VoronoiDistance GetDistanceType () const
+        {
+          return m_distanceType;
+        }
+
+        /// Searches for the seed points nearest to the input value.
+        ///
+        /// @param x The @a x coordinate of the input value.
+        /// @param y The @a y coordinate of the input value.
+        /// @param z The @a z coordinate of the input value.
+        /// @param features The structure that receives the results of the
+        /// search.
+        ///
+        /// The results do not depend on the displacement value, the distance
+        /// type, or whether the distance is enabled.
+        void GetFeatures (double x, double y, double z,
+          VoronoiFeatures& features) const;
+
+        /// Searches for the seed points nearest to each of an array of input
+        /// values.
+        ///
+        /// @param count The number of input values.
+        /// @param x The @a x coordinates of the input values.
+        /// @param y The @a y coordinates of the input values.
+        /// @param z The @a z coordinates of the input values.
+        /// @param pFeatures The array that receives the results of the
+        /// searches.
+        ///
+        /// This method returns the same results as calling GetFeatures() for
+        /// each input value, but nearby input values share the work of
+        /// generating seed points.
+        void GetFeatures (int count, const double* x, const double* y,
+          const double* z, VoronoiFeatures* pFeatures) const;
+
         /// Returns the frequency of the seed points.
         ///
         /// @returns The frequency of the seed points.
@@ -179,6 +305,12 @@ namespace noise
 
         virtual double GetValue (double x, double y, double z) const;
 
+        virtual void GetValues (int count, const double* x, const double* y,
+          const double* z, double* values) const;
+
+        virtual void GetValues (int count, const float* x, const float* y,
+          const float* z, float* values) const;
+
         /// Sets the displacement value of the Voronoi cells.
         ///
         /// @param displacement The displacement value of the Voronoi cells.
@@ -186,12 +318,28 @@ namespace noise
         /// This noise module assigns each Voronoi cell with a random constant
         /// value from a coherent-noise function.  The <i>displacement
         /// value</i> controls the range of random values to assign to each
-        /// cell.  The range of random values is +/- the displacement value.
+        /// cell.  The random values range from -1.0 to +3.0 times the
+        /// displacement value.
         void SetDisplacement (double displacement)
         {
           m_displacement = displacement;
         }
 
+        /// Sets the distance to apply to the output value.
+        ///
+        /// @param distanceType The distance to apply to the output value.
+        ///
+        /// @pre The distance type is one of the values of
+        /// noise::module::VoronoiDistance.
+        ///
+        /// @throw noise::ExceptionInvalidParam
+        /// - An invalid parameter was specified; see the preconditions.
+        ///
+        /// The distance is only applied if it is enabled; see
+        /// EnableDistance().  Each distance ranges from 0.0 to 5.5 and is
+        /// mapped onto the same range of output values.
+        void SetDistanceType (VoronoiDistance distanceType);
+
         /// Sets the frequency of the seed points.
         ///
         /// @param frequency The frequency of the seed points.
@@ -220,6 +368,9 @@ namespace noise
         /// Scale of the random displacement to apply to each Voronoi cell.
         double m_displacement;
 
+        /// Distance that is applied to the output value.
+        VoronoiDistance m_distanceType;
+
         /// Determines if the distance from the nearest seed point is applied to
         /// the output value.
         bool m_enableDistance;
@@ -231,6 +382,36 @@ namespace noise
         /// positions of the seed points.
         int m_seed;
 
+      private:
+
+        /// Direct-mapped cache of seed points used by the batched methods.
+        struct SeedPointCache;
+
+        /// The storage for the seed-point cache of each thread.
+        struct ThreadStorage;
+
+        /// Searches for the seed points nearest to the input value, looking
+        /// up seed points in the cache if one is specified.  The distance to
+        /// the second-nearest seed point is only found if requested.
+        void FindFeatures (double x, double y, double z, bool findSecond,
+          SeedPointCache* pCache, VoronoiFeatures& features) const;
+
+        /// Calculates the output value from the results of a search.
+        double GetFeatureValue (const VoronoiFeatures& features) const;
+
+        /// Implements both versions of the GetValues() method.
+        template <class T>
+        void GetValuesImpl (int count, const T* x, const T* y, const T* z,
+          T* values) const;
+
+        /// Returns the seed-point cache of the calling thread, emptied.
+        ///
+        /// @returns A reference to the seed-point cache.
+        SeedPointCache& GetSeedPointCache () const;
+
+        /// The storage for the seed-point cache of each thread.
+        ThreadStorage* m_pStorage;
+
     };
 
     /// @}
@@ -70,5 +70,7 @@
 #include "module/module.h"
 #include "model/model.h"
 #include "misc.h"
+#include "permutationtable.h"
+#include "threadpool.h"
 
 #endif
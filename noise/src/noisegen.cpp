@@ -20,95 +20,843 @@
 // off every 'zig'.)
 //
 
-#include "noisegen.h"
+#include "noisegenimpl.h"
+#include "exception.h"
 #include "interp.h"
+#include "permutationtable.h"
 #include "vectortable.h"
 
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#endif
+
 using namespace noise;
 
-// Specifies the version of the coherent-noise functions to use.
-// - Set to 2 to use the current version.
-// - Set to 1 to use the flawed version from the original version of libnoise.
-// If your application requires coherent-noise values that were generated by
-// an earlier version of libnoise, change this constant to the appropriate
-// value and recompile libnoise.
-#define NOISE_VERSION 2
-
-// These constants control certain parameters that all coherent-noise
-// functions require.
-#if (NOISE_VERSION == 1)
-// Constants used by the original version of libnoise.
-// Because X_NOISE_GEN is not relatively prime to the other values, and
-// Z_NOISE_GEN is close to 256 (the number of random gradient vectors),
-// patterns show up in high-frequency coherent noise.
-const int X_NOISE_GEN = 1;
-const int Y_NOISE_GEN = 31337;
-const int Z_NOISE_GEN = 263;
-const int SEED_NOISE_GEN = 1013;
-const int SHIFT_NOISE_GEN = 13;
-#else
-// Constants used by the current version of libnoise.
-const int X_NOISE_GEN = 1619;
-const int Y_NOISE_GEN = 31337;
-const int Z_NOISE_GEN = 6971;
-const int SEED_NOISE_GEN = 1013;
-const int SHIFT_NOISE_GEN = 8;
-#endif
+// The instruction set used by the vectorized coherent-noise functions, and
+// the functions that were compiled for that instruction set.  The scalar
+// code is used until the instruction set is selected at load time.
+static SimdLevel g_simdLevel = SIMD_SCALAR;
+static const SimdKernels* g_pSimdKernels = NULL;
+
+// Factors that skew an input value onto the simplex lattice and back, and
+// the scaling value that maps simplex-coherent noise onto the -1.0 to +1.0
+// range.
+static const double SIMPLEX_SKEW_3D = 1.0 / 3.0;
+static const double SIMPLEX_UNSKEW_3D = 1.0 / 6.0;
+static const double SIMPLEX_SCALE_3D = 107.6;
+
+// Scaling value that gives four-dimensional gradient-coherent noise about the
+// same amplitude as three-dimensional gradient-coherent noise.
+static const double GRADIENT_NOISE_4D_SCALE = 1.42;
+
+// Returns the best instruction set that both the processor and the
+// operating system support.
+static SimdLevel GetCpuSimdLevel ()
+{
+#if (defined(__GNUC__) || defined(__clang__)) \
+  && (defined(__i386__) || defined(__x86_64__))
+  // These checks include the operating-system support for the AVX
+  // registers.
+  __builtin_cpu_init ();
+  if (__builtin_cpu_supports ("avx512f")) {
+    return SIMD_AVX512;
+  } else if (__builtin_cpu_supports ("avx2")) {
+    return SIMD_AVX2;
+  } else if (__builtin_cpu_supports ("sse4.1")) {
+    return SIMD_SSE41;
+  } else if (__builtin_cpu_supports ("sse2")) {
+    return SIMD_SSE2;
+  }
+  return SIMD_SCALAR;
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+  int info[4];
+  __cpuid (info, 0);
+  int maxLeaf = info[0];
+  __cpuid (info, 1);
+  bool sse2  = (info[3] & (1 << 26)) != 0;
+  bool sse41 = (info[2] & (1 << 19)) != 0;
+  bool avx2 = false;
+  bool avx512 = false;
+  if ((info[2] & (1 << 27)) != 0 && maxLeaf >= 7) {
+    // The operating system must save the AVX (and AVX-512) registers.
+    unsigned __int64 xcr0 = _xgetbv (0);
+    __cpuidex (info, 7, 0);
+    avx2   = (xcr0 & 0x06) == 0x06 && (info[1] & (1 << 5)) != 0;
+    avx512 = (xcr0 & 0xe6) == 0xe6 && (info[1] & (1 << 16)) != 0;
+  }
+  if (avx512) {
+    return SIMD_AVX512;
+  } else if (avx2) {
+    return SIMD_AVX2;
+  } else if (sse41) {
+    return SIMD_SSE41;
+  } else if (sse2) {
+    return SIMD_SSE2;
+  }
+  return SIMD_SCALAR;
+#else
+  return SIMD_SCALAR;
+#endif
+}
+
+// Returns the vectorized coherent-noise functions for the specified
+// instruction set, or NULL if libnoise was built without them.
+static const SimdKernels* GetSimdKernels (SimdLevel simdLevel)
+{
+  switch (simdLevel) {
+    case SIMD_SSE2:
+      return GetSimdKernelsSse2 ();
+    case SIMD_SSE41:
+      return GetSimdKernelsSse41 ();
+    case SIMD_AVX2:
+      return GetSimdKernelsAvx2 ();
+    case SIMD_AVX512:
+      return GetSimdKernelsAvx512 ();
+    default:
+      return NULL;
+  }
+}
+
+// Selects the fastest supported instruction set when libnoise is loaded.
+static struct SimdInitializer
+{
+  SimdInitializer ()
+  {
+    SetSimdLevel (GetMaxSimdLevel ());
+  }
+} g_simdInitializer;
+
+// Generates a gradient-noise value in the same way as GradientNoise3D() for
+// an input value and a nearby integer value that both lie on the x-z plane.
+// The y component of the gradient vector is multiplied by zero in
+// GradientNoise3D(), so it is not used.
+static inline double GradientNoise2D (double fx, double fz, int ix, int iz,
+  int seed)
+{
+  int vectorIndex = (
+      X_NOISE_GEN    * ix
+    + Z_NOISE_GEN    * iz
+    + SEED_NOISE_GEN * seed)
+    & 0xffffffff;
+  vectorIndex ^= (vectorIndex >> SHIFT_NOISE_GEN);
+  vectorIndex &= 0xff;
+
+  double xvGradient = g_randomVectors[(vectorIndex << 2)    ];
+  double zvGradient = g_randomVectors[(vectorIndex << 2) + 2];
+
+  double xvPoint = (fx - (double)ix);
+  double zvPoint = (fz - (double)iz);
+
+  return ((xvGradient * xvPoint)
+    + (zvGradient * zvPoint)) * 2.12;
+}
+
+// Single-precision version of the above function.
+static inline float GradientNoise2D (float fx, float fz, int ix, int iz,
+  int seed)
+{
+  int vectorIndex = (
+      X_NOISE_GEN    * ix
+    + Z_NOISE_GEN    * iz
+    + SEED_NOISE_GEN * seed)
+    & 0xffffffff;
+  vectorIndex ^= (vectorIndex >> SHIFT_NOISE_GEN);
+  vectorIndex &= 0xff;
+
+  float xvGradient = g_randomVectorsFloat[(vectorIndex << 2)    ];
+  float zvGradient = g_randomVectorsFloat[(vectorIndex << 2) + 2];
+
+  float xvPoint = (fx - (float)ix);
+  float zvPoint = (fz - (float)iz);
+
+  return ((xvGradient * xvPoint)
+    + (zvGradient * zvPoint)) * 2.12f;
+}
+
+// Determines if every element of an array is zero.  The scan stops at the
+// first nonzero element.
+template <class T>
+static bool IsZeroArray (int count, const T* values)
+{
+  for (int i = 0; i < count; i++) {
+    if (values[i] != (T)0.0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Maps the distance between a coordinate and the lower integer boundary onto
+// the S-curve of the noise quality Q.  Q is a template parameter, so the
+// compiler removes the switch and inlines the S-curve.
+template <NoiseQuality Q, class T>
+static inline T SCurveQuality (T a)
+{
+  switch (Q) {
+    case QUALITY_STD:
+      return SCurve3 (a);
+    case QUALITY_BEST:
+      return SCurve5 (a);
+    default:
+      return a;
+  }
+}
+
+// Generates a gradient-coherent-noise value in the same way as
+// GradientCoherentNoise2D(), with the noise quality Q.
+template <NoiseQuality Q, class T>
+static T GradientCoherentNoise2DImpl (T x, T z, int seed)
+{
+  // Create a unit-length square aligned along an integer boundary.  This
+  // square surrounds the input point.
+  int x0 = (x > (T)0.0? (int)x: (int)x - 1);
+  int x1 = x0 + 1;
+  int z0 = (z > (T)0.0? (int)z: (int)z - 1);
+  int z1 = z0 + 1;
+
+  // Map the difference between the coordinates of the input value and the
+  // coordinates of the square's lower-left vertex onto an S-curve.
+  T xs = SCurveQuality<Q> (x - (T)x0);
+  T zs = SCurveQuality<Q> (z - (T)z0);
+
+  // GradientCoherentNoise3D() places a point at y = 0.0 on the upper face
+  // of its cube, and the S-curve value along the y axis is exactly 1.0, so
+  // it returns the bilinear interpolation of the four noise values on that
+  // face.  Interpolate them in the same order.
+  T n0, n1, ix0, ix1;
+  n0   = GradientNoise2D (x, z, x0, z0, seed);
+  n1   = GradientNoise2D (x, z, x1, z0, seed);
+  ix0  = LinearInterp (n0, n1, xs);
+  n0   = GradientNoise2D (x, z, x0, z1, seed);
+  n1   = GradientNoise2D (x, z, x1, z1, seed);
+  ix1  = LinearInterp (n0, n1, xs);
+
+  return LinearInterp (ix0, ix1, zs);
+}
+
+// Generates a gradient-noise value in the same way as GradientNoise3D(), and
+// also returns the partial derivatives of that value, which are the scaled
+// components of the gradient vector.
+static double GradientNoiseDeriv3D (double fx, double fy, double fz, int ix,
+  int iy, int iz, int seed, double& dx, double& dy, double& dz)
+{
+  int vectorIndex = (
+      X_NOISE_GEN    * ix
+    + Y_NOISE_GEN    * iy
+    + Z_NOISE_GEN    * iz
+    + SEED_NOISE_GEN * seed)
+    & 0xffffffff;
+  vectorIndex ^= (vectorIndex >> SHIFT_NOISE_GEN);
+  vectorIndex &= 0xff;
+
+  double xvGradient = g_randomVectors[(vectorIndex << 2)    ];
+  double yvGradient = g_randomVectors[(vectorIndex << 2) + 1];
+  double zvGradient = g_randomVectors[(vectorIndex << 2) + 2];
+
+  double xvPoint = (fx - (double)ix);
+  double yvPoint = (fy - (double)iy);
+  double zvPoint = (fz - (double)iz);
+
+  dx = xvGradient * 2.12;
+  dy = yvGradient * 2.12;
+  dz = zvGradient * 2.12;
+  return ((xvGradient * xvPoint)
+    + (yvGradient * yvPoint)
+    + (zvGradient * zvPoint)) * 2.12;
+}
+
+// Same as the above function, with a permutation table as the lattice hash.
+static double GradientNoiseDeriv3D (double fx, double fy, double fz, int ix,
+  int iy, int iz, const PermutationTable& table, int seed, double& dx,
+  double& dy, double& dz)
+{
+  const double* pVectors = table.GetVectors ()
+    + (table.GetIndex (ix, iy, iz, seed) << 2);
+  double xvGradient = pVectors[0];
+  double yvGradient = pVectors[1];
+  double zvGradient = pVectors[2];
+
+  double xvPoint = (fx - (double)ix);
+  double yvPoint = (fy - (double)iy);
+  double zvPoint = (fz - (double)iz);
+
+  dx = xvGradient * 2.12;
+  dy = yvGradient * 2.12;
+  dz = zvGradient * 2.12;
+  return ((xvGradient * xvPoint)
+    + (yvGradient * yvPoint)
+    + (zvGradient * zvPoint)) * 2.12;
+}
+
+// The lattice hash of the gradient-coherent-noise functions that multiplies
+// the integer coordinates by prime numbers.
+struct ArithmeticLatticeHash
+{
+  int seed;
+
+  double Noise (double fx, double fy, double fz, int ix, int iy, int iz) const
+  {
+    return GradientNoise3D (fx, fy, fz, ix, iy, iz, seed);
+  }
+
+  float Noise (float fx, float fy, float fz, int ix, int iy, int iz) const
+  {
+    return GradientNoise3D (fx, fy, fz, ix, iy, iz, seed);
+  }
+
+  double NoiseDeriv (double fx, double fy, double fz, int ix, int iy, int iz,
+    double& dx, double& dy, double& dz) const
+  {
+    return GradientNoiseDeriv3D (fx, fy, fz, ix, iy, iz, seed, dx, dy, dz);
+  }
+};
+
+// The lattice hash of the gradient-coherent-noise functions that looks up
+// the integer coordinates in a permutation table.
+struct TableLatticeHash
+{
+  const PermutationTable* pTable;
+  int seed;
+
+  double Noise (double fx, double fy, double fz, int ix, int iy, int iz) const
+  {
+    return GradientNoise3D (fx, fy, fz, ix, iy, iz, *pTable, seed);
+  }
+
+  float Noise (float fx, float fy, float fz, int ix, int iy, int iz) const
+  {
+    return GradientNoise3D (fx, fy, fz, ix, iy, iz, *pTable, seed);
+  }
+
+  double NoiseDeriv (double fx, double fy, double fz, int ix, int iy, int iz,
+    double& dx, double& dy, double& dz) const
+  {
+    return GradientNoiseDeriv3D (fx, fy, fz, ix, iy, iz, *pTable, seed, dx,
+      dy, dz);
+  }
+};
+
+// Generates a gradient-coherent-noise value in the same way as
+// GradientCoherentNoise3D(), with the lattice hash H and the noise quality
+// Q.  The hash returns the gradient-noise value of a lattice point in the
+// same way as GradientNoise3D().
+template <NoiseQuality Q, class T, class H>
+static T GradientCoherentNoise3DImpl (T x, T y, T z, const H& hash)
+{
+  // Create a unit-length cube aligned along an integer boundary.  This cube
+  // surrounds the input point.
+  int x0 = (x > (T)0.0? (int)x: (int)x - 1);
+  int x1 = x0 + 1;
+  int y0 = (y > (T)0.0? (int)y: (int)y - 1);
+  int y1 = y0 + 1;
+  int z0 = (z > (T)0.0? (int)z: (int)z - 1);
+  int z1 = z0 + 1;
+
+  // Map the difference between the coordinates of the input value and the
+  // coordinates of the cube's outer-lower-left vertex onto an S-curve.
+  T xs = SCurveQuality<Q> (x - (T)x0);
+  T ys = SCurveQuality<Q> (y - (T)y0);
+  T zs = SCurveQuality<Q> (z - (T)z0);
+
+  // Now calculate the noise values at each vertex of the cube.  To generate
+  // the coherent-noise value at the input point, interpolate these eight
+  // noise values using the S-curve value as the interpolant (trilinear
+  // interpolation.)
+  T n0, n1, ix0, ix1, iy0, iy1;
+  n0   = hash.Noise (x, y, z, x0, y0, z0);
+  n1   = hash.Noise (x, y, z, x1, y0, z0);
+  ix0  = LinearInterp (n0, n1, xs);
+  n0   = hash.Noise (x, y, z, x0, y1, z0);
+  n1   = hash.Noise (x, y, z, x1, y1, z0);
+  ix1  = LinearInterp (n0, n1, xs);
+  iy0  = LinearInterp (ix0, ix1, ys);
+  n0   = hash.Noise (x, y, z, x0, y0, z1);
+  n1   = hash.Noise (x, y, z, x1, y0, z1);
+  ix0  = LinearInterp (n0, n1, xs);
+  n0   = hash.Noise (x, y, z, x0, y1, z1);
+  n1   = hash.Noise (x, y, z, x1, y1, z1);
+  ix1  = LinearInterp (n0, n1, xs);
+  iy1  = LinearInterp (ix0, ix1, ys);
+
+  return LinearInterp (iy0, iy1, zs);
+}
+
+// Generates a gradient-coherent-noise value and its partial derivatives in
+// the same way as GradientCoherentNoise3D(), with the lattice hash H and the
+// noise quality Q.
+template <NoiseQuality Q, class H>
+static double GradientCoherentNoiseDeriv3DImpl (double x, double y,
+  double z, const H& hash, double& dx, double& dy, double& dz)
+{
+  // Create a unit-length cube aligned along an integer boundary.  This cube
+  // surrounds the input point.
+  int x0 = (x > 0.0? (int)x: (int)x - 1);
+  int x1 = x0 + 1;
+  int y0 = (y > 0.0? (int)y: (int)y - 1);
+  int y1 = y0 + 1;
+  int z0 = (z > 0.0? (int)z: (int)z - 1);
+  int z1 = z0 + 1;
+
+  // Map the difference between the coordinates of the input value and the
+  // coordinates of the cube's outer-lower-left vertex onto an S-curve, and
+  // calculate the slope of the S-curve at that position.
+  double xd = x - (double)x0;
+  double yd = y - (double)y0;
+  double zd = z - (double)z0;
+  double xs = 0, ys = 0, zs = 0;
+  double xsd = 0, ysd = 0, zsd = 0;
+  switch (Q) {
+    case QUALITY_FAST:
+      xs = xd;
+      ys = yd;
+      zs = zd;
+      xsd = 1.0;
+      ysd = 1.0;
+      zsd = 1.0;
+      break;
+    case QUALITY_STD:
+      xs = SCurve3 (xd);
+      ys = SCurve3 (yd);
+      zs = SCurve3 (zd);
+      xsd = 6.0 * xd * (1.0 - xd);
+      ysd = 6.0 * yd * (1.0 - yd);
+      zsd = 6.0 * zd * (1.0 - zd);
+      break;
+    case QUALITY_BEST:
+      xs = SCurve5 (xd);
+      ys = SCurve5 (yd);
+      zs = SCurve5 (zd);
+      xsd = 30.0 * xd * xd * (xd - 1.0) * (xd - 1.0);
+      ysd = 30.0 * yd * yd * (yd - 1.0) * (yd - 1.0);
+      zsd = 30.0 * zd * zd * (zd - 1.0) * (zd - 1.0);
+      break;
+  }
+
+  // Interpolate the noise values at the vertices of the cube in the same
+  // order as the other version of this function, so that the returned value
+  // is identical.  Each interpolation also interpolates the derivatives of
+  // its two inputs, and the interpolation along an axis adds the slope of
+  // the S-curve multiplied by the difference between its two inputs to the
+  // derivative along that axis (product rule.)
+  double n0, n1, ix0, ix1, iy0, iy1;
+  double n0x, n0y, n0z, n1x, n1y, n1z;
+  double ix0x, ix0y, ix0z, ix1x, ix1y, ix1z;
+  double iy0x, iy0y, iy0z, iy1x, iy1y, iy1z;
+  n0   = hash.NoiseDeriv (x, y, z, x0, y0, z0, n0x, n0y, n0z);
+  n1   = hash.NoiseDeriv (x, y, z, x1, y0, z0, n1x, n1y, n1z);
+  ix0  = LinearInterp (n0, n1, xs);
+  ix0x = LinearInterp (n0x, n1x, xs) + (n1 - n0) * xsd;
+  ix0y = LinearInterp (n0y, n1y, xs);
+  ix0z = LinearInterp (n0z, n1z, xs);
+  n0   = hash.NoiseDeriv (x, y, z, x0, y1, z0, n0x, n0y, n0z);
+  n1   = hash.NoiseDeriv (x, y, z, x1, y1, z0, n1x, n1y, n1z);
+  ix1  = LinearInterp (n0, n1, xs);
+  ix1x = LinearInterp (n0x, n1x, xs) + (n1 - n0) * xsd;
+  ix1y = LinearInterp (n0y, n1y, xs);
+  ix1z = LinearInterp (n0z, n1z, xs);
+  iy0  = LinearInterp (ix0, ix1, ys);
+  iy0x = LinearInterp (ix0x, ix1x, ys);
+  iy0y = LinearInterp (ix0y, ix1y, ys) + (ix1 - ix0) * ysd;
+  iy0z = LinearInterp (ix0z, ix1z, ys);
+  n0   = hash.NoiseDeriv (x, y, z, x0, y0, z1, n0x, n0y, n0z);
+  n1   = hash.NoiseDeriv (x, y, z, x1, y0, z1, n1x, n1y, n1z);
+  ix0  = LinearInterp (n0, n1, xs);
+  ix0x = LinearInterp (n0x, n1x, xs) + (n1 - n0) * xsd;
+  ix0y = LinearInterp (n0y, n1y, xs);
+  ix0z = LinearInterp (n0z, n1z, xs);
+  n0   = hash.NoiseDeriv (x, y, z, x0, y1, z1, n0x, n0y, n0z);
+  n1   = hash.NoiseDeriv (x, y, z, x1, y1, z1, n1x, n1y, n1z);
+  ix1  = LinearInterp (n0, n1, xs);
+  ix1x = LinearInterp (n0x, n1x, xs) + (n1 - n0) * xsd;
+  ix1y = LinearInterp (n0y, n1y, xs);
+  ix1z = LinearInterp (n0z, n1z, xs);
+  iy1  = LinearInterp (ix0, ix1, ys);
+  iy1x = LinearInterp (ix0x, ix1x, ys);
+  iy1y = LinearInterp (ix0y, ix1y, ys) + (ix1 - ix0) * ysd;
+  iy1z = LinearInterp (ix0z, ix1z, ys);
+
+  dx = LinearInterp (iy0x, iy1x, zs);
+  dy = LinearInterp (iy0y, iy1y, zs);
+  dz = LinearInterp (iy0z, iy1z, zs) + (iy1 - iy0) * zsd;
+  return LinearInterp (iy0, iy1, zs);
+}
+
+// The gradient-coherent-noise functions of GradientCoherentNoiseFunctions,
+// specialized for the noise quality Q.
+
+template <NoiseQuality Q, class T>
+static T GradientCoherentNoise3DQ (T x, T y, T z, int seed)
+{
+  // A point on the x-z plane only depends on four vertices of the cube.
+  if (y == (T)0.0) {
+    return GradientCoherentNoise2DImpl<Q> (x, z, seed);
+  }
+
+  ArithmeticLatticeHash hash = {seed};
+  return GradientCoherentNoise3DImpl<Q> (x, y, z, hash);
+}
+
+template <NoiseQuality Q, class T>
+static T GradientCoherentNoise3DTableQ (T x, T y, T z,
+  const PermutationTable& table, int seed)
+{
+  TableLatticeHash hash = {&table, seed};
+  return GradientCoherentNoise3DImpl<Q> (x, y, z, hash);
+}
+
+template <NoiseQuality Q>
+static double GradientCoherentNoiseDeriv3DQ (double x, double y, double z,
+  int seed, double& dx, double& dy, double& dz)
+{
+  ArithmeticLatticeHash hash = {seed};
+  return GradientCoherentNoiseDeriv3DImpl<Q> (x, y, z, hash, dx, dy, dz);
+}
+
+template <NoiseQuality Q>
+static double GradientCoherentNoiseDeriv3DTableQ (double x, double y,
+  double z, const PermutationTable& table, int seed, double& dx, double& dy,
+  double& dz)
+{
+  TableLatticeHash hash = {&table, seed};
+  return GradientCoherentNoiseDeriv3DImpl<Q> (x, y, z, hash, dx, dy, dz);
+}
+
+template <NoiseQuality Q>
+static void GradientCoherentNoise3DArrayQ (int count, const double* x,
+  const double* y, const double* z, double* values, int seed)
+{
+  // Input values on the x-z plane only depend on four vertices of the cube.
+  // Most arrays have a nonzero y coordinate in their first element, so they
+  // skip the scan; the rest of the array is only scanned if the y
+  // coordinate of its first element is zero.
+  if (count > 0 && y[0] == 0.0 && IsZeroArray (count - 1, y + 1)) {
+    GradientCoherentNoise2DArray (count, x, z, values, seed, Q);
+    return;
+  }
+
+  if (g_pSimdKernels != NULL) {
+    g_pSimdKernels->gradientCoherentNoise3DArray (count, x, y, z, values,
+      seed, Q);
+    return;
+  }
+
+  for (int i = 0; i < count; i++) {
+    values[i] = GradientCoherentNoise3DQ<Q> (x[i], y[i], z[i], seed);
+  }
+}
+
+template <NoiseQuality Q>
+static void GradientCoherentNoise3DArrayFloatQ (int count, const float* x,
+  const float* y, const float* z, float* values, int seed)
+{
+  // Input values on the x-z plane only depend on four vertices of the cube.
+  // Most arrays have a nonzero y coordinate in their first element, so they
+  // skip the scan; the rest of the array is only scanned if the y
+  // coordinate of its first element is zero.
+  if (count > 0 && y[0] == 0.0f && IsZeroArray (count - 1, y + 1)) {
+    GradientCoherentNoise2DArray (count, x, z, values, seed, Q);
+    return;
+  }
+
+  if (g_pSimdKernels != NULL) {
+    g_pSimdKernels->gradientCoherentNoise3DArrayFloat (count, x, y, z,
+      values, seed, Q);
+    return;
+  }
+
+  for (int i = 0; i < count; i++) {
+    values[i] = GradientCoherentNoise3DQ<Q> (x[i], y[i], z[i], seed);
+  }
+}
+
+template <NoiseQuality Q>
+static void GradientCoherentNoise3DTableArrayQ (int count, const double* x,
+  const double* y, const double* z, double* values,
+  const PermutationTable& table, int seed)
+{
+  if (g_pSimdKernels != NULL) {
+    g_pSimdKernels->gradientCoherentNoise3DTableArray (count, x, y, z,
+      values, table, seed, Q);
+    return;
+  }
+
+  for (int i = 0; i < count; i++) {
+    values[i] = GradientCoherentNoise3DTableQ<Q> (x[i], y[i], z[i], table,
+      seed);
+  }
+}
+
+template <NoiseQuality Q>
+static void GradientCoherentNoise3DTableArrayFloatQ (int count,
+  const float* x, const float* y, const float* z, float* values,
+  const PermutationTable& table, int seed)
+{
+  if (g_pSimdKernels != NULL) {
+    g_pSimdKernels->gradientCoherentNoise3DTableArrayFloat (count, x, y, z,
+      values, table, seed, Q);
+    return;
+  }
+
+  for (int i = 0; i < count; i++) {
+    values[i] = GradientCoherentNoise3DTableQ<Q> (x[i], y[i], z[i], table,
+      seed);
+  }
+}
+
+// The specialized gradient-coherent-noise functions for each noise quality.
+static const GradientCoherentNoiseFunctions g_gradientCoherentNoiseFast = {
+  GradientCoherentNoise3DQ<QUALITY_FAST, double>,
+  GradientCoherentNoise3DQ<QUALITY_FAST, float>,
+  GradientCoherentNoise3DTableQ<QUALITY_FAST, double>,
+  GradientCoherentNoise3DTableQ<QUALITY_FAST, float>,
+  GradientCoherentNoiseDeriv3DQ<QUALITY_FAST>,
+  GradientCoherentNoiseDeriv3DTableQ<QUALITY_FAST>,
+  GradientCoherentNoise3DArrayQ<QUALITY_FAST>,
+  GradientCoherentNoise3DArrayFloatQ<QUALITY_FAST>,
+  GradientCoherentNoise3DTableArrayQ<QUALITY_FAST>,
+  GradientCoherentNoise3DTableArrayFloatQ<QUALITY_FAST>
+};
+
+static const GradientCoherentNoiseFunctions g_gradientCoherentNoiseStd = {
+  GradientCoherentNoise3DQ<QUALITY_STD, double>,
+  GradientCoherentNoise3DQ<QUALITY_STD, float>,
+  GradientCoherentNoise3DTableQ<QUALITY_STD, double>,
+  GradientCoherentNoise3DTableQ<QUALITY_STD, float>,
+  GradientCoherentNoiseDeriv3DQ<QUALITY_STD>,
+  GradientCoherentNoiseDeriv3DTableQ<QUALITY_STD>,
+  GradientCoherentNoise3DArrayQ<QUALITY_STD>,
+  GradientCoherentNoise3DArrayFloatQ<QUALITY_STD>,
+  GradientCoherentNoise3DTableArrayQ<QUALITY_STD>,
+  GradientCoherentNoise3DTableArrayFloatQ<QUALITY_STD>
+};
+
+static const GradientCoherentNoiseFunctions g_gradientCoherentNoiseBest = {
+  GradientCoherentNoise3DQ<QUALITY_BEST, double>,
+  GradientCoherentNoise3DQ<QUALITY_BEST, float>,
+  GradientCoherentNoise3DTableQ<QUALITY_BEST, double>,
+  GradientCoherentNoise3DTableQ<QUALITY_BEST, float>,
+  GradientCoherentNoiseDeriv3DQ<QUALITY_BEST>,
+  GradientCoherentNoiseDeriv3DTableQ<QUALITY_BEST>,
+  GradientCoherentNoise3DArrayQ<QUALITY_BEST>,
+  GradientCoherentNoise3DArrayFloatQ<QUALITY_BEST>,
+  GradientCoherentNoise3DTableArrayQ<QUALITY_BEST>,
+  GradientCoherentNoise3DTableArrayFloatQ<QUALITY_BEST>
+};
+
+const GradientCoherentNoiseFunctions&
+  noise::GetGradientCoherentNoiseFunctions (NoiseQuality noiseQuality)
+{
+  switch (noiseQuality) {
+    case QUALITY_STD:
+      return g_gradientCoherentNoiseStd;
+    case QUALITY_BEST:
+      return g_gradientCoherentNoiseBest;
+    default:
+      return g_gradientCoherentNoiseFast;
+  }
+}
+
+double noise::GradientCoherentNoise2D (double x, double z, int seed,
+  NoiseQuality noiseQuality)
+{
+  switch (noiseQuality) {
+    case QUALITY_STD:
+      return GradientCoherentNoise2DImpl<QUALITY_STD> (x, z, seed);
+    case QUALITY_BEST:
+      return GradientCoherentNoise2DImpl<QUALITY_BEST> (x, z, seed);
+    default:
+      return GradientCoherentNoise2DImpl<QUALITY_FAST> (x, z, seed);
+  }
+}
+
+float noise::GradientCoherentNoise2D (float x, float z, int seed,
+  NoiseQuality noiseQuality)
+{
+  switch (noiseQuality) {
+    case QUALITY_STD:
+      return GradientCoherentNoise2DImpl<QUALITY_STD> (x, z, seed);
+    case QUALITY_BEST:
+      return GradientCoherentNoise2DImpl<QUALITY_BEST> (x, z, seed);
+    default:
+      return GradientCoherentNoise2DImpl<QUALITY_FAST> (x, z, seed);
+  }
+}
+
+void noise::GradientCoherentNoise2DArray (int count, const double* x,
+  const double* z, double* values, int seed, NoiseQuality noiseQuality)
+{
+  if (g_pSimdKernels != NULL) {
+    g_pSimdKernels->gradientCoherentNoise2DArray (count, x, z, values, seed,
+      noiseQuality);
+    return;
+  }
+
+  for (int i = 0; i < count; i++) {
+    values[i] = GradientCoherentNoise2D (x[i], z[i], seed, noiseQuality);
+  }
+}
+
+void noise::GradientCoherentNoise2DArray (int count, const float* x,
+  const float* z, float* values, int seed, NoiseQuality noiseQuality)
+{
+  if (g_pSimdKernels != NULL) {
+    g_pSimdKernels->gradientCoherentNoise2DArrayFloat (count, x, z, values,
+      seed, noiseQuality);
+    return;
+  }
+
+  for (int i = 0; i < count; i++) {
+    values[i] = GradientCoherentNoise2D (x[i], z[i], seed, noiseQuality);
+  }
+}
+
+double noise::GradientCoherentNoise3D (double x, double y, double z, int seed,
+  NoiseQuality noiseQuality)
+{
+  return GetGradientCoherentNoiseFunctions (noiseQuality)
+    .gradientCoherentNoise3D (x, y, z, seed);
+}
+
+double noise::GradientCoherentNoise3D (double x, double y, double z,
+  const PermutationTable& table, int seed, NoiseQuality noiseQuality)
+{
+  return GetGradientCoherentNoiseFunctions (noiseQuality)
+    .gradientCoherentNoise3DTable (x, y, z, table, seed);
+}
+
+float noise::GradientCoherentNoise3D (float x, float y, float z, int seed,
+  NoiseQuality noiseQuality)
+{
+  return GetGradientCoherentNoiseFunctions (noiseQuality)
+    .gradientCoherentNoise3DFloat (x, y, z, seed);
+}
+
+float noise::GradientCoherentNoise3D (float x, float y, float z,
+  const PermutationTable& table, int seed, NoiseQuality noiseQuality)
+{
+  return GetGradientCoherentNoiseFunctions (noiseQuality)
+    .gradientCoherentNoise3DTableFloat (x, y, z, table, seed);
+}
 
 double noise::GradientCoherentNoise3D (double x, double y, double z, int seed,
+  NoiseQuality noiseQuality, double& dx, double& dy, double& dz)
+{
+  return GetGradientCoherentNoiseFunctions (noiseQuality)
+    .gradientCoherentNoiseDeriv3D (x, y, z, seed, dx, dy, dz);
+}
+
+double noise::GradientCoherentNoise3D (double x, double y, double z,
+  const PermutationTable& table, int seed, NoiseQuality noiseQuality,
+  double& dx, double& dy, double& dz)
+{
+  return GetGradientCoherentNoiseFunctions (noiseQuality)
+    .gradientCoherentNoiseDeriv3DTable (x, y, z, table, seed, dx, dy, dz);
+}
+
+void noise::GradientCoherentNoise3DArray (int count, const double* x,
+  const double* y, const double* z, double* values, int seed,
   NoiseQuality noiseQuality)
 {
-  // Create a unit-length cube aligned along an integer boundary.  This cube
-  // surrounds the input point.
-  int x0 = (x > 0.0? (int)x: (int)x - 1);
+  GetGradientCoherentNoiseFunctions (noiseQuality)
+    .gradientCoherentNoise3DArray (count, x, y, z, values, seed);
+}
+
+void noise::GradientCoherentNoise3DArray (int count, const float* x,
+  const float* y, const float* z, float* values, int seed,
+  NoiseQuality noiseQuality)
+{
+  GetGradientCoherentNoiseFunctions (noiseQuality)
+    .gradientCoherentNoise3DArrayFloat (count, x, y, z, values, seed);
+}
+
+void noise::GradientCoherentNoise3DArray (int count, const double* x,
+  const double* y, const double* z, double* values,
+  const PermutationTable& table, int seed, NoiseQuality noiseQuality)
+{
+  GetGradientCoherentNoiseFunctions (noiseQuality)
+    .gradientCoherentNoise3DTableArray (count, x, y, z, values, table, seed);
+}
+
+void noise::GradientCoherentNoise3DArray (int count, const float* x,
+  const float* y, const float* z, float* values,
+  const PermutationTable& table, int seed, NoiseQuality noiseQuality)
+{
+  GetGradientCoherentNoiseFunctions (noiseQuality)
+    .gradientCoherentNoise3DTableArrayFloat (count, x, y, z, values, table,
+      seed);
+}
+
+// Interpolates the gradient-noise values at the eight vertices of one cube
+// of the four-dimensional integer lattice, at the w coordinate iw, in the
+// same order as GradientCoherentNoise3D().
+static double GradientCoherentNoiseCube4D (double x, double y, double z,
+  double w, int x0, int y0, int z0, int iw, double xs, double ys, double zs,
+  int seed)
+{
   int x1 = x0 + 1;
-  int y0 = (y > 0.0? (int)y: (int)y - 1);
   int y1 = y0 + 1;
-  int z0 = (z > 0.0? (int)z: (int)z - 1);
   int z1 = z0 + 1;
+  double n0, n1, ix0, ix1, iy0, iy1;
+  n0   = GradientNoise4D (x, y, z, w, x0, y0, z0, iw, seed);
+  n1   = GradientNoise4D (x, y, z, w, x1, y0, z0, iw, seed);
+  ix0  = LinearInterp (n0, n1, xs);
+  n0   = GradientNoise4D (x, y, z, w, x0, y1, z0, iw, seed);
+  n1   = GradientNoise4D (x, y, z, w, x1, y1, z0, iw, seed);
+  ix1  = LinearInterp (n0, n1, xs);
+  iy0  = LinearInterp (ix0, ix1, ys);
+  n0   = GradientNoise4D (x, y, z, w, x0, y0, z1, iw, seed);
+  n1   = GradientNoise4D (x, y, z, w, x1, y0, z1, iw, seed);
+  ix0  = LinearInterp (n0, n1, xs);
+  n0   = GradientNoise4D (x, y, z, w, x0, y1, z1, iw, seed);
+  n1   = GradientNoise4D (x, y, z, w, x1, y1, z1, iw, seed);
+  ix1  = LinearInterp (n0, n1, xs);
+  iy1  = LinearInterp (ix0, ix1, ys);
+  return LinearInterp (iy0, iy1, zs);
+}
+
+double noise::GradientCoherentNoise4D (double x, double y, double z,
+  double w, int seed, NoiseQuality noiseQuality)
+{
+  // Create a unit-length hypercube aligned along an integer boundary.  This
+  // hypercube surrounds the input point.
+  int x0 = (x > 0.0? (int)x: (int)x - 1);
+  int y0 = (y > 0.0? (int)y: (int)y - 1);
+  int z0 = (z > 0.0? (int)z: (int)z - 1);
+  int w0 = (w > 0.0? (int)w: (int)w - 1);
+  int w1 = w0 + 1;
 
   // Map the difference between the coordinates of the input value and the
-  // coordinates of the cube's outer-lower-left vertex onto an S-curve.
-  double xs = 0, ys = 0, zs = 0;
+  // coordinates of the hypercube's lowest vertex onto an S-curve.
+  double xs = 0, ys = 0, zs = 0, ws = 0;
   switch (noiseQuality) {
     case QUALITY_FAST:
       xs = (x - (double)x0);
       ys = (y - (double)y0);
       zs = (z - (double)z0);
+      ws = (w - (double)w0);
       break;
     case QUALITY_STD:
       xs = SCurve3 (x - (double)x0);
       ys = SCurve3 (y - (double)y0);
       zs = SCurve3 (z - (double)z0);
+      ws = SCurve3 (w - (double)w0);
       break;
     case QUALITY_BEST:
       xs = SCurve5 (x - (double)x0);
       ys = SCurve5 (y - (double)y0);
       zs = SCurve5 (z - (double)z0);
+      ws = SCurve5 (w - (double)w0);
       break;
   }
 
-  // Now calculate the noise values at each vertex of the cube.  To generate
-  // the coherent-noise value at the input point, interpolate these eight
-  // noise values using the S-curve value as the interpolant (trilinear
-  // interpolation.)
-  double n0, n1, ix0, ix1, iy0, iy1;
-  n0   = GradientNoise3D (x, y, z, x0, y0, z0, seed);
-  n1   = GradientNoise3D (x, y, z, x1, y0, z0, seed);
-  ix0  = LinearInterp (n0, n1, xs);
-  n0   = GradientNoise3D (x, y, z, x0, y1, z0, seed);
-  n1   = GradientNoise3D (x, y, z, x1, y1, z0, seed);
-  ix1  = LinearInterp (n0, n1, xs);
-  iy0  = LinearInterp (ix0, ix1, ys);
-  n0   = GradientNoise3D (x, y, z, x0, y0, z1, seed);
-  n1   = GradientNoise3D (x, y, z, x1, y0, z1, seed);
-  ix0  = LinearInterp (n0, n1, xs);
-  n0   = GradientNoise3D (x, y, z, x0, y1, z1, seed);
-  n1   = GradientNoise3D (x, y, z, x1, y1, z1, seed);
-  ix1  = LinearInterp (n0, n1, xs);
-  iy1  = LinearInterp (ix0, ix1, ys);
-
-  return LinearInterp (iy0, iy1, zs);
+  // Interpolate the noise values at the sixteen vertices of the hypercube:
+  // trilinear interpolation within the two cubes at w0 and w1, then linear
+  // interpolation between them.
+  double iw0 = GradientCoherentNoiseCube4D (x, y, z, w, x0, y0, z0, w0, xs,
+    ys, zs, seed);
+  double iw1 = GradientCoherentNoiseCube4D (x, y, z, w, x0, y0, z0, w1, xs,
+    ys, zs, seed);
+  return LinearInterp (iw0, iw1, ws);
 }
 
 double noise::GradientNoise3D (double fx, double fy, double fz, int ix,
@@ -144,22 +892,326 @@ double noise::GradientNoise3D (double fx, double fy, double fz, int ix,
     + (zvGradient * zvPoint)) * 2.12;
 }
 
+float noise::GradientNoise3D (float fx, float fy, float fz, int ix,
+  int iy, int iz, int seed)
+{
+  // Randomly generate a gradient vector given the integer coordinates of the
+  // input value.  This implementation generates a random number and uses it
+  // as an index into a normalized-vector lookup table.
+  int vectorIndex = (
+      X_NOISE_GEN    * ix
+    + Y_NOISE_GEN    * iy
+    + Z_NOISE_GEN    * iz
+    + SEED_NOISE_GEN * seed)
+    & 0xffffffff;
+  vectorIndex ^= (vectorIndex >> SHIFT_NOISE_GEN);
+  vectorIndex &= 0xff;
+
+  float xvGradient = g_randomVectorsFloat[(vectorIndex << 2)    ];
+  float yvGradient = g_randomVectorsFloat[(vectorIndex << 2) + 1];
+  float zvGradient = g_randomVectorsFloat[(vectorIndex << 2) + 2];
+
+  // Set up us another vector equal to the distance between the two vectors
+  // passed to this function.
+  float xvPoint = (fx - (float)ix);
+  float yvPoint = (fy - (float)iy);
+  float zvPoint = (fz - (float)iz);
+
+  // Now compute the dot product of the gradient vector with the distance
+  // vector.  The resulting value is gradient noise.  Apply a scaling value
+  // so that this noise value ranges from -1.0 to 1.0.
+  return ((xvGradient * xvPoint)
+    + (yvGradient * yvPoint)
+    + (zvGradient * zvPoint)) * 2.12f;
+}
+
+double noise::GradientNoise3D (double fx, double fy, double fz, int ix,
+  int iy, int iz, const PermutationTable& table, int seed)
+{
+  // Look up the gradient vector of the integer coordinates in the
+  // permutation table.
+  const double* pVectors = table.GetVectors ()
+    + (table.GetIndex (ix, iy, iz, seed) << 2);
+  double xvGradient = pVectors[0];
+  double yvGradient = pVectors[1];
+  double zvGradient = pVectors[2];
+
+  double xvPoint = (fx - (double)ix);
+  double yvPoint = (fy - (double)iy);
+  double zvPoint = (fz - (double)iz);
+
+  return ((xvGradient * xvPoint)
+    + (yvGradient * yvPoint)
+    + (zvGradient * zvPoint)) * 2.12;
+}
+
+float noise::GradientNoise3D (float fx, float fy, float fz, int ix,
+  int iy, int iz, const PermutationTable& table, int seed)
+{
+  const float* pVectors = table.GetVectorsFloat ()
+    + (table.GetIndex (ix, iy, iz, seed) << 2);
+  float xvGradient = pVectors[0];
+  float yvGradient = pVectors[1];
+  float zvGradient = pVectors[2];
+
+  float xvPoint = (fx - (float)ix);
+  float yvPoint = (fy - (float)iy);
+  float zvPoint = (fz - (float)iz);
+
+  return ((xvGradient * xvPoint)
+    + (yvGradient * yvPoint)
+    + (zvGradient * zvPoint)) * 2.12f;
+}
+
+double noise::GradientNoise4D (double fx, double fy, double fz, double fw,
+  int ix, int iy, int iz, int iw, int seed)
+{
+  // Randomly generate a gradient vector given the integer coordinates of the
+  // input value.  The gradient vector is one of the 32 vectors that have
+  // one zero component and three components of +1 or -1; the hash selects
+  // the zero component and the signs of the other three.
+  int vectorIndex = (
+      X_NOISE_GEN    * ix
+    + Y_NOISE_GEN    * iy
+    + Z_NOISE_GEN    * iz
+    + W_NOISE_GEN    * iw
+    + SEED_NOISE_GEN * seed)
+    & 0xffffffff;
+  vectorIndex ^= (vectorIndex >> SHIFT_NOISE_GEN);
+  vectorIndex &= 0xff;
+
+  // Set up us another vector equal to the distance between the two vectors
+  // passed to this function.
+  double xvPoint = (fx - (double)ix);
+  double yvPoint = (fy - (double)iy);
+  double zvPoint = (fz - (double)iz);
+  double wvPoint = (fw - (double)iw);
+
+  // Now compute the dot product of the gradient vector with the distance
+  // vector: drop the component of the distance vector that corresponds to
+  // the zero component, and add or subtract the other three.  Apply a
+  // scaling value so that this noise value ranges from -1.0 to 1.0.
+  double a, b, c;
+  switch ((vectorIndex >> 3) & 3) {
+    case 0:  a = yvPoint; b = zvPoint; c = wvPoint; break;
+    case 1:  a = xvPoint; b = zvPoint; c = wvPoint; break;
+    case 2:  a = xvPoint; b = yvPoint; c = wvPoint; break;
+    default: a = xvPoint; b = yvPoint; c = zvPoint; break;
+  }
+  return (((vectorIndex & 1)? -a: a)
+    + ((vectorIndex & 2)? -b: b)
+    + ((vectorIndex & 4)? -c: c)) * GRADIENT_NOISE_4D_SCALE;
+}
+
+SimdLevel noise::GetMaxSimdLevel ()
+{
+  // Skip the instruction sets that this build of libnoise does not support.
+  int simdLevel = GetCpuSimdLevel ();
+  while (simdLevel > SIMD_SCALAR
+    && GetSimdKernels ((SimdLevel)simdLevel) == NULL) {
+    simdLevel--;
+  }
+  return (SimdLevel)simdLevel;
+}
+
+SimdLevel noise::GetSimdLevel ()
+{
+  return g_simdLevel;
+}
+
 int noise::IntValueNoise3D (int x, int y, int z, int seed)
 {
   // All constants are primes and must remain prime in order for this noise
   // function to work correctly.
-  int n = (
-      X_NOISE_GEN    * x
-    + Y_NOISE_GEN    * y
-    + Z_NOISE_GEN    * z
-    + SEED_NOISE_GEN * seed)
+  //
+  // Earlier versions of libnoise calculated this hash with signed integers
+  // and masked the result to 31 bits.  The products overflow, so optimizing
+  // compilers dropped the final mask, and about half of the returned values
+  // were negative.  The arithmetic is now unsigned, so that the products
+  // wrap around without undefined behavior, and the final mask is left out
+  // on purpose: the 32-bit result is converted to a signed integer, which
+  // reproduces the values that existing applications generate.
+  unsigned int n = (
+      (unsigned int)X_NOISE_GEN    * (unsigned int)x
+    + (unsigned int)Y_NOISE_GEN    * (unsigned int)y
+    + (unsigned int)Z_NOISE_GEN    * (unsigned int)z
+    + (unsigned int)SEED_NOISE_GEN * (unsigned int)seed)
     & 0x7fffffff;
   n = (n >> 13) ^ n;
-  return (n * (n * n * 60493 + 19990303) + 1376312589) & 0x7fffffff;
+  unsigned int hash = n * (n * n * 60493 + 19990303) + 1376312589;
+  if (hash & 0x80000000) {
+    // Converting a value above INT_MAX to a signed integer is
+    // implementation-defined, so assemble the negative number from its low
+    // 31 bits.
+    return (int)(hash & 0x7fffffff) - 2147483647 - 1;
+  }
+  return (int)hash;
 }
 
-double noise::ValueCoherentNoise3D (double x, double y, double z, int seed,
-  NoiseQuality noiseQuality)
+void noise::IntValueNoise3DArray (int count, const int* x, const int* y,
+  const int* z, int* values, int seed)
+{
+  if (g_pSimdKernels != NULL) {
+    g_pSimdKernels->intValueNoise3DArray (count, x, y, z, values, seed);
+    return;
+  }
+
+  for (int i = 0; i < count; i++) {
+    values[i] = IntValueNoise3D (x[i], y[i], z[i], seed);
+  }
+}
+
+int noise::IntValueNoise4D (int x, int y, int z, int w, int seed)
+{
+  // Same as IntValueNoise3D(), with a term for the w coordinate.  There are
+  // no existing values to reproduce, so the result is masked to 31 bits.
+  unsigned int n = (
+      (unsigned int)X_NOISE_GEN    * (unsigned int)x
+    + (unsigned int)Y_NOISE_GEN    * (unsigned int)y
+    + (unsigned int)Z_NOISE_GEN    * (unsigned int)z
+    + (unsigned int)W_NOISE_GEN    * (unsigned int)w
+    + (unsigned int)SEED_NOISE_GEN * (unsigned int)seed)
+    & 0x7fffffff;
+  n = (n >> 13) ^ n;
+  return (int)((n * (n * n * 60493 + 19990303) + 1376312589) & 0x7fffffff);
+}
+
+void noise::SetSimdLevel (SimdLevel simdLevel)
+{
+  if (simdLevel < SIMD_SCALAR || simdLevel > GetCpuSimdLevel ()) {
+    throw noise::ExceptionInvalidParam ();
+  }
+  const SimdKernels* pSimdKernels = GetSimdKernels (simdLevel);
+  if (simdLevel != SIMD_SCALAR && pSimdKernels == NULL) {
+    throw noise::ExceptionInvalidParam ();
+  }
+  g_simdLevel = simdLevel;
+  g_pSimdKernels = pSimdKernels;
+}
+
+// Generates the contribution of one corner of a simplex to a
+// simplex-coherent-noise value.  The offset from the corner to the input
+// value is (xd, yd, zd); the contribution is the dot product of the
+// corner's gradient vector with that offset, attenuated by a radial falloff
+// that reaches zero before the offset leaves the simplices that share the
+// corner.
+//
+// The corner is identified by the sum of its integer coordinates and the
+// seed, each multiplied by its noise-generation constant, as in
+// GradientNoise3D().
+template <class T>
+static inline T SimplexCornerNoise3D (T xd, T yd, T zd, int latticeHash,
+  const T* pRandomVectors)
+{
+  T falloff = (T)0.5 - xd * xd - yd * yd - zd * zd;
+  falloff = (falloff > (T)0.0? falloff: (T)0.0);
+
+  // Select the gradient vector in the same way as GradientNoise3D().
+  int vectorIndex = latticeHash & 0xffffffff;
+  vectorIndex ^= (vectorIndex >> SHIFT_NOISE_GEN);
+  vectorIndex &= 0xff;
+  const T* pGradient = pRandomVectors + (vectorIndex << 2);
+
+  falloff *= falloff;
+  return falloff * falloff * ((pGradient[0] * xd)
+    + (pGradient[1] * yd)
+    + (pGradient[2] * zd));
+}
+
+// Implements both versions of the SimplexCoherentNoise3D() function.
+template <class T>
+static T SimplexCoherentNoise3DImpl (T x, T y, T z, int seed,
+  const T* pRandomVectors)
+{
+  // Skew the input space so that each unit cube of the integer lattice
+  // contains six simplices (tetrahedra) that tile the unskewed space, and
+  // find the cube that contains the input value.
+  T skew = (x + y + z) * (T)SIMPLEX_SKEW_3D;
+  T xs = x + skew;
+  T ys = y + skew;
+  T zs = z + skew;
+  int x0 = (xs > (T)0.0? (int)xs: (int)xs - 1);
+  int y0 = (ys > (T)0.0? (int)ys: (int)ys - 1);
+  int z0 = (zs > (T)0.0? (int)zs: (int)zs - 1);
+
+  // Calculate the offset from the cube's origin to the input value in the
+  // unskewed space.
+  T unskew = (T)(x0 + y0 + z0) * (T)SIMPLEX_UNSKEW_3D;
+  T xd0 = x - ((T)x0 - unskew);
+  T yd0 = y - ((T)y0 - unskew);
+  T zd0 = z - ((T)z0 - unskew);
+
+  // The simplex that contains the input value runs from the cube's origin
+  // to its opposite vertex along the edges of the cube, in decreasing order
+  // of the offset along each axis.  Its second vertex is one step along the
+  // axis with the largest offset, and its third vertex is one step along
+  // every axis except the one with the smallest offset.  Ties are broken in
+  // x, y, z order.  The vertices are selected without branches, since the
+  // order of the offsets is unpredictable.
+  int xy = (xd0 >= yd0);
+  int yz = (yd0 >= zd0);
+  int xz = (xd0 >= zd0);
+  int x1 = xy & xz;
+  int y1 = (1 - xy) & yz;
+  int z1 = (1 - xz) & (1 - yz);
+  int x2 = xy | xz;
+  int y2 = (1 - xy) | yz;
+  int z2 = 1 - (xz & yz);
+
+  // Calculate the offsets from the other three vertices to the input value;
+  // each step along a skewed axis moves the vertex by SIMPLEX_UNSKEW_3D
+  // along every unskewed axis.
+  T g1 = (T)SIMPLEX_UNSKEW_3D;
+  T g2 = (T)(2.0 * SIMPLEX_UNSKEW_3D);
+  T g3 = (T)(3.0 * SIMPLEX_UNSKEW_3D);
+  T xd1 = xd0 - (T)x1 + g1;
+  T yd1 = yd0 - (T)y1 + g1;
+  T zd1 = zd0 - (T)z1 + g1;
+  T xd2 = xd0 - (T)x2 + g2;
+  T yd2 = yd0 - (T)y2 + g2;
+  T zd2 = zd0 - (T)z2 + g2;
+  T xd3 = xd0 - (T)1.0 + g3;
+  T yd3 = yd0 - (T)1.0 + g3;
+  T zd3 = zd0 - (T)1.0 + g3;
+
+  // Add up the contributions of the four vertices, and apply a scaling
+  // value so that the noise value ranges from -1.0 to +1.0.  The lattice
+  // hash is linear in the integer coordinates, so the hashes of the other
+  // three vertices are offsets from the hash of the cube's origin.
+  int latticeHash =
+      X_NOISE_GEN    * x0
+    + Y_NOISE_GEN    * y0
+    + Z_NOISE_GEN    * z0
+    + SEED_NOISE_GEN * seed;
+  T value
+    = SimplexCornerNoise3D (xd0, yd0, zd0, latticeHash, pRandomVectors)
+    + SimplexCornerNoise3D (xd1, yd1, zd1, latticeHash
+      + X_NOISE_GEN * x1 + Y_NOISE_GEN * y1 + Z_NOISE_GEN * z1,
+      pRandomVectors)
+    + SimplexCornerNoise3D (xd2, yd2, zd2, latticeHash
+      + X_NOISE_GEN * x2 + Y_NOISE_GEN * y2 + Z_NOISE_GEN * z2,
+      pRandomVectors)
+    + SimplexCornerNoise3D (xd3, yd3, zd3, latticeHash
+      + X_NOISE_GEN + Y_NOISE_GEN + Z_NOISE_GEN, pRandomVectors);
+  return value * (T)SIMPLEX_SCALE_3D;
+}
+
+double noise::SimplexCoherentNoise3D (double x, double y, double z,
+  int seed)
+{
+  return SimplexCoherentNoise3DImpl (x, y, z, seed, g_randomVectors);
+}
+
+float noise::SimplexCoherentNoise3D (float x, float y, float z, int seed)
+{
+  return SimplexCoherentNoise3DImpl (x, y, z, seed, g_randomVectorsFloat);
+}
+
+// Generates a value-coherent-noise value in the same way as
+// ValueCoherentNoise3D(), with the noise quality Q.
+template <NoiseQuality Q>
+static double ValueCoherentNoise3DImpl (double x, double y, double z,
+  int seed)
 {
   // Create a unit-length cube aligned along an integer boundary.  This cube
   // surrounds the input point.
@@ -172,24 +1224,9 @@ double noise::ValueCoherentNoise3D (double x, double y, double z, int seed,
 
   // Map the difference between the coordinates of the input value and the
   // coordinates of the cube's outer-lower-left vertex onto an S-curve.
-  double xs = 0, ys = 0, zs = 0;
-  switch (noiseQuality) {
-    case QUALITY_FAST:
-      xs = (x - (double)x0);
-      ys = (y - (double)y0);
-      zs = (z - (double)z0);
-      break;
-    case QUALITY_STD:
-      xs = SCurve3 (x - (double)x0);
-      ys = SCurve3 (y - (double)y0);
-      zs = SCurve3 (z - (double)z0);
-      break;
-    case QUALITY_BEST:
-      xs = SCurve5 (x - (double)x0);
-      ys = SCurve5 (y - (double)y0);
-      zs = SCurve5 (z - (double)z0);
-      break;
-  }
+  double xs = SCurveQuality<Q> (x - (double)x0);
+  double ys = SCurveQuality<Q> (y - (double)y0);
+  double zs = SCurveQuality<Q> (z - (double)z0);
 
   // Now calculate the noise values at each vertex of the cube.  To generate
   // the coherent-noise value at the input point, interpolate these eight
@@ -213,8 +1250,124 @@ double noise::ValueCoherentNoise3D (double x, double y, double z, int seed,
   return LinearInterp (iy0, iy1, zs);
 }
 
+double noise::ValueCoherentNoise3D (double x, double y, double z, int seed,
+  NoiseQuality noiseQuality)
+{
+  switch (noiseQuality) {
+    case QUALITY_STD:
+      return ValueCoherentNoise3DImpl<QUALITY_STD> (x, y, z, seed);
+    case QUALITY_BEST:
+      return ValueCoherentNoise3DImpl<QUALITY_BEST> (x, y, z, seed);
+    default:
+      return ValueCoherentNoise3DImpl<QUALITY_FAST> (x, y, z, seed);
+  }
+}
+
+void noise::ValueCoherentNoise3DArray (int count, const double* x,
+  const double* y, const double* z, double* values, int seed,
+  NoiseQuality noiseQuality)
+{
+  if (g_pSimdKernels != NULL) {
+    g_pSimdKernels->valueCoherentNoise3DArray (count, x, y, z, values, seed,
+      noiseQuality);
+    return;
+  }
+
+  for (int i = 0; i < count; i++) {
+    values[i] = ValueCoherentNoise3D (x[i], y[i], z[i], seed, noiseQuality);
+  }
+}
+
+// Interpolates the value-noise values at the eight vertices of one cube of
+// the four-dimensional integer lattice, at the w coordinate iw, in the same
+// order as ValueCoherentNoise3D().
+static double ValueCoherentNoiseCube4D (int x0, int y0, int z0, int iw,
+  double xs, double ys, double zs, int seed)
+{
+  int x1 = x0 + 1;
+  int y1 = y0 + 1;
+  int z1 = z0 + 1;
+  double n0, n1, ix0, ix1, iy0, iy1;
+  n0   = ValueNoise4D (x0, y0, z0, iw, seed);
+  n1   = ValueNoise4D (x1, y0, z0, iw, seed);
+  ix0  = LinearInterp (n0, n1, xs);
+  n0   = ValueNoise4D (x0, y1, z0, iw, seed);
+  n1   = ValueNoise4D (x1, y1, z0, iw, seed);
+  ix1  = LinearInterp (n0, n1, xs);
+  iy0  = LinearInterp (ix0, ix1, ys);
+  n0   = ValueNoise4D (x0, y0, z1, iw, seed);
+  n1   = ValueNoise4D (x1, y0, z1, iw, seed);
+  ix0  = LinearInterp (n0, n1, xs);
+  n0   = ValueNoise4D (x0, y1, z1, iw, seed);
+  n1   = ValueNoise4D (x1, y1, z1, iw, seed);
+  ix1  = LinearInterp (n0, n1, xs);
+  iy1  = LinearInterp (ix0, ix1, ys);
+  return LinearInterp (iy0, iy1, zs);
+}
+
+double noise::ValueCoherentNoise4D (double x, double y, double z, double w,
+  int seed, NoiseQuality noiseQuality)
+{
+  // Create a unit-length hypercube aligned along an integer boundary.  This
+  // hypercube surrounds the input point.
+  int x0 = (x > 0.0? (int)x: (int)x - 1);
+  int y0 = (y > 0.0? (int)y: (int)y - 1);
+  int z0 = (z > 0.0? (int)z: (int)z - 1);
+  int w0 = (w > 0.0? (int)w: (int)w - 1);
+  int w1 = w0 + 1;
+
+  // Map the difference between the coordinates of the input value and the
+  // coordinates of the hypercube's lowest vertex onto an S-curve.
+  double xs = 0, ys = 0, zs = 0, ws = 0;
+  switch (noiseQuality) {
+    case QUALITY_FAST:
+      xs = (x - (double)x0);
+      ys = (y - (double)y0);
+      zs = (z - (double)z0);
+      ws = (w - (double)w0);
+      break;
+    case QUALITY_STD:
+      xs = SCurve3 (x - (double)x0);
+      ys = SCurve3 (y - (double)y0);
+      zs = SCurve3 (z - (double)z0);
+      ws = SCurve3 (w - (double)w0);
+      break;
+    case QUALITY_BEST:
+      xs = SCurve5 (x - (double)x0);
+      ys = SCurve5 (y - (double)y0);
+      zs = SCurve5 (z - (double)z0);
+      ws = SCurve5 (w - (double)w0);
+      break;
+  }
+
+  // Interpolate the noise values at the sixteen vertices of the hypercube:
+  // trilinear interpolation within the two cubes at w0 and w1, then linear
+  // interpolation between them.
+  double iw0 = ValueCoherentNoiseCube4D (x0, y0, z0, w0, xs, ys, zs, seed);
+  double iw1 = ValueCoherentNoiseCube4D (x0, y0, z0, w1, xs, ys, zs, seed);
+  return LinearInterp (iw0, iw1, ws);
+}
+
 double noise::ValueNoise3D (int x, int y, int z, int seed)
 {
   return 1.0 - ((double)IntValueNoise3D (x, y, z, seed) / 1073741824.0);
 }
 
+void noise::ValueNoise3DArray (int count, const int* x, const int* y,
+  const int* z, double* values, int seed)
+{
+  if (g_pSimdKernels != NULL) {
+    g_pSimdKernels->valueNoise3DArray (count, x, y, z, values, seed);
+    return;
+  }
+
+  for (int i = 0; i < count; i++) {
+    values[i] = ValueNoise3D (x[i], y[i], z[i], seed);
+  }
+}
+
+double noise::ValueNoise4D (int x, int y, int z, int w, int seed)
+{
+  return 1.0 - ((double)IntValueNoise4D (x, y, z, w, seed) / 1073741824.0);
+}
+
@@ -25,6 +25,7 @@
 
 #include <math.h>
 #include "basictypes.h"
+#include "permutationtable.h"
 
 namespace noise
 {
@@ -59,6 +60,254 @@ namespace noise
 
   };
 
+  /// Enumerates the instruction sets that the vectorized coherent-noise
+  /// functions can use.
+  ///
+  /// Each level is a superset of the levels before it.
+  enum SimdLevel
+  {
+
+    /// Uses the scalar code only.
+    SIMD_SCALAR = 0,
+
+    /// Uses SSE2 instructions; generates two double-precision or four
+    /// single-precision noise values at once.
+    SIMD_SSE2 = 1,
+
+    /// Uses SSE4.1 instructions; generates two double-precision or four
+    /// single-precision noise values at once.
+    SIMD_SSE41 = 2,
+
+    /// Uses AVX2 instructions; generates four double-precision or eight
+    /// single-precision noise values at once.
+    SIMD_AVX2 = 3,
+
+    /// Uses AVX-512 instructions; generates eight double-precision or
+    /// sixteen single-precision noise values at once.
+    SIMD_AVX512 = 4
+
+  };
+
+  /// Maximum absolute value returned by the gradient-coherent-noise
+  /// functions.
+  ///
+  /// A gradient-coherent-noise value is a weighted average of the dot
+  /// products of the unit-length gradient vectors with the offsets from the
+  /// eight vertices of the surrounding cube, multiplied by 2.12.  For all
+  /// three noise qualities, the weighted average of the squared lengths of
+  /// these offsets is at most 3/4, so the magnitude of the noise value is at
+  /// most 2.12 * sqrt (3/4), or about 1.836.  In practice, the values rarely
+  /// leave the -1.0 to +1.0 range.
+  ///
+  /// The noise modules use this value to calculate the bounds of their
+  /// output values (see noise::module::Module::GetBounds().)
+  const double GRADIENT_COHERENT_NOISE_BOUND = 1.84;
+
+  /// Maximum absolute value returned by the GradientCoherentNoise4D()
+  /// function.
+  ///
+  /// The four-dimensional gradient vectors have a length of sqrt (3), and
+  /// the weighted average of the squared lengths of the offsets from the
+  /// sixteen vertices of the surrounding hypercube is at most 1, so the
+  /// magnitude of the noise value is at most 1.42 * sqrt (3), or about
+  /// 2.4595.  In practice, the values rarely leave the -1.0 to +1.0 range.
+  const double GRADIENT_COHERENT_NOISE_4D_BOUND = 2.46;
+
+  /// Maximum absolute value returned by the simplex-coherent-noise
+  /// functions.
+  ///
+  /// A simplex-coherent-noise value is the sum of the contributions of the
+  /// four vertices of a tetrahedron.  Its magnitude is largest when every
+  /// gradient vector points along the offset from its vertex; the largest
+  /// such sum, found by a numerical search over a tetrahedron, is about
+  /// 0.0092891, and the sum is multiplied by 107.6, so the magnitude of
+  /// the noise value is at most about 0.9995.
+  ///
+  /// The noise modules use this value to calculate the bounds of their
+  /// output values (see noise::module::Module::GetBounds().)
+  const double SIMPLEX_COHERENT_NOISE_BOUND = 1.0;
+
+  /// Maximum absolute difference between a value generated by the
+  /// vectorized GradientCoherentNoise3DArray() function and the value
+  /// generated by GradientCoherentNoise3D() for the same input value.
+  ///
+  /// Both functions perform the same floating-point operations, so this
+  /// difference is zero unless the compiler contracts operations into fused
+  /// multiply-add instructions in one of them.
+  const double NOISE_SIMD_TOLERANCE = 1.0e-12;
+
+  /// The gradient-coherent-noise functions, specialized for one noise
+  /// quality.
+  ///
+  /// Each function in this structure is compiled for a single
+  /// noise::NoiseQuality, so the S-curve is inlined into the interpolation
+  /// and nothing branches on the quality.  The functions return the same
+  /// values as the overloads of GradientCoherentNoise3D() and
+  /// GradientCoherentNoise3DArray() that they are named after, which call
+  /// them.  An application that generates many values with the same noise
+  /// quality, such as a fractal noise module, may call
+  /// GetGradientCoherentNoiseFunctions() once and call these functions
+  /// directly.
+  struct GradientCoherentNoiseFunctions
+  {
+
+    /// GradientCoherentNoise3D().
+    double (*gradientCoherentNoise3D) (double x, double y, double z,
+      int seed);
+
+    /// Single-precision GradientCoherentNoise3D().
+    float (*gradientCoherentNoise3DFloat) (float x, float y, float z,
+      int seed);
+
+    /// GradientCoherentNoise3D() with a permutation table.
+    double (*gradientCoherentNoise3DTable) (double x, double y, double z,
+      const PermutationTable& table, int seed);
+
+    /// Single-precision GradientCoherentNoise3D() with a permutation table.
+    float (*gradientCoherentNoise3DTableFloat) (float x, float y, float z,
+      const PermutationTable& table, int seed);
+
+    /// GradientCoherentNoise3D() with partial derivatives.
+    double (*gradientCoherentNoiseDeriv3D) (double x, double y, double z,
+      int seed, double& dx, double& dy, double& dz);
+
+    /// GradientCoherentNoise3D() with a permutation table and partial
+    /// derivatives.
+    double (*gradientCoherentNoiseDeriv3DTable) (double x, double y,
+      double z, const PermutationTable& table, int seed, double& dx,
+      double& dy, double& dz);
+
+    /// GradientCoherentNoise3DArray().
+    void (*gradientCoherentNoise3DArray) (int count, const double* x,
+      const double* y, const double* z, double* values, int seed);
+
+    /// Single-precision GradientCoherentNoise3DArray().
+    void (*gradientCoherentNoise3DArrayFloat) (int count, const float* x,
+      const float* y, const float* z, float* values, int seed);
+
+    /// GradientCoherentNoise3DArray() with a permutation table.
+    void (*gradientCoherentNoise3DTableArray) (int count, const double* x,
+      const double* y, const double* z, double* values,
+      const PermutationTable& table, int seed);
+
+    /// Single-precision GradientCoherentNoise3DArray() with a permutation
+    /// table.
+    void (*gradientCoherentNoise3DTableArrayFloat) (int count,
+      const float* x, const float* y, const float* z, float* values,
+      const PermutationTable& table, int seed);
+
+  };
+
+  /// Returns the gradient-coherent-noise functions specialized for a noise
+  /// quality.
+  ///
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @returns The specialized functions.  They exist for as long as
+  /// libnoise is loaded.
+  const GradientCoherentNoiseFunctions& GetGradientCoherentNoiseFunctions (
+    NoiseQuality noiseQuality);
+
+  /// Returns the best instruction set that the vectorized coherent-noise
+  /// functions can use on this computer.
+  ///
+  /// @returns The best instruction set that both the processor and this
+  /// build of libnoise support.
+  ///
+  /// libnoise contains a version of the vectorized coherent-noise functions
+  /// for each instruction set in noise::SimdLevel, provided that the
+  /// compiler supports that instruction set.  The processor is queried with
+  /// the @a cpuid instruction.
+  SimdLevel GetMaxSimdLevel ();
+
+  /// Returns the instruction set that the vectorized coherent-noise
+  /// functions currently use.
+  ///
+  /// @returns The instruction set that the vectorized coherent-noise
+  /// functions use.
+  ///
+  /// When libnoise is loaded, it selects the instruction set returned by
+  /// GetMaxSimdLevel().  To select a different instruction set, call
+  /// SetSimdLevel().
+  SimdLevel GetSimdLevel ();
+
+  /// Generates a gradient-coherent-noise value from the coordinates of an
+  /// input value on the x-z plane.
+  ///
+  /// @param x The @a x coordinate of the input value.
+  /// @param z The @a z coordinate of the input value.
+  /// @param seed The random number seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @returns The generated gradient-coherent-noise value.
+  ///
+  /// The return value is identical to the value that
+  /// GradientCoherentNoise3D() returns for the input value (@a x, 0.0,
+  /// @a z).  On that plane, the three-dimensional noise only depends on the
+  /// four vertices of one face of the surrounding cube, so this function
+  /// evaluates half as many gradient vectors.
+  ///
+  /// The return value usually ranges from -1.0 to +1.0; its magnitude never
+  /// exceeds noise::GRADIENT_COHERENT_NOISE_BOUND.
+  double GradientCoherentNoise2D (double x, double z, int seed = 0,
+    NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates a gradient-coherent-noise value from the coordinates of an
+  /// input value on the x-z plane, in single precision.
+  ///
+  /// @param x The @a x coordinate of the input value.
+  /// @param z The @a z coordinate of the input value.
+  /// @param seed The random number seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @returns The generated gradient-coherent-noise value.
+  ///
+  /// The return value is identical to the value that the single-precision
+  /// version of GradientCoherentNoise3D() returns for the input value
+  /// (@a x, 0.0, @a z).
+  float GradientCoherentNoise2D (float x, float z, int seed = 0,
+    NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates gradient-coherent-noise values from the coordinates of an
+  /// array of input values on the x-z plane.
+  ///
+  /// @param count The number of input values.
+  /// @param x An array containing the @a x coordinates of the input values.
+  /// @param z An array containing the @a z coordinates of the input values.
+  /// @param values An array that receives the generated
+  /// gradient-coherent-noise values.
+  /// @param seed The random number seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// The <i>i</i>th element of @a values receives the value that
+  /// GradientCoherentNoise2D() returns for the <i>i</i>th input value.
+  /// This function is vectorized in the same way as
+  /// GradientCoherentNoise3DArray().
+  ///
+  /// Pass each coordinate to the MakeInt32Range() function before calling
+  /// this function.
+  void GradientCoherentNoise2DArray (int count, const double* x,
+    const double* z, double* values, int seed = 0,
+    NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates single-precision gradient-coherent-noise values from the
+  /// coordinates of an array of input values on the x-z plane.
+  ///
+  /// @param count The number of input values.
+  /// @param x An array containing the @a x coordinates of the input values.
+  /// @param z An array containing the @a z coordinates of the input values.
+  /// @param values An array that receives the generated
+  /// gradient-coherent-noise values.
+  /// @param seed The random number seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// The <i>i</i>th element of @a values receives the value that the
+  /// single-precision version of GradientCoherentNoise2D() returns for the
+  /// <i>i</i>th input value.
+  void GradientCoherentNoise2DArray (int count, const float* x,
+    const float* z, float* values, int seed = 0,
+    NoiseQuality noiseQuality = QUALITY_STD);
+
   /// Generates a gradient-coherent-noise value from the coordinates of a
   /// three-dimensional input value.
   ///
@@ -70,13 +319,275 @@ namespace noise
   ///
   /// @returns The generated gradient-coherent-noise value.
   ///
-  /// The return value ranges from -1.0 to +1.0.
+  /// The return value usually ranges from -1.0 to +1.0; its magnitude never
+  /// exceeds noise::GRADIENT_COHERENT_NOISE_BOUND.
   ///
   /// For an explanation of the difference between <i>gradient</i> noise and
   /// <i>value</i> noise, see the comments for the GradientNoise3D() function.
+  ///
+  /// If @a y is 0.0, this function calls GradientCoherentNoise2D(), which
+  /// returns the same value faster.  Noise modules that pass the @a y
+  /// coordinate through unchanged, such as the generator and combiner
+  /// modules, therefore generate values on the x-z plane (for example, for
+  /// noise::model::Plane) with the faster function.
   double GradientCoherentNoise3D (double x, double y, double z, int seed = 0,
     NoiseQuality noiseQuality = QUALITY_STD);
 
+  /// Generates a gradient-coherent-noise value from the coordinates of a
+  /// three-dimensional input value, with a permutation table as the
+  /// lattice hash.
+  ///
+  /// @param x The @a x coordinate of the input value.
+  /// @param y The @a y coordinate of the input value.
+  /// @param z The @a z coordinate of the input value.
+  /// @param table The permutation table.
+  /// @param seed The random number seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @returns The generated gradient-coherent-noise value.
+  ///
+  /// This function works like the other double-precision version, except
+  /// that it selects the gradient vector of each lattice point with the
+  /// permutation table; see noise::PermutationTable.  The gradient vectors
+  /// of the table are unit-length, so the magnitude of the return value
+  /// never exceeds noise::GRADIENT_COHERENT_NOISE_BOUND.
+  double GradientCoherentNoise3D (double x, double y, double z,
+    const PermutationTable& table, int seed = 0,
+    NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates a gradient-coherent-noise value from the coordinates of a
+  /// three-dimensional input value, in single precision.
+  ///
+  /// @param x The @a x coordinate of the input value.
+  /// @param y The @a y coordinate of the input value.
+  /// @param z The @a z coordinate of the input value.
+  /// @param seed The random number seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @returns The generated gradient-coherent-noise value.
+  ///
+  /// This function performs the same steps as the double-precision version
+  /// with single-precision arithmetic and a single-precision copy of the
+  /// gradient-vector table, so its result differs from the double-precision
+  /// result by roughly the precision of a float.
+  ///
+  /// A float has a 24-bit significand, so the fractional part of a
+  /// coordinate becomes coarse as the coordinate grows: between 32768 and
+  /// 65536, a coordinate can only take 256 distinct positions within each
+  /// unit cube of the integer lattice, and above 8388608 every float is an
+  /// integer, where gradient noise is always zero.  MakeInt32Range() only
+  /// keeps coordinates within the range of a 32-bit integer; it does not
+  /// restore the lost precision.  Keep single-precision coordinates (after
+  /// multiplying them by the frequency of the highest octave) well below
+  /// 32768, or use the double-precision functions.
+  ///
+  /// If @a y is 0.0, this function calls the single-precision version of
+  /// GradientCoherentNoise2D().
+  float GradientCoherentNoise3D (float x, float y, float z, int seed = 0,
+    NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates a gradient-coherent-noise value from the coordinates of a
+  /// three-dimensional input value, with a permutation table as the
+  /// lattice hash, in single precision.
+  ///
+  /// @param x The @a x coordinate of the input value.
+  /// @param y The @a y coordinate of the input value.
+  /// @param z The @a z coordinate of the input value.
+  /// @param table The permutation table.
+  /// @param seed The random number seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @returns The generated gradient-coherent-noise value.
+  ///
+  /// This is the single-precision version of the function above; it uses
+  /// the single-precision gradient vectors of the table.
+  float GradientCoherentNoise3D (float x, float y, float z,
+    const PermutationTable& table, int seed = 0,
+    NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates a gradient-coherent-noise value and its partial derivatives
+  /// from the coordinates of a three-dimensional input value.
+  ///
+  /// @param x The @a x coordinate of the input value.
+  /// @param y The @a y coordinate of the input value.
+  /// @param z The @a z coordinate of the input value.
+  /// @param seed The random number seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  /// @param dx Receives the partial derivative with respect to @a x.
+  /// @param dy Receives the partial derivative with respect to @a y.
+  /// @param dz Receives the partial derivative with respect to @a z.
+  ///
+  /// @returns The generated gradient-coherent-noise value.
+  ///
+  /// The return value is identical to the value returned by the other
+  /// double-precision version of this function.  The derivatives are
+  /// calculated analytically from the gradient vectors and the slope of
+  /// the S-curve, so they cost about as much as the value itself, which
+  /// is far less than estimating them from several noise values.
+  ///
+  /// With a noise quality of noise::QUALITY_FAST, the derivatives are
+  /// discontinuous at integer boundaries.
+  double GradientCoherentNoise3D (double x, double y, double z, int seed,
+    NoiseQuality noiseQuality, double& dx, double& dy, double& dz);
+
+  /// Generates a gradient-coherent-noise value and its partial derivatives
+  /// from the coordinates of a three-dimensional input value, with a
+  /// permutation table as the lattice hash.
+  ///
+  /// @param x The @a x coordinate of the input value.
+  /// @param y The @a y coordinate of the input value.
+  /// @param z The @a z coordinate of the input value.
+  /// @param table The permutation table.
+  /// @param seed The random number seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  /// @param dx Receives the partial derivative with respect to @a x.
+  /// @param dy Receives the partial derivative with respect to @a y.
+  /// @param dz Receives the partial derivative with respect to @a z.
+  ///
+  /// @returns The generated gradient-coherent-noise value.
+  ///
+  /// The return value is identical to the value returned by the version of
+  /// this function that takes a permutation table and no derivatives.
+  double GradientCoherentNoise3D (double x, double y, double z,
+    const PermutationTable& table, int seed, NoiseQuality noiseQuality,
+    double& dx, double& dy, double& dz);
+
+  /// Generates gradient-coherent-noise values from the coordinates of an
+  /// array of three-dimensional input values.
+  ///
+  /// @param count The number of input values.
+  /// @param x An array containing the @a x coordinates of the input values.
+  /// @param y An array containing the @a y coordinates of the input values.
+  /// @param z An array containing the @a z coordinates of the input values.
+  /// @param values An array that receives the generated
+  /// gradient-coherent-noise values.
+  /// @param seed The random number seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// The <i>i</i>th element of @a values receives the value that
+  /// GradientCoherentNoise3D() returns for the <i>i</i>th input value.
+  ///
+  /// This function evaluates several input values at once with the
+  /// instruction set returned by GetSimdLevel(): the lattice hash, the
+  /// gradient-vector lookup, the S-curve, and the trilinear interpolation
+  /// are all vectorized.  The vectorized code
+  /// performs exactly the same floating-point operations in the same order
+  /// as GradientCoherentNoise3D(), so the results are bit-identical for all
+  /// three noise qualities.  If the compiler contracts multiplications and
+  /// additions into fused multiply-add instructions (for example, when
+  /// compiling with <tt>-mfma</tt>), the results may differ from
+  /// GradientCoherentNoise3D() by a few units in the last place; the
+  /// difference never exceeds noise::NOISE_SIMD_TOLERANCE.
+  ///
+  /// If every @a y coordinate is 0.0, this function calls
+  /// GradientCoherentNoise2DArray(), which returns the same values faster.
+  ///
+  /// Pass each coordinate to the MakeInt32Range() function before calling
+  /// this function.
+  void GradientCoherentNoise3DArray (int count, const double* x,
+    const double* y, const double* z, double* values, int seed = 0,
+    NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates gradient-coherent-noise values from the coordinates of an
+  /// array of three-dimensional input values, with a permutation table as
+  /// the lattice hash.
+  ///
+  /// @param count The number of input values.
+  /// @param x An array containing the @a x coordinates of the input values.
+  /// @param y An array containing the @a y coordinates of the input values.
+  /// @param z An array containing the @a z coordinates of the input values.
+  /// @param values An array that receives the generated
+  /// gradient-coherent-noise values.
+  /// @param table The permutation table.
+  /// @param seed The random number seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// The <i>i</i>th element of @a values receives the value that the
+  /// version of GradientCoherentNoise3D() that takes a permutation table
+  /// returns for the <i>i</i>th input value.  The table lookups are
+  /// vectorized with gather instructions if GetSimdLevel() returns
+  /// noise::SIMD_AVX2 or higher, and one lane at a time otherwise; the
+  /// results are the same in either case.
+  void GradientCoherentNoise3DArray (int count, const double* x,
+    const double* y, const double* z, double* values,
+    const PermutationTable& table, int seed = 0,
+    NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates single-precision gradient-coherent-noise values from the
+  /// coordinates of an array of three-dimensional input values.
+  ///
+  /// @param count The number of input values.
+  /// @param x An array containing the @a x coordinates of the input values.
+  /// @param y An array containing the @a y coordinates of the input values.
+  /// @param z An array containing the @a z coordinates of the input values.
+  /// @param values An array that receives the generated
+  /// gradient-coherent-noise values.
+  /// @param seed The random number seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// The <i>i</i>th element of @a values receives the value that the
+  /// single-precision version of GradientCoherentNoise3D() returns for the
+  /// <i>i</i>th input value.  A vector register holds twice as many floats
+  /// as doubles, so this function generates twice as many values at once
+  /// as the double-precision version.
+  ///
+  /// See the single-precision version of GradientCoherentNoise3D() for the
+  /// loss of precision at large coordinates.
+  ///
+  /// If every @a y coordinate is 0.0, this function calls the
+  /// single-precision version of GradientCoherentNoise2DArray().
+  void GradientCoherentNoise3DArray (int count, const float* x,
+    const float* y, const float* z, float* values, int seed = 0,
+    NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates single-precision gradient-coherent-noise values from the
+  /// coordinates of an array of three-dimensional input values, with a
+  /// permutation table as the lattice hash.
+  ///
+  /// @param count The number of input values.
+  /// @param x An array containing the @a x coordinates of the input values.
+  /// @param y An array containing the @a y coordinates of the input values.
+  /// @param z An array containing the @a z coordinates of the input values.
+  /// @param values An array that receives the generated
+  /// gradient-coherent-noise values.
+  /// @param table The permutation table.
+  /// @param seed The random number seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// This is the single-precision version of the function above.
+  void GradientCoherentNoise3DArray (int count, const float* x,
+    const float* y, const float* z, float* values,
+    const PermutationTable& table, int seed = 0,
+    NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates a gradient-coherent-noise value from the coordinates of a
+  /// four-dimensional input value.
+  ///
+  /// @param x The @a x coordinate of the input value.
+  /// @param y The @a y coordinate of the input value.
+  /// @param z The @a z coordinate of the input value.
+  /// @param w The @a w coordinate of the input value.
+  /// @param seed The random number seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @returns The generated gradient-coherent-noise value.
+  ///
+  /// The return value usually ranges from -1.0 to +1.0; its magnitude never
+  /// exceeds noise::GRADIENT_COHERENT_NOISE_4D_BOUND.
+  ///
+  /// This function interpolates the gradient-noise values at the sixteen
+  /// vertices of the surrounding hypercube (see GradientNoise4D()), so it
+  /// takes about twice as long as GradientCoherentNoise3D().  The fourth
+  /// coordinate is useful for animating three-dimensional noise over time,
+  /// and for generating seamlessly tiling two-dimensional noise: map each
+  /// of the two tiling coordinates onto a circle, and pass the coordinates
+  /// of the two circles as (@a x, @a y) and (@a z, @a w).
+  ///
+  /// The noise at @a w = 0.0 differs from the three-dimensional noise at
+  /// the same @a x, @a y, and @a z coordinates.
+  double GradientCoherentNoise4D (double x, double y, double z, double w,
+    int seed = 0, NoiseQuality noiseQuality = QUALITY_STD);
+
   /// Generates a gradient-noise value from the coordinates of a
   /// three-dimensional input value and the integer coordinates of a
   /// nearby three-dimensional value.
@@ -121,6 +632,95 @@ namespace noise
   double GradientNoise3D (double fx, double fy, double fz, int ix, int iy,
     int iz, int seed = 0);
 
+  /// Generates a gradient-noise value from the coordinates of a
+  /// three-dimensional input value and the integer coordinates of a
+  /// nearby three-dimensional value, in single precision.
+  ///
+  /// @param fx The floating-point @a x coordinate of the input value.
+  /// @param fy The floating-point @a y coordinate of the input value.
+  /// @param fz The floating-point @a z coordinate of the input value.
+  /// @param ix The integer @a x coordinate of a nearby value.
+  /// @param iy The integer @a y coordinate of a nearby value.
+  /// @param iz The integer @a z coordinate of a nearby value.
+  /// @param seed The random number seed.
+  ///
+  /// @returns The generated gradient-noise value.
+  ///
+  /// This is the single-precision version of the double-precision
+  /// GradientNoise3D() function; the same preconditions apply.
+  float GradientNoise3D (float fx, float fy, float fz, int ix, int iy,
+    int iz, int seed = 0);
+
+  /// Generates a gradient-noise value from the coordinates of a
+  /// three-dimensional input value and the integer coordinates of a
+  /// nearby three-dimensional value, with a permutation table as the
+  /// lattice hash.
+  ///
+  /// @param fx The floating-point @a x coordinate of the input value.
+  /// @param fy The floating-point @a y coordinate of the input value.
+  /// @param fz The floating-point @a z coordinate of the input value.
+  /// @param ix The integer @a x coordinate of a nearby value.
+  /// @param iy The integer @a y coordinate of a nearby value.
+  /// @param iz The integer @a z coordinate of a nearby value.
+  /// @param table The permutation table.
+  /// @param seed The random number seed.
+  ///
+  /// @returns The generated gradient-noise value.
+  ///
+  /// This function works like the other double-precision version of
+  /// GradientNoise3D(), except that the gradient vector is the one that
+  /// noise::PermutationTable::GetIndex() selects; the same preconditions
+  /// apply.
+  double GradientNoise3D (double fx, double fy, double fz, int ix, int iy,
+    int iz, const PermutationTable& table, int seed = 0);
+
+  /// Generates a gradient-noise value from the coordinates of a
+  /// three-dimensional input value and the integer coordinates of a
+  /// nearby three-dimensional value, with a permutation table as the
+  /// lattice hash, in single precision.
+  ///
+  /// @param fx The floating-point @a x coordinate of the input value.
+  /// @param fy The floating-point @a y coordinate of the input value.
+  /// @param fz The floating-point @a z coordinate of the input value.
+  /// @param ix The integer @a x coordinate of a nearby value.
+  /// @param iy The integer @a y coordinate of a nearby value.
+  /// @param iz The integer @a z coordinate of a nearby value.
+  /// @param table The permutation table.
+  /// @param seed The random number seed.
+  ///
+  /// @returns The generated gradient-noise value.
+  ///
+  /// This is the single-precision version of the function above.
+  float GradientNoise3D (float fx, float fy, float fz, int ix, int iy,
+    int iz, const PermutationTable& table, int seed = 0);
+
+  /// Generates a gradient-noise value from the coordinates of a
+  /// four-dimensional input value and the integer coordinates of a nearby
+  /// four-dimensional value.
+  ///
+  /// @param fx The floating-point @a x coordinate of the input value.
+  /// @param fy The floating-point @a y coordinate of the input value.
+  /// @param fz The floating-point @a z coordinate of the input value.
+  /// @param fw The floating-point @a w coordinate of the input value.
+  /// @param ix The integer @a x coordinate of a nearby value.
+  /// @param iy The integer @a y coordinate of a nearby value.
+  /// @param iz The integer @a z coordinate of a nearby value.
+  /// @param iw The integer @a w coordinate of a nearby value.
+  /// @param seed The random number seed.
+  ///
+  /// @returns The generated gradient-noise value.
+  ///
+  /// @pre The difference between each floating-point coordinate and the
+  /// corresponding integer coordinate must be less than or equal to one.
+  ///
+  /// This function works like GradientNoise3D(), except that the gradient
+  /// vector is one of the 32 four-dimensional vectors that have one zero
+  /// component and three components of +1 or -1, selected by hashing the
+  /// nearby integer value.  These vectors need no lookup table, and their
+  /// dot products only require additions.
+  double GradientNoise4D (double fx, double fy, double fz, double fw, int ix,
+    int iy, int iz, int iw, int seed = 0);
+
   /// Generates an integer-noise value from the coordinates of a
   /// three-dimensional input value.
   ///
@@ -131,13 +731,55 @@ namespace noise
   ///
   /// @returns The generated integer-noise value.
   ///
-  /// The return value ranges from 0 to 2147483647.
+  /// The return value ranges from -2147483648 to 2147483647.  Earlier
+  /// versions of libnoise documented a range of 0 to 2147483647, but their
+  /// optimized builds returned negative values as well; this function
+  /// returns the same values as those builds.
   ///
   /// A noise function differs from a random-number generator because it
   /// always returns the same output value if the same input value is passed
   /// to it.
   int IntValueNoise3D (int x, int y, int z, int seed = 0);
 
+  /// Generates integer-noise values from the coordinates of an array of
+  /// three-dimensional input values.
+  ///
+  /// @param count The number of input values.
+  /// @param x An array containing the integer @a x coordinates of the input
+  /// values.
+  /// @param y An array containing the integer @a y coordinates of the input
+  /// values.
+  /// @param z An array containing the integer @a z coordinates of the input
+  /// values.
+  /// @param values An array that receives the generated integer-noise
+  /// values.
+  /// @param seed A random number seed.
+  ///
+  /// The <i>i</i>th element of @a values receives the value that
+  /// IntValueNoise3D() returns for the <i>i</i>th input value.
+  ///
+  /// The hash only uses integer multiplications, additions, and bitwise
+  /// operations, so this function hashes as many input values at once as
+  /// a vector register of the instruction set returned by GetSimdLevel()
+  /// holds 32-bit integers: four with SSE2 or SSE4.1, eight with AVX2, and
+  /// sixteen with AVX-512.
+  void IntValueNoise3DArray (int count, const int* x, const int* y,
+    const int* z, int* values, int seed = 0);
+
+  /// Generates an integer-noise value from the coordinates of a
+  /// four-dimensional input value.
+  ///
+  /// @param x The integer @a x coordinate of the input value.
+  /// @param y The integer @a y coordinate of the input value.
+  /// @param z The integer @a z coordinate of the input value.
+  /// @param w The integer @a w coordinate of the input value.
+  /// @param seed A random number seed.
+  ///
+  /// @returns The generated integer-noise value.
+  ///
+  /// The return value ranges from 0 to 2147483647.
+  int IntValueNoise4D (int x, int y, int z, int w, int seed = 0);
+
   /// Modifies a floating-point value so that it can be stored in a
   /// noise::int32 variable.
   ///
@@ -166,6 +808,98 @@ namespace noise
     }
   }
 
+  /// Modifies a single-precision floating-point value so that it can be
+  /// stored in a noise::int32 variable.
+  ///
+  /// @param n A floating-point number.
+  ///
+  /// @returns The modified floating-point number.
+  ///
+  /// This is the single-precision version of the double-precision
+  /// MakeInt32Range() function.  Note that a float cannot represent the
+  /// fractional part of a number whose magnitude exceeds 8388608, so
+  /// single-precision coherent noise is already degraded long before this
+  /// function modifies a coordinate.
+  inline float MakeInt32Range (float n)
+  {
+    if (n >= 1073741824.0f) {
+      return (2.0f * fmodf (n, 1073741824.0f)) - 1073741824.0f;
+    } else if (n <= -1073741824.0f) {
+      return (2.0f * fmodf (n, 1073741824.0f)) + 1073741824.0f;
+    } else {
+      return n;
+    }
+  }
+
+  /// Sets the instruction set that the vectorized coherent-noise functions
+  /// use.
+  ///
+  /// @param simdLevel The instruction set to use.
+  ///
+  /// @pre @a simdLevel is less than or equal to the value returned by
+  /// GetMaxSimdLevel().
+  ///
+  /// @throw noise::ExceptionInvalidParam An invalid parameter was
+  /// specified; see the preconditions for more information.
+  ///
+  /// The results do not depend on the instruction set, unless the compiler
+  /// contracts operations into fused multiply-add instructions (see
+  /// GradientCoherentNoise3DArray()).  Select a lower instruction set to
+  /// compare the speed of the instruction sets, or pass noise::SIMD_SCALAR
+  /// to generate the values with the scalar code only.
+  ///
+  /// This setting applies to the entire application.  Do not call this
+  /// function while another thread is generating noise values.
+  void SetSimdLevel (SimdLevel simdLevel);
+
+  /// Generates a simplex-coherent-noise value from the coordinates of a
+  /// three-dimensional input value.
+  ///
+  /// @param x The @a x coordinate of the input value.
+  /// @param y The @a y coordinate of the input value.
+  /// @param z The @a z coordinate of the input value.
+  /// @param seed The random number seed.
+  ///
+  /// @returns The generated simplex-coherent-noise value.
+  ///
+  /// The return value ranges from -1.0 to +1.0.
+  ///
+  /// Simplex-coherent noise is gradient noise on a lattice of tetrahedra
+  /// (simplices) instead of cubes.  The input space is skewed so that each
+  /// unit cube of the integer lattice splits into six tetrahedra; the noise
+  /// value is the sum of the contributions of the four vertices of the
+  /// tetrahedron that contains the input value.  Each contribution is the
+  /// dot product of the vertex's gradient vector with the offset from the
+  /// vertex, attenuated by a radial falloff.  The gradient vectors come from
+  /// the same table as the ones of GradientCoherentNoise3D().
+  ///
+  /// Compared to GradientCoherentNoise3D(), which interpolates the values
+  /// of the eight vertices of a cube, this function evaluates half as many
+  /// vertices and needs no interpolation, so it is faster.  The falloff is
+  /// radial, so the noise does not line up with the coordinate axes, and
+  /// its first and second derivatives are continuous everywhere.
+  ///
+  /// Pass each coordinate to the MakeInt32Range() function before calling
+  /// this function.
+  double SimplexCoherentNoise3D (double x, double y, double z, int seed = 0);
+
+  /// Generates a simplex-coherent-noise value from the coordinates of a
+  /// three-dimensional input value, in single precision.
+  ///
+  /// @param x The @a x coordinate of the input value.
+  /// @param y The @a y coordinate of the input value.
+  /// @param z The @a z coordinate of the input value.
+  /// @param seed The random number seed.
+  ///
+  /// @returns The generated simplex-coherent-noise value.
+  ///
+  /// This function performs the same steps as the double-precision version
+  /// with single-precision arithmetic and a single-precision copy of the
+  /// gradient-vector table.  See the single-precision version of
+  /// GradientCoherentNoise3D() for the loss of precision at large
+  /// coordinates.
+  float SimplexCoherentNoise3D (float x, float y, float z, int seed = 0);
+
   /// Generates a value-coherent-noise value from the coordinates of a
   /// three-dimensional input value.
   ///
@@ -177,13 +911,57 @@ namespace noise
   ///
   /// @returns The generated value-coherent-noise value.
   ///
-  /// The return value ranges from -1.0 to +1.0.
+  /// The return value ranges from -1.0 to +3.0, since it interpolates the
+  /// values of ValueNoise3D().
   ///
   /// For an explanation of the difference between <i>gradient</i> noise and
   /// <i>value</i> noise, see the comments for the GradientNoise3D() function.
   double ValueCoherentNoise3D (double x, double y, double z, int seed = 0,
     NoiseQuality noiseQuality = QUALITY_STD);
 
+  /// Generates value-coherent-noise values from the coordinates of an
+  /// array of three-dimensional input values.
+  ///
+  /// @param count The number of input values.
+  /// @param x An array containing the @a x coordinates of the input values.
+  /// @param y An array containing the @a y coordinates of the input values.
+  /// @param z An array containing the @a z coordinates of the input values.
+  /// @param values An array that receives the generated
+  /// value-coherent-noise values.
+  /// @param seed The random number seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// The <i>i</i>th element of @a values receives the value that
+  /// ValueCoherentNoise3D() returns for the <i>i</i>th input value.
+  ///
+  /// Like GradientCoherentNoise3DArray(), this function evaluates several
+  /// input values at once with the instruction set returned by
+  /// GetSimdLevel(), and the results are bit-identical to the scalar
+  /// function unless the compiler contracts operations into fused
+  /// multiply-add instructions.
+  void ValueCoherentNoise3DArray (int count, const double* x,
+    const double* y, const double* z, double* values, int seed = 0,
+    NoiseQuality noiseQuality = QUALITY_STD);
+
+  /// Generates a value-coherent-noise value from the coordinates of a
+  /// four-dimensional input value.
+  ///
+  /// @param x The @a x coordinate of the input value.
+  /// @param y The @a y coordinate of the input value.
+  /// @param z The @a z coordinate of the input value.
+  /// @param w The @a w coordinate of the input value.
+  /// @param seed The random number seed.
+  /// @param noiseQuality The quality of the coherent-noise.
+  ///
+  /// @returns The generated value-coherent-noise value.
+  ///
+  /// The return value ranges from -1.0 to +1.0.
+  ///
+  /// This function interpolates the value-noise values at the sixteen
+  /// vertices of the surrounding hypercube (see ValueNoise4D().)
+  double ValueCoherentNoise4D (double x, double y, double z, double w,
+    int seed = 0, NoiseQuality noiseQuality = QUALITY_STD);
+
   /// Generates a value-noise value from the coordinates of a
   /// three-dimensional input value.
   ///
@@ -194,13 +972,47 @@ namespace noise
   ///
   /// @returns The generated value-noise value.
   ///
-  /// The return value ranges from -1.0 to +1.0.
+  /// The return value ranges from -1.0 to +3.0: it is 1.0 minus the value
+  /// of IntValueNoise3D() divided by 2^30.  Only the values of
+  /// IntValueNoise3D() from 0 to 2147483647 map onto the range of -1.0 to
+  /// +1.0 that earlier versions of libnoise documented.
   ///
   /// A noise function differs from a random-number generator because it
   /// always returns the same output value if the same input value is passed
   /// to it.
   double ValueNoise3D (int x, int y, int z, int seed = 0);
 
+  /// Generates value-noise values from the coordinates of an array of
+  /// three-dimensional input values.
+  ///
+  /// @param count The number of input values.
+  /// @param x An array containing the @a x coordinates of the input values.
+  /// @param y An array containing the @a y coordinates of the input values.
+  /// @param z An array containing the @a z coordinates of the input values.
+  /// @param values An array that receives the generated value-noise values.
+  /// @param seed A random number seed.
+  ///
+  /// The <i>i</i>th element of @a values receives the value that
+  /// ValueNoise3D() returns for the <i>i</i>th input value.  The hashes are
+  /// vectorized as in IntValueNoise3DArray(), but only as many at once as
+  /// a vector register holds doubles.
+  void ValueNoise3DArray (int count, const int* x, const int* y,
+    const int* z, double* values, int seed = 0);
+
+  /// Generates a value-noise value from the coordinates of a
+  /// four-dimensional input value.
+  ///
+  /// @param x The @a x coordinate of the input value.
+  /// @param y The @a y coordinate of the input value.
+  /// @param z The @a z coordinate of the input value.
+  /// @param w The @a w coordinate of the input value.
+  /// @param seed A random number seed.
+  ///
+  /// @returns The generated value-noise value.
+  ///
+  /// The return value ranges from -1.0 to +1.0.
+  double ValueNoise4D (int x, int y, int z, int w, int seed = 0);
+
   /// @}
 
 }
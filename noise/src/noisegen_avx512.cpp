@@ -0,0 +1,51 @@
+// noisegen_avx512.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+// This file provides the AVX-512 versions of the vectorized coherent-noise
+// functions.  Compile it with AVX-512F code generation enabled (-mavx512f);
+// otherwise, it provides no vectorized code.  AVX-512F implies FMA, so also
+// disable floating-point contraction (-ffp-contract=off) to keep the
+// results identical to the scalar code.
+
+#include "noisegenimpl.h"
+
+using namespace noise;
+
+const SimdKernels* noise::GetSimdKernelsAvx512 ()
+{
+#if defined(NOISE_SIMD_AVX512)
+  static const SimdKernels kernels = {
+    GradientCoherentNoise3DArraySimd<SimdAvx512>,
+    GradientCoherentNoise3DArraySimd<SimdAvx512Float>,
+    GradientCoherentNoise2DArraySimd<SimdAvx512>,
+    GradientCoherentNoise2DArraySimd<SimdAvx512Float>,
+    IntValueNoise3DArraySimd<SimdAvx512Float>,
+    ValueNoise3DArraySimd<SimdAvx512>,
+    ValueCoherentNoise3DArraySimd<SimdAvx512>,
+    GradientCoherentNoise3DTableArraySimd<SimdAvx512>,
+    GradientCoherentNoise3DTableArraySimd<SimdAvx512Float>
+  };
+  return &kernels;
+#else
+  return NULL;
+#endif
+}
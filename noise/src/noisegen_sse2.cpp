@@ -0,0 +1,50 @@
+// noisegen_sse2.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+// This file provides the SSE2 versions of the vectorized coherent-noise
+// functions.  Compile it with SSE2 code generation enabled (this is the
+// default on x86-64; use -msse2 on 32-bit x86); otherwise, it provides no
+// vectorized code.
+
+#include "noisegenimpl.h"
+
+using namespace noise;
+
+const SimdKernels* noise::GetSimdKernelsSse2 ()
+{
+#if defined(NOISE_SIMD_SSE2)
+  static const SimdKernels kernels = {
+    GradientCoherentNoise3DArraySimd<SimdSse2>,
+    GradientCoherentNoise3DArraySimd<SimdSse2Float>,
+    GradientCoherentNoise2DArraySimd<SimdSse2>,
+    GradientCoherentNoise2DArraySimd<SimdSse2Float>,
+    IntValueNoise3DArraySimd<SimdSse2Float>,
+    ValueNoise3DArraySimd<SimdSse2>,
+    ValueCoherentNoise3DArraySimd<SimdSse2>,
+    GradientCoherentNoise3DTableArraySimd<SimdSse2>,
+    GradientCoherentNoise3DTableArraySimd<SimdSse2Float>
+  };
+  return &kernels;
+#else
+  return NULL;
+#endif
+}
@@ -0,0 +1,1367 @@
+// noisegenimpl.h
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+#ifndef NOISE_NOISEGENIMPL_H
+#define NOISE_NOISEGENIMPL_H
+
+#include <stddef.h>
+#include "noisegen.h"
+
+// This header is shared by the source files that implement the
+// coherent-noise functions.  It is not part of the libnoise interface.
+//
+// The vectorized coherent-noise code is compiled once per instruction set:
+// each noisegen_<isa>.cpp file includes this header and is compiled with
+// the code-generation flags for its instruction set.  The traits classes
+// below are only defined if the compiler targets their instruction set, so
+// a file that is compiled without those flags provides no vectorized code.
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+// Specifies the version of the coherent-noise functions to use.
+// - Set to 2 to use the current version.
+// - Set to 1 to use the flawed version from the original version of libnoise.
+// If your application requires coherent-noise values that were generated by
+// an earlier version of libnoise, change this constant to the appropriate
+// value and recompile libnoise.
+#define NOISE_VERSION 2
+
+namespace noise
+{
+
+  // These constants control certain parameters that all coherent-noise
+  // functions require.
+#if (NOISE_VERSION == 1)
+  // Constants used by the original version of libnoise.
+  // Because X_NOISE_GEN is not relatively prime to the other values, and
+  // Z_NOISE_GEN is close to 256 (the number of random gradient vectors),
+  // patterns show up in high-frequency coherent noise.
+  const int X_NOISE_GEN = 1;
+  const int Y_NOISE_GEN = 31337;
+  const int Z_NOISE_GEN = 263;
+  const int SEED_NOISE_GEN = 1013;
+  const int SHIFT_NOISE_GEN = 13;
+#else
+  // Constants used by the current version of libnoise.
+  const int X_NOISE_GEN = 1619;
+  const int Y_NOISE_GEN = 31337;
+  const int Z_NOISE_GEN = 6971;
+  const int SEED_NOISE_GEN = 1013;
+  const int SHIFT_NOISE_GEN = 8;
+#endif
+
+  // Constant for the w coordinate of the four-dimensional coherent-noise
+  // functions.  The original version of libnoise has no four-dimensional
+  // functions, so it does not depend on the version.
+  const int W_NOISE_GEN = 4201;
+
+  // The tables of random normalized vectors, defined in vectortable.h.
+  extern double g_randomVectors[256 * 4];
+  extern float g_randomVectorsFloat[256 * 4];
+
+  // The vectorized coherent-noise functions compiled for one instruction
+  // set.
+  struct SimdKernels
+  {
+    void (*gradientCoherentNoise3DArray) (int count, const double* x,
+      const double* y, const double* z, double* values, int seed,
+      NoiseQuality noiseQuality);
+    void (*gradientCoherentNoise3DArrayFloat) (int count, const float* x,
+      const float* y, const float* z, float* values, int seed,
+      NoiseQuality noiseQuality);
+    void (*gradientCoherentNoise2DArray) (int count, const double* x,
+      const double* z, double* values, int seed, NoiseQuality noiseQuality);
+    void (*gradientCoherentNoise2DArrayFloat) (int count, const float* x,
+      const float* z, float* values, int seed, NoiseQuality noiseQuality);
+    void (*intValueNoise3DArray) (int count, const int* x, const int* y,
+      const int* z, int* values, int seed);
+    void (*valueNoise3DArray) (int count, const int* x, const int* y,
+      const int* z, double* values, int seed);
+    void (*valueCoherentNoise3DArray) (int count, const double* x,
+      const double* y, const double* z, double* values, int seed,
+      NoiseQuality noiseQuality);
+    void (*gradientCoherentNoise3DTableArray) (int count, const double* x,
+      const double* y, const double* z, double* values,
+      const PermutationTable& table, int seed, NoiseQuality noiseQuality);
+    void (*gradientCoherentNoise3DTableArrayFloat) (int count,
+      const float* x, const float* y, const float* z, float* values,
+      const PermutationTable& table, int seed, NoiseQuality noiseQuality);
+  };
+
+  // Each of these functions returns the vectorized coherent-noise functions
+  // for one instruction set, or NULL if its source file was compiled
+  // without support for that instruction set.
+  const SimdKernels* GetSimdKernelsSse2 ();
+  const SimdKernels* GetSimdKernelsSse41 ();
+  const SimdKernels* GetSimdKernelsAvx2 ();
+  const SimdKernels* GetSimdKernelsAvx512 ();
+
+}
+
+// The vectorized lattice hash only computes the low 16 bits of the hash on
+// SSE2, which is enough when the shift plus the eight index bits fit in 16
+// bits.  The original version of the coherent-noise functions uses the
+// scalar code.
+#if (NOISE_VERSION != 1)
+#if defined(__AVX512F__)
+#define NOISE_SIMD_AVX512
+#endif
+#if defined(__AVX2__)
+#define NOISE_SIMD_AVX2
+#endif
+#if defined(__SSE4_1__)
+#define NOISE_SIMD_SSE41
+#endif
+#if defined(__SSE2__) || defined(_M_X64) \
+  || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NOISE_SIMD_SSE2
+#endif
+#endif
+
+#if defined(NOISE_SIMD_AVX2) || defined(NOISE_SIMD_AVX512)
+#include <immintrin.h>
+#elif defined(NOISE_SIMD_SSE41)
+#include <smmintrin.h>
+#elif defined(NOISE_SIMD_SSE2)
+#include <emmintrin.h>
+#endif
+
+// The vectorized coherent-noise code below is written once, in terms of the
+// small set of operations provided by a traits class.  Each traits class
+// wraps the intrinsics of one instruction set for one floating-point type
+// (Scalar); WIDTH is the number of input values that the instruction set
+// processes at once.  The integer operations wrap around like unsigned
+// arithmetic, as the lattice hashes require.  Every operation maps
+// to the same IEEE operation as the scalar code, in the same order, so the
+// vectorized results are identical to the scalar results.
+//
+// Everything is declared in an anonymous namespace because every
+// noisegen_<isa>.cpp file compiles its own copy with different
+// code-generation flags.
+
+namespace noise
+{
+
+  namespace
+  {
+
+#if defined(NOISE_SIMD_SSE2)
+
+    // SSE2 traits: two input values per vector.  The integer lattice
+    // coordinates occupy the two low 32-bit lanes of an __m128i.  If SSE4.1
+    // is available, the lattice hashes use 32-bit multiplies and the
+    // gradient indices are extracted directly.
+    struct SimdSse2
+    {
+      static const int WIDTH = 2;
+      typedef double Scalar;
+      typedef __m128d Real;
+      typedef __m128i Int;
+
+      static inline Real Load (const double* p) { return _mm_loadu_pd (p); }
+      static inline void Store (double* p, Real a) { _mm_storeu_pd (p, a); }
+      static inline Real Set (double a) { return _mm_set1_pd (a); }
+      static inline Real Add (Real a, Real b) { return _mm_add_pd (a, b); }
+      static inline Real Sub (Real a, Real b) { return _mm_sub_pd (a, b); }
+      static inline Real Mul (Real a, Real b) { return _mm_mul_pd (a, b); }
+
+      static inline Int LoadInt (const int* p)
+      {
+        return _mm_loadl_epi64 ((const __m128i*)p);
+      }
+      static inline void StoreInt (int* p, Int a)
+      {
+        _mm_storel_epi64 ((__m128i*)p, a);
+      }
+      static inline Int SetInt (int a) { return _mm_set1_epi32 (a); }
+      static inline Int AddInt (Int a, Int b) { return _mm_add_epi32 (a, b); }
+      static inline Int AndInt (Int a, int b)
+      {
+        return _mm_and_si128 (a, _mm_set1_epi32 (b));
+      }
+      static inline Int XorInt (Int a, Int b) { return _mm_xor_si128 (a, b); }
+      static inline Int ShiftRightInt (Int a, int count)
+      {
+        return _mm_srli_epi32 (a, count);
+      }
+      static inline Real ToReal (Int a) { return _mm_cvtepi32_pd (a); }
+
+      // Same as (x > 0.0? (int)x: (int)x - 1).
+      static inline Int Floor (Real x)
+      {
+        Int n = _mm_cvttpd_epi32 (x);
+        Int notPositive = _mm_castpd_si128 (
+          _mm_cmpngt_pd (x, _mm_setzero_pd ()));
+        notPositive = _mm_shuffle_epi32 (notPositive,
+          _MM_SHUFFLE (3, 3, 2, 0));
+        return _mm_add_epi32 (n, notPositive);
+      }
+
+#if defined(NOISE_SIMD_SSE41)
+      static inline Int MulInt (Int a, int b)
+      {
+        return _mm_mullo_epi32 (a, _mm_set1_epi32 (b));
+      }
+
+      static inline Int MulLoInt (Int a, Int b)
+      {
+        return _mm_mullo_epi32 (a, b);
+      }
+#else
+      // SSE2 has no 32-bit multiply, but the gradient index only depends on
+      // the low 16 bits of the hash, so 16-bit multiplies are sufficient.
+      static inline Int MulInt (Int a, int b)
+      {
+        return _mm_mullo_epi16 (a, _mm_set1_epi32 (b & 0xffff));
+      }
+
+      // The value-noise hash needs all 32 bits of each product, so the even
+      // and odd lanes are multiplied separately into 64-bit products and
+      // the low halves are interleaved again.
+      static inline Int MulLoInt (Int a, Int b)
+      {
+        Int even = _mm_mul_epu32 (a, b);
+        Int odd = _mm_mul_epu32 (_mm_srli_epi64 (a, 32),
+          _mm_srli_epi64 (b, 32));
+        return _mm_unpacklo_epi32 (
+          _mm_shuffle_epi32 (even, _MM_SHUFFLE (0, 0, 2, 0)),
+          _mm_shuffle_epi32 (odd, _MM_SHUFFLE (0, 0, 2, 0)));
+      }
+#endif
+
+      static inline Int IndexMask (Int n)
+      {
+        n = _mm_xor_si128 (n, _mm_srli_epi32 (n, SHIFT_NOISE_GEN));
+        return _mm_and_si128 (n, _mm_set1_epi32 (0xff));
+      }
+
+      // Looks up the elements of a table of integers at the specified
+      // indices.
+      static inline Int GatherInt (const int* p, Int index)
+      {
+        int i[4];
+        _mm_storeu_si128 ((__m128i*)i, index);
+        return _mm_setr_epi32 (p[i[0]], p[i[1]], 0, 0);
+      }
+
+      // Retrieves the gradient vectors at the specified indices of a table
+      // of four elements per vector.
+      static inline void GatherGradient (const Scalar* pVectors, Int index,
+        Real& xg, Real& yg, Real& zg)
+      {
+        int i0 = _mm_cvtsi128_si32 (index) << 2;
+#if defined(NOISE_SIMD_SSE41)
+        int i1 = _mm_extract_epi32 (index, 1) << 2;
+#else
+        int i1 = _mm_cvtsi128_si32 (_mm_shuffle_epi32 (index, 1)) << 2;
+#endif
+        Real a0 = _mm_loadu_pd (pVectors + i0    );
+        Real a1 = _mm_loadu_pd (pVectors + i1    );
+        Real b0 = _mm_loadu_pd (pVectors + i0 + 2);
+        Real b1 = _mm_loadu_pd (pVectors + i1 + 2);
+        xg = _mm_unpacklo_pd (a0, a1);
+        yg = _mm_unpackhi_pd (a0, a1);
+        zg = _mm_unpacklo_pd (b0, b1);
+      }
+
+      // Retrieves the gradient vectors at the specified indices of the
+      // normalized-vector lookup table.
+      static inline void Gradient (Int index, Real& xg, Real& yg, Real& zg)
+      {
+        GatherGradient (g_randomVectors, index, xg, yg, zg);
+      }
+
+      // Returns the gradient vectors of a permutation table.
+      static inline const Scalar* TableVectors (const PermutationTable& table)
+      {
+        return table.GetVectors ();
+      }
+    };
+
+    // Single-precision SSE2 traits: four input values per vector.  The
+    // gradient vectors are loaded one row at a time and transposed.
+    struct SimdSse2Float
+    {
+      static const int WIDTH = 4;
+      typedef float Scalar;
+      typedef __m128 Real;
+      typedef __m128i Int;
+
+      static inline Real Load (const float* p) { return _mm_loadu_ps (p); }
+      static inline void Store (float* p, Real a) { _mm_storeu_ps (p, a); }
+      static inline Real Set (double a) { return _mm_set1_ps ((float)a); }
+      static inline Real Add (Real a, Real b) { return _mm_add_ps (a, b); }
+      static inline Real Sub (Real a, Real b) { return _mm_sub_ps (a, b); }
+      static inline Real Mul (Real a, Real b) { return _mm_mul_ps (a, b); }
+
+      static inline Int LoadInt (const int* p)
+      {
+        return _mm_loadu_si128 ((const __m128i*)p);
+      }
+      static inline void StoreInt (int* p, Int a)
+      {
+        _mm_storeu_si128 ((__m128i*)p, a);
+      }
+      static inline Int SetInt (int a) { return _mm_set1_epi32 (a); }
+      static inline Int AddInt (Int a, Int b) { return _mm_add_epi32 (a, b); }
+      static inline Int AndInt (Int a, int b)
+      {
+        return SimdSse2::AndInt (a, b);
+      }
+      static inline Int XorInt (Int a, Int b) { return _mm_xor_si128 (a, b); }
+      static inline Int ShiftRightInt (Int a, int count)
+      {
+        return _mm_srli_epi32 (a, count);
+      }
+      static inline Real ToReal (Int a) { return _mm_cvtepi32_ps (a); }
+
+      // Same as (x > 0.0f? (int)x: (int)x - 1).
+      static inline Int Floor (Real x)
+      {
+        Int n = _mm_cvttps_epi32 (x);
+        Int notPositive = _mm_castps_si128 (
+          _mm_cmpngt_ps (x, _mm_setzero_ps ()));
+        return _mm_add_epi32 (n, notPositive);
+      }
+
+      static inline Int MulInt (Int a, int b)
+      {
+        return SimdSse2::MulInt (a, b);
+      }
+
+      static inline Int MulLoInt (Int a, Int b)
+      {
+        return SimdSse2::MulLoInt (a, b);
+      }
+
+      static inline Int IndexMask (Int n)
+      {
+        return SimdSse2::IndexMask (n);
+      }
+
+      static inline Int GatherInt (const int* p, Int index)
+      {
+        int i[4];
+        _mm_storeu_si128 ((__m128i*)i, index);
+        return _mm_setr_epi32 (p[i[0]], p[i[1]], p[i[2]], p[i[3]]);
+      }
+
+      // Retrieves the gradient vectors at the specified indices of a table
+      // of four elements per vector.
+      static inline void GatherGradient (const Scalar* pVectors, Int index,
+        Real& xg, Real& yg, Real& zg)
+      {
+        Int offset = _mm_slli_epi32 (index, 2);
+        Real r0 = _mm_loadu_ps (pVectors
+          + _mm_cvtsi128_si32 (offset));
+        Real r1 = _mm_loadu_ps (pVectors
+          + _mm_cvtsi128_si32 (_mm_shuffle_epi32 (offset, 1)));
+        Real r2 = _mm_loadu_ps (pVectors
+          + _mm_cvtsi128_si32 (_mm_shuffle_epi32 (offset, 2)));
+        Real r3 = _mm_loadu_ps (pVectors
+          + _mm_cvtsi128_si32 (_mm_shuffle_epi32 (offset, 3)));
+        _MM_TRANSPOSE4_PS (r0, r1, r2, r3);
+        xg = r0;
+        yg = r1;
+        zg = r2;
+      }
+
+      // Retrieves the gradient vectors at the specified indices of the
+      // single-precision normalized-vector lookup table.
+      static inline void Gradient (Int index, Real& xg, Real& yg, Real& zg)
+      {
+        GatherGradient (g_randomVectorsFloat, index, xg, yg, zg);
+      }
+
+      static inline const Scalar* TableVectors (const PermutationTable& table)
+      {
+        return table.GetVectorsFloat ();
+      }
+    };
+
+#endif
+
+#if defined(NOISE_SIMD_AVX2)
+
+    // AVX2 traits: four input values per vector.  The integer lattice
+    // coordinates occupy an __m128i; the gradient vectors are gathered.
+    struct SimdAvx2
+    {
+      static const int WIDTH = 4;
+      typedef double Scalar;
+      typedef __m256d Real;
+      typedef __m128i Int;
+
+      static inline Real Load (const double* p) { return _mm256_loadu_pd (p); }
+      static inline void Store (double* p, Real a) { _mm256_storeu_pd (p, a); }
+      static inline Real Set (double a) { return _mm256_set1_pd (a); }
+      static inline Real Add (Real a, Real b) { return _mm256_add_pd (a, b); }
+      static inline Real Sub (Real a, Real b) { return _mm256_sub_pd (a, b); }
+      static inline Real Mul (Real a, Real b) { return _mm256_mul_pd (a, b); }
+
+      static inline Int LoadInt (const int* p)
+      {
+        return _mm_loadu_si128 ((const __m128i*)p);
+      }
+      static inline void StoreInt (int* p, Int a)
+      {
+        _mm_storeu_si128 ((__m128i*)p, a);
+      }
+      static inline Int SetInt (int a) { return _mm_set1_epi32 (a); }
+      static inline Int AddInt (Int a, Int b) { return _mm_add_epi32 (a, b); }
+      static inline Int AndInt (Int a, int b)
+      {
+        return _mm_and_si128 (a, _mm_set1_epi32 (b));
+      }
+      static inline Int XorInt (Int a, Int b) { return _mm_xor_si128 (a, b); }
+      static inline Int ShiftRightInt (Int a, int count)
+      {
+        return _mm_srli_epi32 (a, count);
+      }
+      static inline Real ToReal (Int a) { return _mm256_cvtepi32_pd (a); }
+
+      // Same as (x > 0.0? (int)x: (int)x - 1).
+      static inline Int Floor (Real x)
+      {
+        Int n = _mm256_cvttpd_epi32 (x);
+        __m256 notPositive = _mm256_castpd_ps (
+          _mm256_cmp_pd (x, _mm256_setzero_pd (), _CMP_NGT_UQ));
+        __m128 mask = _mm_shuffle_ps (_mm256_castps256_ps128 (notPositive),
+          _mm256_extractf128_ps (notPositive, 1), _MM_SHUFFLE (2, 0, 2, 0));
+        return _mm_add_epi32 (n, _mm_castps_si128 (mask));
+      }
+
+      static inline Int MulInt (Int a, int b)
+      {
+        return _mm_mullo_epi32 (a, _mm_set1_epi32 (b));
+      }
+
+      static inline Int MulLoInt (Int a, Int b)
+      {
+        return _mm_mullo_epi32 (a, b);
+      }
+
+      static inline Int IndexMask (Int n)
+      {
+        n = _mm_xor_si128 (n, _mm_srai_epi32 (n, SHIFT_NOISE_GEN));
+        return _mm_and_si128 (n, _mm_set1_epi32 (0xff));
+      }
+
+      // Gathers the elements of a table of integers at the specified
+      // indices.
+      static inline Int GatherInt (const int* p, Int index)
+      {
+        return _mm_i32gather_epi32 (p, index, 4);
+      }
+
+      // Gathers the gradient vectors at the specified indices of a table
+      // of four elements per vector.
+      static inline void GatherGradient (const Scalar* pVectors, Int index,
+        Real& xg, Real& yg, Real& zg)
+      {
+        Int offset = _mm_slli_epi32 (index, 2);
+        Real zero = _mm256_setzero_pd ();
+        Real mask = _mm256_castsi256_pd (_mm256_set1_epi64x (-1));
+        xg = _mm256_mask_i32gather_pd (zero, pVectors    , offset, mask, 8);
+        yg = _mm256_mask_i32gather_pd (zero, pVectors + 1, offset, mask, 8);
+        zg = _mm256_mask_i32gather_pd (zero, pVectors + 2, offset, mask, 8);
+      }
+
+      // Gathers the gradient vectors at the specified indices of the
+      // normalized-vector lookup table.
+      static inline void Gradient (Int index, Real& xg, Real& yg, Real& zg)
+      {
+        GatherGradient (g_randomVectors, index, xg, yg, zg);
+      }
+
+      // Returns the gradient vectors of a permutation table.
+      static inline const Scalar* TableVectors (const PermutationTable& table)
+      {
+        return table.GetVectors ();
+      }
+    };
+
+    // Single-precision AVX2 traits: eight input values per vector.  The
+    // gradient vectors are gathered.
+    struct SimdAvx2Float
+    {
+      static const int WIDTH = 8;
+      typedef float Scalar;
+      typedef __m256 Real;
+      typedef __m256i Int;
+
+      static inline Real Load (const float* p) { return _mm256_loadu_ps (p); }
+      static inline void Store (float* p, Real a) { _mm256_storeu_ps (p, a); }
+      static inline Real Set (double a) { return _mm256_set1_ps ((float)a); }
+      static inline Real Add (Real a, Real b) { return _mm256_add_ps (a, b); }
+      static inline Real Sub (Real a, Real b) { return _mm256_sub_ps (a, b); }
+      static inline Real Mul (Real a, Real b) { return _mm256_mul_ps (a, b); }
+
+      static inline Int LoadInt (const int* p)
+      {
+        return _mm256_loadu_si256 ((const __m256i*)p);
+      }
+      static inline void StoreInt (int* p, Int a)
+      {
+        _mm256_storeu_si256 ((__m256i*)p, a);
+      }
+      static inline Int SetInt (int a) { return _mm256_set1_epi32 (a); }
+      static inline Int AddInt (Int a, Int b)
+      {
+        return _mm256_add_epi32 (a, b);
+      }
+      static inline Int AndInt (Int a, int b)
+      {
+        return _mm256_and_si256 (a, _mm256_set1_epi32 (b));
+      }
+      static inline Int XorInt (Int a, Int b)
+      {
+        return _mm256_xor_si256 (a, b);
+      }
+      static inline Int ShiftRightInt (Int a, int count)
+      {
+        return _mm256_srli_epi32 (a, count);
+      }
+      static inline Real ToReal (Int a) { return _mm256_cvtepi32_ps (a); }
+
+      // Same as (x > 0.0f? (int)x: (int)x - 1).
+      static inline Int Floor (Real x)
+      {
+        Int n = _mm256_cvttps_epi32 (x);
+        Int notPositive = _mm256_castps_si256 (
+          _mm256_cmp_ps (x, _mm256_setzero_ps (), _CMP_NGT_UQ));
+        return _mm256_add_epi32 (n, notPositive);
+      }
+
+      static inline Int MulInt (Int a, int b)
+      {
+        return _mm256_mullo_epi32 (a, _mm256_set1_epi32 (b));
+      }
+
+      static inline Int MulLoInt (Int a, Int b)
+      {
+        return _mm256_mullo_epi32 (a, b);
+      }
+
+      static inline Int IndexMask (Int n)
+      {
+        n = _mm256_xor_si256 (n, _mm256_srai_epi32 (n, SHIFT_NOISE_GEN));
+        return _mm256_and_si256 (n, _mm256_set1_epi32 (0xff));
+      }
+
+      static inline Int GatherInt (const int* p, Int index)
+      {
+        return _mm256_i32gather_epi32 (p, index, 4);
+      }
+
+      // Gathers the gradient vectors at the specified indices of a table
+      // of four elements per vector.
+      static inline void GatherGradient (const Scalar* pVectors, Int index,
+        Real& xg, Real& yg, Real& zg)
+      {
+        Int offset = _mm256_slli_epi32 (index, 2);
+        Real zero = _mm256_setzero_ps ();
+        Real mask = _mm256_castsi256_ps (_mm256_set1_epi32 (-1));
+        xg = _mm256_mask_i32gather_ps (zero, pVectors    , offset, mask, 4);
+        yg = _mm256_mask_i32gather_ps (zero, pVectors + 1, offset, mask, 4);
+        zg = _mm256_mask_i32gather_ps (zero, pVectors + 2, offset, mask, 4);
+      }
+
+      // Gathers the gradient vectors at the specified indices of the
+      // single-precision normalized-vector lookup table.
+      static inline void Gradient (Int index, Real& xg, Real& yg, Real& zg)
+      {
+        GatherGradient (g_randomVectorsFloat, index, xg, yg, zg);
+      }
+
+      static inline const Scalar* TableVectors (const PermutationTable& table)
+      {
+        return table.GetVectorsFloat ();
+      }
+    };
+
+#endif
+
+#if defined(NOISE_SIMD_AVX512)
+
+    // AVX-512 traits: eight input values per vector.  The integer lattice
+    // coordinates occupy an __m256i; the gradient vectors are gathered.
+    // The conversions use the zero-masked intrinsics with a full mask,
+    // which are equivalent to the unmasked ones, because some compilers
+    // warn that the unmasked ones read an undefined register.
+    struct SimdAvx512
+    {
+      static const int WIDTH = 8;
+      typedef double Scalar;
+      typedef __m512d Real;
+      typedef __m256i Int;
+
+      static inline Real Load (const double* p) { return _mm512_loadu_pd (p); }
+      static inline void Store (double* p, Real a) { _mm512_storeu_pd (p, a); }
+      static inline Real Set (double a) { return _mm512_set1_pd (a); }
+      static inline Real Add (Real a, Real b) { return _mm512_add_pd (a, b); }
+      static inline Real Sub (Real a, Real b) { return _mm512_sub_pd (a, b); }
+      static inline Real Mul (Real a, Real b) { return _mm512_mul_pd (a, b); }
+
+      static inline Int LoadInt (const int* p)
+      {
+        return _mm256_loadu_si256 ((const __m256i*)p);
+      }
+      static inline void StoreInt (int* p, Int a)
+      {
+        _mm256_storeu_si256 ((__m256i*)p, a);
+      }
+      static inline Int SetInt (int a) { return _mm256_set1_epi32 (a); }
+      static inline Int AddInt (Int a, Int b)
+      {
+        return _mm256_add_epi32 (a, b);
+      }
+      static inline Int AndInt (Int a, int b)
+      {
+        return _mm256_and_si256 (a, _mm256_set1_epi32 (b));
+      }
+      static inline Int XorInt (Int a, Int b)
+      {
+        return _mm256_xor_si256 (a, b);
+      }
+      static inline Int ShiftRightInt (Int a, int count)
+      {
+        return _mm256_srli_epi32 (a, count);
+      }
+      static inline Real ToReal (Int a)
+      {
+        return _mm512_maskz_cvtepi32_pd (0xff, a);
+      }
+
+      // Same as (x > 0.0? (int)x: (int)x - 1).
+      static inline Int Floor (Real x)
+      {
+        Int n = _mm512_maskz_cvttpd_epi32 (0xff, x);
+        __mmask8 notPositive = _mm512_cmp_pd_mask (x, _mm512_setzero_pd (),
+          _CMP_NGT_UQ);
+        Int minusOne = _mm512_maskz_cvtepi64_epi32 (0xff,
+          _mm512_maskz_set1_epi64 (notPositive, -1));
+        return _mm256_add_epi32 (n, minusOne);
+      }
+
+      static inline Int MulInt (Int a, int b)
+      {
+        return _mm256_mullo_epi32 (a, _mm256_set1_epi32 (b));
+      }
+
+      static inline Int MulLoInt (Int a, Int b)
+      {
+        return _mm256_mullo_epi32 (a, b);
+      }
+
+      static inline Int IndexMask (Int n)
+      {
+        n = _mm256_xor_si256 (n, _mm256_srai_epi32 (n, SHIFT_NOISE_GEN));
+        return _mm256_and_si256 (n, _mm256_set1_epi32 (0xff));
+      }
+
+      // Gathers the elements of a table of integers at the specified
+      // indices.
+      static inline Int GatherInt (const int* p, Int index)
+      {
+        return _mm256_i32gather_epi32 (p, index, 4);
+      }
+
+      // Gathers the gradient vectors at the specified indices of a table
+      // of four elements per vector.
+      static inline void GatherGradient (const Scalar* pVectors, Int index,
+        Real& xg, Real& yg, Real& zg)
+      {
+        Int offset = _mm256_slli_epi32 (index, 2);
+        Real zero = _mm512_setzero_pd ();
+        xg = _mm512_mask_i32gather_pd (zero, 0xff, offset, pVectors    , 8);
+        yg = _mm512_mask_i32gather_pd (zero, 0xff, offset, pVectors + 1, 8);
+        zg = _mm512_mask_i32gather_pd (zero, 0xff, offset, pVectors + 2, 8);
+      }
+
+      // Gathers the gradient vectors at the specified indices of the
+      // normalized-vector lookup table.
+      static inline void Gradient (Int index, Real& xg, Real& yg, Real& zg)
+      {
+        GatherGradient (g_randomVectors, index, xg, yg, zg);
+      }
+
+      // Returns the gradient vectors of a permutation table.
+      static inline const Scalar* TableVectors (const PermutationTable& table)
+      {
+        return table.GetVectors ();
+      }
+    };
+
+    // Single-precision AVX-512 traits: sixteen input values per vector.  The
+    // gradient vectors are gathered.  As in SimdAvx512, the conversions and
+    // shifts use the zero-masked intrinsics with a full mask.
+    struct SimdAvx512Float
+    {
+      static const int WIDTH = 16;
+      typedef float Scalar;
+      typedef __m512 Real;
+      typedef __m512i Int;
+
+      static inline Real Load (const float* p) { return _mm512_loadu_ps (p); }
+      static inline void Store (float* p, Real a) { _mm512_storeu_ps (p, a); }
+      static inline Real Set (double a) { return _mm512_set1_ps ((float)a); }
+      static inline Real Add (Real a, Real b) { return _mm512_add_ps (a, b); }
+      static inline Real Sub (Real a, Real b) { return _mm512_sub_ps (a, b); }
+      static inline Real Mul (Real a, Real b) { return _mm512_mul_ps (a, b); }
+
+      static inline Int LoadInt (const int* p)
+      {
+        return _mm512_loadu_si512 (p);
+      }
+      static inline void StoreInt (int* p, Int a)
+      {
+        _mm512_storeu_si512 (p, a);
+      }
+      static inline Int SetInt (int a) { return _mm512_set1_epi32 (a); }
+      static inline Int AddInt (Int a, Int b)
+      {
+        return _mm512_add_epi32 (a, b);
+      }
+      static inline Int AndInt (Int a, int b)
+      {
+        return _mm512_and_si512 (a, _mm512_set1_epi32 (b));
+      }
+      static inline Int XorInt (Int a, Int b)
+      {
+        return _mm512_xor_si512 (a, b);
+      }
+      static inline Int ShiftRightInt (Int a, int count)
+      {
+        return _mm512_maskz_srli_epi32 (0xffff, a, count);
+      }
+      static inline Real ToReal (Int a)
+      {
+        return _mm512_maskz_cvtepi32_ps (0xffff, a);
+      }
+
+      // Same as (x > 0.0f? (int)x: (int)x - 1).
+      static inline Int Floor (Real x)
+      {
+        Int n = _mm512_maskz_cvttps_epi32 (0xffff, x);
+        __mmask16 notPositive = _mm512_cmp_ps_mask (x, _mm512_setzero_ps (),
+          _CMP_NGT_UQ);
+        return _mm512_mask_sub_epi32 (n, notPositive, n,
+          _mm512_set1_epi32 (1));
+      }
+
+      static inline Int MulInt (Int a, int b)
+      {
+        return _mm512_mullo_epi32 (a, _mm512_set1_epi32 (b));
+      }
+
+      static inline Int MulLoInt (Int a, Int b)
+      {
+        return _mm512_mullo_epi32 (a, b);
+      }
+
+      static inline Int IndexMask (Int n)
+      {
+        n = _mm512_xor_si512 (n, _mm512_maskz_srai_epi32 (0xffff, n,
+          SHIFT_NOISE_GEN));
+        return _mm512_and_si512 (n, _mm512_set1_epi32 (0xff));
+      }
+
+      static inline Int GatherInt (const int* p, Int index)
+      {
+        // The unmasked intrinsic passes an undefined source vector to the
+        // masked form, which GCC reports as uninitialized; all lanes are
+        // gathered, so the zero source is never used.
+        return _mm512_mask_i32gather_epi32 (_mm512_setzero_si512 (), 0xffff,
+          index, p, 4);
+      }
+
+      // Gathers the gradient vectors at the specified indices of a table
+      // of four elements per vector.
+      static inline void GatherGradient (const Scalar* pVectors, Int index,
+        Real& xg, Real& yg, Real& zg)
+      {
+        Int offset = _mm512_maskz_slli_epi32 (0xffff, index, 2);
+        Real zero = _mm512_setzero_ps ();
+        xg = _mm512_mask_i32gather_ps (zero, 0xffff, offset, pVectors    , 4);
+        yg = _mm512_mask_i32gather_ps (zero, 0xffff, offset, pVectors + 1, 4);
+        zg = _mm512_mask_i32gather_ps (zero, 0xffff, offset, pVectors + 2, 4);
+      }
+
+      // Gathers the gradient vectors at the specified indices of the
+      // single-precision normalized-vector lookup table.
+      static inline void Gradient (Int index, Real& xg, Real& yg, Real& zg)
+      {
+        GatherGradient (g_randomVectorsFloat, index, xg, yg, zg);
+      }
+
+      static inline const Scalar* TableVectors (const PermutationTable& table)
+      {
+        return table.GetVectorsFloat ();
+      }
+    };
+
+#endif
+
+    template <class V>
+    inline typename V::Real LinearInterpSimd (typename V::Real n0,
+      typename V::Real n1, typename V::Real a)
+    {
+      // ((1.0 - a) * n0) + (a * n1)
+      return V::Add (V::Mul (V::Sub (V::Set (1.0), a), n0), V::Mul (a, n1));
+    }
+
+    // Q is a template parameter, so the compiler removes the switch.
+    template <class V, NoiseQuality Q>
+    inline typename V::Real SCurveSimd (typename V::Real a)
+    {
+      switch (Q) {
+        case QUALITY_STD:
+          // a * a * (3.0 - 2.0 * a)
+          return V::Mul (V::Mul (a, a),
+            V::Sub (V::Set (3.0), V::Mul (V::Set (2.0), a)));
+        case QUALITY_BEST: {
+          // (6.0 * a5) - (15.0 * a4) + (10.0 * a3)
+          typename V::Real a3 = V::Mul (V::Mul (a, a), a);
+          typename V::Real a4 = V::Mul (a3, a);
+          typename V::Real a5 = V::Mul (a4, a);
+          return V::Add (
+            V::Sub (V::Mul (V::Set (6.0), a5), V::Mul (V::Set (15.0), a4)),
+            V::Mul (V::Set (10.0), a3));
+        }
+        default:
+          return a;
+      }
+    }
+
+    // Vectorized version of GradientNoise3D().  seedTerm contains the seed
+    // multiplied by SEED_NOISE_GEN.
+    template <class V>
+    inline typename V::Real GradientNoise3DSimd (typename V::Real fx,
+      typename V::Real fy, typename V::Real fz, typename V::Int ix,
+      typename V::Int iy, typename V::Int iz, typename V::Int seedTerm)
+    {
+      typename V::Int vectorIndex = V::AddInt (
+        V::AddInt (V::MulInt (ix, X_NOISE_GEN), V::MulInt (iy, Y_NOISE_GEN)),
+        V::AddInt (V::MulInt (iz, Z_NOISE_GEN), seedTerm));
+      vectorIndex = V::IndexMask (vectorIndex);
+
+      typename V::Real xvGradient, yvGradient, zvGradient;
+      V::Gradient (vectorIndex, xvGradient, yvGradient, zvGradient);
+
+      typename V::Real xvPoint = V::Sub (fx, V::ToReal (ix));
+      typename V::Real yvPoint = V::Sub (fy, V::ToReal (iy));
+      typename V::Real zvPoint = V::Sub (fz, V::ToReal (iz));
+
+      return V::Mul (V::Add (V::Add (
+        V::Mul (xvGradient, xvPoint),
+        V::Mul (yvGradient, yvPoint)),
+        V::Mul (zvGradient, zvPoint)), V::Set (2.12));
+    }
+
+    // Vectorized version of GradientCoherentNoise3D().
+    template <class V, NoiseQuality Q>
+    inline typename V::Real GradientCoherentNoise3DSimd (
+      typename V::Real x, typename V::Real y, typename V::Real z,
+      typename V::Int seedTerm)
+    {
+      typename V::Int one = V::SetInt (1);
+      typename V::Int x0 = V::Floor (x);
+      typename V::Int x1 = V::AddInt (x0, one);
+      typename V::Int y0 = V::Floor (y);
+      typename V::Int y1 = V::AddInt (y0, one);
+      typename V::Int z0 = V::Floor (z);
+      typename V::Int z1 = V::AddInt (z0, one);
+
+      typename V::Real xs = SCurveSimd<V, Q> (V::Sub (x, V::ToReal (x0)));
+      typename V::Real ys = SCurveSimd<V, Q> (V::Sub (y, V::ToReal (y0)));
+      typename V::Real zs = SCurveSimd<V, Q> (V::Sub (z, V::ToReal (z0)));
+
+      typename V::Real n0, n1, ix0, ix1, iy0, iy1;
+      n0  = GradientNoise3DSimd<V> (x, y, z, x0, y0, z0, seedTerm);
+      n1  = GradientNoise3DSimd<V> (x, y, z, x1, y0, z0, seedTerm);
+      ix0 = LinearInterpSimd<V> (n0, n1, xs);
+      n0  = GradientNoise3DSimd<V> (x, y, z, x0, y1, z0, seedTerm);
+      n1  = GradientNoise3DSimd<V> (x, y, z, x1, y1, z0, seedTerm);
+      ix1 = LinearInterpSimd<V> (n0, n1, xs);
+      iy0 = LinearInterpSimd<V> (ix0, ix1, ys);
+      n0  = GradientNoise3DSimd<V> (x, y, z, x0, y0, z1, seedTerm);
+      n1  = GradientNoise3DSimd<V> (x, y, z, x1, y0, z1, seedTerm);
+      ix0 = LinearInterpSimd<V> (n0, n1, xs);
+      n0  = GradientNoise3DSimd<V> (x, y, z, x0, y1, z1, seedTerm);
+      n1  = GradientNoise3DSimd<V> (x, y, z, x1, y1, z1, seedTerm);
+      ix1 = LinearInterpSimd<V> (n0, n1, xs);
+      iy1 = LinearInterpSimd<V> (ix0, ix1, ys);
+
+      return LinearInterpSimd<V> (iy0, iy1, zs);
+    }
+
+    // Vectorized version of the GradientNoise3D() function that takes a
+    // permutation table.  index contains the indices of the gradient
+    // vectors that the table selects for the lattice points.
+    template <class V>
+    inline typename V::Real GradientNoise3DTableSimd (typename V::Real fx,
+      typename V::Real fy, typename V::Real fz, typename V::Int ix,
+      typename V::Int iy, typename V::Int iz, typename V::Int index,
+      const typename V::Scalar* pVectors)
+    {
+      typename V::Real xvGradient, yvGradient, zvGradient;
+      V::GatherGradient (pVectors, index, xvGradient, yvGradient, zvGradient);
+
+      typename V::Real xvPoint = V::Sub (fx, V::ToReal (ix));
+      typename V::Real yvPoint = V::Sub (fy, V::ToReal (iy));
+      typename V::Real zvPoint = V::Sub (fz, V::ToReal (iz));
+
+      return V::Mul (V::Add (V::Add (
+        V::Mul (xvGradient, xvPoint),
+        V::Mul (yvGradient, yvPoint)),
+        V::Mul (zvGradient, zvPoint)), V::Set (2.12));
+    }
+
+    // Looks up the permutation at (a + b) & mask for each lane.
+    template <class V>
+    inline typename V::Int PermuteSimd (const int* pPermutations,
+      typename V::Int a, typename V::Int b, int mask)
+    {
+      return V::GatherInt (pPermutations, V::AndInt (V::AddInt (a, b), mask));
+    }
+
+    // Vectorized version of the GradientCoherentNoise3D() function that
+    // takes a permutation table.  seedIndex contains the permutation of the
+    // seed.  The cube's vertices share the permutations of their x and y
+    // coordinates, so the eight hashes need fourteen table lookups instead
+    // of twenty-four.
+    template <class V, NoiseQuality Q>
+    inline typename V::Real GradientCoherentNoise3DTableSimd (
+      typename V::Real x, typename V::Real y, typename V::Real z,
+      typename V::Int seedIndex, const int* pPermutations, int mask,
+      const typename V::Scalar* pVectors)
+    {
+      typename V::Int one = V::SetInt (1);
+      typename V::Int x0 = V::Floor (x);
+      typename V::Int x1 = V::AddInt (x0, one);
+      typename V::Int y0 = V::Floor (y);
+      typename V::Int y1 = V::AddInt (y0, one);
+      typename V::Int z0 = V::Floor (z);
+      typename V::Int z1 = V::AddInt (z0, one);
+
+      typename V::Real xs = SCurveSimd<V, Q> (V::Sub (x, V::ToReal (x0)));
+      typename V::Real ys = SCurveSimd<V, Q> (V::Sub (y, V::ToReal (y0)));
+      typename V::Real zs = SCurveSimd<V, Q> (V::Sub (z, V::ToReal (z0)));
+
+      const int* p = pPermutations;
+      typename V::Int px0 = PermuteSimd<V> (p, seedIndex, x0, mask);
+      typename V::Int px1 = PermuteSimd<V> (p, seedIndex, x1, mask);
+      typename V::Int px0y0 = PermuteSimd<V> (p, px0, y0, mask);
+      typename V::Int px1y0 = PermuteSimd<V> (p, px1, y0, mask);
+      typename V::Int px0y1 = PermuteSimd<V> (p, px0, y1, mask);
+      typename V::Int px1y1 = PermuteSimd<V> (p, px1, y1, mask);
+
+      typename V::Real n0, n1, ix0, ix1, iy0, iy1;
+      n0  = GradientNoise3DTableSimd<V> (x, y, z, x0, y0, z0,
+        PermuteSimd<V> (p, px0y0, z0, mask), pVectors);
+      n1  = GradientNoise3DTableSimd<V> (x, y, z, x1, y0, z0,
+        PermuteSimd<V> (p, px1y0, z0, mask), pVectors);
+      ix0 = LinearInterpSimd<V> (n0, n1, xs);
+      n0  = GradientNoise3DTableSimd<V> (x, y, z, x0, y1, z0,
+        PermuteSimd<V> (p, px0y1, z0, mask), pVectors);
+      n1  = GradientNoise3DTableSimd<V> (x, y, z, x1, y1, z0,
+        PermuteSimd<V> (p, px1y1, z0, mask), pVectors);
+      ix1 = LinearInterpSimd<V> (n0, n1, xs);
+      iy0 = LinearInterpSimd<V> (ix0, ix1, ys);
+      n0  = GradientNoise3DTableSimd<V> (x, y, z, x0, y0, z1,
+        PermuteSimd<V> (p, px0y0, z1, mask), pVectors);
+      n1  = GradientNoise3DTableSimd<V> (x, y, z, x1, y0, z1,
+        PermuteSimd<V> (p, px1y0, z1, mask), pVectors);
+      ix0 = LinearInterpSimd<V> (n0, n1, xs);
+      n0  = GradientNoise3DTableSimd<V> (x, y, z, x0, y1, z1,
+        PermuteSimd<V> (p, px0y1, z1, mask), pVectors);
+      n1  = GradientNoise3DTableSimd<V> (x, y, z, x1, y1, z1,
+        PermuteSimd<V> (p, px1y1, z1, mask), pVectors);
+      ix1 = LinearInterpSimd<V> (n0, n1, xs);
+      iy1 = LinearInterpSimd<V> (ix0, ix1, ys);
+
+      return LinearInterpSimd<V> (iy0, iy1, zs);
+    }
+
+    // Vectorized version of GradientNoise2D() in noisegen.cpp.  The y
+    // component of the gradient vector is not used.
+    template <class V>
+    inline typename V::Real GradientNoise2DSimd (typename V::Real fx,
+      typename V::Real fz, typename V::Int ix, typename V::Int iz,
+      typename V::Int seedTerm)
+    {
+      typename V::Int vectorIndex = V::AddInt (V::MulInt (ix, X_NOISE_GEN),
+        V::AddInt (V::MulInt (iz, Z_NOISE_GEN), seedTerm));
+      vectorIndex = V::IndexMask (vectorIndex);
+
+      typename V::Real xvGradient, yvGradient, zvGradient;
+      V::Gradient (vectorIndex, xvGradient, yvGradient, zvGradient);
+
+      typename V::Real xvPoint = V::Sub (fx, V::ToReal (ix));
+      typename V::Real zvPoint = V::Sub (fz, V::ToReal (iz));
+
+      return V::Mul (V::Add (
+        V::Mul (xvGradient, xvPoint),
+        V::Mul (zvGradient, zvPoint)), V::Set (2.12));
+    }
+
+    // Vectorized version of GradientCoherentNoise2D().
+    template <class V, NoiseQuality Q>
+    inline typename V::Real GradientCoherentNoise2DSimd (
+      typename V::Real x, typename V::Real z, typename V::Int seedTerm)
+    {
+      typename V::Int one = V::SetInt (1);
+      typename V::Int x0 = V::Floor (x);
+      typename V::Int x1 = V::AddInt (x0, one);
+      typename V::Int z0 = V::Floor (z);
+      typename V::Int z1 = V::AddInt (z0, one);
+
+      typename V::Real xs = SCurveSimd<V, Q> (V::Sub (x, V::ToReal (x0)));
+      typename V::Real zs = SCurveSimd<V, Q> (V::Sub (z, V::ToReal (z0)));
+
+      typename V::Real n0, n1, ix0, ix1;
+      n0  = GradientNoise2DSimd<V> (x, z, x0, z0, seedTerm);
+      n1  = GradientNoise2DSimd<V> (x, z, x1, z0, seedTerm);
+      ix0 = LinearInterpSimd<V> (n0, n1, xs);
+      n0  = GradientNoise2DSimd<V> (x, z, x0, z1, seedTerm);
+      n1  = GradientNoise2DSimd<V> (x, z, x1, z1, seedTerm);
+      ix1 = LinearInterpSimd<V> (n0, n1, xs);
+
+      return LinearInterpSimd<V> (ix0, ix1, zs);
+    }
+
+    // Vectorized version of IntValueNoise3D().  seedTerm contains the seed
+    // multiplied by SEED_NOISE_GEN.  Like IntValueNoise3D(), it does not mask
+    // the result to 31 bits, so the 32-bit lanes hold signed values.
+    template <class V>
+    inline typename V::Int IntValueNoise3DSimd (typename V::Int ix,
+      typename V::Int iy, typename V::Int iz, typename V::Int seedTerm)
+    {
+      typename V::Int n = V::AddInt (
+        V::AddInt (V::MulLoInt (ix, V::SetInt (X_NOISE_GEN)),
+          V::MulLoInt (iy, V::SetInt (Y_NOISE_GEN))),
+        V::AddInt (V::MulLoInt (iz, V::SetInt (Z_NOISE_GEN)), seedTerm));
+      n = V::AndInt (n, 0x7fffffff);
+      n = V::XorInt (V::ShiftRightInt (n, 13), n);
+
+      // n * (n * n * 60493 + 19990303) + 1376312589
+      typename V::Int m = V::AddInt (
+        V::MulLoInt (V::MulLoInt (n, n), V::SetInt (60493)),
+        V::SetInt (19990303));
+      return V::AddInt (V::MulLoInt (n, m), V::SetInt (1376312589));
+    }
+
+    // Vectorized version of ValueNoise3D().  Dividing by a power of two is
+    // exact, so multiplying by its reciprocal gives the same result.
+    template <class V>
+    inline typename V::Real ValueNoise3DSimd (typename V::Int ix,
+      typename V::Int iy, typename V::Int iz, typename V::Int seedTerm)
+    {
+      return V::Sub (V::Set (1.0), V::Mul (V::ToReal (
+        IntValueNoise3DSimd<V> (ix, iy, iz, seedTerm)),
+        V::Set (1.0 / 1073741824.0)));
+    }
+
+    // Vectorized version of ValueCoherentNoise3D().
+    template <class V, NoiseQuality Q>
+    inline typename V::Real ValueCoherentNoise3DSimd (typename V::Real x,
+      typename V::Real y, typename V::Real z, typename V::Int seedTerm)
+    {
+      typename V::Int one = V::SetInt (1);
+      typename V::Int x0 = V::Floor (x);
+      typename V::Int x1 = V::AddInt (x0, one);
+      typename V::Int y0 = V::Floor (y);
+      typename V::Int y1 = V::AddInt (y0, one);
+      typename V::Int z0 = V::Floor (z);
+      typename V::Int z1 = V::AddInt (z0, one);
+
+      typename V::Real xs = SCurveSimd<V, Q> (V::Sub (x, V::ToReal (x0)));
+      typename V::Real ys = SCurveSimd<V, Q> (V::Sub (y, V::ToReal (y0)));
+      typename V::Real zs = SCurveSimd<V, Q> (V::Sub (z, V::ToReal (z0)));
+
+      typename V::Real n0, n1, ix0, ix1, iy0, iy1;
+      n0  = ValueNoise3DSimd<V> (x0, y0, z0, seedTerm);
+      n1  = ValueNoise3DSimd<V> (x1, y0, z0, seedTerm);
+      ix0 = LinearInterpSimd<V> (n0, n1, xs);
+      n0  = ValueNoise3DSimd<V> (x0, y1, z0, seedTerm);
+      n1  = ValueNoise3DSimd<V> (x1, y1, z0, seedTerm);
+      ix1 = LinearInterpSimd<V> (n0, n1, xs);
+      iy0 = LinearInterpSimd<V> (ix0, ix1, ys);
+      n0  = ValueNoise3DSimd<V> (x0, y0, z1, seedTerm);
+      n1  = ValueNoise3DSimd<V> (x1, y0, z1, seedTerm);
+      ix0 = LinearInterpSimd<V> (n0, n1, xs);
+      n0  = ValueNoise3DSimd<V> (x0, y1, z1, seedTerm);
+      n1  = ValueNoise3DSimd<V> (x1, y1, z1, seedTerm);
+      ix1 = LinearInterpSimd<V> (n0, n1, xs);
+      iy1 = LinearInterpSimd<V> (ix0, ix1, ys);
+
+      return LinearInterpSimd<V> (iy0, iy1, zs);
+    }
+
+    // Generates the values of GradientCoherentNoise3DArraySimd() that fill
+    // whole vectors, with the noise quality Q, and returns the number of
+    // values that it generated.
+    template <class V, NoiseQuality Q>
+    int GradientCoherentNoise3DLoopSimd (int count,
+      const typename V::Scalar* x, const typename V::Scalar* y,
+      const typename V::Scalar* z, typename V::Scalar* values, int seed)
+    {
+      int i = 0;
+      typename V::Int seedTerm = V::SetInt (SEED_NOISE_GEN * seed);
+      for (; i + V::WIDTH <= count; i += V::WIDTH) {
+        V::Store (values + i, GradientCoherentNoise3DSimd<V, Q> (
+          V::Load (x + i), V::Load (y + i), V::Load (z + i), seedTerm));
+      }
+      return i;
+    }
+
+    // Vectorized version of GradientCoherentNoise3DArray().
+    template <class V>
+    void GradientCoherentNoise3DArraySimd (int count,
+      const typename V::Scalar* x, const typename V::Scalar* y,
+      const typename V::Scalar* z, typename V::Scalar* values, int seed,
+      NoiseQuality noiseQuality)
+    {
+      // Select the vectorized loop for the noise quality once for the
+      // whole array.
+      int i;
+      switch (noiseQuality) {
+        case QUALITY_STD:
+          i = GradientCoherentNoise3DLoopSimd<V, QUALITY_STD> (count, x, y,
+            z, values, seed);
+          break;
+        case QUALITY_BEST:
+          i = GradientCoherentNoise3DLoopSimd<V, QUALITY_BEST> (count, x, y,
+            z, values, seed);
+          break;
+        default:
+          i = GradientCoherentNoise3DLoopSimd<V, QUALITY_FAST> (count, x, y,
+            z, values, seed);
+          break;
+      }
+
+      // Generate the remaining values with the scalar code.
+      for (; i < count; i++) {
+        values[i] = GradientCoherentNoise3D (x[i], y[i], z[i], seed,
+          noiseQuality);
+      }
+    }
+
+    // Generates the values of GradientCoherentNoise3DTableArraySimd() that
+    // fill whole vectors, with the noise quality Q, and returns the number of
+    // values that it generated.
+    template <class V, NoiseQuality Q>
+    int GradientCoherentNoise3DTableLoopSimd (int count,
+      const typename V::Scalar* x, const typename V::Scalar* y,
+      const typename V::Scalar* z, typename V::Scalar* values,
+      const PermutationTable& table, int seed)
+    {
+      int i = 0;
+      int mask = table.GetSize () - 1;
+      const int* pPermutations = table.GetPermutations ();
+      const typename V::Scalar* pVectors = V::TableVectors (table);
+      typename V::Int seedIndex = V::SetInt (
+        pPermutations[(unsigned int)seed & (unsigned int)mask]);
+      for (; i + V::WIDTH <= count; i += V::WIDTH) {
+        V::Store (values + i, GradientCoherentNoise3DTableSimd<V, Q> (
+          V::Load (x + i), V::Load (y + i), V::Load (z + i), seedIndex,
+          pPermutations, mask, pVectors));
+      }
+      return i;
+    }
+
+    // Vectorized version of the GradientCoherentNoise3DArray() function
+    // that takes a permutation table.
+    template <class V>
+    void GradientCoherentNoise3DTableArraySimd (int count,
+      const typename V::Scalar* x, const typename V::Scalar* y,
+      const typename V::Scalar* z, typename V::Scalar* values,
+      const PermutationTable& table, int seed, NoiseQuality noiseQuality)
+    {
+      // Select the vectorized loop for the noise quality once for the
+      // whole array.
+      int i;
+      switch (noiseQuality) {
+        case QUALITY_STD:
+          i = GradientCoherentNoise3DTableLoopSimd<V, QUALITY_STD> (count, x,
+            y, z, values, table, seed);
+          break;
+        case QUALITY_BEST:
+          i = GradientCoherentNoise3DTableLoopSimd<V, QUALITY_BEST> (count,
+            x, y, z, values, table, seed);
+          break;
+        default:
+          i = GradientCoherentNoise3DTableLoopSimd<V, QUALITY_FAST> (count,
+            x, y, z, values, table, seed);
+          break;
+      }
+
+      // Generate the remaining values with the scalar code.
+      for (; i < count; i++) {
+        values[i] = GradientCoherentNoise3D (x[i], y[i], z[i], table, seed,
+          noiseQuality);
+      }
+    }
+
+    // Generates the values of GradientCoherentNoise2DArraySimd() that fill
+    // whole vectors, with the noise quality Q, and returns the number of
+    // values that it generated.
+    template <class V, NoiseQuality Q>
+    int GradientCoherentNoise2DLoopSimd (int count,
+      const typename V::Scalar* x, const typename V::Scalar* z,
+      typename V::Scalar* values, int seed)
+    {
+      int i = 0;
+      typename V::Int seedTerm = V::SetInt (SEED_NOISE_GEN * seed);
+      for (; i + V::WIDTH <= count; i += V::WIDTH) {
+        V::Store (values + i, GradientCoherentNoise2DSimd<V, Q> (
+          V::Load (x + i), V::Load (z + i), seedTerm));
+      }
+      return i;
+    }
+
+    // Vectorized version of GradientCoherentNoise2DArray().
+    template <class V>
+    void GradientCoherentNoise2DArraySimd (int count,
+      const typename V::Scalar* x, const typename V::Scalar* z,
+      typename V::Scalar* values, int seed, NoiseQuality noiseQuality)
+    {
+      // Select the vectorized loop for the noise quality once for the
+      // whole array.
+      int i;
+      switch (noiseQuality) {
+        case QUALITY_STD:
+          i = GradientCoherentNoise2DLoopSimd<V, QUALITY_STD> (count, x, z,
+            values, seed);
+          break;
+        case QUALITY_BEST:
+          i = GradientCoherentNoise2DLoopSimd<V, QUALITY_BEST> (count, x, z,
+            values, seed);
+          break;
+        default:
+          i = GradientCoherentNoise2DLoopSimd<V, QUALITY_FAST> (count, x, z,
+            values, seed);
+          break;
+      }
+
+      // Generate the remaining values with the scalar code.
+      for (; i < count; i++) {
+        values[i] = GradientCoherentNoise2D (x[i], z[i], seed, noiseQuality);
+      }
+    }
+
+    // Vectorized version of IntValueNoise3DArray().  The hash only uses
+    // integer operations, so it is instantiated with the single-precision
+    // traits, whose integer vectors hold the most lanes.
+    template <class V>
+    void IntValueNoise3DArraySimd (int count, const int* x, const int* y,
+      const int* z, int* values, int seed)
+    {
+      int i = 0;
+      typename V::Int seedTerm = V::SetInt (
+        (int)((unsigned int)SEED_NOISE_GEN * (unsigned int)seed));
+      for (; i + V::WIDTH <= count; i += V::WIDTH) {
+        V::StoreInt (values + i, IntValueNoise3DSimd<V> (V::LoadInt (x + i),
+          V::LoadInt (y + i), V::LoadInt (z + i), seedTerm));
+      }
+
+      // Generate the remaining values with the scalar code.
+      for (; i < count; i++) {
+        values[i] = IntValueNoise3D (x[i], y[i], z[i], seed);
+      }
+    }
+
+    // Vectorized version of ValueNoise3DArray().
+    template <class V>
+    void ValueNoise3DArraySimd (int count, const int* x, const int* y,
+      const int* z, double* values, int seed)
+    {
+      int i = 0;
+      typename V::Int seedTerm = V::SetInt (
+        (int)((unsigned int)SEED_NOISE_GEN * (unsigned int)seed));
+      for (; i + V::WIDTH <= count; i += V::WIDTH) {
+        V::Store (values + i, ValueNoise3DSimd<V> (V::LoadInt (x + i),
+          V::LoadInt (y + i), V::LoadInt (z + i), seedTerm));
+      }
+
+      // Generate the remaining values with the scalar code.
+      for (; i < count; i++) {
+        values[i] = ValueNoise3D (x[i], y[i], z[i], seed);
+      }
+    }
+
+    // Generates the values of ValueCoherentNoise3DArraySimd() that fill whole
+    // vectors, with the noise quality Q, and returns the number of values that
+    // it generated.
+    template <class V, NoiseQuality Q>
+    int ValueCoherentNoise3DLoopSimd (int count, const double* x,
+      const double* y, const double* z, double* values, int seed)
+    {
+      int i = 0;
+      typename V::Int seedTerm = V::SetInt (
+        (int)((unsigned int)SEED_NOISE_GEN * (unsigned int)seed));
+      for (; i + V::WIDTH <= count; i += V::WIDTH) {
+        V::Store (values + i, ValueCoherentNoise3DSimd<V, Q> (
+          V::Load (x + i), V::Load (y + i), V::Load (z + i), seedTerm));
+      }
+      return i;
+    }
+
+    // Vectorized version of ValueCoherentNoise3DArray().
+    template <class V>
+    void ValueCoherentNoise3DArraySimd (int count, const double* x,
+      const double* y, const double* z, double* values, int seed,
+      NoiseQuality noiseQuality)
+    {
+      // Select the vectorized loop for the noise quality once for the
+      // whole array.
+      int i;
+      switch (noiseQuality) {
+        case QUALITY_STD:
+          i = ValueCoherentNoise3DLoopSimd<V, QUALITY_STD> (count, x, y, z,
+            values, seed);
+          break;
+        case QUALITY_BEST:
+          i = ValueCoherentNoise3DLoopSimd<V, QUALITY_BEST> (count, x, y, z,
+            values, seed);
+          break;
+        default:
+          i = ValueCoherentNoise3DLoopSimd<V, QUALITY_FAST> (count, x, y, z,
+            values, seed);
+          break;
+      }
+
+      // Generate the remaining values with the scalar code.
+      for (; i < count; i++) {
+        values[i] = ValueCoherentNoise3D (x[i], y[i], z[i], seed,
+          noiseQuality);
+      }
+    }
+
+  }
+
+}
+
+#endif
+
+#endif
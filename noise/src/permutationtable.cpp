@@ -0,0 +1,102 @@
+// permutationtable.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+#include <math.h>
+#include <stddef.h>
+#include "exception.h"
+#include "permutationtable.h"
+
+using namespace noise;
+
+// Returns the next number of a linear congruential generator.  The
+// generator is defined here, instead of using rand(), so that a table
+// generated from the same seed is the same on every platform.
+static inline unsigned int NextRandom (unsigned int& state)
+{
+  state = state * 1664525u + 1013904223u;
+  return state >> 8;
+}
+
+PermutationTable::PermutationTable (int seed, int size):
+  m_pPermutations (NULL),
+  m_seed (seed),
+  m_size (size),
+  m_pVectors (NULL),
+  m_pVectorsFloat (NULL)
+{
+  if (size < PERMUTATION_TABLE_MIN_SIZE || size > PERMUTATION_TABLE_MAX_SIZE
+    || (size & (size - 1)) != 0) {
+    throw noise::ExceptionInvalidParam ();
+  }
+
+  // The destructor does not run if the constructor throws, so free the
+  // arrays that were allocated before a failed allocation.
+  try {
+    m_pPermutations = new int[size];
+    m_pVectors = new double[size * 4];
+    m_pVectorsFloat = new float[size * 4];
+  } catch (...) {
+    delete[] m_pPermutations;
+    delete[] m_pVectors;
+    throw;
+  }
+
+  // Shuffle the numbers from 0 to the size minus one (Fisher-Yates.)
+  unsigned int state = (unsigned int)seed * 2654435761u + 12345u;
+  for (int i = 0; i < size; i++) {
+    m_pPermutations[i] = i;
+  }
+  for (int i = size - 1; i > 0; i--) {
+    int j = (int)(NextRandom (state) % (unsigned int)(i + 1));
+    int temp = m_pPermutations[i];
+    m_pPermutations[i] = m_pPermutations[j];
+    m_pPermutations[j] = temp;
+  }
+
+  // Generate random points inside the unit sphere, rejecting the ones that
+  // are too close to the center to be normalized accurately, and project
+  // them onto the sphere.  This distributes the directions evenly.
+  for (int i = 0; i < size; i++) {
+    double x, y, z, lengthSquared;
+    do {
+      x = (double)NextRandom (state) / 8388608.0 - 1.0;
+      y = (double)NextRandom (state) / 8388608.0 - 1.0;
+      z = (double)NextRandom (state) / 8388608.0 - 1.0;
+      lengthSquared = x * x + y * y + z * z;
+    } while (lengthSquared > 1.0 || lengthSquared < 0.01);
+    double length = sqrt (lengthSquared);
+    m_pVectors[i * 4    ] = x / length;
+    m_pVectors[i * 4 + 1] = y / length;
+    m_pVectors[i * 4 + 2] = z / length;
+    m_pVectors[i * 4 + 3] = 0.0;
+    for (int j = 0; j < 4; j++) {
+      m_pVectorsFloat[i * 4 + j] = (float)m_pVectors[i * 4 + j];
+    }
+  }
+}
+
+PermutationTable::~PermutationTable ()
+{
+  delete[] m_pPermutations;
+  delete[] m_pVectors;
+  delete[] m_pVectorsFloat;
+}
@@ -0,0 +1,183 @@
+// permutationtable.h
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+#ifndef NOISE_PERMUTATIONTABLE_H
+#define NOISE_PERMUTATIONTABLE_H
+
+namespace noise
+{
+
+  /// @addtogroup libnoise
+  /// @{
+
+  /// Default number of entries in a noise::PermutationTable.
+  const int DEFAULT_PERMUTATION_TABLE_SIZE = 4096;
+
+  /// Maximum number of entries in a noise::PermutationTable.
+  const int PERMUTATION_TABLE_MAX_SIZE = 4096;
+
+  /// Minimum number of entries in a noise::PermutationTable.
+  const int PERMUTATION_TABLE_MIN_SIZE = 256;
+
+  /// A seeded lattice hash for the gradient-coherent-noise functions.
+  ///
+  /// By default, the gradient-coherent-noise functions hash the integer
+  /// coordinates of each lattice point by multiplying them with prime
+  /// numbers, and use eight bits of the result to select one of 256
+  /// gradient vectors.  A permutation table is an alternative: it holds a
+  /// random permutation of the numbers from 0 to the size of the table
+  /// minus one, and the same number of random gradient vectors.  The hash
+  /// of a lattice point (@a x, @a y, @a z) is
+  /// <i>P</i>[<i>P</i>[<i>P</i>[<i>P</i>[@a seed] + @a x] + @a y] +
+  /// @a z], where <i>P</i> is the permutation and each index wraps around
+  /// the size of the table, and it selects the gradient vector directly.
+  ///
+  /// Both the permutation and the gradient vectors are generated from the
+  /// seed that is passed to the constructor, so each table produces a
+  /// different noise.  A table of 4096 entries repeats less visibly than
+  /// the 256 gradient vectors of the default hash; on the other hand, the
+  /// pattern of the noise repeats every 256 or 4096 units along each axis.
+  ///
+  /// To use a permutation table, pass it to the overloads of the
+  /// gradient-coherent-noise functions that take one, or call the
+  /// SetPermutationTable() method of a noise::module::Perlin,
+  /// noise::module::Billow, or noise::module::RidgedMulti noise module.
+  /// A table is never modified after it is created, so several noise
+  /// modules and threads may share it.
+  class PermutationTable
+  {
+
+    public:
+
+      /// Constructor.
+      ///
+      /// @param seed The seed of the permutation and the gradient vectors.
+      /// @param size The number of entries.
+      ///
+      /// @pre The size is a power of two from
+      /// noise::PERMUTATION_TABLE_MIN_SIZE to
+      /// noise::PERMUTATION_TABLE_MAX_SIZE.
+      ///
+      /// @throw noise::ExceptionInvalidParam
+      /// - An invalid parameter was specified; see the preconditions for
+      ///   more information.
+      explicit PermutationTable (int seed = 0,
+        int size = DEFAULT_PERMUTATION_TABLE_SIZE);
+
+      /// Destructor.
+      ~PermutationTable ();
+
+      /// Returns the hash of a lattice point.
+      ///
+      /// @param ix The integer @a x coordinate of the lattice point.
+      /// @param iy The integer @a y coordinate of the lattice point.
+      /// @param iz The integer @a z coordinate of the lattice point.
+      /// @param seed The random number seed.
+      ///
+      /// @returns The index of the gradient vector of the lattice point,
+      /// from 0 to the size of the table minus one.
+      int GetIndex (int ix, int iy, int iz, int seed) const
+      {
+        unsigned int mask = (unsigned int)(m_size - 1);
+        int index = m_pPermutations[(unsigned int)seed & mask];
+        index = m_pPermutations[((unsigned int)index + (unsigned int)ix)
+          & mask];
+        index = m_pPermutations[((unsigned int)index + (unsigned int)iy)
+          & mask];
+        return m_pPermutations[((unsigned int)index + (unsigned int)iz)
+          & mask];
+      }
+
+      /// Returns the permutation.
+      ///
+      /// @returns A pointer to an array of as many integers as the size of
+      /// the table.
+      const int* GetPermutations () const
+      {
+        return m_pPermutations;
+      }
+
+      /// Returns the seed of the permutation and the gradient vectors.
+      ///
+      /// @returns The seed that was passed to the constructor.
+      int GetSeed () const
+      {
+        return m_seed;
+      }
+
+      /// Returns the number of entries.
+      ///
+      /// @returns The number of entries.
+      int GetSize () const
+      {
+        return m_size;
+      }
+
+      /// Returns the gradient vectors.
+      ///
+      /// @returns A pointer to an array of four doubles per entry: the
+      /// @a x, @a y, and @a z components of a unit-length vector, and 0.0.
+      /// This is the layout of the default table of gradient vectors.
+      const double* GetVectors () const
+      {
+        return m_pVectors;
+      }
+
+      /// Returns the single-precision gradient vectors.
+      ///
+      /// @returns A pointer to an array of four floats per entry, holding
+      /// the gradient vectors rounded to single precision.
+      const float* GetVectorsFloat () const
+      {
+        return m_pVectorsFloat;
+      }
+
+    private:
+
+      /// Copying a permutation table is not allowed.
+      PermutationTable (const PermutationTable& table);
+
+      /// Copying a permutation table is not allowed.
+      PermutationTable& operator= (const PermutationTable& table);
+
+      /// The permutation.
+      int* m_pPermutations;
+
+      /// The seed of the permutation and the gradient vectors.
+      int m_seed;
+
+      /// The number of entries.
+      int m_size;
+
+      /// The gradient vectors, four doubles per entry.
+      double* m_pVectors;
+
+      /// The single-precision gradient vectors, four floats per entry.
+      float* m_pVectorsFloat;
+
+  };
+
+  /// @}
+
+}
+
+#endif
@@ -0,0 +1,157 @@
+// threadimpl.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+#include <vector>
+#include "threadimpl.h"
+
+using namespace noise;
+
+ThreadKey noise::g_perThreadKey;
+
+// The library-wide mutex that protects the slots, the tables of all
+// threads, and the lists of objects of the PerThread objects.
+static Mutex g_perThreadMutex;
+
+// The number of slots that have been handed out, including free ones.
+static int g_slotCount = 0;
+
+// The slots of destroyed PerThread objects, which are handed out again.
+static std::vector<int>* g_pFreeSlots = NULL;
+
+// Determines if the key and mutex were created.
+static bool g_isPerThreadReady = false;
+
+// Destroys the table of a thread that is exiting, along with the objects of
+// that thread.
+#ifdef _WIN32
+static VOID WINAPI DestroyTable (PVOID pParam)
+#else
+static void DestroyTable (void* pParam)
+#endif
+{
+  PerThreadTable* pTable = (PerThreadTable*)pParam;
+  if (pTable == NULL) {
+    return;
+  }
+  Lock (g_perThreadMutex);
+  for (int slot = 0; slot < pTable->capacity; slot++) {
+    PerThreadNode* pNode = pTable->ppNodes[slot];
+    if (pNode != NULL) {
+      pTable->ppNodes[slot] = NULL;
+      pNode->pOwner->ReleaseNode (pNode);
+    }
+  }
+  Unlock (g_perThreadMutex);
+  delete[] pTable->ppNodes;
+  delete pTable;
+}
+
+// Creates the key and the mutex.  Called once.
+static void InitPerThread ()
+{
+  if (CreateKey (g_perThreadKey, DestroyTable)) {
+    InitLock (g_perThreadMutex);
+    g_pFreeSlots = new std::vector<int>;
+    g_isPerThreadReady = true;
+  }
+}
+
+#ifdef _WIN32
+static INIT_ONCE g_perThreadOnce = INIT_ONCE_STATIC_INIT;
+
+static BOOL CALLBACK InitPerThreadOnce (PINIT_ONCE pOnce, PVOID pParam,
+  PVOID* ppContext)
+{
+  InitPerThread ();
+  return TRUE;
+}
+#else
+static pthread_once_t g_perThreadOnce = PTHREAD_ONCE_INIT;
+#endif
+
+PerThreadBase::PerThreadBase ()
+{
+#ifdef _WIN32
+  InitOnceExecuteOnce (&g_perThreadOnce, InitPerThreadOnce, NULL, NULL);
+#else
+  pthread_once (&g_perThreadOnce, InitPerThread);
+#endif
+  if (!g_isPerThreadReady) {
+    throw noise::ExceptionOutOfMemory ();
+  }
+
+  Lock (g_perThreadMutex);
+  if (!g_pFreeSlots->empty ()) {
+    m_slot = g_pFreeSlots->back ();
+    g_pFreeSlots->pop_back ();
+  } else {
+    m_slot = g_slotCount++;
+  }
+  Unlock (g_perThreadMutex);
+}
+
+PerThreadBase::~PerThreadBase ()
+{
+  // The derived class has already removed the objects of this slot from
+  // the tables of all threads.
+  Lock (g_perThreadMutex);
+  g_pFreeSlots->push_back (m_slot);
+  Unlock (g_perThreadMutex);
+}
+
+void PerThreadBase::InsertNode (PerThreadNode* pNode)
+{
+  PerThreadTable* pTable = (PerThreadTable*)GetKeyValue (g_perThreadKey);
+  if (pTable == NULL) {
+    pTable = new PerThreadTable;
+    pTable->ppNodes = NULL;
+    pTable->capacity = 0;
+    SetKeyValue (g_perThreadKey, pTable);
+  }
+  if (m_slot >= pTable->capacity) {
+    // Other threads may clear entries of this table while it is enlarged,
+    // but they lock the mutex to do so.
+    int capacity = pTable->capacity * 2;
+    if (capacity <= m_slot) {
+      capacity = m_slot + 16;
+    }
+    PerThreadNode** ppNodes = new PerThreadNode*[capacity];
+    for (int slot = 0; slot < capacity; slot++) {
+      ppNodes[slot] = slot < pTable->capacity? pTable->ppNodes[slot]: NULL;
+    }
+    delete[] pTable->ppNodes;
+    pTable->ppNodes = ppNodes;
+    pTable->capacity = capacity;
+  }
+  pTable->ppNodes[m_slot] = pNode;
+  pNode->pTable = pTable;
+}
+
+void PerThreadBase::LockAll ()
+{
+  Lock (g_perThreadMutex);
+}
+
+void PerThreadBase::UnlockAll ()
+{
+  Unlock (g_perThreadMutex);
+}
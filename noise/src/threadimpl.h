@@ -0,0 +1,400 @@
+// threadimpl.h
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+#ifndef NOISE_THREADIMPL_H
+#define NOISE_THREADIMPL_H
+
+// This header is internal to libnoise.  It wraps the threading functions of
+// the operating system: POSIX threads, or Win32 threads on Windows.
+
+#include <stddef.h>
+#ifdef _WIN32
+// Condition variables and fiber-local storage with destructors require
+// Windows Vista or later.
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#include "exception.h"
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+namespace noise
+{
+
+#ifdef _WIN32
+  typedef HANDLE Thread;
+  typedef CRITICAL_SECTION Mutex;
+  typedef CONDITION_VARIABLE Condition;
+  typedef DWORD ThreadKey;  // A fiber-local storage index.
+#else
+  typedef pthread_t Thread;
+  typedef pthread_mutex_t Mutex;
+  typedef pthread_cond_t Condition;
+  typedef pthread_key_t ThreadKey;
+#endif
+
+  inline void InitLock (Mutex& mutex)
+  {
+#ifdef _WIN32
+    InitializeCriticalSection (&mutex);
+#else
+    pthread_mutex_init (&mutex, NULL);
+#endif
+  }
+
+  inline void DestroyLock (Mutex& mutex)
+  {
+#ifdef _WIN32
+    DeleteCriticalSection (&mutex);
+#else
+    pthread_mutex_destroy (&mutex);
+#endif
+  }
+
+  inline void Lock (Mutex& mutex)
+  {
+#ifdef _WIN32
+    EnterCriticalSection (&mutex);
+#else
+    pthread_mutex_lock (&mutex);
+#endif
+  }
+
+  inline void Unlock (Mutex& mutex)
+  {
+#ifdef _WIN32
+    LeaveCriticalSection (&mutex);
+#else
+    pthread_mutex_unlock (&mutex);
+#endif
+  }
+
+  inline void InitCondition (Condition& condition)
+  {
+#ifdef _WIN32
+    InitializeConditionVariable (&condition);
+#else
+    pthread_cond_init (&condition, NULL);
+#endif
+  }
+
+  inline void DestroyCondition (Condition& condition)
+  {
+#ifdef _WIN32
+    // Windows condition variables do not need to be destroyed.
+    (void)condition;
+#else
+    pthread_cond_destroy (&condition);
+#endif
+  }
+
+  inline void Wait (Condition& condition, Mutex& mutex)
+  {
+#ifdef _WIN32
+    SleepConditionVariableCS (&condition, &mutex, INFINITE);
+#else
+    pthread_cond_wait (&condition, &mutex);
+#endif
+  }
+
+  inline void WakeAll (Condition& condition)
+  {
+#ifdef _WIN32
+    WakeAllConditionVariable (&condition);
+#else
+    pthread_cond_broadcast (&condition);
+#endif
+  }
+
+  // Atomically adds a value to an integer and returns the previous value of
+  // the integer.
+  inline int AtomicAdd (volatile int& value, int addend)
+  {
+#ifdef _WIN32
+    return (int)InterlockedExchangeAdd ((volatile LONG*)&value, addend);
+#else
+    return __sync_fetch_and_add (&value, addend);
+#endif
+  }
+
+  // Atomically adds a value to a size and returns the previous value of the
+  // size.  To subtract, pass the two's complement of the value.
+  inline size_t AtomicAdd (volatile size_t& value, size_t addend)
+  {
+#if defined (_WIN64)
+    return (size_t)InterlockedExchangeAdd64 ((volatile LONGLONG*)&value,
+      (LONGLONG)addend);
+#elif defined (_WIN32)
+    return (size_t)InterlockedExchangeAdd ((volatile LONG*)&value,
+      (LONG)addend);
+#else
+    return __sync_fetch_and_add (&value, addend);
+#endif
+  }
+
+#ifdef _WIN32
+  // Creates a key that identifies a thread-local pointer.  The pointer is
+  // initially NULL in every thread.  When a thread exits, the destructor is
+  // called with the pointer of that thread if it is not NULL.  Returns false
+  // if the operating system has no more keys.
+  inline bool CreateKey (ThreadKey& key, PFLS_CALLBACK_FUNCTION destructor)
+  {
+    key = FlsAlloc (destructor);
+    return key != FLS_OUT_OF_INDEXES;
+  }
+#else
+  inline bool CreateKey (ThreadKey& key, void (*destructor) (void*))
+  {
+    return pthread_key_create (&key, destructor) == 0;
+  }
+#endif
+
+  inline void* GetKeyValue (ThreadKey& key)
+  {
+#ifdef _WIN32
+    return FlsGetValue (key);
+#else
+    return pthread_getspecific (key);
+#endif
+  }
+
+  inline void SetKeyValue (ThreadKey& key, void* pValue)
+  {
+#ifdef _WIN32
+    FlsSetValue (key, pValue);
+#else
+    pthread_setspecific (key, pValue);
+#endif
+  }
+
+  class PerThreadBase;
+
+  // The part of an object of a thread that is shared by all types of
+  // objects (see PerThread.)
+  struct PerThreadNode
+  {
+    // The PerThread object that this object belongs to.
+    PerThreadBase* pOwner;
+
+    // The table of the thread that this object belongs to.
+    struct PerThreadTable* pTable;
+  };
+
+  // The objects of a thread, indexed by the slots of the PerThread objects
+  // that they belong to.  A slot without an object holds NULL.
+  struct PerThreadTable
+  {
+    PerThreadNode** ppNodes;
+    int capacity;
+  };
+
+  // The key that identifies the PerThreadTable of each thread.  It is
+  // created by the first PerThreadBase constructor and never deleted; it is
+  // the only thread key that libnoise uses, whatever the number of
+  // PerThread objects.
+  extern ThreadKey g_perThreadKey;
+
+  // The part of PerThread that does not depend on the type of the objects.
+  // Each PerThread object has a slot, a small integer that indexes the
+  // PerThreadTable of each thread; a slot is reused after its PerThread
+  // object is destroyed.  A single library-wide mutex protects the slots,
+  // the tables of all threads, and the lists of objects.
+  class PerThreadBase
+  {
+
+    public:
+
+      PerThreadBase ();
+
+      virtual ~PerThreadBase ();
+
+      // Locks the library-wide mutex.
+      static void LockAll ();
+
+      // Unlocks the library-wide mutex.
+      static void UnlockAll ();
+
+      // Destroys an object of a thread that is exiting.  The table entry
+      // of the object is already NULL.  The library-wide mutex is locked
+      // when this method is called.
+      virtual void ReleaseNode (PerThreadNode* pNode) = 0;
+
+    protected:
+
+      // Returns the object of the calling thread, or NULL if the calling
+      // thread has no object yet.  This method does not lock.
+      PerThreadNode* FindNode () const
+      {
+        PerThreadTable* pTable = (PerThreadTable*)GetKeyValue (
+          g_perThreadKey);
+        if (pTable == NULL || m_slot >= pTable->capacity) {
+          return NULL;
+        }
+        return pTable->ppNodes[m_slot];
+      }
+
+      // Stores a new object for the calling thread in the table of that
+      // thread, which is created or enlarged as needed.  The library-wide
+      // mutex must be locked when this method is called.
+      void InsertNode (PerThreadNode* pNode);
+
+      // Removes an object from the table of its thread.  The library-wide
+      // mutex must be locked when this method is called.
+      void RemoveNode (PerThreadNode* pNode)
+      {
+        pNode->pTable->ppNodes[m_slot] = NULL;
+      }
+
+    private:
+
+      // Copying is not allowed.
+      PerThreadBase (const PerThreadBase& perThread);
+      PerThreadBase& operator= (const PerThreadBase& perThread);
+
+      // The index of the objects of this PerThread object in the table of
+      // each thread.
+      int m_slot;
+
+  };
+
+  // Stores a separate object of type T for each thread that calls the Get()
+  // method.  The object of a thread is created by its first call, which
+  // locks the library-wide mutex; later calls do not lock.  The object is
+  // destroyed when its thread exits, or with this object, whichever comes
+  // first.
+  template <class T>
+  class PerThread: public PerThreadBase
+  {
+
+    public:
+
+      // An object of a thread, in the list of all objects.
+      struct Node: public PerThreadNode
+      {
+        T value;
+        Node* pPrev;
+        Node* pNext;
+      };
+
+      PerThread ():
+        m_pFirst (NULL)
+      {
+      }
+
+      virtual ~PerThread ()
+      {
+        LockAll ();
+        Node* pNode = m_pFirst;
+        while (pNode != NULL) {
+          Node* pNext = pNode->pNext;
+          RemoveNode (pNode);
+          delete pNode;
+          pNode = pNext;
+        }
+        UnlockAll ();
+      }
+
+      // Returns the object of the calling thread.
+      T& Get ()
+      {
+        Node* pNode = (Node*)FindNode ();
+        if (pNode == NULL) {
+          pNode = new Node;
+          pNode->pOwner = this;
+          pNode->pPrev = NULL;
+          LockAll ();
+          try {
+            InsertNode (pNode);
+          } catch (...) {
+            UnlockAll ();
+            delete pNode;
+            throw;
+          }
+          pNode->pNext = m_pFirst;
+          if (m_pFirst != NULL) {
+            m_pFirst->pPrev = pNode;
+          }
+          m_pFirst = pNode;
+          UnlockAll ();
+        }
+        return pNode->value;
+      }
+
+      // Returns the first object in the list of all objects.  The list must
+      // be traversed while the mutex is locked.
+      Node* GetFirst () const
+      {
+        return m_pFirst;
+      }
+
+      // Locks the mutex that protects the list of all objects.
+      void LockList ()
+      {
+        LockAll ();
+      }
+
+      // Unlocks the mutex that protects the list of all objects.
+      void UnlockList ()
+      {
+        UnlockAll ();
+      }
+
+      virtual void ReleaseNode (PerThreadNode* pNode)
+      {
+        Node* pTypedNode = (Node*)pNode;
+        OnThreadExit (pTypedNode->value);
+        if (pTypedNode->pPrev != NULL) {
+          pTypedNode->pPrev->pNext = pTypedNode->pNext;
+        } else {
+          m_pFirst = pTypedNode->pNext;
+        }
+        if (pTypedNode->pNext != NULL) {
+          pTypedNode->pNext->pPrev = pTypedNode->pPrev;
+        }
+        delete pTypedNode;
+      }
+
+    protected:
+
+      // Called with the object of a thread that is exiting, just before the
+      // object is destroyed, while the mutex is locked.  A derived class may
+      // override this method to keep a part of the object, such as a
+      // statistic.
+      virtual void OnThreadExit (T& value)
+      {
+      }
+
+    private:
+
+      // The first node in the list of all objects.
+      Node* m_pFirst;
+
+  };
+
+}
+
+#endif
+
+#endif
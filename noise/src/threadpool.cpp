@@ -0,0 +1,247 @@
+// threadpool.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+#include "exception.h"
+#include "threadimpl.h"
+#include "threadpool.h"
+
+using namespace noise;
+
+// The synchronization state that a thread pool shares with its worker
+// threads.
+struct noise::ThreadPoolState
+{
+  /// Protects all other members of this structure.
+  Mutex mutex;
+
+  /// Signaled when a parallel operation starts or the pool shuts down.
+  Condition startCondition;
+
+  /// Signaled when a parallel operation completes.
+  Condition doneCondition;
+
+  /// The worker threads.
+  Thread* pThreads;
+
+  /// The number of worker threads.
+  int threadCount;
+
+  /// The function that performs a job of the current operation.
+  ThreadPoolJob job;
+
+  /// The context pointer passed to the job function.
+  void* pContext;
+
+  /// The number of jobs in the current operation.
+  int jobCount;
+
+  /// The index of the next job to hand out.  The threads take jobs by
+  /// incrementing this index atomically, without locking the mutex.
+  volatile int nextJob;
+
+  /// The number of worker threads that have not finished the current
+  /// operation.
+  int busyCount;
+
+  /// Incremented each time a parallel operation starts.
+  unsigned int generation;
+
+  /// Determines if a parallel operation is in progress.
+  bool isRunning;
+
+  /// Determines if the worker threads are to exit.
+  bool isQuitting;
+};
+
+// Performs jobs of the current operation until all of them have been handed
+// out.  The mutex must not be locked when this function is called.  The
+// job function, context pointer, and job count do not change until every
+// thread has returned from this function.
+static void PerformJobs (ThreadPoolState& state)
+{
+  for (;;) {
+    int jobIndex = AtomicAdd (state.nextJob, 1);
+    if (jobIndex >= state.jobCount) {
+      break;
+    }
+    state.job (state.pContext, jobIndex);
+  }
+}
+
+// The main function of a worker thread.
+static void WorkerMain (ThreadPoolState& state)
+{
+  // The generation is 0 when the thread is created, even if an operation
+  // has already started by the time this thread runs.
+  unsigned int generation = 0;
+  Lock (state.mutex);
+  for (;;) {
+    while (!state.isQuitting && state.generation == generation) {
+      Wait (state.startCondition, state.mutex);
+    }
+    if (state.isQuitting) {
+      break;
+    }
+    generation = state.generation;
+    Unlock (state.mutex);
+    PerformJobs (state);
+    Lock (state.mutex);
+    if (--state.busyCount == 0) {
+      WakeAll (state.doneCondition);
+    }
+  }
+  Unlock (state.mutex);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI WorkerEntry (LPVOID pParam)
+{
+  WorkerMain (*(ThreadPoolState*)pParam);
+  return 0;
+}
+#else
+static void* WorkerEntry (void* pParam)
+{
+  WorkerMain (*(ThreadPoolState*)pParam);
+  return NULL;
+}
+#endif
+
+ThreadPool::ThreadPool ()
+{
+  Create (GetProcessorCount ());
+}
+
+ThreadPool::ThreadPool (int threadCount)
+{
+  if (threadCount < 1) {
+    throw noise::ExceptionInvalidParam ();
+  }
+  Create (threadCount);
+}
+
+ThreadPool::~ThreadPool ()
+{
+  ThreadPoolState& state = *m_pState;
+  Lock (state.mutex);
+  state.isQuitting = true;
+  WakeAll (state.startCondition);
+  Unlock (state.mutex);
+
+  for (int i = 0; i < state.threadCount; i++) {
+#ifdef _WIN32
+    WaitForSingleObject (state.pThreads[i], INFINITE);
+    CloseHandle (state.pThreads[i]);
+#else
+    pthread_join (state.pThreads[i], NULL);
+#endif
+  }
+
+  DestroyCondition (state.doneCondition);
+  DestroyCondition (state.startCondition);
+  DestroyLock (state.mutex);
+  delete[] state.pThreads;
+  delete m_pState;
+}
+
+void ThreadPool::Create (int threadCount)
+{
+  m_pState = new ThreadPoolState;
+  ThreadPoolState& state = *m_pState;
+  InitLock (state.mutex);
+  InitCondition (state.startCondition);
+  InitCondition (state.doneCondition);
+  state.pThreads = new Thread[threadCount - 1];
+  state.threadCount = 0;
+  state.job = NULL;
+  state.pContext = NULL;
+  state.jobCount = 0;
+  state.nextJob = 0;
+  state.busyCount = 0;
+  state.generation = 0;
+  state.isRunning = false;
+  state.isQuitting = false;
+
+  for (int i = 0; i < threadCount - 1; i++) {
+#ifdef _WIN32
+    HANDLE hThread = CreateThread (NULL, 0, WorkerEntry, &state, 0, NULL);
+    if (hThread == NULL) {
+      break;
+    }
+    state.pThreads[i] = hThread;
+#else
+    if (pthread_create (&state.pThreads[i], NULL, WorkerEntry, &state)
+      != 0) {
+      break;
+    }
+#endif
+    state.threadCount++;
+  }
+  m_threadCount = state.threadCount + 1;
+}
+
+int ThreadPool::GetProcessorCount ()
+{
+  int processorCount;
+#ifdef _WIN32
+  SYSTEM_INFO systemInfo;
+  GetSystemInfo (&systemInfo);
+  processorCount = (int)systemInfo.dwNumberOfProcessors;
+#else
+  processorCount = (int)sysconf (_SC_NPROCESSORS_ONLN);
+#endif
+  return processorCount > 1? processorCount: 1;
+}
+
+void ThreadPool::Run (int jobCount, ThreadPoolJob job, void* pContext)
+{
+  ThreadPoolState& state = *m_pState;
+  if (state.threadCount == 0) {
+    for (int i = 0; i < jobCount; i++) {
+      job (pContext, i);
+    }
+    return;
+  }
+
+  Lock (state.mutex);
+  while (state.isRunning) {
+    Wait (state.doneCondition, state.mutex);
+  }
+  state.isRunning = true;
+  state.job = job;
+  state.pContext = pContext;
+  state.jobCount = jobCount;
+  state.nextJob = 0;
+  state.busyCount = state.threadCount;
+  state.generation++;
+  WakeAll (state.startCondition);
+  Unlock (state.mutex);
+
+  PerformJobs (state);
+  Lock (state.mutex);
+  while (state.busyCount > 0) {
+    Wait (state.doneCondition, state.mutex);
+  }
+  state.isRunning = false;
+  WakeAll (state.doneCondition);
+  Unlock (state.mutex);
+}
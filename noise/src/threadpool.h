@@ -0,0 +1,144 @@
+// threadpool.h
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+#ifndef NOISE_THREADPOOL_H
+#define NOISE_THREADPOOL_H
+
+namespace noise
+{
+
+  /// @addtogroup libnoise
+  /// @{
+
+  /// Function that performs one job of a parallel operation.
+  ///
+  /// @param pContext The context pointer passed to the
+  /// noise::ThreadPool::Run() method.
+  /// @param jobIndex The index of the job to perform.
+  typedef void (*ThreadPoolJob) (void* pContext, int jobIndex);
+
+  /// The synchronization state that a thread pool shares with its worker
+  /// threads.
+  struct ThreadPoolState;
+
+  /// A set of threads that perform the jobs of a parallel operation.
+  ///
+  /// The threads are created by the constructor and are reused by each
+  /// call to the Run() method, so a thread pool can be kept around for
+  /// the lifetime of the application.
+  ///
+  /// The thread that calls the Run() method also performs jobs, so a
+  /// thread pool with a thread count of @b n creates @b n - 1 worker
+  /// threads.  A thread pool with a thread count of 1 performs all jobs
+  /// in the calling thread.
+  ///
+  /// The models use a thread pool to generate grids of output values
+  /// (see noise::model::Plane::GetValues(), for example.)
+  class ThreadPool
+  {
+
+    public:
+
+      /// Constructor.
+      ///
+      /// This constructor creates one thread per processor.
+      ThreadPool ();
+
+      /// Constructor.
+      ///
+      /// @param threadCount The number of threads that perform jobs,
+      /// including the thread that calls the Run() method.
+      ///
+      /// @pre The thread count is at least 1.
+      ///
+      /// @throw noise::ExceptionInvalidParam
+      /// - An invalid parameter was specified; see the preconditions for
+      ///   more information.
+      ///
+      /// If the operating system refuses to create all of the worker
+      /// threads, the thread pool uses the threads that were created.
+      ThreadPool (int threadCount);
+
+      /// Destructor.
+      ///
+      /// This destructor waits for the worker threads to exit.
+      ~ThreadPool ();
+
+      /// Returns the number of processors in this system.
+      ///
+      /// @returns The number of processors.
+      static int GetProcessorCount ();
+
+      /// Returns the number of threads that perform jobs.
+      ///
+      /// @returns The number of threads, including the thread that calls
+      /// the Run() method.
+      int GetThreadCount () const
+      {
+        return m_threadCount;
+      }
+
+      /// Performs the jobs of a parallel operation.
+      ///
+      /// @param jobCount The number of jobs.
+      /// @param job The function that performs a job.
+      /// @param pContext The context pointer passed to the job function.
+      ///
+      /// This method calls the job function once for each job index from
+      /// 0 to @a jobCount - 1, and returns when all jobs are complete.  The
+      /// jobs are handed out to the threads one at a time, in order, so
+      /// that threads that finish early take more of the jobs.  A thread
+      /// takes a job with a single atomic increment, without locking, so
+      /// even small jobs such as a row of a noise map do not contend.
+      ///
+      /// The job function must not throw exceptions, and it must not call
+      /// the Run() method of the same thread pool.  If several threads
+      /// call this method at the same time, the parallel operations are
+      /// performed one after another.
+      void Run (int jobCount, ThreadPoolJob job, void* pContext);
+
+    private:
+
+      /// Creates the worker threads.
+      ///
+      /// @param threadCount The number of threads that perform jobs.
+      void Create (int threadCount);
+
+      /// Copying a thread pool is not allowed.
+      ThreadPool (const ThreadPool& pool);
+
+      /// Copying a thread pool is not allowed.
+      ThreadPool& operator= (const ThreadPool& pool);
+
+      /// The synchronization state shared with the worker threads.
+      ThreadPoolState* m_pState;
+
+      /// The number of threads that perform jobs.
+      int m_threadCount;
+
+  };
+
+  /// @}
+
+}
+
+#endif
@@ -0,0 +1,198 @@
+// boundsnan.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+// Tests the GetBounds() method of noise modules, and of noise::module::Program,
+// with source modules that output NaN: a negative number raised to a
+// fractional power.  Every output value must be within the bounds, and a NaN
+// output value requires an infinite bound.
+
+#include <math.h>
+#include <stdio.h>
+
+#include <noise.h>
+
+using namespace noise;
+
+// The box that the output values are sampled from.
+static const double LOWER = -2.0;
+static const double UPPER = 2.0;
+
+// The number of samples along each axis of the box.
+static const int SAMPLE_COUNT = 24;
+
+// Returns true if a value is within a range, following the NaN convention of
+// GetBounds().
+static bool IsWithin (double value, double lower, double upper)
+{
+  if (value != value) {
+    return lower == -HUGE_VAL || upper == HUGE_VAL;
+  }
+  return value >= lower && value <= upper;
+}
+
+// Samples a module over the box and returns the number of output values
+// outside its bounds, and outside the bounds of a Program compiled from it.
+static int CheckBounds (const char* name, const module::Module& module)
+{
+  module::Program program;
+  program.Compile (module);
+  double lower, upper, programLower, programUpper;
+  module.GetBounds (LOWER, LOWER, LOWER, UPPER, UPPER, UPPER, lower, upper);
+  program.GetBounds (LOWER, LOWER, LOWER, UPPER, UPPER, UPPER, programLower,
+    programUpper);
+  int failCount = 0;
+  double step = (UPPER - LOWER) / (SAMPLE_COUNT - 1);
+  for (int i = 0; i < SAMPLE_COUNT; i++) {
+    for (int j = 0; j < SAMPLE_COUNT; j++) {
+      for (int k = 0; k < SAMPLE_COUNT; k++) {
+        double x = LOWER + i * step;
+        double y = LOWER + j * step;
+        double z = LOWER + k * step;
+        double value = module.GetValue (x, y, z);
+        if (!IsWithin (value, lower, upper)) {
+          if (failCount == 0) {
+            printf ("FAIL: %s: %g at (%g, %g, %g) is outside [%g, %g]\n",
+              name, value, x, y, z, lower, upper);
+          }
+          failCount++;
+        }
+        double programValue = program.GetValue (x, y, z);
+        if (!IsWithin (programValue, programLower, programUpper)) {
+          if (failCount == 0) {
+            printf ("FAIL: %s: program value %g at (%g, %g, %g) is outside "
+              "[%g, %g]\n", name, programValue, x, y, z, programLower,
+              programUpper);
+          }
+          failCount++;
+        }
+      }
+    }
+  }
+  return failCount;
+}
+
+int main ()
+{
+  // A source module that outputs NaN wherever the base is negative.
+  module::Perlin base;
+  module::Perlin exponent;
+  exponent.SetSeed (1);
+  module::Power power;
+  power.SetSourceModule (0, base);
+  power.SetSourceModule (1, exponent);
+
+  // Clamping does not remove NaN.
+  module::Clamp clamp;
+  clamp.SetSourceModule (0, power);
+  clamp.SetBounds (-0.5, 0.5);
+
+  module::Perlin other;
+  other.SetSeed (2);
+  module::Perlin blendControl;
+  blendControl.SetSeed (3);
+  module::Blend blend;
+  blend.SetSourceModule (0, other);
+  blend.SetSourceModule (1, base);
+  blend.SetControlModule (blendControl);
+
+  int failCount = 0;
+
+  module::Max max;
+  max.SetSourceModule (0, clamp);
+  max.SetSourceModule (1, blend);
+  failCount += CheckBounds ("Max", max);
+
+  module::Max maxSwapped;
+  maxSwapped.SetSourceModule (0, blend);
+  maxSwapped.SetSourceModule (1, clamp);
+  failCount += CheckBounds ("Max (swapped)", maxSwapped);
+
+  module::Min min;
+  min.SetSourceModule (0, clamp);
+  min.SetSourceModule (1, blend);
+  failCount += CheckBounds ("Min", min);
+
+  module::Min minSwapped;
+  minSwapped.SetSourceModule (0, blend);
+  minSwapped.SetSourceModule (1, clamp);
+  failCount += CheckBounds ("Min (swapped)", minSwapped);
+
+  module::Select select;
+  select.SetSourceModule (0, base);
+  select.SetSourceModule (1, other);
+  select.SetControlModule (power);
+  select.SetBounds (0.0, 0.5);
+  failCount += CheckBounds ("Select", select);
+  select.SetEdgeFalloff (0.25);
+  failCount += CheckBounds ("Select (falloff)", select);
+
+  module::Curve curve;
+  curve.SetSourceModule (0, clamp);
+  curve.AddControlPoint (-1.0, -0.5);
+  curve.AddControlPoint (0.0, 0.0);
+  curve.AddControlPoint (0.5, 0.25);
+  curve.AddControlPoint (1.0, 8.0);
+  failCount += CheckBounds ("Curve", curve);
+
+  module::Terrace terrace;
+  terrace.SetSourceModule (0, clamp);
+  terrace.AddControlPoint (-1.0);
+  terrace.AddControlPoint (0.0);
+  terrace.AddControlPoint (8.0);
+  failCount += CheckBounds ("Terrace", terrace);
+
+  // Every coordinate of the source module may be NaN, for which a generator
+  // module outputs NaN; a noise::module::Terrace noise module then maps NaN
+  // onto its last control point.
+  module::Displace displace;
+  displace.SetSourceModule (0, other);
+  displace.SetDisplaceModules (clamp, clamp, clamp);
+  failCount += CheckBounds ("Displace", displace);
+  module::Terrace otherTerrace;
+  otherTerrace.SetSourceModule (0, other);
+  otherTerrace.AddControlPoint (-1.0);
+  otherTerrace.AddControlPoint (0.0);
+  otherTerrace.AddControlPoint (8.0);
+  otherTerrace.AddControlPoint (16.0);
+  module::Displace terraceDisplace;
+  terraceDisplace.SetSourceModule (0, otherTerrace);
+  terraceDisplace.SetDisplaceModules (clamp, clamp, clamp);
+  failCount += CheckBounds ("Displace (terrace)", terraceDisplace);
+
+  // A constant NaN output value, which a Program folds.
+  module::Const negative;
+  negative.SetConstValue (-2.0);
+  module::Const half;
+  half.SetConstValue (0.5);
+  module::Power constPower;
+  constPower.SetSourceModule (0, negative);
+  constPower.SetSourceModule (1, half);
+  module::Max constMax;
+  constMax.SetSourceModule (0, constPower);
+  constMax.SetSourceModule (1, base);
+  failCount += CheckBounds ("Const", constMax);
+
+  if (failCount == 0) {
+    printf ("boundsnan: ok\n");
+  }
+  return failCount == 0? 0: 1;
+}
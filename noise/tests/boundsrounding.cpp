@@ -0,0 +1,203 @@
+// boundsrounding.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+// Tests that the GetBounds() method of noise modules, and of
+// noise::module::Program, rounds outward: interpolating between equal
+// values, or transforming coordinates, must not leave the bounds by a unit
+// in the last place.  Each graph is built with many random parameters.
+
+#include <math.h>
+#include <stdio.h>
+
+#include <noise.h>
+
+using namespace noise;
+
+// The number of random parameter sets of each graph.
+static const int TRIAL_COUNT = 200;
+
+// The number of samples along each axis of a box.
+static const int SAMPLE_COUNT = 8;
+
+// Outputs the x coordinate of the input value, so that its bounds are the
+// x coordinates of the box.
+class XCoordinate: public module::Module
+{
+
+  public:
+
+    XCoordinate ():
+      Module (0)
+    {
+    }
+
+    virtual void GetBounds (double lowerX, double lowerY, double lowerZ,
+      double upperX, double upperY, double upperZ, double& lowerBound,
+      double& upperBound) const
+    {
+      lowerBound = lowerX;
+      upperBound = upperX;
+    }
+
+    virtual int GetSourceModuleCount () const
+    {
+      return 0;
+    }
+
+    virtual double GetValue (double x, double y, double z) const
+    {
+      return x;
+    }
+
+};
+
+// Returns a pseudo-random value from lower to upper.  Dividing by a number
+// that is not a power of two fills the mantissa, so that the calculations on
+// the value are rounded.
+static double GetRandom (double lower, double upper)
+{
+  static unsigned int state = 1;
+  state = state * 1103515245 + 12345;
+  return lower + (upper - lower) * ((state >> 8) / 16777259.0);
+}
+
+// Returns a coordinate of a sample within a range, which includes both of its
+// ends exactly.
+static double GetSample (double lower, double upper, int index)
+{
+  if (index == SAMPLE_COUNT - 1) {
+    return upper;
+  }
+  return lower + (upper - lower) * index / (SAMPLE_COUNT - 1);
+}
+
+// Samples a module over a random box and returns the number of output values
+// outside its bounds, and outside the bounds of a Program compiled from it.
+static int CheckBounds (const char* name, const module::Module& module)
+{
+  double lower[3], upper[3];
+  for (int i = 0; i < 3; i++) {
+    lower[i] = GetRandom (-100.0, 100.0);
+    upper[i] = lower[i] + GetRandom (0.0, 4.0);
+  }
+  module::Program program;
+  program.Compile (module);
+  double lowerBound, upperBound, programLower, programUpper;
+  module.GetBounds (lower[0], lower[1], lower[2], upper[0], upper[1],
+    upper[2], lowerBound, upperBound);
+  program.GetBounds (lower[0], lower[1], lower[2], upper[0], upper[1],
+    upper[2], programLower, programUpper);
+  int failCount = 0;
+  for (int i = 0; i < SAMPLE_COUNT; i++) {
+    for (int j = 0; j < SAMPLE_COUNT; j++) {
+      for (int k = 0; k < SAMPLE_COUNT; k++) {
+        double x = GetSample (lower[0], upper[0], i);
+        double y = GetSample (lower[1], upper[1], j);
+        double z = GetSample (lower[2], upper[2], k);
+        double value = module.GetValue (x, y, z);
+        double programValue = program.GetValue (x, y, z);
+        if (!(value >= lowerBound && value <= upperBound)) {
+          if (failCount == 0) {
+            printf ("FAIL: %s: %.17g is outside [%.17g, %.17g]\n", name,
+              value, lowerBound, upperBound);
+          }
+          failCount++;
+        }
+        if (!(programValue >= programLower && programValue <= programUpper)) {
+          if (failCount == 0) {
+            printf ("FAIL: %s: program value %.17g is outside [%.17g, "
+              "%.17g]\n", name, programValue, programLower, programUpper);
+          }
+          failCount++;
+        }
+      }
+    }
+  }
+  return failCount;
+}
+
+int main ()
+{
+  int failCount = 0;
+  for (int trial = 0; trial < TRIAL_COUNT; trial++) {
+    module::Const constant;
+    constant.SetConstValue (GetRandom (-10.0, 10.0));
+    module::Perlin control;
+    control.SetSeed (trial);
+    module::Clamp alpha;
+    alpha.SetSourceModule (0, control);
+    alpha.SetBounds (-1.0, 1.0);
+
+    // Interpolating between two equal values may round past them.
+    module::Blend blend;
+    blend.SetSourceModule (0, constant);
+    blend.SetSourceModule (1, constant);
+    blend.SetControlModule (alpha);
+    failCount += CheckBounds ("Blend", blend);
+
+    module::Select select;
+    select.SetSourceModule (0, constant);
+    select.SetSourceModule (1, constant);
+    select.SetControlModule (control);
+    select.SetBounds (GetRandom (-1.0, 0.0), GetRandom (0.0, 1.0));
+    select.SetEdgeFalloff (GetRandom (0.5, 1.0));
+    failCount += CheckBounds ("Select", select);
+
+    module::Turbulence turbulence;
+    turbulence.SetSourceModule (0, blend);
+    turbulence.SetSeed (trial);
+    turbulence.SetPower (GetRandom (0.0, 1.0));
+    failCount += CheckBounds ("Turbulence", turbulence);
+
+    module::Terrace terrace;
+    terrace.SetSourceModule (0, control);
+    terrace.AddControlPoint (GetRandom (-2.0, -1.0));
+    terrace.AddControlPoint (GetRandom (-1.0, 1.0));
+    terrace.AddControlPoint (GetRandom (1.0, 2.0));
+    terrace.InvertTerraces (trial % 2 == 1);
+    failCount += CheckBounds ("Terrace", terrace);
+
+    module::Curve curve;
+    curve.SetSourceModule (0, control);
+    for (int i = 0; i < 5; i++) {
+      curve.AddControlPoint (i - 2.0, GetRandom (-10.0, 10.0));
+    }
+    failCount += CheckBounds ("Curve", curve);
+
+    // The transformed coordinates add up their terms in a different order
+    // from the transformed box.
+    XCoordinate xCoordinate;
+    double matrix[12];
+    for (int i = 0; i < 12; i++) {
+      matrix[i] = GetRandom (-2.0, 2.0);
+    }
+    module::TransformPoint transformPoint;
+    transformPoint.SetSourceModule (0, xCoordinate);
+    transformPoint.SetMatrix (matrix);
+    failCount += CheckBounds ("TransformPoint", transformPoint);
+  }
+
+  if (failCount == 0) {
+    printf ("boundsrounding: ok\n");
+  }
+  return failCount == 0? 0: 1;
+}
@@ -0,0 +1,171 @@
+// cachethreads.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+// Tests the per-thread state of noise::module::Cache and
+// noise::module::HashCache: more instances than the operating system has
+// thread keys, evaluated from short-lived threads, whose state must be
+// freed when they exit.
+
+#include <stdio.h>
+#include <vector>
+
+#include <noise.h>
+#include "threadimpl.h"
+
+using namespace noise;
+
+// More instances than PTHREAD_KEYS_MAX (1024 on Linux.)
+static const int CACHE_COUNT = 2500;
+
+static const int THREAD_COUNT = 8;
+
+static const int ROUND_COUNT = 4;
+
+// An object that counts its live instances.
+struct Counted
+{
+  static volatile int liveCount;
+
+  Counted ()
+  {
+    AtomicAdd (liveCount, 1);
+  }
+
+  ~Counted ()
+  {
+    AtomicAdd (liveCount, -1);
+  }
+};
+
+volatile int Counted::liveCount = 0;
+
+struct TestContext
+{
+  std::vector<module::Perlin*> sources;
+  std::vector<module::Cache*> caches;
+  std::vector<module::HashCache*> hashCaches;
+  PerThread<Counted>* pCounted;
+  volatile int failCount;
+};
+
+static void EvaluateAll (void* pContext, int jobIndex)
+{
+  TestContext& context = *(TestContext*)pContext;
+  context.pCounted->Get ();
+  double x = jobIndex * 0.37;
+  double z = jobIndex * 0.11;
+  for (size_t i = 0; i < context.caches.size (); i++) {
+    double expected = context.sources[i % context.sources.size ()]->GetValue (
+      x, 0.5, z);
+    // Twice, so that the second call is answered from the cache.
+    for (int j = 0; j < 2; j++) {
+      if (context.caches[i]->GetValue (x, 0.5, z) != expected
+        || context.hashCaches[i]->GetValue (x, 0.5, z) != expected) {
+        AtomicAdd (context.failCount, 1);
+      }
+    }
+  }
+}
+
+int main ()
+{
+  TestContext context;
+  context.failCount = 0;
+  for (int i = 0; i < 16; i++) {
+    module::Perlin* pSource = new module::Perlin;
+    pSource->SetSeed (i);
+    pSource->SetOctaveCount (2);
+    context.sources.push_back (pSource);
+  }
+  try {
+    for (int i = 0; i < CACHE_COUNT; i++) {
+      module::Cache* pCache = new module::Cache;
+      pCache->SetSourceModule (0, *context.sources[i % 16]);
+      context.caches.push_back (pCache);
+      module::HashCache* pHashCache = new module::HashCache;
+      pHashCache->SetEntryCount (16);
+      pHashCache->SetSourceModule (0, *context.sources[i % 16]);
+      context.hashCaches.push_back (pHashCache);
+    }
+  } catch (noise::Exception&) {
+    printf ("FAIL: could not create %d caches (created %d)\n", CACHE_COUNT,
+      (int)context.caches.size ());
+    return 1;
+  }
+  context.pCounted = new PerThread<Counted>;
+
+  int jobCount = THREAD_COUNT * 4;
+  for (int round = 0; round < ROUND_COUNT; round++) {
+    // Destroying the pool makes its worker threads exit, which must free
+    // their per-thread state.
+    ThreadPool* pPool = new ThreadPool (THREAD_COUNT);
+    pPool->Run (jobCount, EvaluateAll, &context);
+    delete pPool;
+  }
+
+  int failCount = 0;
+  if (context.failCount != 0) {
+    printf ("FAIL: %d cached values differ from the source values\n",
+      context.failCount);
+    failCount++;
+  }
+
+  // Only the calling thread, which also performs jobs, has not exited.
+  if (Counted::liveCount > 1) {
+    printf ("FAIL: %d per-thread objects outlived their threads\n",
+      Counted::liveCount - 1);
+    failCount++;
+  }
+
+  // The counts of the exited threads are kept.
+  noise::uint64 lookupCount = 0;
+  for (size_t i = 0; i < context.hashCaches.size (); i++) {
+    lookupCount += context.hashCaches[i]->GetHitCount ()
+      + context.hashCaches[i]->GetMissCount ();
+  }
+  noise::uint64 expectedCount = (noise::uint64)ROUND_COUNT * jobCount * 2
+    * CACHE_COUNT;
+  if (lookupCount != expectedCount) {
+    printf ("FAIL: %llu hash-cache lookups counted, %llu expected\n",
+      (unsigned long long)lookupCount, (unsigned long long)expectedCount);
+    failCount++;
+  }
+
+  delete context.pCounted;
+  if (Counted::liveCount != 0) {
+    printf ("FAIL: %d per-thread objects outlived their owner\n",
+      Counted::liveCount);
+    failCount++;
+  }
+  for (size_t i = 0; i < context.caches.size (); i++) {
+    delete context.caches[i];
+    delete context.hashCaches[i];
+  }
+  for (size_t i = 0; i < context.sources.size (); i++) {
+    delete context.sources[i];
+  }
+
+  if (failCount == 0) {
+    printf ("cachethreads: ok\n");
+  }
+  return failCount == 0? 0: 1;
+}
@@ -0,0 +1,119 @@
+// fractalnan.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+// Tests the GetValues() method of the fractal generator modules on a span
+// of input values that holds both a NaN coordinate and a coordinate beyond
+// 2^29, which must still be passed to MakeInt32Range().  The
+// double-precision output values must be identical to the ones from
+// GetValue(), and a NaN input value must not change the single-precision
+// output values of the other input values.
+
+#include <math.h>
+#include <stdio.h>
+
+#include <noise.h>
+
+using namespace noise;
+
+// The number of input values: one span of the batched GetValues() methods.
+static const int COUNT = module::MODULE_BATCH_SIZE;
+
+// The input value that holds the huge coordinate, and the one that holds
+// the NaN coordinate.
+static const int HUGE_INDEX = 17;
+static const int NAN_INDEX = 90;
+
+// Returns true if two values are identical, or both NaN.
+template <class T>
+static bool IsSame (T a, T b)
+{
+  return a == b || (a != a && b != b);
+}
+
+// Compares the output values of a module for the span with and without the
+// NaN coordinate, and returns the number of mismatches.
+static int CheckModule (const char* name, const module::Module& module)
+{
+  double x[COUNT], y[COUNT], z[COUNT], values[COUNT];
+  float xf[COUNT], yf[COUNT], zf[COUNT], valuesf[COUNT], cleanValuesf[COUNT];
+  for (int i = 0; i < COUNT; i++) {
+    x[i] = 0.37 * i - 11.0;
+    y[i] = 0.21 * i + 3.0;
+    z[i] = -0.13 * i + 0.5;
+  }
+  x[HUGE_INDEX] = 3.1e9;
+  for (int i = 0; i < COUNT; i++) {
+    xf[i] = (float)x[i];
+    yf[i] = (float)y[i];
+    zf[i] = (float)z[i];
+  }
+  module.GetValues (COUNT, xf, yf, zf, cleanValuesf);
+  y[NAN_INDEX] = sqrt (-1.0);
+  yf[NAN_INDEX] = (float)y[NAN_INDEX];
+  module.GetValues (COUNT, x, y, z, values);
+  module.GetValues (COUNT, xf, yf, zf, valuesf);
+
+  int failCount = 0;
+  for (int i = 0; i < COUNT; i++) {
+    double expected = module.GetValue (x[i], y[i], z[i]);
+    if (!IsSame (values[i], expected)) {
+      if (failCount == 0) {
+        printf ("FAIL: %s: GetValues() returned %.17g at %d, GetValue() "
+          "returned %.17g\n", name, values[i], i, expected);
+      }
+      failCount++;
+    }
+    if (i != NAN_INDEX && !IsSame (valuesf[i], cleanValuesf[i])) {
+      if (failCount == 0) {
+        printf ("FAIL: %s: single-precision GetValues() returned %.9g at "
+          "%d, %.9g without the NaN coordinate\n", name, valuesf[i], i,
+          cleanValuesf[i]);
+      }
+      failCount++;
+    }
+  }
+  return failCount;
+}
+
+int main ()
+{
+  int failCount = 0;
+
+  module::Perlin perlin;
+  failCount += CheckModule ("Perlin", perlin);
+
+  module::Billow billow;
+  failCount += CheckModule ("Billow", billow);
+
+  module::RidgedMulti ridgedMulti;
+  failCount += CheckModule ("RidgedMulti", ridgedMulti);
+
+  // Turbulence distorts the input values with Perlin noise modules.
+  module::Turbulence turbulence;
+  turbulence.SetSourceModule (0, perlin);
+  failCount += CheckModule ("Turbulence", turbulence);
+
+  if (failCount == 0) {
+    printf ("fractalnan: ok\n");
+  }
+  return failCount == 0? 0: 1;
+}
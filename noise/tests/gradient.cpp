@@ -0,0 +1,151 @@
+// gradient.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+
+// Tests the GetValueAndGradient() method of the fractal generator modules.
+// The output value must be identical to the output value of GetValue(), and
+// each partial derivative must match a central difference of GetValue().
+// The absolute values in noise::module::Billow and
+// noise::module::RidgedMulti have kinks where a derivative jumps; the input
+// values whose forward and backward differences disagree are near a kink
+// and are skipped.
+
+#include <math.h>
+#include <stdio.h>
+
+#include <noise.h>
+
+using namespace noise;
+
+// The number of input values of each noise module.
+static const int COUNT = 2000;
+
+// The step of the differences.
+static const double STEP = 1.0e-6;
+
+// The largest difference between a partial derivative and its central
+// difference, relative to the magnitude of the partial derivative plus one.
+static const double TOLERANCE = 1.0e-4;
+
+// The smallest difference between the forward and backward differences that
+// indicates a kink, relative to the magnitude of the partial derivative plus
+// one.  Away from a kink, the difference between them is the second
+// derivative multiplied by the step.
+static const double KINK_TOLERANCE = 1.0e-2;
+
+// Returns a pseudo-random value from lower to upper.
+static double GetRandom (double lower, double upper)
+{
+  static unsigned int state = 1;
+  state = state * 1103515245 + 12345;
+  return lower + (upper - lower) * ((state >> 8) / 16777216.0);
+}
+
+// Compares a partial derivative to the differences of the output values at
+// offsets of -STEP, 0, and +STEP along its axis.  Returns false if the
+// partial derivative does not match, and sets isKink if the forward and
+// backward differences disagree.
+static bool IsDerivativeMatch (double derivative, double lowerValue,
+  double value, double upperValue, bool& isKink)
+{
+  double forward = (upperValue - value) / STEP;
+  double backward = (value - lowerValue) / STEP;
+  double central = (upperValue - lowerValue) / (2.0 * STEP);
+  double scale = 1.0 + fabs (derivative);
+  if (fabs (forward - backward) > KINK_TOLERANCE * scale) {
+    isKink = true;
+    return true;
+  }
+  return fabs (derivative - central) <= TOLERANCE * scale;
+}
+
+// Compares the output values and partial derivatives of a noise module at
+// random input values to GetValue(), and returns the number of mismatches.
+template <class T>
+static int CheckModule (const char* name, const T& module)
+{
+  int failCount = 0;
+  int kinkCount = 0;
+  for (int i = 0; i < COUNT; i++) {
+    double x = GetRandom (-50.0, 50.0);
+    double y = GetRandom (-50.0, 50.0);
+    double z = GetRandom (-50.0, 50.0);
+    double dx, dy, dz;
+    double value = module.GetValueAndGradient (x, y, z, dx, dy, dz);
+    double expected = module.GetValue (x, y, z);
+    bool isKink = false;
+    bool isMatch = IsDerivativeMatch (dx, module.GetValue (x - STEP, y, z),
+      expected, module.GetValue (x + STEP, y, z), isKink);
+    isMatch = IsDerivativeMatch (dy, module.GetValue (x, y - STEP, z),
+      expected, module.GetValue (x, y + STEP, z), isKink) && isMatch;
+    isMatch = IsDerivativeMatch (dz, module.GetValue (x, y, z - STEP),
+      expected, module.GetValue (x, y, z + STEP), isKink) && isMatch;
+    if (isKink) {
+      kinkCount++;
+    }
+    if (value != expected || !isMatch) {
+      if (failCount == 0) {
+        printf ("FAIL: %s: (%.17g, %.17g, %.17g) returned %.17g and "
+          "gradient (%g, %g, %g), GetValue() returned %.17g\n", name, x, y,
+          z, value, dx, dy, dz, expected);
+      }
+      failCount++;
+    }
+  }
+
+  // Kinks are rare; skipping most input values would hide errors.
+  if (kinkCount > COUNT / 10) {
+    printf ("FAIL: %s: %d of %d input values are near a kink\n", name,
+      kinkCount, COUNT);
+    failCount++;
+  }
+  return failCount;
+}
+
+int main ()
+{
+  int failCount = 0;
+
+  module::Perlin perlin;
+  failCount += CheckModule ("Perlin", perlin);
+  perlin.SetNoiseQuality (QUALITY_BEST);
+  perlin.SetOctaveCount (3);
+  perlin.SetFrequency (0.7);
+  failCount += CheckModule ("Perlin (best quality)", perlin);
+
+  module::Billow billow;
+  failCount += CheckModule ("Billow", billow);
+  billow.SetPersistence (0.7);
+  billow.SetSeed (11);
+  failCount += CheckModule ("Billow (persistence)", billow);
+
+  module::RidgedMulti ridgedMulti;
+  failCount += CheckModule ("RidgedMulti", ridgedMulti);
+  ridgedMulti.SetLacunarity (2.5);
+  ridgedMulti.SetSeed (12);
+  failCount += CheckModule ("RidgedMulti (lacunarity)", ridgedMulti);
+
+  if (failCount == 0) {
+    printf ("gradient: ok\n");
+  }
+  return failCount == 0? 0: 1;
+}
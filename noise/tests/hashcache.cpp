@@ -0,0 +1,162 @@
+// hashcache.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+
+// Tests that the output values of noise::module::HashCache are identical to
+// the output values of its source module, with both versions of
+// GetValues() and with GetValue(), for input values that repeat in random
+// order.  The input values include both signs of zero, which must be
+// cached separately, and NaN.  The tables are small enough that entries are
+// replaced.
+
+#include <math.h>
+#include <stdio.h>
+
+#include <noise.h>
+
+using namespace noise;
+
+// The number of distinct input values.
+static const int POINT_COUNT = 40;
+
+// The number of input values of each call; more than two spans of the
+// batched GetValues() methods.
+static const int COUNT = 2 * module::MODULE_BATCH_SIZE + 37;
+
+// Outputs a value that depends on the sign of a zero x coordinate.
+class SignedSource: public module::Module
+{
+
+  public:
+
+    SignedSource ():
+      Module (0)
+    {
+    }
+
+    virtual int GetSourceModuleCount () const
+    {
+      return 0;
+    }
+
+    virtual double GetValue (double x, double y, double z) const
+    {
+      return 1.0 / x + 2.0 * y - z;
+    }
+
+};
+
+// Returns a pseudo-random integer from 0 to count minus one.
+static int GetRandomInt (int count)
+{
+  static unsigned int state = 1;
+  state = state * 1103515245 + 12345;
+  return (int)((state >> 8) % (unsigned int)count);
+}
+
+// Returns true if two values are identical, or both NaN.
+template <class T>
+static bool IsSame (T a, T b)
+{
+  return a == b || (a != a && b != b);
+}
+
+// Compares the output values of a noise::module::HashCache noise module to
+// the output values of its source module, and returns the number of
+// mismatches.
+static int CheckCache (const char* name, const module::Module& source,
+  int entryCount)
+{
+  double pointX[POINT_COUNT], pointY[POINT_COUNT], pointZ[POINT_COUNT];
+  for (int i = 0; i < POINT_COUNT; i++) {
+    pointX[i] = 0.37 * i - 7.0;
+    pointY[i] = 0.11 * i;
+    pointZ[i] = -0.23 * i + 1.0;
+  }
+  pointX[1] = 0.0;
+  pointX[2] = -0.0;
+  pointY[1] = pointY[2];
+  pointZ[1] = pointZ[2];
+  pointY[3] = sqrt (-1.0);
+
+  module::HashCache cache;
+  cache.SetSourceModule (0, source);
+  cache.SetEntryCount (entryCount);
+
+  int failCount = 0;
+  for (int pass = 0; pass < 4; pass++) {
+    double x[COUNT], y[COUNT], z[COUNT], values[COUNT], expected[COUNT];
+    float xf[COUNT], yf[COUNT], zf[COUNT], valuesf[COUNT], expectedf[COUNT];
+    for (int i = 0; i < COUNT; i++) {
+      int point = GetRandomInt (POINT_COUNT);
+      x[i] = pointX[point];
+      y[i] = pointY[point];
+      z[i] = pointZ[point];
+      xf[i] = (float)x[i];
+      yf[i] = (float)y[i];
+      zf[i] = (float)z[i];
+    }
+    cache.GetValues (COUNT, x, y, z, values);
+    cache.GetValues (COUNT, xf, yf, zf, valuesf);
+    source.GetValues (COUNT, x, y, z, expected);
+    source.GetValues (COUNT, xf, yf, zf, expectedf);
+    for (int i = 0; i < COUNT; i++) {
+      double value = cache.GetValue (x[i], y[i], z[i]);
+      if (!IsSame (values[i], expected[i]) || !IsSame (value, expected[i])
+        || !IsSame (valuesf[i], expectedf[i])) {
+        if (failCount == 0) {
+          printf ("FAIL: %s: %d entries: returned %.17g, %.17g, and %.9g at "
+            "%d, the source module returned %.17g and %.9g\n", name,
+            entryCount, values[i], value, valuesf[i], i, expected[i],
+            expectedf[i]);
+        }
+        failCount++;
+      }
+    }
+  }
+
+  // The input values repeat, so some of them must be found in the tables.
+  if (cache.GetHitCount () == 0) {
+    printf ("FAIL: %s: %d entries: no input value was found\n", name,
+      entryCount);
+    failCount++;
+  }
+  return failCount;
+}
+
+int main ()
+{
+  int failCount = 0;
+
+  SignedSource signedSource;
+  failCount += CheckCache ("SignedSource", signedSource, 4);
+  failCount += CheckCache ("SignedSource", signedSource, 1024);
+
+  module::Perlin perlin;
+  failCount += CheckCache ("Perlin", perlin, 16);
+  failCount += CheckCache ("Perlin", perlin, 1024);
+
+  if (failCount == 0) {
+    printf ("hashcache: ok\n");
+  }
+  return failCount == 0? 0: 1;
+}
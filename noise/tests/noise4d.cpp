@@ -0,0 +1,163 @@
+// noise4d.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+
+// Tests four-dimensional coherent noise.  GradientCoherentNoise4D() must be
+// zero at the lattice points, its magnitude must not exceed
+// noise::GRADIENT_COHERENT_NOISE_4D_BOUND, and it must change continuously.
+// ValueCoherentNoise4D() must range from -1.0 to +1.0 and be equal to
+// ValueNoise4D() at the lattice points.  The GetValue4D() method of the
+// fractal generator modules must change continuously along the w axis and
+// stay within the sum of the amplitudes of their octaves.
+
+#include <math.h>
+#include <stdio.h>
+
+#include <noise.h>
+
+using namespace noise;
+
+// The number of random input values of each check.
+static const int COUNT = 20000;
+
+// The offset between two input values that tests continuity, and the largest
+// difference between their noise values.
+static const double CONTINUITY_STEP = 1.0e-7;
+static const double CONTINUITY_TOLERANCE = 1.0e-4;
+
+// Returns a pseudo-random value from lower to upper.
+static double GetRandom (double lower, double upper)
+{
+  static unsigned int state = 1;
+  state = state * 1103515245 + 12345;
+  return lower + (upper - lower) * ((state >> 8) / 16777216.0);
+}
+
+// Returns a pseudo-random integer from -100 to 99.
+static int GetRandomInt ()
+{
+  return (int)floor (GetRandom (-100.0, 100.0));
+}
+
+// Checks the coherent-noise functions for a noise quality, and returns the
+// number of failures.
+static int CheckCoherentNoise (NoiseQuality noiseQuality)
+{
+  int failCount = 0;
+  for (int i = 0; i < COUNT; i++) {
+    int seed = i % 5;
+    int ix = GetRandomInt ();
+    int iy = GetRandomInt ();
+    int iz = GetRandomInt ();
+    int iw = GetRandomInt ();
+    double latticeGradient = GradientCoherentNoise4D (ix, iy, iz, iw, seed,
+      noiseQuality);
+    double latticeValue = ValueCoherentNoise4D (ix, iy, iz, iw, seed,
+      noiseQuality);
+    if (latticeGradient != 0.0
+      || latticeValue != ValueNoise4D (ix, iy, iz, iw, seed)) {
+      if (failCount == 0) {
+        printf ("FAIL: quality %d: lattice point (%d, %d, %d, %d) returned "
+          "%.17g and %.17g\n", (int)noiseQuality, ix, iy, iz, iw,
+          latticeGradient, latticeValue);
+      }
+      failCount++;
+    }
+
+    double x = GetRandom (-100.0, 100.0);
+    double y = GetRandom (-100.0, 100.0);
+    double z = GetRandom (-100.0, 100.0);
+    double w = GetRandom (-100.0, 100.0);
+    double gradient = GradientCoherentNoise4D (x, y, z, w, seed,
+      noiseQuality);
+    double nearGradient = GradientCoherentNoise4D (x, y + CONTINUITY_STEP, z,
+      w - CONTINUITY_STEP, seed, noiseQuality);
+    double value = ValueCoherentNoise4D (x, y, z, w, seed, noiseQuality);
+    double nearValue = ValueCoherentNoise4D (x - CONTINUITY_STEP, y, z,
+      w + CONTINUITY_STEP, seed, noiseQuality);
+    if (!(fabs (gradient) <= GRADIENT_COHERENT_NOISE_4D_BOUND)
+      || !(fabs (nearGradient - gradient) <= CONTINUITY_TOLERANCE)
+      || !(value >= -1.0 && value <= 1.0)
+      || !(fabs (nearValue - value) <= CONTINUITY_TOLERANCE)) {
+      if (failCount == 0) {
+        printf ("FAIL: quality %d: (%.17g, %.17g, %.17g, %.17g) returned "
+          "%.17g and %.17g, and %.17g and %.17g nearby\n",
+          (int)noiseQuality, x, y, z, w, gradient, value, nearGradient,
+          nearValue);
+      }
+      failCount++;
+    }
+  }
+  return failCount;
+}
+
+// Checks the GetValue4D() method of a fractal generator module, whose
+// output values are at most a bound, and returns the number of failures.
+template <class T>
+static int CheckModule (const char* name, const T& module, double bound)
+{
+  int failCount = 0;
+  for (int i = 0; i < COUNT; i++) {
+    double x = GetRandom (-10.0, 10.0);
+    double y = GetRandom (-10.0, 10.0);
+    double z = GetRandom (-10.0, 10.0);
+    double w = GetRandom (-10.0, 10.0);
+    double value = module.GetValue4D (x, y, z, w);
+    double nextValue = module.GetValue4D (x, y, z, w + CONTINUITY_STEP);
+    if (!(fabs (value) <= bound)
+      || !(fabs (nextValue - value) <= CONTINUITY_TOLERANCE)) {
+      if (failCount == 0) {
+        printf ("FAIL: %s: (%.17g, %.17g, %.17g, %.17g) returned %.17g, "
+          "and %.17g at the next w coordinate\n", name, x, y, z, w, value,
+          nextValue);
+      }
+      failCount++;
+    }
+  }
+  return failCount;
+}
+
+int main ()
+{
+  int failCount = 0;
+  failCount += CheckCoherentNoise (QUALITY_FAST);
+  failCount += CheckCoherentNoise (QUALITY_STD);
+  failCount += CheckCoherentNoise (QUALITY_BEST);
+
+  // The default Perlin noise has six octaves with a persistence of 0.5.
+  module::Perlin perlin;
+  failCount += CheckModule ("Perlin", perlin,
+    (2.0 - 1.0 / 32.0) * GRADIENT_COHERENT_NOISE_4D_BOUND);
+
+  // Normalized octaves have the range of a single octave, which ranges from
+  // -1.0 to 2.0 * GRADIENT_COHERENT_NOISE_4D_BOUND - 1.0 before 0.5 is
+  // added.
+  module::Billow billow;
+  billow.EnableNormalization ();
+  failCount += CheckModule ("Billow", billow,
+    2.0 * GRADIENT_COHERENT_NOISE_4D_BOUND - 0.5);
+
+  if (failCount == 0) {
+    printf ("noise4d: ok\n");
+  }
+  return failCount == 0? 0: 1;
+}
@@ -0,0 +1,153 @@
+// normalization.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+
+// Tests the EnableNormalization() method of the fractal generator modules.
+// With normalization, the bounds of the output values must not depend on the
+// number of octaves or their amplitudes: they must be the bounds of a single
+// octave.  Every output value must be within these bounds, and a single
+// normalized octave must output the same values as without normalization.
+
+#include <math.h>
+#include <stdio.h>
+
+#include <noise.h>
+
+using namespace noise;
+
+// The number of input values of each parameter set.
+static const int COUNT = 2000;
+
+// The largest number of octaves tested.
+static const int MAX_OCTAVE_COUNT = 10;
+
+// The largest difference between the bounds of a parameter set and the
+// bounds of a single octave; normalization divides by a sum that is rounded.
+static const double BOUND_TOLERANCE = 1.0e-12;
+
+// The box that the output values are sampled from.
+static const double LOWER = -20.0;
+static const double UPPER = 20.0;
+
+// Returns a pseudo-random value from lower to upper.
+static double GetRandom (double lower, double upper)
+{
+  static unsigned int state = 1;
+  state = state * 1103515245 + 12345;
+  return lower + (upper - lower) * ((state >> 8) / 16777216.0);
+}
+
+// Sets the parameter that determines the amplitudes of the octaves: the
+// persistence, or the lacunarity of a noise::module::RidgedMulti noise
+// module, whose spectral weights depend on it.
+static void SetAmplitudeParam (module::Perlin& perlin, double param)
+{
+  perlin.SetPersistence (param);
+}
+
+static void SetAmplitudeParam (module::Billow& billow, double param)
+{
+  billow.SetPersistence (param);
+}
+
+static void SetAmplitudeParam (module::RidgedMulti& ridgedMulti, double param)
+{
+  ridgedMulti.SetLacunarity (1.0 / param);
+}
+
+// Checks a fractal generator module with normalization for several numbers
+// of octaves and amplitudes, and returns the number of failures.
+template <class T>
+static int CheckModule (const char* name)
+{
+  T module;
+  module.SetOctaveCount (1);
+  T reference;
+  reference.SetOctaveCount (1);
+  module.EnableNormalization ();
+  double singleLower, singleUpper;
+  module.GetBounds (LOWER, LOWER, LOWER, UPPER, UPPER, UPPER, singleLower,
+    singleUpper);
+
+  int failCount = 0;
+  for (int i = 0; i < COUNT; i++) {
+    double x = GetRandom (LOWER, UPPER);
+    double y = GetRandom (LOWER, UPPER);
+    double z = GetRandom (LOWER, UPPER);
+    double value = module.GetValue (x, y, z);
+    double expected = reference.GetValue (x, y, z);
+    if (value != expected) {
+      if (failCount == 0) {
+        printf ("FAIL: %s: one normalized octave returned %.17g, expected "
+          "%.17g\n", name, value, expected);
+      }
+      failCount++;
+    }
+  }
+
+  static const double PARAMS[3] = {0.25, 0.5, 0.9};
+  for (int octaveCount = 1; octaveCount <= MAX_OCTAVE_COUNT; octaveCount++) {
+    for (int i = 0; i < 3; i++) {
+      module.SetOctaveCount (octaveCount);
+      SetAmplitudeParam (module, PARAMS[i]);
+      double lower, upper;
+      module.GetBounds (LOWER, LOWER, LOWER, UPPER, UPPER, UPPER, lower,
+        upper);
+      if (fabs (lower - singleLower) > BOUND_TOLERANCE
+        || fabs (upper - singleUpper) > BOUND_TOLERANCE) {
+        if (failCount == 0) {
+          printf ("FAIL: %s: %d octaves, parameter %g: the bounds are "
+            "[%.17g, %.17g], one octave has [%.17g, %.17g]\n", name,
+            octaveCount, PARAMS[i], lower, upper, singleLower,
+            singleUpper);
+        }
+        failCount++;
+      }
+      for (int j = 0; j < COUNT / MAX_OCTAVE_COUNT; j++) {
+        double value = module.GetValue (GetRandom (LOWER, UPPER),
+          GetRandom (LOWER, UPPER), GetRandom (LOWER, UPPER));
+        if (!(value >= lower && value <= upper)) {
+          if (failCount == 0) {
+            printf ("FAIL: %s: %d octaves, parameter %g: %.17g is outside "
+              "[%.17g, %.17g]\n", name, octaveCount, PARAMS[i], value,
+              lower, upper);
+          }
+          failCount++;
+        }
+      }
+    }
+  }
+  return failCount;
+}
+
+int main ()
+{
+  int failCount = 0;
+  failCount += CheckModule<module::Perlin> ("Perlin");
+  failCount += CheckModule<module::Billow> ("Billow");
+  failCount += CheckModule<module::RidgedMulti> ("RidgedMulti");
+
+  if (failCount == 0) {
+    printf ("normalization: ok\n");
+  }
+  return failCount == 0? 0: 1;
+}
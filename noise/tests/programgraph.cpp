@@ -0,0 +1,453 @@
+// programgraph.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+
+// Tests noise::module::Program on random graphs of noise modules.  With
+// fusion disabled, the output values of GetValue() and of both versions of
+// GetValues() must be identical to the output values of the root noise
+// module.  With fusion enabled, the output values of graphs whose output
+// values change continuously with the input value must be within
+// FUSION_TOLERANCE of the output values of the root noise module.  The
+// output values of a program must be within the bounds that its
+// GetBounds() method returns.
+
+#include <math.h>
+#include <stdio.h>
+
+#include <noise.h>
+
+using namespace noise;
+
+// The number of random graphs.
+static const int TRIAL_COUNT = 300;
+
+// The number of input values of each graph; more than two spans of the
+// batched GetValues() methods, with a partial span at the end.
+static const int COUNT = 2 * module::MODULE_BATCH_SIZE + 37;
+
+// The largest number of noise modules of a graph.
+static const int MAX_MODULE_COUNT = 64;
+
+// The number of levels of noise modules above the generator modules.
+static const int MAX_DEPTH = 4;
+
+// The largest difference between the output values of a fused program and
+// of the root noise module, relative to the magnitude of the output value
+// plus one.
+static const double FUSION_TOLERANCE = 1.0e-9;
+
+// Returns a pseudo-random integer from 0 to count minus one.
+static int GetRandomInt (int count)
+{
+  static unsigned int state = 1;
+  state = state * 1103515245 + 12345;
+  return (int)((state >> 8) % (unsigned int)count);
+}
+
+// Returns a pseudo-random value from lower to upper.
+static double GetRandom (double lower, double upper)
+{
+  return lower + (upper - lower) * (GetRandomInt (16777216) / 16777216.0);
+}
+
+// Returns true if two values are identical, or both NaN.
+template <class T>
+static bool IsSame (T a, T b)
+{
+  return a == b || (a != a && b != b);
+}
+
+// Returns true if a value is within a range, following the NaN convention of
+// GetBounds().
+static bool IsWithin (double value, double lower, double upper)
+{
+  if (value != value) {
+    return lower == -HUGE_VAL || upper == HUGE_VAL;
+  }
+  return value >= lower && value <= upper;
+}
+
+// Creates the noise modules of a random graph and deletes them.
+class Graph
+{
+
+  public:
+
+    // Creates a random graph.  If isContinuous is true, the output values of
+    // the graph change continuously with the input value, and have a
+    // bounded slope.
+    Graph (bool isContinuous):
+      m_completeCount (0),
+      m_isContinuous (isContinuous),
+      m_moduleCount (0)
+    {
+      m_pRoot = CreateModule (MAX_DEPTH);
+    }
+
+    ~Graph ()
+    {
+      for (int i = 0; i < m_moduleCount; i++) {
+        delete m_pModules[i];
+      }
+    }
+
+    const module::Module& GetRoot () const
+    {
+      return *m_pRoot;
+    }
+
+  private:
+
+    // Adds a noise module to the graph and returns it.
+    template <class T>
+    T* Add (T* pModule)
+    {
+      m_pModules[m_moduleCount++] = pModule;
+      return pModule;
+    }
+
+    // Returns a new noise module at a level of the graph, or sometimes an
+    // existing noise module, so that noise modules are shared.  Only the
+    // noise modules whose source modules are all set are shared, so that
+    // the graph has no cycles.  Near the largest number of noise modules,
+    // existing noise modules are always shared.
+    module::Module* CreateModule (int depth)
+    {
+      if (m_completeCount > 0 && (GetRandomInt (8) == 0
+        || m_moduleCount + 8 >= MAX_MODULE_COUNT)) {
+        return m_pCompleteModules[GetRandomInt (m_completeCount)];
+      }
+      module::Module* pModule;
+      if (depth == 0) {
+        pModule = CreateGenerator ();
+      } else {
+        pModule = CreateOperator (depth - 1);
+      }
+      m_pCompleteModules[m_completeCount++] = pModule;
+      return pModule;
+    }
+
+    // Returns a new generator module with random parameters.
+    module::Module* CreateGenerator ()
+    {
+      switch (GetRandomInt (m_isContinuous? 5: 6)) {
+        case 0: {
+          module::Const* pConst = Add (new module::Const);
+          pConst->SetConstValue (GetRandom (-1.0, 1.0));
+          return pConst;
+        }
+        case 1: {
+          module::Cylinders* pCylinders = Add (new module::Cylinders);
+          pCylinders->SetFrequency (GetRandom (0.5, 2.0));
+          return pCylinders;
+        }
+        case 2: {
+          module::Spheres* pSpheres = Add (new module::Spheres);
+          pSpheres->SetFrequency (GetRandom (0.5, 2.0));
+          return pSpheres;
+        }
+        case 3: {
+          // A noise::module::Voronoi noise module is only continuous
+          // without the displacement value.
+          module::Voronoi* pVoronoi = Add (new module::Voronoi);
+          pVoronoi->SetSeed (GetRandomInt (1000));
+          pVoronoi->EnableDistance (true);
+          pVoronoi->SetDisplacement (m_isContinuous? 0.0: 1.0);
+          return pVoronoi;
+        }
+        case 4: {
+          // Few octaves keep the test fast; equal parameters and seeds let
+          // the program treat several generator modules as one.
+          module::Perlin* pPerlin = Add (new module::Perlin);
+          pPerlin->SetSeed (GetRandomInt (4));
+          pPerlin->SetOctaveCount (1 + GetRandomInt (3));
+          return pPerlin;
+        }
+        default: {
+          return Add (new module::Checkerboard);
+        }
+      }
+    }
+
+    // Returns a new noise module that is not a generator module, with
+    // random parameters and source modules.
+    module::Module* CreateOperator (int depth)
+    {
+      module::Module* pModule;
+      switch (GetRandomInt (m_isContinuous? 20: 21)) {
+        case 0:
+          pModule = Add (new module::Abs);
+          break;
+        case 1:
+          pModule = Add (new module::Add);
+          break;
+        case 2:
+          pModule = Add (new module::Blend);
+          break;
+        case 3:
+          pModule = Add (new module::Cache);
+          break;
+        case 4: {
+          module::Clamp* pClamp = Add (new module::Clamp);
+          double lower = GetRandom (-1.0, 0.5);
+          pClamp->SetBounds (lower, lower + GetRandom (0.0, 1.0));
+          pModule = pClamp;
+          break;
+        }
+        case 5: {
+          module::Curve* pCurve = Add (new module::Curve);
+          for (int i = 0; i < 5; i++) {
+            pCurve->AddControlPoint (i - 2.0, GetRandom (-1.0, 1.0));
+          }
+          pModule = pCurve;
+          break;
+        }
+        case 6:
+          pModule = Add (new module::Displace);
+          break;
+        case 7: {
+          // An exponent below 1.0 has an unbounded slope.
+          module::Exponent* pExponent = Add (new module::Exponent);
+          pExponent->SetExponent (GetRandom (1.0, 3.0));
+          pModule = pExponent;
+          break;
+        }
+        case 8:
+          pModule = Add (new module::Invert);
+          break;
+        case 9:
+          pModule = Add (new module::Max);
+          break;
+        case 10:
+          pModule = Add (new module::Min);
+          break;
+        case 11:
+          pModule = Add (new module::Multiply);
+          break;
+        case 12: {
+          module::RotatePoint* pRotatePoint = Add (new module::RotatePoint);
+          pRotatePoint->SetAngles (GetRandom (-180.0, 180.0),
+            GetRandom (-180.0, 180.0), GetRandom (-180.0, 180.0));
+          pModule = pRotatePoint;
+          break;
+        }
+        case 13: {
+          module::ScaleBias* pScaleBias = Add (new module::ScaleBias);
+          pScaleBias->SetScale (GetRandom (-2.0, 2.0));
+          pScaleBias->SetBias (GetRandom (-1.0, 1.0));
+          pModule = pScaleBias;
+          break;
+        }
+        case 14: {
+          module::ScalePoint* pScalePoint = Add (new module::ScalePoint);
+          pScalePoint->SetScale (GetRandom (0.5, 2.0), GetRandom (-2.0, 2.0),
+            GetRandom (0.5, 2.0));
+          pModule = pScalePoint;
+          break;
+        }
+        case 15: {
+          // An edge falloff keeps the transitions continuous.
+          module::Select* pSelect = Add (new module::Select);
+          double lower = GetRandom (-1.0, 0.5);
+          pSelect->SetBounds (lower, lower + GetRandom (0.5, 1.0));
+          pSelect->SetEdgeFalloff (GetRandom (0.1, 0.25));
+          pModule = pSelect;
+          break;
+        }
+        case 16: {
+          module::Terrace* pTerrace = Add (new module::Terrace);
+          pTerrace->AddControlPoint (GetRandom (-1.0, -0.5));
+          pTerrace->AddControlPoint (GetRandom (-0.5, 0.5));
+          pTerrace->AddControlPoint (GetRandom (0.5, 1.0));
+          pTerrace->InvertTerraces (GetRandomInt (2) == 1);
+          pModule = pTerrace;
+          break;
+        }
+        case 17: {
+          double matrix[12];
+          for (int i = 0; i < 12; i++) {
+            matrix[i] = GetRandom (-1.5, 1.5);
+          }
+          module::TransformPoint* pTransformPoint
+            = Add (new module::TransformPoint);
+          pTransformPoint->SetMatrix (matrix);
+          pModule = pTransformPoint;
+          break;
+        }
+        case 18: {
+          module::TranslatePoint* pTranslatePoint
+            = Add (new module::TranslatePoint);
+          pTranslatePoint->SetTranslation (GetRandom (-4.0, 4.0),
+            GetRandom (-4.0, 4.0), GetRandom (-4.0, 4.0));
+          pModule = pTranslatePoint;
+          break;
+        }
+        case 19: {
+          module::Turbulence* pTurbulence = Add (new module::Turbulence);
+          pTurbulence->SetSeed (GetRandomInt (1000));
+          pTurbulence->SetPower (GetRandom (0.0, 0.5));
+          pTurbulence->SetRoughness (1 + GetRandomInt (2));
+          pModule = pTurbulence;
+          break;
+        }
+        default: {
+          // A noise::module::Power noise module outputs NaN for a negative
+          // base and a fractional exponent.
+          pModule = Add (new module::Power);
+          break;
+        }
+      }
+
+      // Nested transformations are fused into one instruction.
+      for (int i = 0; i < pModule->GetSourceModuleCount (); i++) {
+        module::Module* pSourceModule;
+        if (i == 0 && GetRandomInt (3) == 0) {
+          pSourceModule = CreateTransformChain (depth);
+        } else {
+          pSourceModule = CreateModule (depth);
+        }
+        pModule->SetSourceModule (i, *pSourceModule);
+      }
+      return pModule;
+    }
+
+    // Returns a chain of transformer modules, or of noise::module::ScaleBias
+    // noise modules, which a program fuses into one instruction.
+    module::Module* CreateTransformChain (int depth)
+    {
+      module::Module* pModule = CreateModule (depth);
+      int length = 2 + GetRandomInt (3);
+      bool isScaleBias = GetRandomInt (2) == 0;
+      for (int i = 0; i < length && m_moduleCount < MAX_MODULE_COUNT; i++) {
+        module::Module* pNext;
+        if (isScaleBias) {
+          module::ScaleBias* pScaleBias = Add (new module::ScaleBias);
+          pScaleBias->SetScale (GetRandom (-1.5, 1.5));
+          pScaleBias->SetBias (GetRandom (-0.5, 0.5));
+          pNext = pScaleBias;
+        } else if (GetRandomInt (2) == 0) {
+          module::ScalePoint* pScalePoint = Add (new module::ScalePoint);
+          pScalePoint->SetScale (GetRandom (0.5, 2.0), GetRandom (-2.0, 2.0),
+            GetRandom (0.5, 2.0));
+          pNext = pScalePoint;
+        } else {
+          module::RotatePoint* pRotatePoint = Add (new module::RotatePoint);
+          pRotatePoint->SetAngles (GetRandom (-180.0, 180.0),
+            GetRandom (-180.0, 180.0), GetRandom (-180.0, 180.0));
+          pNext = pRotatePoint;
+        }
+        pNext->SetSourceModule (0, *pModule);
+        pModule = pNext;
+      }
+      return pModule;
+    }
+
+    int m_completeCount;
+    bool m_isContinuous;
+    int m_moduleCount;
+    module::Module* m_pCompleteModules[MAX_MODULE_COUNT];
+    module::Module* m_pModules[MAX_MODULE_COUNT];
+    module::Module* m_pRoot;
+
+};
+
+// Compiles a random graph with and without fusion, and returns the number of
+// output values that do not match the root noise module or its bounds.
+static int CheckGraph (int trial, bool isContinuous)
+{
+  Graph graph (isContinuous);
+  const module::Module& root = graph.GetRoot ();
+
+  double lower[3], upper[3];
+  for (int i = 0; i < 3; i++) {
+    lower[i] = GetRandom (-8.0, 8.0);
+    upper[i] = lower[i] + GetRandom (0.0, 4.0);
+  }
+  double x[COUNT], y[COUNT], z[COUNT], expected[COUNT], values[COUNT];
+  float xf[COUNT], yf[COUNT], zf[COUNT], expectedf[COUNT], valuesf[COUNT];
+  for (int i = 0; i < COUNT; i++) {
+    x[i] = GetRandom (lower[0], upper[0]);
+    y[i] = GetRandom (lower[1], upper[1]);
+    z[i] = GetRandom (lower[2], upper[2]);
+    xf[i] = (float)x[i];
+    yf[i] = (float)y[i];
+    zf[i] = (float)z[i];
+    expected[i] = root.GetValue (x[i], y[i], z[i]);
+  }
+  root.GetValues (COUNT, xf, yf, zf, expectedf);
+
+  int failCount = 0;
+  for (int isFused = 0; isFused < 2; isFused++) {
+    module::Program program;
+    program.EnableFusion (isFused == 1);
+    program.Compile (root);
+    program.GetValues (COUNT, x, y, z, values);
+    program.GetValues (COUNT, xf, yf, zf, valuesf);
+    double lowerBound, upperBound;
+    program.GetBounds (lower[0], lower[1], lower[2], upper[0], upper[1],
+      upper[2], lowerBound, upperBound);
+    for (int i = 0; i < COUNT; i++) {
+      double value = program.GetValue (x[i], y[i], z[i]);
+      bool isMatch;
+      if (isFused == 0) {
+        isMatch = IsSame (value, expected[i]) && IsSame (values[i], value)
+          && IsSame (valuesf[i], expectedf[i]);
+      } else {
+        double tolerance = FUSION_TOLERANCE * (1.0 + fabs (expected[i]));
+        isMatch = !isContinuous || (fabs (value - expected[i]) <= tolerance
+          && fabs (values[i] - expected[i]) <= tolerance);
+      }
+      if (!isMatch) {
+        if (failCount == 0) {
+          printf ("FAIL: trial %d (fusion %d): program returned %.17g, "
+            "%.17g, and %.9g at %d, the graph returned %.17g and %.9g\n",
+            trial, isFused, value, values[i], valuesf[i], i, expected[i],
+            expectedf[i]);
+        }
+        failCount++;
+      }
+      if (!IsWithin (value, lowerBound, upperBound)
+        || !IsWithin (values[i], lowerBound, upperBound)) {
+        if (failCount == 0) {
+          printf ("FAIL: trial %d (fusion %d): %.17g at %d is outside "
+            "[%.17g, %.17g]\n", trial, isFused, value, i, lowerBound,
+            upperBound);
+        }
+        failCount++;
+      }
+    }
+  }
+  return failCount;
+}
+
+int main ()
+{
+  int failCount = 0;
+  for (int trial = 0; trial < TRIAL_COUNT; trial++) {
+    failCount += CheckGraph (trial, trial % 2 == 1);
+  }
+
+  if (failCount == 0) {
+    printf ("programgraph: ok\n");
+  }
+  return failCount == 0? 0: 1;
+}
@@ -0,0 +1,166 @@
+// samplespacing.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+
+// Tests the SetSampleSpacing() method of the fractal generator modules.  With
+// a lacunarity of 2.0, a sample spacing of 0.25 divided by a power of two
+// generates every octave up to the one whose wavelength is four times the
+// sample spacing, at full weight, and drops the others: the output values
+// must be identical to the output values of a noise module with that many
+// octaves.  Between 0.25 and 0.5, the first octave of a
+// noise::module::Perlin noise module fades out by the same factor at every
+// input value.
+
+#include <math.h>
+#include <stdio.h>
+
+#include <noise.h>
+
+using namespace noise;
+
+// The number of input values; more than one span of the batched
+// GetValues() methods.
+static const int COUNT = module::MODULE_BATCH_SIZE + 75;
+
+// The number of octaves of the noise modules without a sample spacing.
+static const int OCTAVE_COUNT = 6;
+
+// The input values.
+static double g_x[COUNT], g_y[COUNT], g_z[COUNT];
+
+static void InitInputValues ()
+{
+  for (int i = 0; i < COUNT; i++) {
+    g_x[i] = 0.173 * i - 20.0;
+    g_y[i] = 0.319 * i - 51.0;
+    g_z[i] = -0.057 * i + 3.5;
+  }
+}
+
+// Compares the output values of a noise module with a sample spacing to the
+// output values of a noise module with fewer octaves, with both GetValue()
+// and GetValues(), and returns the number of mismatches.
+static int CheckSameValues (const char* name, int octaveCount,
+  const module::Module& module, const module::Module& expectedModule)
+{
+  double values[COUNT], expected[COUNT];
+  module.GetValues (COUNT, g_x, g_y, g_z, values);
+  expectedModule.GetValues (COUNT, g_x, g_y, g_z, expected);
+  int failCount = 0;
+  for (int i = 0; i < COUNT; i++) {
+    double value = module.GetValue (g_x[i], g_y[i], g_z[i]);
+    if (value != expected[i] || values[i] != expected[i]) {
+      if (failCount == 0) {
+        printf ("FAIL: %s: %d octaves: returned %.17g and %.17g at %d, "
+          "expected %.17g\n", name, octaveCount, value, values[i], i,
+          expected[i]);
+      }
+      failCount++;
+    }
+  }
+  return failCount;
+}
+
+// Checks a fractal generator module at the sample spacings that keep from
+// one to OCTAVE_COUNT octaves, and returns the number of mismatches.
+template <class T>
+static int CheckModule (const char* name)
+{
+  int failCount = 0;
+  T module;
+  module.SetOctaveCount (OCTAVE_COUNT);
+  T expectedModule;
+  expectedModule.SetOctaveCount (OCTAVE_COUNT);
+  module.SetSampleSpacing (0.0);
+  failCount += CheckSameValues (name, OCTAVE_COUNT, module, expectedModule);
+
+  double sampleSpacing = 0.25;
+  for (int octaveCount = 1; octaveCount <= OCTAVE_COUNT; octaveCount++) {
+    module.SetSampleSpacing (sampleSpacing);
+    expectedModule.SetOctaveCount (octaveCount);
+    failCount += CheckSameValues (name, octaveCount, module, expectedModule);
+    sampleSpacing *= 0.5;
+  }
+
+  // A negative sample spacing is not valid.
+  try {
+    module.SetSampleSpacing (-1.0);
+    printf ("FAIL: %s: a negative sample spacing was accepted\n", name);
+    failCount++;
+  } catch (noise::ExceptionInvalidParam&) {
+  }
+  return failCount;
+}
+
+// Checks that the first octave of a noise::module::Perlin noise module fades
+// out between sample spacings of 0.25 and 0.5, and returns the number of
+// mismatches.
+static int CheckFade ()
+{
+  module::Perlin oneOctave;
+  oneOctave.SetOctaveCount (1);
+  module::Perlin perlin;
+  perlin.SetSampleSpacing (0.35);
+  double weight = 0.0;
+  int failCount = 0;
+  for (int i = 0; i < COUNT; i++) {
+    double value = perlin.GetValue (g_x[i], g_y[i], g_z[i]);
+    double fullValue = oneOctave.GetValue (g_x[i], g_y[i], g_z[i]);
+    if (fabs (fullValue) < 0.01) {
+      continue;
+    }
+    if (weight == 0.0) {
+      weight = value / fullValue;
+    }
+    if (!(weight > 0.0 && weight < 1.0)
+      || fabs (value - weight * fullValue) > 1.0e-12) {
+      if (failCount == 0) {
+        printf ("FAIL: fade: returned %.17g at %d, expected %.17g times "
+          "%.17g\n", value, i, weight, fullValue);
+      }
+      failCount++;
+    }
+  }
+  perlin.SetSampleSpacing (0.5);
+  if (perlin.GetValue (g_x[0], g_y[0], g_z[0]) != 0.0) {
+    printf ("FAIL: fade: the first octave was generated at a sample spacing "
+      "of 0.5\n");
+    failCount++;
+  }
+  return failCount;
+}
+
+int main ()
+{
+  InitInputValues ();
+  int failCount = 0;
+  failCount += CheckModule<module::Perlin> ("Perlin");
+  failCount += CheckModule<module::Billow> ("Billow");
+  failCount += CheckModule<module::RidgedMulti> ("RidgedMulti");
+  failCount += CheckModule<module::Simplex> ("Simplex");
+  failCount += CheckFade ();
+
+  if (failCount == 0) {
+    printf ("samplespacing: ok\n");
+  }
+  return failCount == 0? 0: 1;
+}
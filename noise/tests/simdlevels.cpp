@@ -0,0 +1,138 @@
+// simdlevels.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+
+// Tests that the output values of the noise modules that use the vectorized
+// coherent-noise functions do not depend on the instruction set: at every
+// level that noise::SetSimdLevel() accepts on this computer, the output
+// values of both versions of GetValues() must be identical to the output
+// values at noise::SIMD_SCALAR.  The levels that the processor does not
+// support are skipped.
+
+#include <stdio.h>
+
+#include <noise.h>
+
+using namespace noise;
+
+// The number of input values; more than two spans of the batched
+// GetValues() methods, with a partial span at the end.
+static const int COUNT = 2 * module::MODULE_BATCH_SIZE + 37;
+
+// The input values; the first span lies on the x-z plane, which the
+// coherent-noise functions generate with a faster path, and the last input
+// values are far from the origin.
+static double g_x[COUNT], g_y[COUNT], g_z[COUNT];
+static float g_xf[COUNT], g_yf[COUNT], g_zf[COUNT];
+
+// Returns true if two values are identical, or both NaN.
+template <class T>
+static bool IsSame (T a, T b)
+{
+  return a == b || (a != a && b != b);
+}
+
+static void InitInputValues ()
+{
+  for (int i = 0; i < COUNT; i++) {
+    g_x[i] = 0.173 * i - 20.0;
+    g_y[i] = i < module::MODULE_BATCH_SIZE? 0.0: 0.319 * i - 51.0;
+    g_z[i] = -0.057 * i + 3.5;
+  }
+  for (int i = COUNT - 8; i < COUNT; i++) {
+    g_x[i] += 1.5e9;
+    g_z[i] -= 7.0e8;
+  }
+  for (int i = 0; i < COUNT; i++) {
+    g_xf[i] = (float)g_x[i];
+    g_yf[i] = (float)g_y[i];
+    g_zf[i] = (float)g_z[i];
+  }
+}
+
+// Compares the output values of a noise module at every supported level to
+// its output values at noise::SIMD_SCALAR, and returns the number of
+// mismatches.
+static int CheckModule (const char* name, const module::Module& module)
+{
+  double expected[COUNT], values[COUNT];
+  float expectedf[COUNT], valuesf[COUNT];
+  SetSimdLevel (SIMD_SCALAR);
+  module.GetValues (COUNT, g_x, g_y, g_z, expected);
+  module.GetValues (COUNT, g_xf, g_yf, g_zf, expectedf);
+
+  int failCount = 0;
+  SimdLevel maxSimdLevel = GetMaxSimdLevel ();
+  for (int level = SIMD_SCALAR + 1; level <= maxSimdLevel; level++) {
+    SetSimdLevel ((SimdLevel)level);
+    module.GetValues (COUNT, g_x, g_y, g_z, values);
+    module.GetValues (COUNT, g_xf, g_yf, g_zf, valuesf);
+    for (int i = 0; i < COUNT; i++) {
+      if (!IsSame (values[i], expected[i])
+        || !IsSame (valuesf[i], expectedf[i])) {
+        if (failCount == 0) {
+          printf ("FAIL: %s: level %d returned %.17g and %.9g at %d, level "
+            "0 returned %.17g and %.9g\n", name, level, values[i],
+            valuesf[i], i, expected[i], expectedf[i]);
+        }
+        failCount++;
+      }
+    }
+  }
+  SetSimdLevel (maxSimdLevel);
+  return failCount;
+}
+
+int main ()
+{
+  InitInputValues ();
+  PermutationTable table (5);
+  int failCount = 0;
+
+  module::Perlin perlin;
+  failCount += CheckModule ("Perlin", perlin);
+  perlin.SetPermutationTable (&table);
+  failCount += CheckModule ("Perlin (table)", perlin);
+
+  module::Billow billow;
+  failCount += CheckModule ("Billow", billow);
+  billow.SetPermutationTable (&table);
+  failCount += CheckModule ("Billow (table)", billow);
+
+  module::RidgedMulti ridgedMulti;
+  failCount += CheckModule ("RidgedMulti", ridgedMulti);
+  ridgedMulti.SetPermutationTable (&table);
+  failCount += CheckModule ("RidgedMulti (table)", ridgedMulti);
+
+  // noise::module::Voronoi generates its seed points with the vectorized
+  // value-noise function.
+  module::Voronoi voronoi;
+  failCount += CheckModule ("Voronoi", voronoi);
+  voronoi.EnableDistance (true);
+  voronoi.SetDistanceType (module::VORONOI_DISTANCE_F2_MINUS_F1);
+  failCount += CheckModule ("Voronoi (distance)", voronoi);
+
+  if (failCount == 0) {
+    printf ("simdlevels: ok\n");
+  }
+  return failCount == 0? 0: 1;
+}
@@ -0,0 +1,158 @@
+// simplex.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+
+// Tests simplex noise.  The magnitude of SimplexCoherentNoise3D() must not
+// exceed noise::SIMPLEX_COHERENT_NOISE_BOUND, the single-precision version
+// must be close to the double-precision version, and the noise must change
+// continuously.  The double-precision output values of the GetValues()
+// method of noise::module::Simplex must be identical to the output values
+// of GetValue(), the single-precision output values must be close to them,
+// and all output values must be within the bounds that GetBounds()
+// returns.
+
+#include <math.h>
+#include <stdio.h>
+
+#include <noise.h>
+
+using namespace noise;
+
+// The number of input values of the coherent-noise function.
+static const int COUNT = 100000;
+
+// The number of input values of the noise module; more than two spans of
+// the batched GetValues() methods.
+static const int MODULE_COUNT = 2 * module::MODULE_BATCH_SIZE + 37;
+
+// The largest difference between single-precision and double-precision
+// noise values.
+static const double FLOAT_TOLERANCE = 1.0e-4;
+
+// The offset between two input values that tests continuity, and the largest
+// difference between their noise values.  The slope of the noise is at most
+// a few units.
+static const double CONTINUITY_STEP = 1.0e-7;
+static const double CONTINUITY_TOLERANCE = 1.0e-5;
+
+// Returns a pseudo-random value from lower to upper.
+static double GetRandom (double lower, double upper)
+{
+  static unsigned int state = 1;
+  state = state * 1103515245 + 12345;
+  return lower + (upper - lower) * ((state >> 8) / 16777216.0);
+}
+
+// Checks SimplexCoherentNoise3D() at random input values, and returns the
+// number of failures.
+static int CheckCoherentNoise ()
+{
+  int failCount = 0;
+  double maxMagnitude = 0.0;
+  for (int i = 0; i < COUNT; i++) {
+    // Coordinates that are exactly representable in single precision.
+    double x = (float)GetRandom (-100.0, 100.0);
+    double y = (float)GetRandom (-100.0, 100.0);
+    double z = (float)GetRandom (-100.0, 100.0);
+    int seed = i % 7;
+    double value = SimplexCoherentNoise3D (x, y, z, seed);
+    float valuef = SimplexCoherentNoise3D ((float)x, (float)y, (float)z,
+      seed);
+    double nearValue = SimplexCoherentNoise3D (x + CONTINUITY_STEP, y,
+      z - CONTINUITY_STEP, seed);
+    maxMagnitude = GetMax (maxMagnitude, fabs (value));
+    if (!(fabs (value) <= SIMPLEX_COHERENT_NOISE_BOUND)
+      || !(fabs (valuef - value) <= FLOAT_TOLERANCE)
+      || !(fabs (nearValue - value) <= CONTINUITY_TOLERANCE)) {
+      if (failCount == 0) {
+        printf ("FAIL: (%.17g, %.17g, %.17g) returned %.17g, %.9g in single "
+          "precision, and %.17g nearby\n", x, y, z, value, valuef,
+          nearValue);
+      }
+      failCount++;
+    }
+  }
+
+  // Simplex noise that never leaves a small range is not noise.
+  if (maxMagnitude < 0.5) {
+    printf ("FAIL: the largest magnitude is %.17g\n", maxMagnitude);
+    failCount++;
+  }
+  return failCount;
+}
+
+// Checks a noise::module::Simplex noise module over a box, and returns the
+// number of failures.
+static int CheckModule (const char* name, const module::Simplex& simplex)
+{
+  double x[MODULE_COUNT], y[MODULE_COUNT], z[MODULE_COUNT];
+  double values[MODULE_COUNT];
+  float xf[MODULE_COUNT], yf[MODULE_COUNT], zf[MODULE_COUNT];
+  float valuesf[MODULE_COUNT];
+  for (int i = 0; i < MODULE_COUNT; i++) {
+    xf[i] = (float)GetRandom (-3.0, 5.0);
+    yf[i] = (float)GetRandom (-3.0, 5.0);
+    zf[i] = (float)GetRandom (-3.0, 5.0);
+    x[i] = xf[i];
+    y[i] = yf[i];
+    z[i] = zf[i];
+  }
+  simplex.GetValues (MODULE_COUNT, x, y, z, values);
+  simplex.GetValues (MODULE_COUNT, xf, yf, zf, valuesf);
+  double lowerBound, upperBound;
+  simplex.GetBounds (-3.0, -3.0, -3.0, 5.0, 5.0, 5.0, lowerBound,
+    upperBound);
+
+  int failCount = 0;
+  for (int i = 0; i < MODULE_COUNT; i++) {
+    double value = simplex.GetValue (x[i], y[i], z[i]);
+    if (values[i] != value
+      || !(fabs (valuesf[i] - value) <= FLOAT_TOLERANCE)
+      || !(value >= lowerBound && value <= upperBound)) {
+      if (failCount == 0) {
+        printf ("FAIL: %s: GetValue() returned %.17g at %d, GetValues() "
+          "returned %.17g and %.9g, the bounds are [%.17g, %.17g]\n", name,
+          value, i, values[i], valuesf[i], lowerBound, upperBound);
+      }
+      failCount++;
+    }
+  }
+  return failCount;
+}
+
+int main ()
+{
+  int failCount = 0;
+  failCount += CheckCoherentNoise ();
+
+  module::Simplex simplex;
+  failCount += CheckModule ("Simplex", simplex);
+  simplex.SetFrequency (0.3);
+  simplex.SetPersistence (0.8);
+  simplex.SetSeed (9);
+  failCount += CheckModule ("Simplex (persistence)", simplex);
+
+  if (failCount == 0) {
+    printf ("simplex: ok\n");
+  }
+  return failCount == 0? 0: 1;
+}
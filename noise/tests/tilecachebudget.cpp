@@ -0,0 +1,170 @@
+// cachethreads.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+// Tests that the memory budget of noise::module::TileCache is shared by
+// all threads that call it, and that the tiles of a thread are discarded
+// when the thread exits.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <new>
+
+#include <noise.h>
+#include "threadimpl.h"
+
+using namespace noise;
+
+static const size_t MEMORY_BUDGET = 256 * 1024;
+
+static const int THREAD_COUNT = 8;
+
+// Each job generates a different region of the grid, larger than half of
+// the memory budget, and each thread performs several jobs.
+static const int JOB_COUNT = THREAD_COUNT * 8;
+
+static const int REGION_SIZE_X = 256;
+
+static const int REGION_SIZE_Z = 64;
+
+static const double SPACING = 1.0 / 64.0;
+
+// The number of bytes allocated by new[] and not yet freed.  The tiles and
+// hash buckets of noise::module::TileCache are allocated by new[].
+static volatile size_t g_arrayBytes = 0;
+
+void* operator new[] (size_t size)
+{
+  // Store the size before the array, keeping the array aligned.
+  char* pBlock = (char*)malloc (size + 16);
+  if (pBlock == NULL) {
+    throw std::bad_alloc ();
+  }
+  *(size_t*)pBlock = size;
+  AtomicAdd (g_arrayBytes, size);
+  return pBlock + 16;
+}
+
+void operator delete[] (void* pArray) throw ()
+{
+  if (pArray != NULL) {
+    char* pBlock = (char*)pArray - 16;
+    AtomicAdd (g_arrayBytes, (size_t)0 - *(size_t*)pBlock);
+    free (pBlock);
+  }
+}
+
+struct TestContext
+{
+  module::Perlin source;
+  module::TileCache tileCache;
+  volatile int failCount;
+};
+
+static void GenerateRegion (void* pContext, int jobIndex)
+{
+  TestContext& context = *(TestContext*)pContext;
+  double x[REGION_SIZE_X];
+  double y[REGION_SIZE_X];
+  double z[REGION_SIZE_X];
+  double values[REGION_SIZE_X];
+  double expected[REGION_SIZE_X];
+  for (int k = 0; k < REGION_SIZE_Z; k++) {
+    for (int i = 0; i < REGION_SIZE_X; i++) {
+      x[i] = i * SPACING;
+      y[i] = 0.0;
+      z[i] = (jobIndex * REGION_SIZE_Z + k) * SPACING;
+    }
+    context.tileCache.GetValues (REGION_SIZE_X, x, y, z, values);
+    context.source.GetValues (REGION_SIZE_X, x, y, z, expected);
+    for (int i = 0; i < REGION_SIZE_X; i++) {
+      if (values[i] != expected[i]) {
+        AtomicAdd (context.failCount, 1);
+      }
+    }
+  }
+}
+
+int main ()
+{
+  TestContext context;
+  context.failCount = 0;
+  context.tileCache.SetSourceModule (0, context.source);
+  context.tileCache.SetGrid (0.0, 0.0, 0.0, SPACING, 1.0, SPACING);
+  context.tileCache.SetMemoryBudget (MEMORY_BUDGET);
+
+  int failCount = 0;
+  ThreadPool* pPool = new ThreadPool (THREAD_COUNT);
+
+  // The first run creates the per-thread state of the tile cache;
+  // changing the memory budget then discards the tiles but not that
+  // state, so that only the tiles are allocated by the second run.
+  pPool->Run (JOB_COUNT, GenerateRegion, &context);
+  context.tileCache.SetMemoryBudget (MEMORY_BUDGET);
+  if (context.tileCache.GetMemoryUsage () != 0) {
+    printf ("FAIL: %lu bytes used after the tiles were discarded\n",
+      (unsigned long)context.tileCache.GetMemoryUsage ());
+    failCount++;
+  }
+  size_t baseBytes = g_arrayBytes;
+  pPool->Run (JOB_COUNT, GenerateRegion, &context);
+
+  // Tiles are only freed when they are discarded, so the memory used
+  // after the jobs is the most that was used during them.
+  size_t tileBytes = g_arrayBytes - baseBytes;
+  if (tileBytes > MEMORY_BUDGET) {
+    printf ("FAIL: %lu bytes of tiles allocated by %d threads, budget is "
+      "%lu\n", (unsigned long)tileBytes, pPool->GetThreadCount (),
+      (unsigned long)MEMORY_BUDGET);
+    failCount++;
+  }
+  if (tileBytes == 0) {
+    printf ("FAIL: no tiles were stored\n");
+    failCount++;
+  }
+  if (context.tileCache.GetMemoryUsage () > MEMORY_BUDGET) {
+    printf ("FAIL: memory usage of %lu bytes exceeds the budget of %lu\n",
+      (unsigned long)context.tileCache.GetMemoryUsage (),
+      (unsigned long)MEMORY_BUDGET);
+    failCount++;
+  }
+
+  // The tiles of the worker threads are discarded when they exit; only
+  // those of the calling thread, which also performs jobs, remain.
+  delete pPool;
+  size_t remainingBytes = g_arrayBytes - baseBytes;
+  if (remainingBytes > context.tileCache.GetMemoryUsage ()) {
+    printf ("FAIL: %lu bytes of tiles remain after the threads exited\n",
+      (unsigned long)remainingBytes);
+    failCount++;
+  }
+
+  if (context.failCount != 0) {
+    printf ("FAIL: %d cached values differ from the source values\n",
+      context.failCount);
+    failCount++;
+  }
+
+  if (failCount == 0) {
+    printf ("tilecachebudget: ok\n");
+  }
+  return failCount == 0? 0: 1;
+}
@@ -0,0 +1,110 @@
+// valuenoise.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+
+// Tests that the value-noise functions return the values that earlier
+// versions of libnoise generated, including the negative values of
+// IntValueNoise3D(), and that the array functions return the same values at
+// every supported instruction set.
+
+#include <stdio.h>
+
+#include <noise.h>
+
+using namespace noise;
+
+// The number of lattice points of the array functions.
+static const int COUNT = 1000;
+
+// Lattice points, and the values that earlier versions of libnoise generated
+// for them.
+struct KnownValue
+{
+  int x, y, z, seed;
+  int intValue;
+  double value;
+};
+
+static const KnownValue KNOWN_VALUES[] = {
+  {    0,    0,    0, 0,  1376312589, -0.28179098386317492},
+  {    1,    2,    3, 0,   448794225,  0.58202780690044165},
+  {   -7,   11,    5, 1, -1389413199,  2.2939918776974082 },
+  {  100, -200,  300, 2,  -333813399,  1.310887954197824  },
+  {12345,  678,   -9, 3,   896916385,  0.16468152310699224},
+  {   -1,   -1,   -1, 4,  1637107743, -0.52467539813369513},
+  {    5,    5,    5, 5,   797123913,  0.2576205050572753 },
+  {   31,  -17,    2, 6,  -428148223,  1.398744105361402  }
+};
+
+static const int KNOWN_VALUE_COUNT
+  = sizeof (KNOWN_VALUES) / sizeof (KNOWN_VALUES[0]);
+
+int main ()
+{
+  int failCount = 0;
+
+  for (int i = 0; i < KNOWN_VALUE_COUNT; i++) {
+    const KnownValue& known = KNOWN_VALUES[i];
+    int intValue = IntValueNoise3D (known.x, known.y, known.z, known.seed);
+    double value = ValueNoise3D (known.x, known.y, known.z, known.seed);
+    if (intValue != known.intValue || value != known.value) {
+      if (failCount == 0) {
+        printf ("FAIL: (%d, %d, %d) returned %d and %.17g, expected %d and "
+          "%.17g\n", known.x, known.y, known.z, intValue, value,
+          known.intValue, known.value);
+      }
+      failCount++;
+    }
+  }
+
+  int x[COUNT], y[COUNT], z[COUNT], intValues[COUNT];
+  double values[COUNT];
+  for (int i = 0; i < COUNT; i++) {
+    x[i] = i * 7919 - 3000000;
+    y[i] = i * 104729 % 65536 - 32768;
+    z[i] = -i * 31;
+  }
+  SimdLevel maxSimdLevel = GetMaxSimdLevel ();
+  for (int level = SIMD_SCALAR; level <= maxSimdLevel; level++) {
+    SetSimdLevel ((SimdLevel)level);
+    IntValueNoise3DArray (COUNT, x, y, z, intValues, 7);
+    ValueNoise3DArray (COUNT, x, y, z, values, 7);
+    for (int i = 0; i < COUNT; i++) {
+      int intValue = IntValueNoise3D (x[i], y[i], z[i], 7);
+      double value = ValueNoise3D (x[i], y[i], z[i], 7);
+      if (intValues[i] != intValue || values[i] != value) {
+        if (failCount == 0) {
+          printf ("FAIL: level %d: arrays returned %d and %.17g at %d, "
+            "expected %d and %.17g\n", level, intValues[i], values[i], i,
+            intValue, value);
+        }
+        failCount++;
+      }
+    }
+  }
+  SetSimdLevel (maxSimdLevel);
+
+  if (failCount == 0) {
+    printf ("valuenoise: ok\n");
+  }
+  return failCount == 0? 0: 1;
+}
@@ -0,0 +1,170 @@
+// voronoifeatures.cpp
+//
+// Copyright (C) 2003, 2004 Jason Bevins
+//
+// This library is free software; you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation; either version 2.1 of the License, or (at
+// your option) any later version.
+//
+// This library is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+// License (COPYING.txt) for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this library; if not, write to the Free Software Foundation,
+// Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// The developer's email is jlbezigvins@gmzigail.com (for great email, take
+// off every 'zig'.)
+//
+
+
+// Tests the GetFeatures() methods of noise::module::Voronoi.  The nearest
+// and second-nearest distances must be identical to the distances that a
+// search of all 125 unit cubes around the input value finds, which checks
+// that the pruned search skips no unit cube that it needs.  The batched
+// method must return the same results as the single-input-value method,
+// and the output values of the noise module must be calculated from the
+// results for each distance type.
+
+#include <math.h>
+#include <stdio.h>
+
+#include <mathconsts.h>
+#include <noise.h>
+
+using namespace noise;
+
+// The number of input values; more than two spans of the batched
+// GetValues() methods.
+static const int COUNT = 2 * module::MODULE_BATCH_SIZE + 37;
+
+// Returns a pseudo-random value from lower to upper.
+static double GetRandom (double lower, double upper)
+{
+  static unsigned int state = 1;
+  state = state * 1103515245 + 12345;
+  return lower + (upper - lower) * ((state >> 8) / 16777216.0);
+}
+
+// Searches all 125 unit cubes around a scaled input value, in the same order
+// as noise::module::Voronoi, for the squared distances to the nearest and
+// second-nearest seed points.
+static void FindDistances (double x, double y, double z, int seed,
+  double& minDist, double& secondDist)
+{
+  int xInt = (x > 0.0? (int)x: (int)x - 1);
+  int yInt = (y > 0.0? (int)y: (int)y - 1);
+  int zInt = (z > 0.0? (int)z: (int)z - 1);
+  minDist = 2147483647.0;
+  secondDist = 2147483647.0;
+  for (int zCur = zInt - 2; zCur <= zInt + 2; zCur++) {
+    for (int yCur = yInt - 2; yCur <= yInt + 2; yCur++) {
+      for (int xCur = xInt - 2; xCur <= xInt + 2; xCur++) {
+        double xDist = xCur + ValueNoise3D (xCur, yCur, zCur, seed    ) - x;
+        double yDist = yCur + ValueNoise3D (xCur, yCur, zCur, seed + 1) - y;
+        double zDist = zCur + ValueNoise3D (xCur, yCur, zCur, seed + 2) - z;
+        double dist = xDist * xDist + yDist * yDist + zDist * zDist;
+        if (dist < minDist) {
+          secondDist = minDist;
+          minDist = dist;
+        } else if (dist < secondDist) {
+          secondDist = dist;
+        }
+      }
+    }
+  }
+}
+
+// Returns true if two sets of features are identical.
+static bool IsSame (const module::VoronoiFeatures& a,
+  const module::VoronoiFeatures& b)
+{
+  return a.distance1 == b.distance1 && a.distance2 == b.distance2
+    && a.cellId == b.cellId && a.cellValue == b.cellValue && a.x == b.x
+    && a.y == b.y && a.z == b.z;
+}
+
+// Checks the features of a noise::module::Voronoi noise module at random
+// input values, and returns the number of failures.
+static int CheckVoronoi (const char* name, module::Voronoi& voronoi)
+{
+  double x[COUNT], y[COUNT], z[COUNT];
+  for (int i = 0; i < COUNT; i++) {
+    x[i] = GetRandom (-6.0, 6.0);
+    y[i] = GetRandom (-6.0, 6.0);
+    z[i] = GetRandom (-6.0, 6.0);
+  }
+  module::VoronoiFeatures features[COUNT];
+  voronoi.GetFeatures (COUNT, x, y, z, features);
+
+  double distanceValues[3][COUNT];
+  static const module::VoronoiDistance DISTANCE_TYPES[3] = {
+    module::VORONOI_DISTANCE_F1,
+    module::VORONOI_DISTANCE_F2,
+    module::VORONOI_DISTANCE_F2_MINUS_F1
+  };
+  voronoi.EnableDistance (true);
+  for (int i = 0; i < 3; i++) {
+    voronoi.SetDistanceType (DISTANCE_TYPES[i]);
+    voronoi.GetValues (COUNT, x, y, z, distanceValues[i]);
+  }
+  voronoi.EnableDistance (false);
+
+  int failCount = 0;
+  double frequency = voronoi.GetFrequency ();
+  double displacement = voronoi.GetDisplacement ();
+  for (int i = 0; i < COUNT; i++) {
+    module::VoronoiFeatures single;
+    voronoi.GetFeatures (x[i], y[i], z[i], single);
+    double minDist, secondDist;
+    FindDistances (x[i] * frequency, y[i] * frequency, z[i] * frequency,
+      voronoi.GetSeed (), minDist, secondDist);
+    double xDist = single.x * frequency - x[i] * frequency;
+    double yDist = single.y * frequency - y[i] * frequency;
+    double zDist = single.z * frequency - z[i] * frequency;
+    double seedDist = sqrt (xDist * xDist + yDist * yDist + zDist * zDist);
+    double displacedValue = displacement * single.cellValue;
+    bool isMatch = IsSame (features[i], single)
+      && single.distance1 == sqrt (minDist)
+      && single.distance2 == sqrt (secondDist)
+      && single.distance1 <= single.distance2
+      && fabs (seedDist - single.distance1) <= 1.0e-9
+      && single.cellValue == 1.0 - single.cellId / 1073741824.0
+      && distanceValues[0][i]
+        == single.distance1 * SQRT_3 - 1.0 + displacedValue
+      && distanceValues[1][i]
+        == single.distance2 * SQRT_3 - 1.0 + displacedValue
+      && distanceValues[2][i] == (single.distance2 - single.distance1)
+        * SQRT_3 - 1.0 + displacedValue;
+    if (!isMatch) {
+      if (failCount == 0) {
+        printf ("FAIL: %s: (%.17g, %.17g, %.17g) returned distances %.17g "
+          "and %.17g, the full search found %.17g and %.17g\n", name, x[i],
+          y[i], z[i], single.distance1, single.distance2, sqrt (minDist),
+          sqrt (secondDist));
+      }
+      failCount++;
+    }
+  }
+  return failCount;
+}
+
+int main ()
+{
+  int failCount = 0;
+
+  module::Voronoi voronoi;
+  failCount += CheckVoronoi ("Voronoi", voronoi);
+  voronoi.SetFrequency (1.7);
+  voronoi.SetSeed (23);
+  voronoi.SetDisplacement (-0.5);
+  failCount += CheckVoronoi ("Voronoi (frequency)", voronoi);
+
+  if (failCount == 0) {
+    printf ("voronoifeatures: ok\n");
+  }
+  return failCount == 0? 0: 1;
+}